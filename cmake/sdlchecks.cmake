@@ -903,6 +903,20 @@ macro(CheckPTHREAD)
         endif()
       endif()
 
+      if(LINUX)
+        check_c_source_compiles("
+            #include <linux/futex.h>
+            #include <sys/syscall.h>
+            #include <unistd.h>
+            int main(int argc, char **argv) {
+              int word = 0;
+              return (int)syscall(SYS_futex, &word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+            }" HAVE_LINUX_FUTEX)
+        if(HAVE_LINUX_FUTEX)
+          set(SDL_THREAD_LINUX_FUTEX 1)
+        endif()
+      endif()
+
       if(SDL_PTHREADS_SEM)
         check_c_source_compiles("#include <pthread.h>
                                  #include <semaphore.h>
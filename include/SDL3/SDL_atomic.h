@@ -511,6 +511,95 @@ extern SDL_DECLSPEC int SDLCALL SDL_AddAtomicInt(SDL_AtomicInt *a, int v);
 #define SDL_AtomicDecRef(a)    (SDL_AddAtomicInt(a, -1) == 1)
 #endif
 
+/**
+ * Wait until an atomic variable no longer has a value.
+ *
+ * This puts the calling thread to sleep as long as the variable holds
+ * `value`. Another thread that changes the variable wakes the waiting threads
+ * with SDL_NotifyAtomicIntOne() or SDL_NotifyAtomicIntAll(). This lets
+ * threads wait on a counter or a flag without spinning and without pairing
+ * it with a mutex and condition variable.
+ *
+ * The value is checked again every time the thread wakes up, so if the
+ * variable was changed and then changed back to `value` before the thread
+ * got to run, it keeps waiting.
+ *
+ * On Linux this sleeps on a futex and on Windows 8 and newer it uses
+ * WaitOnAddress(). Elsewhere the waiting threads are kept in a small table of
+ * mutexes and condition variables, indexed by the address of the variable.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable.
+ * \param value the value to wait on.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_NotifyAtomicIntAll
+ * \sa SDL_NotifyAtomicIntOne
+ * \sa SDL_WaitAtomicIntTimeout
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_WaitAtomicInt(SDL_AtomicInt *a, int value);
+
+/**
+ * Wait until an atomic variable no longer has a value, or a timeout elapses.
+ *
+ * This works like SDL_WaitAtomicInt(), but gives up after `timeoutMS`
+ * milliseconds.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable.
+ * \param value the value to wait on.
+ * \param timeoutMS the timeout, in milliseconds, 0 to only check the value,
+ *                  or -1 to wait indefinitely.
+ * \returns true if the variable no longer has the value, false if the wait
+ *          timed out.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_NotifyAtomicIntAll
+ * \sa SDL_NotifyAtomicIntOne
+ * \sa SDL_WaitAtomicInt
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_WaitAtomicIntTimeout(SDL_AtomicInt *a, int value, Sint32 timeoutMS);
+
+/**
+ * Wake up one thread waiting on an atomic variable.
+ *
+ * Call this after changing the variable. This is cheap when nobody is
+ * waiting.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_NotifyAtomicIntAll
+ * \sa SDL_WaitAtomicInt
+ * \sa SDL_WaitAtomicIntTimeout
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_NotifyAtomicIntOne(SDL_AtomicInt *a);
+
+/**
+ * Wake up all threads waiting on an atomic variable.
+ *
+ * Call this after changing the variable. This is cheap when nobody is
+ * waiting.
+ *
+ * \param a a pointer to an SDL_AtomicInt variable.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_NotifyAtomicIntOne
+ * \sa SDL_WaitAtomicInt
+ * \sa SDL_WaitAtomicIntTimeout
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_NotifyAtomicIntAll(SDL_AtomicInt *a);
+
 /**
  * A type representing an atomic unsigned 32-bit value.
  *
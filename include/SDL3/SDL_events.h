@@ -1357,6 +1357,33 @@ extern SDL_DECLSPEC bool SDLCALL SDL_WaitEventTimeout(SDL_Event *event, Sint32 t
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_PushEvent(SDL_Event *event);
 
+/**
+ * Add several events to the event queue at once.
+ *
+ * This works like calling SDL_PushEvent() for each event, but the events are
+ * added with a single lock of the event queue, and anyone waiting for events
+ * is woken up only once. The events are added in order, and no other event
+ * will be queued between them.
+ *
+ * Each event is passed through the event filter and event watchers first;
+ * events that the filter rejects are left out. `events` is not modified, the
+ * timestamps of events that have none are filled in on a copy.
+ *
+ * \param events an array of events to be added to the queue.
+ * \param count the number of events in `events`.
+ * \returns the number of events added to the queue, which is less than
+ *          `count` if events were filtered or the queue is full, or -1 on
+ *          failure; call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_PushEvent
+ * \sa SDL_PeepEvents
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_PushEvents(const SDL_Event *events, int count);
+
 /**
  * A function pointer used for callbacks that watch the event queue.
  *
@@ -1599,6 +1626,33 @@ extern SDL_DECLSPEC SDL_Window * SDLCALL SDL_GetWindowFromEvent(const SDL_Event
  */
 extern SDL_DECLSPEC int SDLCALL SDL_GetEventDescription(const SDL_Event *event, char *buf, int buflen);
 
+/**
+ * Get the raw motion events of a device that were merged in the event queue.
+ *
+ * When SDL_HINT_EVENT_COALESCE_MOTION is enabled, consecutive motion events
+ * from a device are merged into one queued event, and the original events
+ * are kept in a history for that device, which holds the most recent 128
+ * events. This function copies the oldest events from the history into
+ * `events` and removes them from it, so calling it after handling a merged
+ * event returns the samples that made it up. The history of a device is
+ * discarded when the device is removed.
+ *
+ * \param type SDL_EVENT_MOUSE_MOTION, SDL_EVENT_PEN_MOTION or
+ *             SDL_EVENT_FINGER_MOTION.
+ * \param which the SDL_MouseID, SDL_PenID or SDL_TouchID of the device.
+ * \param events an array of events to be filled in.
+ * \param numevents the maximum number of events to return.
+ * \returns the number of events copied into `events`, or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetMotionHistory(SDL_EventType type, Uint64 which, SDL_Event *events, int numevents);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
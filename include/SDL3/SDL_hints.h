@@ -617,6 +617,8 @@ extern "C" {
  * - "neon"
  * - "lsx"
  * - "lasx"
+ * - "pclmul"
+ * - "pmull"
  *
  * The items can be prefixed by '+'/'-' to add/remove features.
  *
@@ -772,6 +774,28 @@ extern "C" {
  */
 #define SDL_HINT_EVDEV_DEVICES "SDL_EVDEV_DEVICES"
 
+/**
+ * A variable controlling whether consecutive motion events are merged in the
+ * event queue.
+ *
+ * When enabled, a mouse, pen or finger motion event that is added right
+ * after a motion event of the same type from the same device and window is
+ * merged into the queued event instead of taking a new slot: the position is
+ * updated to the latest one and relative motion is added up. The raw,
+ * unmerged events of each device can be retrieved with
+ * SDL_GetMotionHistory().
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Every motion event is queued separately. (default)
+ * - "1": Consecutive motion events are merged.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_EVENT_COALESCE_MOTION "SDL_EVENT_COALESCE_MOTION"
+
 /**
  * A variable controlling verbosity of the logging of SDL events pushed onto
  * the internal queue.
@@ -2347,6 +2371,52 @@ extern "C" {
  */
 #define SDL_HINT_KMSDRM_REQUIRE_DRM_MASTER "SDL_KMSDRM_REQUIRE_DRM_MASTER"
 
+/**
+ * A variable controlling whether SDL uses pthread synchronization objects on
+ * Linux.
+ *
+ * By default, SDL builds its mutexes, semaphores and condition variables
+ * directly on Linux futexes, which avoids system calls when there is no
+ * contention and spins briefly before sleeping when there is. This hint
+ * makes SDL use the pthread implementations instead.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Use futexes. (default)
+ * - "1": Force the use of pthread mutexes, semaphores and condition
+ *   variables.
+ *
+ * This hint is read from the environment when the first mutex or semaphore
+ * is created, so it has to be set before the program starts.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_LINUX_FORCE_PTHREAD_SYNC "SDL_LINUX_FORCE_PTHREAD_SYNC"
+
+/**
+ * A variable controlling whether SDL profiles its locks.
+ *
+ * When this is enabled, SDL keeps statistics about how often each named
+ * mutex and read/write lock is acquired, contended and held, which can be
+ * logged with SDL_DumpLockProfile(). Locks are named when they are created
+ * with SDL_CreateMutexWithProperties() or SDL_CreateRWLockWithProperties(),
+ * and SDL names the ones it uses internally.
+ *
+ * Profiling is supported with pthreads and on Windows. Other platforms ignore
+ * this hint.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Locks aren't profiled. (default)
+ * - "1": Named locks are profiled.
+ *
+ * This hint is read from the environment when each lock is created, so it has
+ * to be set before the program starts.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ */
+#define SDL_HINT_LOCK_PROFILING "SDL_LOCK_PROFILING"
+
 /**
  * A variable controlling the default SDL log levels.
  *
@@ -2373,6 +2443,36 @@ extern "C" {
  */
 #define SDL_HINT_LOGGING "SDL_LOGGING"
 
+/**
+ * A variable controlling whether log messages are written on a background
+ * thread.
+ *
+ * By default, the log output function is called on the thread that logs the
+ * message, which can cause glitches when logging from audio or input
+ * threads. In asynchronous mode, messages are put in a queue and written out
+ * by a separate thread, in the order they were logged.
+ *
+ * The variable can be set to the following values:
+ *
+ * - "0": Log messages are written synchronously. (default)
+ * - "1" or "drop": Log messages are written asynchronously, and messages
+ *   are dropped if the queue is full. The number of dropped messages is
+ *   logged once there is room again.
+ * - "block": Log messages are written asynchronously, and logging waits for
+ *   room in the queue if it is full.
+ *
+ * Critical messages are written out before the logging call returns, and
+ * SDL_SetLogOutputFunction() passes any queued messages to the previous
+ * output function before replacing it.
+ *
+ * This hint can be set anytime.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ *
+ * \sa SDL_FlushLogs
+ */
+#define SDL_HINT_LOG_ASYNC "SDL_LOG_ASYNC"
+
 /**
  * A variable controlling whether to force the application to become the
  * foreground process when launched on macOS.
@@ -3252,6 +3352,26 @@ extern "C" {
  */
 #define SDL_HINT_TIMER_RESOLUTION "SDL_TIMER_RESOLUTION"
 
+/**
+ * A variable controlling how many threads run timer callbacks.
+ *
+ * By default, every timer callback runs on a single timer thread, so a slow
+ * callback delays every other timer. When this is set to a number greater
+ * than 0, timers that are due are handed to a pool of that many worker
+ * threads instead. A timer never runs concurrently with itself, but
+ * different timers may run at the same time, so callbacks that share data
+ * need to protect it.
+ *
+ * The default value is "0".
+ *
+ * This hint should be set before the timer subsystem is initialized.
+ *
+ * \since This hint is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetTimerStats
+ */
+#define SDL_HINT_TIMER_THREADS "SDL_TIMER_THREADS"
+
 /**
  * A variable controlling whether touch events should generate synthetic mouse
  * events.
@@ -225,6 +225,15 @@ typedef struct SDL_IOStream SDL_IOStream;
  * effect. For example, "t" is sometimes appended to make explicit the file is
  * a text file.
  *
+ * Files opened only for reading can be mapped into memory instead, by adding
+ * an "m" to the mode ("rm" or "rbm"). Reading a mapped file copies directly
+ * from the file's pages in the operating system's cache, without going
+ * through a system call for each read. The mapped data is available through
+ * the `SDL_PROP_IOSTREAM_MEMORY_POINTER` and
+ * `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER` properties, like for
+ * SDL_IOFromConstMem(). Adding "S" or "R" too hints that the file will be
+ * read sequentially or randomly, see SDL_MapFile() for details.
+ *
  * This function supports Unicode filenames, but they must be encoded in UTF-8
  * format, regardless of the underlying operating system.
  *
@@ -253,6 +262,10 @@ typedef struct SDL_IOStream SDL_IOStream;
  *   to an Android NDK `AAsset *`, that this SDL_IOStream is using to access
  *   the filesystem. If SDL used some other method to access the filesystem,
  *   this property will not be set.
+ * - `SDL_PROP_IOSTREAM_MEMORY_POINTER`: the file's data, if the file was
+ *   mapped into memory.
+ * - `SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER`: the size of the file's data, if
+ *   the file was mapped into memory.
  *
  * \param file a UTF-8 string representing the filename to open.
  * \param mode an ASCII string representing the mode to be used for opening
@@ -396,6 +409,44 @@ extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromDynamicMem(void);
 #define SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER    "SDL.iostream.dynamic.memory"
 #define SDL_PROP_IOSTREAM_DYNAMIC_CHUNKSIZE_NUMBER  "SDL.iostream.dynamic.chunksize"
 
+/**
+ * Use this function to create an SDL_IOStream that buffers another stream.
+ *
+ * Reads are served from a buffer that is refilled from `src` a buffer at a
+ * time, and writes are collected in the buffer until it's full, the stream
+ * is flushed, or the stream switches to reading. This makes many small reads
+ * and writes, like SDL_ReadU32LE() and SDL_WriteU32LE() calls, much cheaper
+ * on streams where each one goes to the operating system. Reads and writes
+ * of at least the buffer size bypass the buffer.
+ *
+ * Seeking within the data currently in the buffer doesn't touch `src`.
+ *
+ * `src` must not be used directly while the buffered stream is open, since
+ * its position runs ahead of the buffered stream's position. When the
+ * buffered stream is closed, any buffered writes are written and, if `src`
+ * is left open, `src` is seeked back to the position the buffered stream was
+ * at.
+ *
+ * \param src the stream to buffer.
+ * \param buffer_size the size of the buffer, in bytes, or 0 to use a default
+ *                    size.
+ * \param closeio if true, calls SDL_CloseIO() on `src` when the buffered
+ *                stream is closed, even in the case of an error.
+ * \returns a pointer to a new SDL_IOStream structure or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CloseIO
+ * \sa SDL_FlushIO
+ * \sa SDL_ReadIO
+ * \sa SDL_SeekIO
+ * \sa SDL_WriteIO
+ */
+extern SDL_DECLSPEC SDL_IOStream * SDLCALL SDL_IOFromBufferedIO(SDL_IOStream *src, size_t buffer_size, bool closeio);
+
 /* @} *//* IOFrom functions */
 
 
@@ -720,10 +771,74 @@ extern SDL_DECLSPEC void * SDLCALL SDL_LoadFile_IO(SDL_IOStream *src, size_t *da
  * \since This function is available since SDL 3.2.0.
  *
  * \sa SDL_LoadFile_IO
+ * \sa SDL_MapFile
  * \sa SDL_SaveFile
  */
 extern SDL_DECLSPEC void * SDLCALL SDL_LoadFile(const char *file, size_t *datasize);
 
+/**
+ * Flags for mapping files into memory.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_MapFile
+ */
+typedef Uint32 SDL_MapFileFlags;
+
+#define SDL_MAPFILE_SEQUENTIAL (1u << 0) /**< The data will be read in order, so read far ahead of it. */
+#define SDL_MAPFILE_RANDOM     (1u << 1) /**< The data will be read in no particular order, so don't read ahead. */
+
+/**
+ * Map all the data from a file path into memory, without copying it.
+ *
+ * Unlike SDL_LoadFile(), this doesn't read the file up front. The data is
+ * read from the file's pages in the operating system's cache when it is
+ * first touched, and the memory is shared with other programs mapping the
+ * same file. The data can be passed to SDL_IOFromConstMem() to use it with
+ * anything that reads an SDL_IOStream.
+ *
+ * The flags are hints about how the data will be accessed, and are used by
+ * the operating system to decide how much of the file to read at a time.
+ *
+ * If the file can't be mapped, for example because it's an Android asset or
+ * a pipe, or because the platform doesn't support mapping files, it's read
+ * into memory instead. Either way, the data must be released with
+ * SDL_UnmapFile().
+ *
+ * The data is read-only, and unlike SDL_LoadFile() it isn't null
+ * terminated. The file must not be truncated while it's mapped.
+ *
+ * \param file the path to map into memory.
+ * \param flags `SDL_MAPFILE_*` bitflags describing how the data will be
+ *              accessed, or 0.
+ * \param datasize if not NULL, will store the number of bytes mapped.
+ * \returns the data or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_IOFromConstMem
+ * \sa SDL_LoadFile
+ * \sa SDL_UnmapFile
+ */
+extern SDL_DECLSPEC const void * SDLCALL SDL_MapFile(const char *file, SDL_MapFileFlags flags, size_t *datasize);
+
+/**
+ * Release data mapped with SDL_MapFile().
+ *
+ * \param mem the data returned by SDL_MapFile(), may be NULL.
+ * \param datasize the size returned by SDL_MapFile().
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_MapFile
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_UnmapFile(const void *mem, size_t datasize);
+
 /**
  * Save all the data into an SDL data stream.
  *
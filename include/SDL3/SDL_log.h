@@ -528,6 +528,24 @@ extern SDL_DECLSPEC void SDLCALL SDL_GetLogOutputFunction(SDL_LogOutputFunction
  */
 extern SDL_DECLSPEC void SDLCALL SDL_SetLogOutputFunction(SDL_LogOutputFunction callback, void *userdata);
 
+/**
+ * Wait for queued log messages to be written.
+ *
+ * When SDL_HINT_LOG_ASYNC is enabled, log messages are written out on a
+ * background thread. This waits until every message logged before this call
+ * has been passed to the log output function. If logging is synchronous,
+ * this does nothing.
+ *
+ * Calling this from within a log output function does nothing.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_HINT_LOG_ASYNC
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_FlushLogs(void);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
@@ -317,6 +317,35 @@ typedef struct SDL_Mutex SDL_Mutex;
  */
 extern SDL_DECLSPEC SDL_Mutex * SDLCALL SDL_CreateMutex(void);
 
+/**
+ * Create a new mutex with the specified properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_MUTEX_CREATE_NAME_STRING`: the name of the mutex, which is used
+ *   to identify it in lock profiles. Mutexes with the same name share their
+ *   statistics. Optional, defaults to NULL.
+ *
+ * Lock profiling is enabled with SDL_HINT_LOCK_PROFILING, and only covers
+ * named locks. The mutex works exactly like one created by SDL_CreateMutex()
+ * either way.
+ *
+ * \param props the properties to use.
+ * \returns the initialized and unlocked mutex or NULL on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateMutex
+ * \sa SDL_DestroyMutex
+ * \sa SDL_DumpLockProfile
+ */
+extern SDL_DECLSPEC SDL_Mutex * SDLCALL SDL_CreateMutexWithProperties(SDL_PropertiesID props);
+
+#define SDL_PROP_MUTEX_CREATE_NAME_STRING "SDL.mutex.create.name"
+
 /**
  * Lock the mutex.
  *
@@ -468,6 +497,35 @@ typedef struct SDL_RWLock SDL_RWLock;
  */
 extern SDL_DECLSPEC SDL_RWLock * SDLCALL SDL_CreateRWLock(void);
 
+/**
+ * Create a new read/write lock with the specified properties.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_RWLOCK_CREATE_NAME_STRING`: the name of the read/write lock,
+ *   which is used to identify it in lock profiles. Locks with the same name
+ *   share their statistics. Optional, defaults to NULL.
+ *
+ * Lock profiling is enabled with SDL_HINT_LOCK_PROFILING, and only covers
+ * named locks. Hold times are only measured for write locks, since any number
+ * of threads can hold a read-only lock at once.
+ *
+ * \param props the properties to use.
+ * \returns the initialized and unlocked read/write lock or NULL on failure;
+ *          call SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateRWLock
+ * \sa SDL_DestroyRWLock
+ * \sa SDL_DumpLockProfile
+ */
+extern SDL_DECLSPEC SDL_RWLock * SDLCALL SDL_CreateRWLockWithProperties(SDL_PropertiesID props);
+
+#define SDL_PROP_RWLOCK_CREATE_NAME_STRING "SDL.rwlock.create.name"
+
 /**
  * Lock the read/write lock for _read only_ operations.
  *
@@ -636,6 +694,55 @@ extern SDL_DECLSPEC void SDLCALL SDL_DestroyRWLock(SDL_RWLock *rwlock);
 /* @} *//* Read/write lock functions */
 
 
+/**
+ *  \name Lock profiling functions
+ */
+/* @{ */
+
+/**
+ * Log the statistics of every profiled lock.
+ *
+ * When SDL_HINT_LOCK_PROFILING is set, SDL counts how often each named mutex
+ * and read/write lock is acquired, how often a thread had to wait for it and
+ * for how long, and how long it was held. Every line of the table covers all
+ * the locks with the same name, and the locks that threads spent the most
+ * time waiting for are listed first. Wait and hold times are recorded in
+ * histograms with power of two buckets, so percentiles are rounded up to the
+ * next power of two nanoseconds.
+ *
+ * The locks that SDL uses internally are named after what they protect, for
+ * example "SDL_EventQ.lock". The table is also logged by SDL_Quit().
+ *
+ * \returns true on success or false if lock profiling isn't enabled; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateMutexWithProperties
+ * \sa SDL_CreateRWLockWithProperties
+ * \sa SDL_ResetLockProfile
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_DumpLockProfile(void);
+
+/**
+ * Clear the statistics of every profiled lock.
+ *
+ * This can be used to profile just one part of a program, such as a level
+ * once it's done loading.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DumpLockProfile
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetLockProfile(void);
+
+/* @} *//* Lock profiling functions */
+
+
 /**
  *  \name Semaphore functions
  */
@@ -43,6 +43,10 @@
  *   types.
  *
  * Properties can be removed from a group by using SDL_ClearProperty.
+ *
+ * Code that reads the same property many times, e.g. once per frame, can
+ * look up the property name once with SDL_GetPropertyAtom and use the
+ * getters that take an SDL_PropertyAtom, which skip the name lookup.
  */
 
 
@@ -65,6 +69,24 @@ extern "C" {
  */
 typedef Uint32 SDL_PropertiesID;
 
+/**
+ * An interned property name.
+ *
+ * Each distinct property name maps to a single nonzero atom, which can be
+ * used with the getters that end in `ByAtom` to avoid looking up the name on
+ * every call.
+ *
+ * Every name that is ever set on a group of properties or passed to
+ * SDL_GetPropertyAtom() is interned, and stays interned until SDL_Quit() is
+ * called. Apps that generate property names at runtime, for example by
+ * formatting an ID into the name, grow this table with every new name.
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ */
+typedef Uint32 SDL_PropertyAtom;
+
 /**
  * SDL property type
  *
@@ -465,6 +487,138 @@ extern SDL_DECLSPEC float SDLCALL SDL_GetFloatProperty(SDL_PropertiesID props, c
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value);
 
+/**
+ * Get the atom for a property name.
+ *
+ * The atom is created the first time a name is seen, and remains valid
+ * until SDL_Quit() is called. Atoms are never reused, so an atom kept from
+ * before SDL_Quit() doesn't match any property afterwards, and has to be
+ * looked up again.
+ *
+ * \param name the name of the property.
+ * \returns the atom for the property name, or 0 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetBooleanPropertyByAtom
+ * \sa SDL_GetFloatPropertyByAtom
+ * \sa SDL_GetNumberPropertyByAtom
+ * \sa SDL_GetPointerPropertyByAtom
+ * \sa SDL_GetStringPropertyByAtom
+ */
+extern SDL_DECLSPEC SDL_PropertyAtom SDLCALL SDL_GetPropertyAtom(const char *name);
+
+/**
+ * Get a pointer property from a group of properties using an atom.
+ *
+ * This is the same as SDL_GetPointerProperty(), but takes a property name that has
+ * been looked up with SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query.
+ * \param atom the atom of the name of the property to query.
+ * \param default_value the default value of the property.
+ * \returns the value of the property, or `default_value` if it is not set.
+ *
+ * \threadsafety It is safe to call this function from any thread, although
+ *               the data returned is not protected and could potentially be
+ *               freed if the property is changed or cleared from another
+ *               thread. If you need to avoid this, use SDL_LockProperties()
+ *               and SDL_UnlockProperties().
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetPointerProperty
+ */
+extern SDL_DECLSPEC void * SDLCALL SDL_GetPointerPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, void *default_value);
+
+/**
+ * Get a string property from a group of properties using an atom.
+ *
+ * This is the same as SDL_GetStringProperty(), but takes a property name that has
+ * been looked up with SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query.
+ * \param atom the atom of the name of the property to query.
+ * \param default_value the default value of the property.
+ * \returns the value of the property, or `default_value` if it is not set.
+ *
+ * \threadsafety It is safe to call this function from any thread, although
+ *               the data returned is not protected and could potentially be
+ *               freed if the property is changed or cleared from another
+ *               thread. If you need to avoid this, use SDL_LockProperties()
+ *               and SDL_UnlockProperties().
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetStringProperty
+ */
+extern SDL_DECLSPEC const char * SDLCALL SDL_GetStringPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, const char *default_value);
+
+/**
+ * Get a number property from a group of properties using an atom.
+ *
+ * This is the same as SDL_GetNumberProperty(), but takes a property name that has
+ * been looked up with SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query.
+ * \param atom the atom of the name of the property to query.
+ * \param default_value the default value of the property.
+ * \returns the value of the property, or `default_value` if it is not set.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetNumberProperty
+ */
+extern SDL_DECLSPEC Sint64 SDLCALL SDL_GetNumberPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, Sint64 default_value);
+
+/**
+ * Get a floating point property from a group of properties using an atom.
+ *
+ * This is the same as SDL_GetFloatProperty(), but takes a property name that has
+ * been looked up with SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query.
+ * \param atom the atom of the name of the property to query.
+ * \param default_value the default value of the property.
+ * \returns the value of the property, or `default_value` if it is not set.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetFloatProperty
+ */
+extern SDL_DECLSPEC float SDLCALL SDL_GetFloatPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, float default_value);
+
+/**
+ * Get a boolean property from a group of properties using an atom.
+ *
+ * This is the same as SDL_GetBooleanProperty(), but takes a property name that has
+ * been looked up with SDL_GetPropertyAtom().
+ *
+ * \param props the properties to query.
+ * \param atom the atom of the name of the property to query.
+ * \param default_value the default value of the property.
+ * \returns the value of the property, or `default_value` if it is not set.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetPropertyAtom
+ * \sa SDL_GetBooleanProperty
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetBooleanPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, bool default_value);
+
 /**
  * Clear a property from a group of properties.
  *
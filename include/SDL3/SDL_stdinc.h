@@ -1558,6 +1558,41 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetMemoryFunctions(SDL_malloc_func malloc_f
                                                             SDL_realloc_func realloc_func,
                                                             SDL_free_func free_func);
 
+/**
+ * Enable or disable per-thread caching of small allocations.
+ *
+ * SDL_malloc and friends normally call straight into the current memory
+ * functions, which usually serialize every call behind a single lock. With
+ * the thread cache enabled, small blocks freed by a thread are kept for that
+ * thread to reuse, and move between threads in batches, so the memory
+ * functions are called far less often under heavy multi-threaded use.
+ *
+ * This costs a small header on every allocation, and memory allocated by
+ * SDL_malloc can then only be released with SDL_free, never by calling the
+ * memory functions directly. A thread hands its cached memory back when it
+ * calls SDL_CleanupTLS(), which SDL does automatically for threads created
+ * with SDL_CreateThread() and for the main thread in SDL_Quit().
+ *
+ * Like SDL_SetMemoryFunctions(), this needs to be called before any memory
+ * has been allocated, usually as the first call made into the SDL library.
+ * The cache works on top of whatever memory functions are set. Each block
+ * remembers the memory functions that allocated it, so with the cache
+ * enabled, memory allocated before a later SDL_SetMemoryFunctions() call is
+ * still reallocated and freed by the functions it came from.
+ *
+ * \param enabled true to enable the thread cache, false to disable it.
+ * \returns true on success or false on failure (if memory has already been
+ *          allocated, or the platform doesn't support thread caching); call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety This should be called before any other threads are created.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SetMemoryFunctions
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SetMemoryThreadCache(bool enabled);
+
 /**
  * Allocate memory aligned to a specific alignment.
  *
@@ -2079,6 +2114,113 @@ extern SDL_DECLSPEC void SDLCALL SDL_qsort_r(void *base, size_t nmemb, size_t si
  */
 extern SDL_DECLSPEC void * SDLCALL SDL_bsearch_r(const void *key, const void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
 
+/**
+ * The type of the keys sorted by SDL_SortKeys32() and SDL_SortKeys64().
+ *
+ * \since This enum is available since SDL 3.4.0.
+ *
+ * \sa SDL_SortKeys32
+ * \sa SDL_SortKeys64
+ */
+typedef enum SDL_SortKeyType
+{
+    SDL_SORTKEY_UNSIGNED,   /**< Unsigned integers. */
+    SDL_SORTKEY_SIGNED,     /**< Signed integers. */
+    SDL_SORTKEY_FLOAT       /**< IEEE 754 floating point numbers, -0.0 sorts before 0.0, negative NaNs sort first and positive NaNs last. */
+} SDL_SortKeyType;
+
+/**
+ * Sort an array by a 32-bit key stored in each element.
+ *
+ * This uses a radix sort, which looks at the key bits directly instead of
+ * calling a compare function, and is much faster than SDL_qsort() for large
+ * arrays of elements with integer or floating point keys, such as render
+ * keys or depth values.
+ *
+ * The sort is stable: elements with equal keys stay in the order they were
+ * in.
+ *
+ * For example:
+ *
+ * ```c
+ * typedef struct {
+ *     Uint32 key;
+ *     SDL_Texture *texture;
+ * } sprite;
+ *
+ * SDL_SortKeys32(sprites, num_sprites, sizeof(sprites[0]), offsetof(sprite, key), SDL_SORTKEY_UNSIGNED);
+ * ```
+ *
+ * \param base a pointer to the start of the array.
+ * \param nmemb the number of elements in the array.
+ * \param size the size of the elements in the array.
+ * \param key_offset the offset of the key in each element, it does not need
+ *                   to be aligned.
+ * \param type the type of the key.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SortKeys64
+ * \sa SDL_qsort
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SortKeys32(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_SortKeyType type);
+
+/**
+ * Sort an array by a 64-bit key stored in each element.
+ *
+ * This is the same as SDL_SortKeys32(), for keys that are 64-bit integers or
+ * doubles.
+ *
+ * \param base a pointer to the start of the array.
+ * \param nmemb the number of elements in the array.
+ * \param size the size of the elements in the array.
+ * \param key_offset the offset of the key in each element, it does not need
+ *                   to be aligned.
+ * \param type the type of the key.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SortKeys32
+ * \sa SDL_qsort
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_SortKeys64(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_SortKeyType type);
+
+/**
+ * Sort a large array using multiple threads.
+ *
+ * This takes the same parameters as SDL_qsort_r(). The array is split into a
+ * chunk per CPU core, the chunks are sorted on separate threads, and then
+ * merged together, also on separate threads. This needs a temporary buffer
+ * as large as the array.
+ *
+ * Small arrays, or arrays on systems with a single CPU core, are sorted on
+ * the calling thread with SDL_qsort_r(), which is also what happens if the
+ * temporary buffer can't be allocated.
+ *
+ * \param base a pointer to the start of the array.
+ * \param nmemb the number of elements in the array.
+ * \param size the size of the elements in the array.
+ * \param compare a function used to compare elements in the array.
+ * \param userdata a pointer to pass to the compare function.
+ *
+ * \threadsafety It is safe to call this function from any thread. The
+ *               compare function will be called from several threads at the
+ *               same time.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_qsort_r
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ParallelSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata);
+
 /**
  * Compute the absolute value of `x`.
  *
@@ -4439,6 +4581,137 @@ extern SDL_DECLSPEC float SDLCALL SDL_randf_r(Uint64 *state);
  */
 extern SDL_DECLSPEC Uint32 SDLCALL SDL_rand_bits_r(Uint64 *state);
 
+/**
+ * A stream of pseudo-random numbers, for generating many of them at once.
+ *
+ * The stream is a counter-based generator (Philox4x32-10): the value at any
+ * position depends only on the seed and the position, so a stream produces
+ * the same values however they're split between calls to SDL_RandFillBits(),
+ * SDL_RandFillFloats() and SDL_RandFillInts(). Each value generated, of any
+ * type, uses one position in the stream.
+ *
+ * The fields can be set directly: setting `position` skips forward or back
+ * in the stream, and streams with different seeds can be given to different
+ * threads, or to different objects that need their own reproducible
+ * sequence.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_InitRandomStream
+ */
+typedef struct SDL_RandomStream
+{
+    Uint64 seed;        /**< the key that selects the sequence of values. */
+    Uint64 position;    /**< the number of values generated so far. */
+} SDL_RandomStream;
+
+/**
+ * Initialize a stream of pseudo-random numbers.
+ *
+ * Using the same seed again produces the same stream of values.
+ *
+ * \param stream the stream to initialize.
+ * \param seed the value to use as a random number seed, or 0 to use
+ *             SDL_GetPerformanceCounter().
+ *
+ * \threadsafety This function is thread-safe, as long as the stream isn't
+ *               shared between threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_RandFillBits
+ * \sa SDL_RandFillFloats
+ * \sa SDL_RandFillInts
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_InitRandomStream(SDL_RandomStream *stream, Uint64 seed);
+
+/**
+ * Fill an array with pseudo-random 32-bit values.
+ *
+ * This generates several values at a time using the SIMD instructions the
+ * CPU has, which is much faster than calling SDL_rand_bits_r() for each
+ * value when many are needed.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos).
+ *
+ * \param stream the stream to generate values from, which is advanced by
+ *               `count` values.
+ * \param values an array to fill with values in the range of
+ *               [0-SDL_MAX_UINT32].
+ * \param count the number of values to generate.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is thread-safe, as long as the stream isn't
+ *               shared between threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_InitRandomStream
+ * \sa SDL_RandFillFloats
+ * \sa SDL_RandFillInts
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RandFillBits(SDL_RandomStream *stream, Uint32 *values, int count);
+
+/**
+ * Fill an array with uniform pseudo-random floating point numbers less than
+ * 1.0.
+ *
+ * Each value is generated from 32 random bits the same way as SDL_randf_r().
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos).
+ *
+ * \param stream the stream to generate values from, which is advanced by
+ *               `count` values.
+ * \param values an array to fill with values in the range of [0.0, 1.0).
+ * \param count the number of values to generate.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is thread-safe, as long as the stream isn't
+ *               shared between threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_InitRandomStream
+ * \sa SDL_RandFillBits
+ * \sa SDL_RandFillInts
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RandFillFloats(SDL_RandomStream *stream, float *values, int count);
+
+/**
+ * Fill an array with pseudo-random numbers less than n for positive n.
+ *
+ * Each value is generated from 32 random bits the same way as SDL_rand_r(),
+ * so the same caveats about evenness for large n apply.
+ *
+ * There are no guarantees as to the quality of the random sequence produced,
+ * and this should not be used for security (cryptography, passwords) or where
+ * money is on the line (loot-boxes, casinos).
+ *
+ * \param stream the stream to generate values from, which is advanced by
+ *               `count` values.
+ * \param values an array to fill with values in the range of [0 .. n-1].
+ * \param count the number of values to generate.
+ * \param n the number of possible outcomes. n must be positive.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety This function is thread-safe, as long as the stream isn't
+ *               shared between threads.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_InitRandomStream
+ * \sa SDL_RandFillBits
+ * \sa SDL_RandFillFloats
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_RandFillInts(SDL_RandomStream *stream, Sint32 *values, int count, Sint32 n);
+
 #ifndef SDL_PI_D
 
 /**
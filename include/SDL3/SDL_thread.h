@@ -569,6 +569,178 @@ extern SDL_DECLSPEC bool SDLCALL SDL_SetTLS(SDL_TLSID *id, const void *value, SD
  */
 extern SDL_DECLSPEC void SDLCALL SDL_CleanupTLS(void);
 
+/**
+ * A pool of worker threads that run jobs.
+ *
+ * Each worker has its own queue of jobs. Jobs submitted from a worker, like
+ * the pieces a job splits its work into, go on that worker's queue, and
+ * idle workers take jobs from the others' queues, so the work spreads over
+ * all the threads without them contending for a single lock.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateJobSystem
+ * \sa SDL_SubmitJob
+ */
+typedef struct SDL_JobSystem SDL_JobSystem;
+
+/**
+ * A job that has been submitted to a job system.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitJob
+ * \sa SDL_WaitJob
+ * \sa SDL_ReleaseJob
+ */
+typedef struct SDL_Job SDL_Job;
+
+/**
+ * The function that does the work of a job.
+ *
+ * \param userdata what was passed as `userdata` to SDL_SubmitJob().
+ *
+ * \threadsafety This is called on one of the job system's worker threads,
+ *               or on a thread that is waiting in SDL_WaitJob().
+ *
+ * \since This datatype is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+typedef void (SDLCALL *SDL_JobFunction)(void *userdata);
+
+/**
+ * Create a job system with a pool of worker threads.
+ *
+ * These are the supported properties:
+ *
+ * - `SDL_PROP_JOBSYSTEM_CREATE_THREADS_NUMBER`: the number of worker
+ *   threads, defaults to the number of logical CPU cores.
+ * - `SDL_PROP_JOBSYSTEM_CREATE_PIN_THREADS_BOOLEAN`: true to ask for each
+ *   worker to stay on its own CPU core, which keeps its data in that core's
+ *   caches. This is a hint that is ignored where it isn't supported, and
+ *   defaults to false.
+ * - `SDL_PROP_JOBSYSTEM_CREATE_PRIORITY_NUMBER`: the SDL_ThreadPriority of
+ *   the worker threads, defaults to SDL_THREAD_PRIORITY_NORMAL.
+ *
+ * \param props the properties to use, or 0 for the defaults.
+ * \returns the new job system or NULL on failure; call SDL_GetError() for
+ *          more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DestroyJobSystem
+ * \sa SDL_SubmitJob
+ */
+extern SDL_DECLSPEC SDL_JobSystem * SDLCALL SDL_CreateJobSystem(SDL_PropertiesID props);
+
+#define SDL_PROP_JOBSYSTEM_CREATE_THREADS_NUMBER       "SDL.jobsystem.create.threads"
+#define SDL_PROP_JOBSYSTEM_CREATE_PIN_THREADS_BOOLEAN  "SDL.jobsystem.create.pin_threads"
+#define SDL_PROP_JOBSYSTEM_CREATE_PRIORITY_NUMBER      "SDL.jobsystem.create.priority"
+
+/**
+ * Get the number of worker threads in a job system.
+ *
+ * This is useful for deciding how many pieces to split work into.
+ *
+ * \param system the job system to query.
+ * \returns the number of worker threads or -1 on failure; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateJobSystem
+ */
+extern SDL_DECLSPEC int SDLCALL SDL_GetJobSystemThreadCount(SDL_JobSystem *system);
+
+/**
+ * Destroy a job system.
+ *
+ * All the jobs that have been submitted are run before the worker threads
+ * exit. Jobs that haven't been released are still valid afterwards, and
+ * are all done, so they should be released with SDL_ReleaseJob().
+ *
+ * \param system the job system to destroy.
+ *
+ * \threadsafety This should not be called from one of the job system's own
+ *               jobs.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateJobSystem
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_DestroyJobSystem(SDL_JobSystem *system);
+
+/**
+ * Submit a job to run on a job system.
+ *
+ * The job runs once all of its dependencies are done. A job with no
+ * function does no work, it is done as soon as its dependencies are, so it
+ * can be used to wait on a group of jobs at once.
+ *
+ * Jobs can submit more jobs and wait on them, which is the usual way to
+ * split work into pieces: while a job waits, the thread it runs on works on
+ * other jobs.
+ *
+ * The returned job must be released with SDL_ReleaseJob() when it's no
+ * longer needed to wait on or to depend on, which can be right away if
+ * nothing will.
+ *
+ * \param system the job system to run the job on.
+ * \param func the function to call, may be NULL.
+ * \param userdata a pointer that is passed to `func`.
+ * \param dependencies an array of jobs that must be done before this one
+ *                     runs, may be NULL if `num_dependencies` is 0.
+ * \param num_dependencies the number of jobs in `dependencies`.
+ * \returns the new job or NULL on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_ReleaseJob
+ * \sa SDL_WaitJob
+ */
+extern SDL_DECLSPEC SDL_Job * SDLCALL SDL_SubmitJob(SDL_JobSystem *system, SDL_JobFunction func, void *userdata, SDL_Job * const *dependencies, int num_dependencies);
+
+/**
+ * Wait for a job to be done.
+ *
+ * Instead of blocking, the calling thread runs other jobs from the job
+ * system until this one is done, so it's safe to wait from inside a job.
+ *
+ * \param job the job to wait for.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_WaitJob(SDL_Job *job);
+
+/**
+ * Release a job.
+ *
+ * This doesn't cancel the job, which still runs if it hasn't yet.
+ *
+ * \param job the job to release.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_SubmitJob
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ReleaseJob(SDL_Job *job);
+
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
 }
@@ -296,6 +296,70 @@ extern SDL_DECLSPEC void SDLCALL SDL_DelayNS(Uint64 ns);
  */
 extern SDL_DECLSPEC void SDLCALL SDL_DelayPrecise(Uint64 ns);
 
+/**
+ * The number of buckets in the SDL_DelayStats wake error histogram.
+ *
+ * \since This macro is available since SDL 3.4.0.
+ */
+#define SDL_DELAY_STATS_BUCKETS 16
+
+/**
+ * Statistics about how precise SDL_DelayPrecise() has been.
+ *
+ * The wake error is how late SDL_DelayPrecise() returned compared to the
+ * requested time. `histogram[0]` counts delays that returned less than 1
+ * microsecond late, `histogram[i]` counts delays that returned less than
+ * 2^i microseconds late, and the last bucket counts everything later than
+ * that.
+ *
+ * SDL_DelayPrecise() sleeps for as much of the delay as it can, and busy
+ * waits for the rest. It measures how much the sleeps overshoot on each
+ * thread, and keeps enough time in reserve to cover that.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetDelayStats
+ */
+typedef struct SDL_DelayStats
+{
+    Uint64 num_delays;      /**< the number of calls to SDL_DelayPrecise() */
+    Uint64 total_error;     /**< the total wake error, in nanoseconds */
+    Uint64 max_error;       /**< the largest wake error, in nanoseconds */
+    Uint64 total_sleep;     /**< the total time spent sleeping, in nanoseconds */
+    Uint64 total_spin;      /**< the total time spent busy waiting, in nanoseconds */
+    Uint64 histogram[SDL_DELAY_STATS_BUCKETS]; /**< the number of delays by wake error */
+} SDL_DelayStats;
+
+/**
+ * Get statistics about the precision of SDL_DelayPrecise().
+ *
+ * The statistics cover every call to SDL_DelayPrecise() on every thread since
+ * the last call to SDL_ResetDelayStats().
+ *
+ * \param stats a pointer filled in with the delay statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_DelayPrecise
+ * \sa SDL_ResetDelayStats
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetDelayStats(SDL_DelayStats *stats);
+
+/**
+ * Reset the statistics about the precision of SDL_DelayPrecise().
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetDelayStats
+ */
+extern SDL_DECLSPEC void SDLCALL SDL_ResetDelayStats(void);
+
 /**
  * Definition of the timer ID type.
  *
@@ -442,6 +506,46 @@ extern SDL_DECLSPEC SDL_TimerID SDLCALL SDL_AddTimerNS(Uint64 interval, SDL_NSTi
  */
 extern SDL_DECLSPEC bool SDLCALL SDL_RemoveTimer(SDL_TimerID id);
 
+/**
+ * Statistics about how a timer has been running.
+ *
+ * Lateness is the time between when a callback was scheduled to run and
+ * when it actually started. If it grows, the timer callbacks take more time
+ * than the threads running them have available; see SDL_HINT_TIMER_THREADS.
+ *
+ * \since This struct is available since SDL 3.4.0.
+ *
+ * \sa SDL_GetTimerStats
+ */
+typedef struct SDL_TimerStats
+{
+    Uint64 num_calls;       /**< the number of times the callback has been called */
+    Uint64 total_lateness;  /**< the total lateness of all calls, in nanoseconds */
+    Uint64 max_lateness;    /**< the largest lateness of a single call, in nanoseconds */
+    Uint64 last_lateness;   /**< the lateness of the most recent call, in nanoseconds */
+    Uint64 total_runtime;   /**< the total time spent in the callback, in nanoseconds */
+} SDL_TimerStats;
+
+/**
+ * Get statistics about how a timer has been running.
+ *
+ * Statistics are available until the timer is removed, or until a new timer
+ * is created after the callback has returned 0.
+ *
+ * \param id the ID of the timer to query.
+ * \param stats a pointer filled in with the timer statistics.
+ * \returns true on success or false on failure; call SDL_GetError() for more
+ *          information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_AddTimer
+ * \sa SDL_AddTimerNS
+ */
+extern SDL_DECLSPEC bool SDLCALL SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats);
+
 
 /* Ends C function definitions when using C++ */
 #ifdef __cplusplus
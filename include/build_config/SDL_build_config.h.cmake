@@ -174,12 +174,15 @@
 #cmakedefine HAVE_FSEEKO 1
 #cmakedefine HAVE_FSEEKO64 1
 #cmakedefine HAVE_MEMFD_CREATE 1
+#cmakedefine HAVE_MMAP 1
+#cmakedefine HAVE_MADVISE 1
 #cmakedefine HAVE_POSIX_FALLOCATE 1
 #cmakedefine HAVE_SIGACTION 1
 #cmakedefine HAVE_SA_SIGACTION 1
 #cmakedefine HAVE_ST_MTIM 1
 #cmakedefine HAVE_SETJMP 1
 #cmakedefine HAVE_NANOSLEEP 1
+#cmakedefine HAVE_CLOCK_NANOSLEEP 1
 #cmakedefine HAVE_GMTIME_R 1
 #cmakedefine HAVE_LOCALTIME_R 1
 #cmakedefine HAVE_NL_LANGINFO 1
@@ -350,6 +353,7 @@
 #cmakedefine SDL_THREAD_PTHREAD 1
 #cmakedefine SDL_THREAD_PTHREAD_RECURSIVE_MUTEX 1
 #cmakedefine SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP 1
+#cmakedefine SDL_THREAD_LINUX_FUTEX 1
 #cmakedefine SDL_THREAD_WINDOWS 1
 #cmakedefine SDL_THREAD_VITA 1
 #cmakedefine SDL_THREAD_PSP 1
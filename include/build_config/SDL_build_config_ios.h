@@ -131,6 +131,8 @@
 #define HAVE_LOCALTIME_R 1
 #define HAVE_NL_LANGINFO 1
 #define HAVE_SYSCONF 1
+#define HAVE_MMAP 1
+#define HAVE_MADVISE 1
 #define HAVE_SYSCTLBYNAME 1
 #define HAVE_O_CLOEXEC 1
 
@@ -135,6 +135,8 @@
 #define HAVE_LOCALTIME_R 1
 #define HAVE_NL_LANGINFO 1
 #define HAVE_SYSCONF 1
+#define HAVE_MMAP 1
+#define HAVE_MADVISE 1
 #define HAVE_SYSCTLBYNAME 1
 
 #if defined(__has_include) && (defined(__i386__) || defined(__x86_64))
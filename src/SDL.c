@@ -50,6 +50,7 @@
 #include "render/SDL_sysrender.h"
 #include "sensor/SDL_sensor_c.h"
 #include "stdlib/SDL_getenv_c.h"
+#include "stdlib/SDL_sysstdlib.h"
 #include "thread/SDL_thread_c.h"
 #include "tray/SDL_tray_utils.h"
 #include "video/SDL_pixels_c.h"
@@ -301,6 +302,7 @@ static void SDL_QuitMainThread(void)
     SDL_QuitTicks();
     SDL_QuitEnvironment();
     SDL_QuitTLSData();
+    SDL_QuitMemoryCaches();
 }
 
 bool SDL_InitSubSystem(SDL_InitFlags flags)
@@ -665,6 +667,10 @@ void SDL_Quit(void)
 
     SDL_QuitTimers();
     SDL_QuitAsyncIO();
+    SDL_QuitJobSystem();
+    SDL_QuitAtomicWait();
+    SDL_QuitLockProfiling();
+    SDL_StopLogThread();
 
     SDL_SetObjectsInvalid();
     SDL_AssertionsQuit();
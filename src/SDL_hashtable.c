@@ -20,34 +20,92 @@
 */
 #include "SDL_internal.h"
 
-typedef struct SDL_HashItem
+#include "thread/SDL_thread_c.h"
+
+// The table is split into three parallel arrays: a dense array of one-byte
+//  control words (the metadata), and separate arrays for the full hashes, the
+//  keys and the values. Lookups only touch the metadata until a candidate is
+//  found, and the metadata is scanned a whole group of slots at a time, with
+//  SIMD compares where available.
+//
+// A control byte is either HASHCTRL_EMPTY, HASHCTRL_DELETED or HASHCTRL_RETIRED
+//  (tombstones), or the top 7 bits of the item's hash (the "fragment") for
+//  occupied slots. Slots are probed in aligned groups of HASHTABLE_GROUP_WIDTH,
+//  visiting groups in triangular order, so every group is reached once the
+//  probe distance reaches the number of groups.
+
+#define HASHCTRL_EMPTY   ((Uint8)0x80)
+#define HASHCTRL_DELETED ((Uint8)0xFE)
+#define HASHCTRL_RETIRED ((Uint8)0xFF)  // a tombstone that concurrent readers might still be looking at
+#define HASHCTRL_IS_FULL(ctrl) (((ctrl) & 0x80) == 0)
+
+#define HASHTABLE_GROUP_WIDTH 16u
+
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define HASHTABLE_USE_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define HASHTABLE_USE_NEON
+#endif
+
+// A slot takes at most 32 bytes (key and value pointers, hash, control byte), so this keeps the slot arrays below 2^31 bytes
+#define MAX_HASHTABLE_SIZE (0x80000000u / 32u)
+
+// Tables made with SDL_CreateConcurrentHashTable never block lookups. Writers
+//  still serialize on a mutex, but readers only register themselves in an
+//  epoch counter and then use whatever slot arrays are currently published.
+//  Since a reader might still be looking at something a writer just removed,
+//  these tables only reuse a removed item's slot (its tombstone starts out as
+//  HASHCTRL_RETIRED and becomes HASHCTRL_DELETED), and only free old arrays
+//  and removed items, once every reader that could have seen them left.
+
+typedef struct SDL_HashSlots
 {
-    // TODO: Splitting off values into a separate array might be more cache-friendly
+    Uint8 *ctrl;        // one control byte per slot, at least HASHTABLE_GROUP_WIDTH of them
+    Uint32 *hashes;
+    const void **keys;
+    const void **values;
+    Uint32 hash_mask;   // number of slots - 1
+    Uint32 group_mask;  // number of groups - 1
+    Uint32 group_bits;  // mask of the usable bits in a group match, for tables smaller than a group
+} SDL_HashSlots;
+
+// Readers count themselves in one of several cache lines, picked by thread, so
+//  lookups from different threads don't all fight over the same counter.
+#define HASHTABLE_READER_STRIPES 16
+
+typedef struct SDL_HashReaders
+{
+    SDL_AtomicInt count[2];  // readers that entered during an even or odd epoch
+    Uint8 padding[64 - (2 * sizeof(SDL_AtomicInt))];
+} SDL_HashReaders;
+
+typedef struct SDL_HashRetired
+{
+    SDL_HashSlots *slots;  // old arrays to free, or NULL if this is a removed item.
+    SDL_HashSlots *owner;  // the arrays a removed item was in
+    Uint32 slot;           // the slot a removed item was in
     const void *key;
     const void *value;
-    Uint32 hash;
-    Uint32 probe_len : 31;
-    Uint32 live : 1;
-} SDL_HashItem;
-
-// Must be a power of 2 >= sizeof(SDL_HashItem)
-#define MAX_HASHITEM_SIZEOF 32u
-SDL_COMPILE_TIME_ASSERT(sizeof_SDL_HashItem, sizeof(SDL_HashItem) <= MAX_HASHITEM_SIZEOF);
-
-// Anything larger than this will cause integer overflows
-#define MAX_HASHTABLE_SIZE (0x80000000u / (MAX_HASHITEM_SIZEOF))
+    struct SDL_HashRetired *next;
+} SDL_HashRetired;
 
 struct SDL_HashTable
 {
-    SDL_RWLock *lock;  // NULL if not created threadsafe
-    SDL_HashItem *table;
+    SDL_RWLock *lock;       // NULL if not created threadsafe
+    SDL_Mutex *write_lock;  // only used by concurrent tables
+    SDL_HashSlots *slots;   // accessed atomically in concurrent tables
     SDL_HashCallback hash;
     SDL_HashKeyMatchCallback keymatch;
     SDL_HashDestroyCallback destroy;
     void *userdata;
-    Uint32 hash_mask;
-    Uint32 max_probe_len;
+    Uint32 growth_left;     // empty slots that can be filled before we must resize
     Uint32 num_occupied_slots;
+    bool concurrent;
+    SDL_AtomicInt num_items;      // num_occupied_slots for lockless readers of concurrent tables
+    SDL_AtomicInt epoch;
+    SDL_HashReaders *readers;     // HASHTABLE_READER_STRIPES of them
+    SDL_HashRetired *retired[2];  // things removed during an even or odd epoch
+    SDL_HashRetired *retired_pool;  // unused retired nodes, so removals don't allocate
 };
 
 
@@ -57,7 +115,8 @@ static Uint32 CalculateHashBucketsFromEstimate(int estimated_capacity)
         return 4;  // start small, grow as necessary.
     }
 
-    const Uint32 estimated32 = (Uint32) estimated_capacity;
+    // leave room for the maximum load factor of 7/8.
+    const Uint32 estimated32 = (Uint32) SDL_min((Uint64)estimated_capacity + ((Uint64)estimated_capacity / 7), (Uint64)MAX_HASHTABLE_SIZE);
     Uint32 buckets = ((Uint32) 1) << SDL_MostSignificantBitIndex32(estimated32);
     if (!SDL_HasExactlyOneBitSet32(estimated32)) {
         buckets <<= 1;  // need next power of two up to fit overflow capacity bits.
@@ -66,7 +125,42 @@ static Uint32 CalculateHashBucketsFromEstimate(int estimated_capacity)
     return SDL_min(buckets, MAX_HASHTABLE_SIZE);
 }
 
-SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_HashCallback hash,
+static SDL_INLINE Uint32 capacity_to_growth(Uint32 capacity)
+{
+    // Tables that fit in a single group always have trailing empty control bytes, so they can fill up completely.
+    if (capacity < HASHTABLE_GROUP_WIDTH) {
+        return capacity;
+    }
+    return capacity - (capacity / 8);
+}
+
+// The header and all the arrays live in a single allocation.
+static SDL_HashSlots *alloc_slots(Uint32 num_buckets)
+{
+    const Uint32 num_ctrl = SDL_max(num_buckets, HASHTABLE_GROUP_WIDTH);
+    const size_t header_size = (sizeof(SDL_HashSlots) + sizeof(void *) - 1) & ~(sizeof(void *) - 1);
+    const size_t pointers_size = num_buckets * sizeof(void *);
+    const size_t hashes_size = num_buckets * sizeof(Uint32);
+    Uint8 *block = (Uint8 *)SDL_malloc(header_size + (pointers_size * 2) + hashes_size + num_ctrl);
+    if (!block) {
+        return NULL;
+    }
+
+    SDL_HashSlots *slots = (SDL_HashSlots *)block;
+    block += header_size;
+    slots->keys = (const void **)block;
+    slots->values = (const void **)(block + pointers_size);
+    slots->hashes = (Uint32 *)(block + (pointers_size * 2));
+    slots->ctrl = block + (pointers_size * 2) + hashes_size;
+    SDL_memset(slots->ctrl, HASHCTRL_EMPTY, num_ctrl);
+
+    slots->hash_mask = num_buckets - 1;
+    slots->group_mask = (num_ctrl / HASHTABLE_GROUP_WIDTH) - 1;
+    slots->group_bits = (num_buckets < HASHTABLE_GROUP_WIDTH) ? ((1u << num_buckets) - 1) : ((1u << HASHTABLE_GROUP_WIDTH) - 1);
+    return slots;
+}
+
+static SDL_HashTable *create_table(int estimated_capacity, bool threadsafe, bool concurrent, SDL_HashCallback hash,
                                    SDL_HashKeyMatchCallback keymatch,
                                    SDL_HashDestroyCallback destroy, void *userdata)
 {
@@ -76,21 +170,30 @@ SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_
         return NULL;
     }
 
-    if (threadsafe) {
-        table->lock = SDL_CreateRWLock();
+    if (concurrent) {
+        table->concurrent = true;
+        table->write_lock = SDL_CreateNamedMutex("SDL_HashTable.write_lock");
+        table->readers = (SDL_HashReaders *)SDL_aligned_alloc(sizeof(SDL_HashReaders), HASHTABLE_READER_STRIPES * sizeof(SDL_HashReaders));
+        if (!table->write_lock || !table->readers) {
+            SDL_DestroyHashTable(table);
+            return NULL;
+        }
+        SDL_memset(table->readers, 0, HASHTABLE_READER_STRIPES * sizeof(SDL_HashReaders));
+    } else if (threadsafe) {
+        table->lock = SDL_CreateNamedRWLock("SDL_HashTable.lock");
         if (!table->lock) {
             SDL_DestroyHashTable(table);
             return NULL;
         }
     }
 
-    table->table = (SDL_HashItem *)SDL_calloc(num_buckets, sizeof(SDL_HashItem));
-    if (!table->table) {
+    table->slots = alloc_slots(num_buckets);
+    if (!table->slots) {
         SDL_DestroyHashTable(table);
         return NULL;
     }
 
-    table->hash_mask = num_buckets - 1;
+    table->growth_left = capacity_to_growth(num_buckets);
     table->userdata = userdata;
     table->hash = hash;
     table->keymatch = keymatch;
@@ -98,196 +201,436 @@ SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_
     return table;
 }
 
-static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
+SDL_HashTable *SDL_CreateHashTable(int estimated_capacity, bool threadsafe, SDL_HashCallback hash,
+                                   SDL_HashKeyMatchCallback keymatch,
+                                   SDL_HashDestroyCallback destroy, void *userdata)
 {
-    const Uint32 BitMixer = 0x9E3779B1u;
-    return table->hash(table->userdata, key) * BitMixer;
+    return create_table(estimated_capacity, threadsafe, false, hash, keymatch, destroy, userdata);
 }
 
-static SDL_INLINE Uint32 get_probe_length(Uint32 zero_idx, Uint32 actual_idx, Uint32 num_buckets)
+SDL_HashTable *SDL_CreateConcurrentHashTable(int estimated_capacity, SDL_HashCallback hash,
+                                             SDL_HashKeyMatchCallback keymatch,
+                                             SDL_HashDestroyCallback destroy, void *userdata)
 {
-    // returns the probe sequence length from zero_idx to actual_idx
-    if (actual_idx < zero_idx) {
-        return num_buckets - zero_idx + actual_idx;
-    }
-
-    return actual_idx - zero_idx;
+    return create_table(estimated_capacity, true, true, hash, keymatch, destroy, userdata);
 }
 
-static SDL_HashItem *find_item(const SDL_HashTable *ht, const void *key, Uint32 hash, Uint32 *i, Uint32 *probe_len)
+// Returns the arrays to read from. `*token` must be passed back to unlock_for_reading.
+static const SDL_HashSlots *lock_for_reading(const SDL_HashTable *table, int *token)
 {
-    Uint32 hash_mask = ht->hash_mask;
-    Uint32 max_probe_len = ht->max_probe_len;
+    *token = 0;
 
-    SDL_HashItem *table = ht->table;
+    if (!table->concurrent) {
+        SDL_LockRWLockForReading(table->lock);
+        return table->slots;
+    }
+
+    SDL_HashTable *ht = (SDL_HashTable *)table;
+    const Uint32 stripe = ((Uint32)SDL_GetCurrentThreadID() * 0x9E3779B1u) >> 28;
+    SDL_COMPILE_TIME_ASSERT(reader_stripes, HASHTABLE_READER_STRIPES == 16);
 
     while (true) {
-        SDL_HashItem *item = table + *i;
-        Uint32 item_hash = item->hash;
+        const int epoch = SDL_GetAtomicInt(&ht->epoch);
+        SDL_AtomicInt *count = &ht->readers[stripe].count[epoch & 1];
+        SDL_AddAtomicInt(count, 1);
+        // If the epoch moved before we were counted, a writer might have missed us. Retry in the new epoch.
+        if (SDL_GetAtomicInt(&ht->epoch) == epoch) {
+            *token = (int)(stripe * 2) + (epoch & 1);
+            return (const SDL_HashSlots *)SDL_GetAtomicPointer((void **)&ht->slots);
+        }
+        SDL_AddAtomicInt(count, -1);
+    }
+}
 
-        if (!item->live) {
-            return NULL;
+static void unlock_for_reading(const SDL_HashTable *table, int token)
+{
+    if (!table->concurrent) {
+        SDL_UnlockRWLock(table->lock);
+    } else {
+        SDL_AddAtomicInt(&table->readers[token / 2].count[token & 1], -1);
+    }
+}
+
+static bool has_readers(const SDL_HashTable *ht, int parity)
+{
+    for (int i = 0; i < HASHTABLE_READER_STRIPES; ++i) {
+        if (SDL_GetAtomicInt(&ht->readers[i].count[parity]) != 0) {
+            return true;
         }
+    }
+    return false;
+}
+
+static void free_retired_items(SDL_HashRetired *retired)
+{
+    while (retired) {
+        SDL_HashRetired *next = retired->next;
+        SDL_free(retired);
+        retired = next;
+    }
+}
 
-        if (item_hash == hash && ht->keymatch(ht->userdata, item->key, key)) {
-            return item;
+// Frees what the retired nodes hold and puts the nodes back in the pool.
+static void free_retired(SDL_HashTable *ht, SDL_HashRetired *retired)
+{
+    while (retired) {
+        SDL_HashRetired *next = retired->next;
+        if (retired->slots) {
+            SDL_free(retired->slots);
+        } else {
+            // Nobody can see the old item anymore, so its slot can take a new one. If the arrays were
+            //  rebuilt since, they were retired after the item and the tombstone went with them.
+            if (retired->owner == ht->slots) {
+                SDL_assert(retired->owner->ctrl[retired->slot] == HASHCTRL_RETIRED);
+                retired->owner->ctrl[retired->slot] = HASHCTRL_DELETED;
+            }
+            if (ht->destroy) {
+                ht->destroy(ht->userdata, retired->key, retired->value);
+            }
         }
+        retired->next = ht->retired_pool;
+        ht->retired_pool = retired;
+        retired = next;
+    }
+}
 
-        Uint32 item_probe_len = item->probe_len;
-        SDL_assert(item_probe_len == get_probe_length(item_hash & hash_mask, (Uint32)(item - table), hash_mask + 1));
+// Frees whatever no reader can see anymore. This never waits on readers.
+static void reclaim_retired(SDL_HashTable *ht)
+{
+    const int epoch = SDL_GetAtomicInt(&ht->epoch);
+    const int previous = (epoch + 1) & 1;
 
-        if (*probe_len > item_probe_len) {
-            return NULL;
+    if (has_readers(ht, previous)) {
+        return;  // someone is still reading from the previous epoch.
+    }
+
+    // Anything retired during the previous epoch was unpublished before the current epoch started,
+    //  so only readers from the previous epoch could still see it, and they are all gone.
+    free_retired(ht, ht->retired[previous]);
+    ht->retired[previous] = NULL;
+
+    // Move on to a new epoch, so the current list can be freed once its readers leave.
+    if (ht->retired[epoch & 1]) {
+        SDL_AddAtomicInt(&ht->epoch, 1);
+    }
+}
+
+// Waits until every reader that was active when this was called has left.
+static void wait_for_readers(SDL_HashTable *ht)
+{
+    for (int i = 0; i < 2; ++i) {
+        const int epoch = SDL_AddAtomicInt(&ht->epoch, 1);
+        while (has_readers(ht, epoch & 1)) {
+            SDL_CPUPauseInstruction();
         }
+    }
+}
 
-        if (++*probe_len > max_probe_len) {
-            return NULL;
+// Frees old arrays, or an item removed from `owner`, once no reader can see them anymore.
+static void retire(SDL_HashTable *ht, SDL_HashSlots *slots, SDL_HashSlots *owner, Uint32 slot, const void *key, const void *value)
+{
+    SDL_HashRetired *retired = ht->retired_pool;
+    if (retired) {
+        ht->retired_pool = retired->next;
+    } else {
+        retired = (SDL_HashRetired *)SDL_malloc(sizeof(*retired));
+        if (!retired) {
+            // Out of memory, do it the slow way.
+            wait_for_readers(ht);
+            if (slots) {
+                // Items retired earlier may still point at these arrays as their owner, settle them first
+                //  so a later array at the same address isn't mistaken for their owner.
+                free_retired(ht, ht->retired[0]);
+                free_retired(ht, ht->retired[1]);
+                ht->retired[0] = NULL;
+                ht->retired[1] = NULL;
+                SDL_free(slots);
+            } else {
+                if (owner == ht->slots) {
+                    owner->ctrl[slot] = HASHCTRL_DELETED;
+                }
+                if (ht->destroy) {
+                    ht->destroy(ht->userdata, key, value);
+                }
+            }
+            return;
         }
+    }
+
+    const int parity = SDL_GetAtomicInt(&ht->epoch) & 1;
+    retired->slots = slots;
+    retired->owner = owner;
+    retired->slot = slot;
+    retired->key = key;
+    retired->value = value;
+    retired->next = ht->retired[parity];
+    ht->retired[parity] = retired;
+}
+
+static void lock_for_writing(SDL_HashTable *ht)
+{
+    if (ht->concurrent) {
+        SDL_LockMutex(ht->write_lock);
+    } else {
+        SDL_LockRWLockForWriting(ht->lock);
+    }
+}
 
-        *i = (*i + 1) & hash_mask;
+static void unlock_for_writing(SDL_HashTable *ht)
+{
+    if (ht->concurrent) {
+        SDL_SetAtomicInt(&ht->num_items, (int)ht->num_occupied_slots);
+        reclaim_retired(ht);
+        SDL_UnlockMutex(ht->write_lock);
+    } else {
+        SDL_UnlockRWLock(ht->lock);
     }
 }
 
-static SDL_HashItem *find_first_item(const SDL_HashTable *ht, const void *key, Uint32 hash)
+static SDL_INLINE Uint32 calc_hash(const SDL_HashTable *table, const void *key)
 {
-    Uint32 i = hash & ht->hash_mask;
-    Uint32 probe_len = 0;
-    return find_item(ht, key, hash, &i, &probe_len);
+    const Uint32 BitMixer = 0x9E3779B1u;
+    return table->hash(table->userdata, key) * BitMixer;
 }
 
-static SDL_HashItem *insert_item(SDL_HashItem *item_to_insert, SDL_HashItem *table, Uint32 hash_mask, Uint32 *max_probe_len_ptr)
+// The multiply in calc_hash mixes best into the high bits, so the fragment comes from the top 7 bits.
+static SDL_INLINE Uint8 hash_fragment(Uint32 hash)
 {
-    const Uint32 num_buckets = hash_mask + 1;
-    Uint32 idx = item_to_insert->hash & hash_mask;
-    SDL_HashItem *target = NULL;
-    SDL_HashItem temp_item;
+    return (Uint8)(hash >> 25);
+}
 
-    while (true) {
-        SDL_HashItem *candidate = table + idx;
+static SDL_INLINE Uint32 lowest_bit_index(Uint32 mask)
+{
+    return (Uint32)SDL_MostSignificantBitIndex32(mask & (~mask + 1));
+}
 
-        if (!candidate->live) {
-            // Found an empty slot. Put it here and we're done.
-            *candidate = *item_to_insert;
+// Each of these returns a bitmask with bit N set if control byte N of the group matches.
+#ifdef HASHTABLE_USE_SSE2
 
-            if (target == NULL) {
-                target = candidate;
-            }
+static SDL_INLINE Uint32 group_match(const Uint8 *group, Uint8 fragment)
+{
+    const __m128i ctrl = _mm_loadu_si128((const __m128i *)group);
+    return (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)fragment)));
+}
 
-            const Uint32 probe_len = get_probe_length(candidate->hash & hash_mask, idx, num_buckets);
-            candidate->probe_len = probe_len;
+static SDL_INLINE Uint32 group_match_empty(const Uint8 *group)
+{
+    return group_match(group, HASHCTRL_EMPTY);
+}
 
-            if (*max_probe_len_ptr < probe_len) {
-                *max_probe_len_ptr = probe_len;
-            }
+static SDL_INLINE Uint32 group_match_empty_or_deleted(const Uint8 *group)
+{
+    // all the special values have the high bit set, occupied slots never do.
+    return (Uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)group));
+}
 
-            break;
-        }
+#elif defined(HASHTABLE_USE_NEON)
 
-        const Uint32 candidate_probe_len = candidate->probe_len;
-        SDL_assert(candidate_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-        const Uint32 new_probe_len = get_probe_length(item_to_insert->hash & hash_mask, idx, num_buckets);
+static SDL_INLINE Uint32 group_bitmask_neon(uint8x16_t matches)
+{
+    static const Uint8 bits[16] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    const uint8x16_t masked = vandq_u8(matches, vld1q_u8(bits));
+    return (Uint32)vaddv_u8(vget_low_u8(masked)) | ((Uint32)vaddv_u8(vget_high_u8(masked)) << 8);
+}
+
+static SDL_INLINE Uint32 group_match(const Uint8 *group, Uint8 fragment)
+{
+    return group_bitmask_neon(vceqq_u8(vld1q_u8(group), vdupq_n_u8(fragment)));
+}
 
-        if (candidate_probe_len < new_probe_len) {
-            // Robin Hood hashing: the item at idx has a better probe length than our item would at this position.
-            // Evict it and put our item in its place, then continue looking for a new spot for the displaced item.
-            // This algorithm significantly reduces clustering in the table, making lookups take very few probes.
+static SDL_INLINE Uint32 group_match_empty(const Uint8 *group)
+{
+    return group_match(group, HASHCTRL_EMPTY);
+}
 
-            temp_item = *candidate;
-            *candidate = *item_to_insert;
+static SDL_INLINE Uint32 group_match_empty_or_deleted(const Uint8 *group)
+{
+    return group_bitmask_neon(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(group))));
+}
 
-            if (target == NULL) {
-                target = candidate;
-            }
+#else
 
-            *item_to_insert = temp_item;
+static SDL_INLINE Uint32 group_match(const Uint8 *group, Uint8 fragment)
+{
+    Uint32 result = 0;
+    for (Uint32 i = 0; i < HASHTABLE_GROUP_WIDTH; ++i) {
+        result |= (Uint32)(group[i] == fragment) << i;
+    }
+    return result;
+}
+
+static SDL_INLINE Uint32 group_match_empty(const Uint8 *group)
+{
+    return group_match(group, HASHCTRL_EMPTY);
+}
+
+static SDL_INLINE Uint32 group_match_empty_or_deleted(const Uint8 *group)
+{
+    Uint32 result = 0;
+    for (Uint32 i = 0; i < HASHTABLE_GROUP_WIDTH; ++i) {
+        result |= (Uint32)(group[i] >> 7) << i;
+    }
+    return result;
+}
+
+#endif
+
+static bool find_slot(const SDL_HashTable *ht, const SDL_HashSlots *slots, const void *key, Uint32 hash, Uint32 *slot)
+{
+    const Uint8 fragment = hash_fragment(hash);
+    const Uint32 group_mask = slots->group_mask;
+    Uint32 group = hash & group_mask;
 
-            SDL_assert(new_probe_len == get_probe_length(candidate->hash & hash_mask, idx, num_buckets));
-            candidate->probe_len = new_probe_len;
+    for (Uint32 step = 1;; ++step) {
+        const Uint32 first = group * HASHTABLE_GROUP_WIDTH;
+        const Uint8 *ctrl = slots->ctrl + first;
+        Uint32 mask = group_match(ctrl, fragment);
 
-            if (*max_probe_len_ptr < new_probe_len) {
-                *max_probe_len_ptr = new_probe_len;
+        if (mask && ht->concurrent) {
+            SDL_MemoryBarrierAcquire();  // pairs with the release in set_slot.
+        }
+
+        while (mask) {
+            const Uint32 i = first + lowest_bit_index(mask);
+            if (slots->hashes[i] == hash && ht->keymatch(ht->userdata, slots->keys[i], key)) {
+                *slot = i;
+                return true;
             }
+            mask &= mask - 1;
         }
 
-        idx = (idx + 1) & hash_mask;
-    }
+        // A group with an empty slot was never full, so the key can't have been pushed past it.
+        if (group_match_empty(ctrl) || step > group_mask) {
+            return false;
+        }
 
-    return target;
+        group = (group + step) & group_mask;
+    }
 }
 
-static void delete_item(SDL_HashTable *ht, SDL_HashItem *item)
+static bool find_insert_slot(const SDL_HashTable *ht, const SDL_HashSlots *slots, Uint32 hash, Uint32 *slot)
 {
-    const Uint32 hash_mask = ht->hash_mask;
-    SDL_HashItem *table = ht->table;
+    const Uint32 group_mask = slots->group_mask;
+    Uint32 group = hash & group_mask;
+
+    for (Uint32 step = 1;; ++step) {
+        const Uint8 *ctrl = slots->ctrl + (group * HASHTABLE_GROUP_WIDTH);
+        // concurrent tables can't reuse a retired tombstone yet, a reader might still be looking at the old item.
+        const Uint32 mask = (ht->concurrent ? (group_match_empty(ctrl) | group_match(ctrl, HASHCTRL_DELETED)) : group_match_empty_or_deleted(ctrl)) & slots->group_bits;
+        if (mask) {
+            *slot = (group * HASHTABLE_GROUP_WIDTH) + lowest_bit_index(mask);
+            return true;
+        } else if (step > group_mask) {
+            return false;  // only tables smaller than a group can fill up completely.
+        }
 
-    if (ht->destroy) {
-        ht->destroy(ht->userdata, item->key, item->value);
+        group = (group + step) & group_mask;
+    }
+}
+
+static void set_slot(SDL_HashTable *ht, SDL_HashSlots *slots, Uint32 slot, const void *key, const void *value, Uint32 hash)
+{
+    if (slots->ctrl[slot] == HASHCTRL_EMPTY) {
+        SDL_assert(ht->growth_left > 0);
+        ht->growth_left--;
+    }
+    slots->hashes[slot] = hash;
+    slots->keys[slot] = key;
+    slots->values[slot] = value;
+    if (ht->concurrent) {
+        SDL_MemoryBarrierRelease();  // the item must be complete before readers can match its control byte.
     }
+    slots->ctrl[slot] = hash_fragment(hash);
+    ht->num_occupied_slots++;
+}
 
+static void delete_slot(SDL_HashTable *ht, SDL_HashSlots *slots, Uint32 slot)
+{
     SDL_assert(ht->num_occupied_slots > 0);
     ht->num_occupied_slots--;
 
-    Uint32 idx = (Uint32)(item - ht->table);
-
-    while (true) {
-        idx = (idx + 1) & hash_mask;
-        SDL_HashItem *next_item = table + idx;
+    if (ht->concurrent) {
+        slots->ctrl[slot] = HASHCTRL_RETIRED;
+        retire(ht, NULL, slots, slot, slots->keys[slot], slots->values[slot]);
+        return;
+    }
 
-        if (next_item->probe_len < 1) {
-            SDL_zerop(item);
-            return;
-        }
+    if (ht->destroy) {
+        ht->destroy(ht->userdata, slots->keys[slot], slots->values[slot]);
+    }
 
-        *item = *next_item;
-        item->probe_len -= 1;
-        SDL_assert(item->probe_len < ht->max_probe_len);
-        item = next_item;
+    // If this slot's group still has an empty slot, no probe sequence ever continued past it, so the
+    //  slot can become empty again. Otherwise we need a tombstone to keep later items reachable.
+    const Uint8 *group = slots->ctrl + ((slot / HASHTABLE_GROUP_WIDTH) * HASHTABLE_GROUP_WIDTH);
+    if (group_match_empty(group)) {
+        slots->ctrl[slot] = HASHCTRL_EMPTY;
+        ht->growth_left++;
+    } else {
+        slots->ctrl[slot] = HASHCTRL_DELETED;
     }
 }
 
 static bool resize(SDL_HashTable *ht, Uint32 new_size)
 {
-    const Uint32 new_hash_mask = new_size - 1;
-    SDL_HashItem *new_table = SDL_calloc(new_size, sizeof(*new_table));
+    SDL_HashSlots *old_slots = ht->slots;
+    const Uint32 old_size = old_slots->hash_mask + 1;
+    const Uint32 num_occupied_slots = ht->num_occupied_slots;
+    SDL_HashSlots *new_slots = alloc_slots(new_size);
 
-    if (!new_table) {
+    if (!new_slots) {
         return false;
     }
 
-    SDL_HashItem *old_table = ht->table;
-    const Uint32 old_size = ht->hash_mask + 1;
-
-    ht->max_probe_len = 0;
-    ht->hash_mask = new_hash_mask;
-    ht->table = new_table;
+    ht->growth_left = capacity_to_growth(new_size);
+    ht->num_occupied_slots = 0;
 
     for (Uint32 i = 0; i < old_size; ++i) {
-        SDL_HashItem *item = old_table + i;
-        if (item->live) {
-            insert_item(item, new_table, new_hash_mask, &ht->max_probe_len);
+        if (HASHCTRL_IS_FULL(old_slots->ctrl[i])) {
+            const Uint32 hash = old_slots->hashes[i];
+            Uint32 slot = 0;
+            find_insert_slot(ht, new_slots, hash, &slot);  // the new arrays are at least as big, this can't fail.
+            set_slot(ht, new_slots, slot, old_slots->keys[i], old_slots->values[i], hash);
         }
     }
 
-    SDL_free(old_table);
+    SDL_assert(ht->num_occupied_slots == num_occupied_slots);
+    (void)num_occupied_slots;
+
+    if (ht->concurrent) {
+        SDL_SetAtomicPointer((void **)&ht->slots, new_slots);
+        retire(ht, old_slots, NULL, 0, NULL, NULL);
+    } else {
+        ht->slots = new_slots;
+        SDL_free(old_slots);
+    }
     return true;
 }
 
 static bool maybe_resize(SDL_HashTable *ht)
 {
-    const Uint32 capacity = ht->hash_mask + 1;
+    if (ht->growth_left > 0) {
+        return true;
+    }
 
-    if (capacity >= MAX_HASHTABLE_SIZE) {
+    const Uint32 capacity = ht->slots->hash_mask + 1;
+
+    // If tombstones are eating more than half the usable space, just clean them up.
+    if (ht->num_occupied_slots <= (capacity_to_growth(capacity) / 2)) {
+        return resize(ht, capacity);
+    } else if (capacity >= MAX_HASHTABLE_SIZE) {
         return false;
     }
 
-    const Uint32 max_load_factor = 217; // range: 0-255; 217 is roughly 85%
-    const Uint32 resize_threshold = (Uint32)((max_load_factor * (Uint64)capacity) >> 8);
+    return resize(ht, capacity * 2);
+}
 
-    if (ht->num_occupied_slots > resize_threshold) {
-        return resize(ht, capacity * 2);
+// Finds a free slot for a new item, growing the table first if necessary.
+static bool reserve_slot(SDL_HashTable *ht, Uint32 hash, Uint32 *slot)
+{
+    if (find_insert_slot(ht, ht->slots, hash, slot) && (ht->slots->ctrl[*slot] != HASHCTRL_EMPTY || ht->growth_left > 0)) {
+        return true;  // reusing a tombstone is always fine, but taking an empty slot might need a bigger table first.
     }
-
-    return true;
+    return maybe_resize(ht) && find_insert_slot(ht, ht->slots, hash, slot);
 }
 
 bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *value, bool replace)
@@ -298,41 +641,32 @@ bool SDL_InsertIntoHashTable(SDL_HashTable *table, const void *key, const void *
 
     bool result = false;
 
-    SDL_LockRWLockForWriting(table->lock);
+    lock_for_writing(table);
 
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
-    bool do_insert = true;
+    Uint32 slot, new_slot;
 
-    if (item) {
-        if (replace) {
-            delete_item(table, item);
-        } else {
+    if (find_slot(table, table->slots, key, hash, &slot)) {
+        if (!replace) {
             SDL_SetError("key already exists and replace is disabled");
-            do_insert = false;
-        }
-    }
-
-    if (do_insert) {
-        SDL_HashItem new_item;
-        new_item.key = key;
-        new_item.value = value;
-        new_item.hash = hash;
-        new_item.live = true;
-        new_item.probe_len = 0;
-
-        table->num_occupied_slots++;
-
-        if (!maybe_resize(table)) {
-            table->num_occupied_slots--;
-        } else {
-            // This never returns NULL
-            insert_item(&new_item, table->table, table->hash_mask, &table->max_probe_len);
+        } else if (!table->concurrent) {
+            delete_slot(table, table->slots, slot);
+            set_slot(table, table->slots, slot, key, value, hash);
+            result = true;
+        } else if (reserve_slot(table, hash, &new_slot)) {
+            // Publish the new item before removing the old one, so readers always find one of them.
+            //  Reserving might have rebuilt the arrays, so look up the old item again.
+            find_slot(table, table->slots, key, hash, &slot);
+            set_slot(table, table->slots, new_slot, key, value, hash);
+            delete_slot(table, table->slots, slot);
             result = true;
         }
+    } else if (reserve_slot(table, hash, &slot)) {
+        set_slot(table, table->slots, slot, key, value, hash);
+        result = true;
     }
 
-    SDL_UnlockRWLock(table->lock);
+    unlock_for_writing(table);
     return result;
 }
 
@@ -345,19 +679,20 @@ bool SDL_FindInHashTable(const SDL_HashTable *table, const void *key, const void
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForReading(table->lock);
+    int token;
+    const SDL_HashSlots *slots = lock_for_reading(table, &token);
 
     bool result = false;
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *i = find_first_item(table, key, hash);
-    if (i) {
+    Uint32 slot;
+    if (find_slot(table, slots, key, hash, &slot)) {
         if (value) {
-            *value = i->value;
+            *value = slots->values[slot];
         }
         result = true;
     }
 
-    SDL_UnlockRWLock(table->lock);
+    unlock_for_reading(table, token);
 
     return result;
 }
@@ -368,17 +703,17 @@ bool SDL_RemoveFromHashTable(SDL_HashTable *table, const void *key)
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForWriting(table->lock);
+    lock_for_writing(table);
 
     bool result = false;
     const Uint32 hash = calc_hash(table, key);
-    SDL_HashItem *item = find_first_item(table, key, hash);
-    if (item) {
-        delete_item(table, item);
+    Uint32 slot;
+    if (find_slot(table, table->slots, key, hash, &slot)) {
+        delete_slot(table, table->slots, slot);
         result = true;
     }
 
-    SDL_UnlockRWLock(table->lock);
+    unlock_for_writing(table);
     return result;
 }
 
@@ -390,21 +725,25 @@ bool SDL_IterateHashTable(const SDL_HashTable *table, SDL_HashTableIterateCallba
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_LockRWLockForReading(table->lock);
-    SDL_HashItem *end = table->table + (table->hash_mask + 1);
+    int token;
+    const SDL_HashSlots *slots = lock_for_reading(table, &token);
+    const Uint32 num_buckets = slots->hash_mask + 1;
     Uint32 num_iterated = 0;
 
-    for (SDL_HashItem *item = table->table; item < end; item++) {
-        if (item->live) {
-            if (!callback(userdata, table, item->key, item->value)) {
+    for (Uint32 i = 0; i < num_buckets; i++) {
+        if (HASHCTRL_IS_FULL(slots->ctrl[i])) {
+            if (table->concurrent) {
+                SDL_MemoryBarrierAcquire();
+            }
+            if (!callback(userdata, table, slots->keys[i], slots->values[i])) {
                 break;  // callback requested iteration stop.
-            } else if (++num_iterated >= table->num_occupied_slots) {
+            } else if (!table->concurrent && ++num_iterated >= table->num_occupied_slots) {
                 break;  // we can drop out early because we've seen all the live items.
             }
         }
     }
 
-    SDL_UnlockRWLock(table->lock);
+    unlock_for_reading(table, token);
     return true;
 }
 
@@ -414,9 +753,14 @@ bool SDL_HashTableEmpty(SDL_HashTable *table)
         return SDL_InvalidParamError("table");
     }
 
-    SDL_LockRWLockForReading(table->lock);
+    if (table->concurrent) {
+        return (SDL_GetAtomicInt(&table->num_items) == 0);
+    }
+
+    int token;
+    lock_for_reading(table, &token);
     const bool retval = (table->num_occupied_slots == 0);
-    SDL_UnlockRWLock(table->lock);
+    unlock_for_reading(table, token);
     return retval;
 }
 
@@ -424,13 +768,14 @@ bool SDL_HashTableEmpty(SDL_HashTable *table)
 static void destroy_all(SDL_HashTable *table)
 {
     SDL_HashDestroyCallback destroy = table->destroy;
-    if (destroy) {
+    SDL_HashSlots *slots = table->slots;
+    if (destroy && slots) {
         void *userdata = table->userdata;
-        SDL_HashItem *end = table->table + (table->hash_mask + 1);
-        for (SDL_HashItem *i = table->table; i < end; ++i) {
-            if (i->live) {
-                i->live = false;
-                destroy(userdata, i->key, i->value);
+        const Uint32 num_buckets = slots->hash_mask + 1;
+        for (Uint32 i = 0; i < num_buckets; ++i) {
+            if (HASHCTRL_IS_FULL(slots->ctrl[i])) {
+                slots->ctrl[i] = HASHCTRL_DELETED;
+                destroy(userdata, slots->keys[i], slots->values[i]);
             }
         }
     }
@@ -439,24 +784,55 @@ static void destroy_all(SDL_HashTable *table)
 void SDL_ClearHashTable(SDL_HashTable *table)
 {
     if (table) {
-        SDL_LockRWLockForWriting(table->lock);
+        lock_for_writing(table);
         {
-            destroy_all(table);
-            SDL_memset(table->table, 0, sizeof(*table->table) * (table->hash_mask + 1));
-            table->num_occupied_slots = 0;
+            SDL_HashSlots *slots = table->slots;
+            const Uint32 num_buckets = slots->hash_mask + 1;
+            SDL_HashSlots *new_slots = table->concurrent ? alloc_slots(num_buckets) : NULL;
+            if (new_slots) {
+                // swap in empty arrays, and retire everything in the old ones.
+                SDL_SetAtomicPointer((void **)&table->slots, new_slots);
+                for (Uint32 i = 0; i < num_buckets; ++i) {
+                    if (HASHCTRL_IS_FULL(slots->ctrl[i])) {
+                        retire(table, NULL, slots, i, slots->keys[i], slots->values[i]);
+                    }
+                }
+                retire(table, slots, NULL, 0, NULL, NULL);
+                table->growth_left = capacity_to_growth(num_buckets);
+                table->num_occupied_slots = 0;
+            } else if (table->concurrent) {
+                for (Uint32 i = 0; i < num_buckets; ++i) {
+                    if (HASHCTRL_IS_FULL(slots->ctrl[i])) {
+                        delete_slot(table, slots, i);
+                    }
+                }
+            } else {
+                destroy_all(table);
+                SDL_memset(slots->ctrl, HASHCTRL_EMPTY, SDL_max(num_buckets, HASHTABLE_GROUP_WIDTH));
+                table->growth_left = capacity_to_growth(num_buckets);
+                table->num_occupied_slots = 0;
+            }
         }
-        SDL_UnlockRWLock(table->lock);
+        unlock_for_writing(table);
     }
 }
 
 void SDL_DestroyHashTable(SDL_HashTable *table)
 {
     if (table) {
+        // nothing else may be using the table now, so everything retired can go right away.
+        free_retired(table, table->retired[0]);
+        free_retired(table, table->retired[1]);
+        free_retired_items(table->retired_pool);
         destroy_all(table);
         if (table->lock) {
             SDL_DestroyRWLock(table->lock);
         }
-        SDL_free(table->table);
+        if (table->write_lock) {
+            SDL_DestroyMutex(table->write_lock);
+        }
+        SDL_aligned_free(table->readers);
+        SDL_free(table->slots);
         SDL_free(table);
     }
 }
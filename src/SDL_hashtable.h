@@ -60,8 +60,10 @@
  * iterate through all the items in the table (SDL_IterateHashTable).
  *
  * The underlying hash table implementation is always subject to change, but
- * at the time of writing, it uses open addressing and Robin Hood hashing.
- * The technical details are explained [here](https://github.com/libsdl-org/SDL/pull/10897).
+ * at the time of writing, it uses open addressing with a separate array of
+ * one-byte hash fragments that is probed a group of slots at a time (with
+ * SIMD compares where available), and keeps keys and values in their own
+ * arrays.
  *
  * Hashtables keep an SDL_RWLock internally, so multiple threads can perform
  * hash lookups in parallel, while changes to the table will safely serialize
@@ -294,6 +296,45 @@ extern SDL_HashTable * SDL_CreateHashTable(int estimated_capacity,
                                            void *userdata);
 
 
+/**
+ * Create a new hash table whose lookups never block.
+ *
+ * This works like SDL_CreateHashTable() with `threadsafe` set to true, but is
+ * meant for tables that are read far more often than they are changed, from
+ * several threads at once. Changes to the table still serialize against each
+ * other, but SDL_FindInHashTable() and SDL_IterateHashTable() never wait on a
+ * lock; they read a snapshot of the table that writers only replace or free
+ * once no reader can still be looking at it.
+ *
+ * Because of this, the SDL_HashDestroyCallback for a removed or replaced item
+ * may run some time after the removal, from whatever thread next changes the
+ * table (or from SDL_DestroyHashTable()). Unlike `threadsafe` tables, lookups
+ * may be nested, so an iteration callback can look things up in the same
+ * table.
+ *
+ * \param estimated_capacity the approximate maximum number of items to be held
+ *                           in the hash table, or 0 for no estimate.
+ * \param hash the function to use to hash keys.
+ * \param keymatch the function to use to compare keys.
+ * \param destroy the function to use to clean up keys and values, may be NULL.
+ * \param userdata a pointer that is passed to the callbacks.
+ * \returns a newly-created hash table, or NULL if there was an error; call
+ *          SDL_GetError() for more information.
+ *
+ * \threadsafety It is safe to call this function from any thread.
+ *
+ * \since This function is available since SDL 3.4.0.
+ *
+ * \sa SDL_CreateHashTable
+ * \sa SDL_DestroyHashTable
+ */
+extern SDL_HashTable * SDL_CreateConcurrentHashTable(int estimated_capacity,
+                                                     SDL_HashCallback hash,
+                                                     SDL_HashKeyMatchCallback keymatch,
+                                                     SDL_HashDestroyCallback destroy,
+                                                     void *userdata);
+
+
 /**
  * Destroy a hash table.
  *
@@ -42,6 +42,33 @@ typedef struct SDL_Hint
 
 static SDL_AtomicU32 SDL_hint_props;
 
+/* SDL_GetHint() looks hints up in a cache that it can read without locking.
+   Each name gets an entry with its resolved value (the environment variable,
+   or the hint if it has override priority or there is no environment
+   variable), which is valid as long as its generation matches the global
+   one. Setting or resetting any hint, or changing the environment, starts a
+   new generation, and the next lookup of each name resolves it again.
+
+   Resolved values are interned and refcounted by the cache entries that point
+   at them. A new generation doesn't touch an entry whose value is unchanged,
+   so a pointer returned by SDL_GetHint() stays valid until the value of that
+   hint changes, and values no entry uses anymore are freed.
+ */
+typedef struct SDL_HintCacheEntry
+{
+    SDL_AtomicInt generation;
+    const char *value;
+} SDL_HintCacheEntry;
+
+static SDL_AtomicInt SDL_hint_generation = { 1 };
+static void *SDL_hint_cache;    // SDL_HashTable of hint name -> SDL_HintCacheEntry
+static SDL_HashTable *SDL_hint_values; // string -> SDL_HintValue, protected by the hint properties lock
+
+typedef struct SDL_HintValue
+{
+    int refcount;
+    // the string follows
+} SDL_HintValue;
 
 void SDL_InitHints(void)
 {
@@ -57,6 +84,20 @@ void SDL_QuitHints(void)
     if (props) {
         SDL_DestroyProperties(props);
     }
+
+    SDL_HashTable *cache = (SDL_HashTable *)SDL_SetAtomicPointer(&SDL_hint_cache, NULL);
+    if (cache) {
+        SDL_DestroyHashTable(cache);
+    }
+    if (SDL_hint_values) {
+        SDL_DestroyHashTable(SDL_hint_values);
+        SDL_hint_values = NULL;
+    }
+}
+
+void SDL_InvalidateHintCache(void)
+{
+    SDL_AddAtomicInt(&SDL_hint_generation, 1);
 }
 
 static SDL_PropertiesID GetHintProperties(bool create)
@@ -129,6 +170,7 @@ bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriori
                 char *old_value = hint->value;
 
                 hint->value = value ? SDL_strdup(value) : NULL;
+                SDL_InvalidateHintCache();
                 SDL_HintWatch *entry = hint->callbacks;
                 while (entry) {
                     // Save the next entry in case this one is deleted
@@ -138,7 +180,10 @@ bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriori
                 }
                 SDL_free(old_value);
             }
-            hint->priority = priority;
+            if (hint->priority != priority) {
+                hint->priority = priority;
+                SDL_InvalidateHintCache();
+            }
             result = true;
         }
     } else {  // Couldn't find the hint? Add a new one.
@@ -148,6 +193,7 @@ bool SDL_SetHintWithPriority(const char *name, const char *value, SDL_HintPriori
             hint->priority = priority;
             hint->callbacks = NULL;
             result = SDL_SetPointerPropertyWithCleanup(hints, name, hint, CleanupHintProperty, NULL);
+            SDL_InvalidateHintCache();
         }
     }
 
@@ -193,6 +239,7 @@ bool SDL_ResetHint(const char *name)
         SDL_free(hint->value);
         hint->value = NULL;
         hint->priority = SDL_HINT_DEFAULT;
+        SDL_InvalidateHintCache();
         result = true;
     }
 
@@ -232,6 +279,7 @@ static void SDLCALL ResetHintsCallback(void *userdata, SDL_PropertiesID hints, c
     SDL_free(hint->value);
     hint->value = NULL;
     hint->priority = SDL_HINT_DEFAULT;
+    SDL_InvalidateHintCache();
 
 #ifdef SDL_PLATFORM_ANDROID
     if (SDL_strcmp(name, SDL_HINT_ANDROID_ALLOW_RECREATE_ACTIVITY) == 0) {
@@ -255,31 +303,149 @@ bool SDL_SetHint(const char *name, const char *value)
     return SDL_SetHintWithPriority(name, value, SDL_HINT_NORMAL);
 }
 
-const char *SDL_GetHint(const char *name)
+static SDL_HashTable *GetHintCache(void)
 {
-    if (!name) {
-        return NULL;
+    SDL_HashTable *cache = (SDL_HashTable *)SDL_GetAtomicPointer(&SDL_hint_cache);
+    if (!cache) {
+        cache = SDL_CreateConcurrentHashTable(0, SDL_HashString, SDL_KeyMatchString, SDL_DestroyHashKeyAndValue, NULL);
+        if (!cache) {
+            return NULL;
+        }
+        if (!SDL_CompareAndSwapAtomicPointer(&SDL_hint_cache, NULL, cache)) {
+            // Somebody else created the cache before us, just use that
+            SDL_DestroyHashTable(cache);
+            cache = (SDL_HashTable *)SDL_GetAtomicPointer(&SDL_hint_cache);
+        }
     }
+    return cache;
+}
+
+// Get a reference to an interned copy of the string -- called with the hint properties locked
+static const char *InternHintValue(const char *value)
+{
+    SDL_HintValue *interned = NULL;
 
-    const char *result = GetHintEnvironmentVariable(name);
+    if (!SDL_hint_values) {
+        SDL_hint_values = SDL_CreateHashTable(0, false, SDL_HashString, SDL_KeyMatchString, SDL_DestroyHashValue, NULL);
+        if (!SDL_hint_values) {
+            return NULL;
+        }
+    }
 
+    if (!SDL_FindInHashTable(SDL_hint_values, value, (const void **)&interned)) {
+        const size_t len = SDL_strlen(value);
+        interned = (SDL_HintValue *)SDL_malloc(sizeof(*interned) + len + 1);
+        if (!interned) {
+            return NULL;
+        }
+        interned->refcount = 0;
+        SDL_memcpy(interned + 1, value, len + 1);
+        if (!SDL_InsertIntoHashTable(SDL_hint_values, interned + 1, interned, false)) {
+            SDL_free(interned);
+            return NULL;
+        }
+    }
+    ++interned->refcount;
+    return (const char *)(interned + 1);
+}
+
+// Drop a reference taken by InternHintValue() -- called with the hint properties locked
+static void ReleaseHintValue(const char *value)
+{
+    SDL_HintValue *interned = NULL;
+
+    if (value && SDL_FindInHashTable(SDL_hint_values, value, (const void **)&interned)) {
+        if (--interned->refcount == 0) {
+            SDL_RemoveFromHashTable(SDL_hint_values, value);
+        }
+    }
+}
+
+// Resolve the value of a hint and update its cache entry
+static const char *ResolveHint(const char *name)
+{
     const SDL_PropertiesID hints = GetHintProperties(false);
-    if (hints) {
-        SDL_LockProperties(hints);
+    if (!hints) {
+        // No hints have been set, so there's nothing to cache or to lock
+        return GetHintEnvironmentVariable(name);
+    }
+
+    const char *result = NULL;
+
+    SDL_LockProperties(hints);
+    {
+        // Read the generation first, anything that changes after this makes the entry stale
+        const int generation = SDL_GetAtomicInt(&SDL_hint_generation);
+
+        result = GetHintEnvironmentVariable(name);
 
         SDL_Hint *hint = (SDL_Hint *)SDL_GetPointerProperty(hints, name, NULL);
         if (hint) {
             if (!result || hint->priority == SDL_HINT_OVERRIDE) {
-                result = SDL_GetPersistentString(hint->value);
+                result = hint->value;
+            }
+        }
+
+        SDL_HintCacheEntry *entry = NULL;
+        SDL_HashTable *cache = GetHintCache();
+        if (cache && !SDL_FindInHashTable(cache, name, (const void **)&entry)) {
+            char *key = SDL_strdup(name);
+            entry = (SDL_HintCacheEntry *)SDL_malloc(sizeof(*entry));
+            if (key && entry) {
+                SDL_SetAtomicInt(&entry->generation, 0);
+                entry->value = NULL;
+            }
+            if (!key || !entry || !SDL_InsertIntoHashTable(cache, key, entry, false)) {
+                SDL_free(key);
+                SDL_free(entry);
+                entry = NULL;
             }
         }
 
-        SDL_UnlockProperties(hints);
+        if (!entry) {
+            // Nothing would hold a reference to an interned value, fall back to a copy for this thread
+            result = SDL_GetPersistentString(result);
+        } else if (!result || !entry->value || SDL_strcmp(result, entry->value) != 0) {
+            const char *value = result ? InternHintValue(result) : NULL;
+            if (value || !result) {
+                // Readers might still be using the old value, but they were told it only lasts until the hint changes
+                ReleaseHintValue(entry->value);
+                entry->value = value;
+                SDL_MemoryBarrierRelease();
+                SDL_SetAtomicInt(&entry->generation, generation);
+                result = value;
+            } else {
+                result = SDL_GetPersistentString(result);
+            }
+        } else {
+            // Same value as before, keep the pointer that callers already have
+            result = entry->value;
+            SDL_SetAtomicInt(&entry->generation, generation);
+        }
     }
+    SDL_UnlockProperties(hints);
 
     return result;
 }
 
+const char *SDL_GetHint(const char *name)
+{
+    if (!name) {
+        return NULL;
+    }
+
+    SDL_HashTable *cache = (SDL_HashTable *)SDL_GetAtomicPointer(&SDL_hint_cache);
+    if (cache) {
+        SDL_HintCacheEntry *entry;
+        if (SDL_FindInHashTable(cache, name, (const void **)&entry) &&
+            SDL_GetAtomicInt(&entry->generation) == SDL_GetAtomicInt(&SDL_hint_generation)) {
+            SDL_MemoryBarrierAcquire();
+            return entry->value;
+        }
+    }
+    return ResolveHint(name);
+}
+
 int SDL_GetStringInteger(const char *value, int default_value)
 {
     if (!value || !*value) {
@@ -29,5 +29,6 @@ extern void SDL_InitHints(void);
 extern bool SDL_GetStringBoolean(const char *value, bool default_value);
 extern int SDL_GetStringInteger(const char *value, int default_value);
 extern void SDL_QuitHints(void);
+extern void SDL_InvalidateHintCache(void);
 
 #endif // SDL_hints_c_h_
@@ -27,6 +27,8 @@
 // Simple log messages in SDL
 
 #include "SDL_log_c.h"
+#include "SDL_hints_c.h"
+#include "thread/SDL_thread_c.h"
 
 #ifdef HAVE_STDIO_H
 #include <stdio.h>
@@ -41,6 +43,12 @@
 // The size of the stack buffer to use for rendering log messages.
 #define SDL_MAX_LOG_MESSAGE_STACK 256
 
+// The number of messages that can wait for the log thread, must be a power of two
+#define SDL_LOG_QUEUE_SIZE 512
+
+// Messages shorter than this are copied into the queue, longer ones are allocated
+#define SDL_LOG_QUEUE_MESSAGE_SIZE 232
+
 #define DEFAULT_CATEGORY -1
 
 typedef struct SDL_LogLevel
@@ -50,6 +58,32 @@ typedef struct SDL_LogLevel
     struct SDL_LogLevel *next;
 } SDL_LogLevel;
 
+typedef enum SDL_LogMode
+{
+    SDL_LOG_MODE_SYNC,
+    SDL_LOG_MODE_ASYNC_DROP,
+    SDL_LOG_MODE_ASYNC_BLOCK
+} SDL_LogMode;
+
+typedef enum SDL_LogThreadState
+{
+    SDL_LOG_THREAD_STOPPED,
+    SDL_LOG_THREAD_STARTING,
+    SDL_LOG_THREAD_RUNNING,
+    SDL_LOG_THREAD_FAILED
+} SDL_LogThreadState;
+
+// A message waiting for the log thread.
+//  The sequence number tells producers and the log thread who owns the record.
+typedef struct SDL_LogRecord
+{
+    SDL_AtomicU32 sequence;
+    int category;
+    SDL_LogPriority priority;
+    char *long_message;
+    char message[SDL_LOG_QUEUE_MESSAGE_SIZE];
+} SDL_LogRecord;
+
 
 // The default log output function
 static void SDLCALL SDL_LogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message);
@@ -66,6 +100,23 @@ static SDL_LogPriority SDL_log_default_priority SDL_GUARDED_BY(SDL_log_lock);
 static SDL_LogOutputFunction SDL_log_function SDL_GUARDED_BY(SDL_log_function_lock) = SDL_LogOutput;
 static void *SDL_log_userdata SDL_GUARDED_BY(SDL_log_function_lock) = NULL;
 
+// Asynchronous logging, see SDL_HINT_LOG_ASYNC
+static SDL_AtomicInt SDL_log_mode;
+static SDL_LogThreadState SDL_log_thread_state SDL_GUARDED_BY(SDL_log_lock);
+static SDL_Thread *SDL_log_thread;
+static SDL_ThreadID SDL_log_thread_id;
+static SDL_LogRecord *SDL_log_queue;
+static SDL_AtomicU32 SDL_log_enqueue_pos;
+static Uint32 SDL_log_dequeue_pos;  // only used by the log thread
+static SDL_AtomicU32 SDL_log_written;
+static SDL_AtomicInt SDL_log_dropped;
+static SDL_AtomicInt SDL_log_producers;
+static SDL_AtomicInt SDL_log_sleeping;
+static SDL_AtomicInt SDL_log_quit;
+static SDL_Semaphore *SDL_log_wakeup;
+static SDL_Mutex *SDL_log_flush_lock;
+static SDL_Condition *SDL_log_flushed;
+
 #ifdef HAVE_GCC_DIAGNOSTIC_PRAGMA
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-variable"
@@ -125,6 +176,20 @@ static void SDLCALL SDL_LoggingChanged(void *userdata, const char *name, const c
     SDL_ResetLogPriorities();
 }
 
+static void SDLCALL SDL_LogAsyncChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_LogMode mode = SDL_LOG_MODE_SYNC;
+
+    if (hint && *hint) {
+        if (SDL_strcasecmp(hint, "block") == 0) {
+            mode = SDL_LOG_MODE_ASYNC_BLOCK;
+        } else if (SDL_strcasecmp(hint, "drop") == 0 || SDL_GetStringBoolean(hint, false)) {
+            mode = SDL_LOG_MODE_ASYNC_DROP;
+        }
+    }
+    SDL_SetAtomicInt(&SDL_log_mode, mode);
+}
+
 void SDL_InitLog(void)
 {
     if (!SDL_ShouldInit(&SDL_log_init)) {
@@ -132,10 +197,11 @@ void SDL_InitLog(void)
     }
 
     // If these fail we'll continue without them.
-    SDL_log_lock = SDL_CreateMutex();
-    SDL_log_function_lock = SDL_CreateMutex();
+    SDL_log_lock = SDL_CreateNamedMutex("SDL_log_lock");
+    SDL_log_function_lock = SDL_CreateNamedMutex("SDL_log_function_lock");
 
     SDL_AddHintCallback(SDL_HINT_LOGGING, SDL_LoggingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_LOG_ASYNC, SDL_LogAsyncChanged, NULL);
 
     SDL_SetInitialized(&SDL_log_init, true);
 }
@@ -147,6 +213,9 @@ void SDL_QuitLog(void)
     }
 
     SDL_RemoveHintCallback(SDL_HINT_LOGGING, SDL_LoggingChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_LOG_ASYNC, SDL_LogAsyncChanged, NULL);
+
+    SDL_StopLogThread();
 
     CleanupLogPriorities();
     CleanupLogPrefixes();
@@ -569,6 +638,267 @@ static const char *GetCategoryPrefix(int category)
 }
 #endif // SDL_PLATFORM_ANDROID
 
+static bool SDL_LogQueueReady(void)
+{
+    SDL_LogRecord *record = &SDL_log_queue[SDL_log_dequeue_pos & (SDL_LOG_QUEUE_SIZE - 1)];
+    return (SDL_GetAtomicU32(&record->sequence) == SDL_log_dequeue_pos + 1);
+}
+
+// Called on the log thread, returns false if the queue is empty
+static bool SDL_WriteQueuedLogMessage(void)
+{
+    SDL_LogRecord *record = &SDL_log_queue[SDL_log_dequeue_pos & (SDL_LOG_QUEUE_SIZE - 1)];
+
+    if (SDL_GetAtomicU32(&record->sequence) != SDL_log_dequeue_pos + 1) {
+        return false;
+    }
+
+    SDL_LockMutex(SDL_log_function_lock);
+    {
+        if (SDL_log_function) {
+            SDL_log_function(SDL_log_userdata, record->category, record->priority, record->long_message ? record->long_message : record->message);
+        }
+    }
+    SDL_UnlockMutex(SDL_log_function_lock);
+
+    if (record->long_message) {
+        SDL_free(record->long_message);
+        record->long_message = NULL;
+    }
+
+    // Hand the record back to the producers
+    SDL_SetAtomicU32(&record->sequence, SDL_log_dequeue_pos + SDL_LOG_QUEUE_SIZE);
+    ++SDL_log_dequeue_pos;
+    SDL_SetAtomicU32(&SDL_log_written, SDL_log_dequeue_pos);
+    return true;
+}
+
+static void SDL_WakeLogThread(void)
+{
+    if (SDL_GetAtomicInt(&SDL_log_sleeping) && SDL_CompareAndSwapAtomicInt(&SDL_log_sleeping, 1, 0)) {
+        SDL_SignalSemaphore(SDL_log_wakeup);
+    }
+}
+
+static int SDLCALL SDL_LogThread(void *unused)
+{
+    SDL_log_thread_id = SDL_GetCurrentThreadID();
+
+    for ( ; ; ) {
+        while (SDL_WriteQueuedLogMessage()) {
+        }
+
+        const int dropped = SDL_SetAtomicInt(&SDL_log_dropped, 0);
+        if (dropped > 0) {
+            char message[64];
+            (void)SDL_snprintf(message, sizeof(message), "%d log messages were dropped", dropped);
+            SDL_LockMutex(SDL_log_function_lock);
+            {
+                if (SDL_log_function) {
+                    SDL_log_function(SDL_log_userdata, SDL_LOG_CATEGORY_SYSTEM, SDL_LOG_PRIORITY_WARN, message);
+                }
+            }
+            SDL_UnlockMutex(SDL_log_function_lock);
+        }
+
+        SDL_LockMutex(SDL_log_flush_lock);
+        SDL_BroadcastCondition(SDL_log_flushed);
+        SDL_UnlockMutex(SDL_log_flush_lock);
+
+        const bool quit = (SDL_GetAtomicInt(&SDL_log_quit) != 0);
+        if (quit && SDL_GetAtomicInt(&SDL_log_producers) == 0 && !SDL_LogQueueReady()) {
+            break;
+        }
+
+        // Producers check this flag after they publish a message, so check the queue again after setting it
+        SDL_SetAtomicInt(&SDL_log_sleeping, 1);
+        if (SDL_LogQueueReady()) {
+            SDL_SetAtomicInt(&SDL_log_sleeping, 0);
+            continue;
+        }
+        SDL_WaitSemaphoreTimeout(SDL_log_wakeup, quit ? 1 : -1);
+        SDL_SetAtomicInt(&SDL_log_sleeping, 0);
+    }
+    return 0;
+}
+
+static void SDL_FreeLogQueue(void)
+{
+    SDL_free(SDL_log_queue);
+    SDL_log_queue = NULL;
+    SDL_DestroySemaphore(SDL_log_wakeup);
+    SDL_log_wakeup = NULL;
+    SDL_DestroyCondition(SDL_log_flushed);
+    SDL_log_flushed = NULL;
+    SDL_DestroyMutex(SDL_log_flush_lock);
+    SDL_log_flush_lock = NULL;
+}
+
+static bool SDL_StartLogThread(void)
+{
+    bool result;
+
+    if (SDL_GetAtomicPointer((void **)&SDL_log_thread)) {
+        return true;
+    }
+
+    SDL_LockMutex(SDL_log_lock);
+    {
+        // Creating the thread can log, which will come back here on this thread while we're starting
+        if (SDL_log_thread_state == SDL_LOG_THREAD_STOPPED) {
+            SDL_log_thread_state = SDL_LOG_THREAD_STARTING;
+
+            SDL_log_queue = (SDL_LogRecord *)SDL_calloc(SDL_LOG_QUEUE_SIZE, sizeof(*SDL_log_queue));
+            SDL_log_wakeup = SDL_CreateSemaphore(0);
+            SDL_log_flush_lock = SDL_CreateNamedMutex("SDL_log_flush_lock");
+            SDL_log_flushed = SDL_CreateCondition();
+            if (SDL_log_queue && SDL_log_wakeup && SDL_log_flush_lock && SDL_log_flushed) {
+                for (Uint32 i = 0; i < SDL_LOG_QUEUE_SIZE; ++i) {
+                    SDL_SetAtomicU32(&SDL_log_queue[i].sequence, i);
+                }
+                SDL_SetAtomicU32(&SDL_log_enqueue_pos, 0);
+                SDL_SetAtomicU32(&SDL_log_written, 0);
+                SDL_log_dequeue_pos = 0;
+
+                SDL_Thread *thread = SDL_CreateThread(SDL_LogThread, "SDLLog", NULL);
+                if (thread) {
+                    SDL_log_thread_id = SDL_GetThreadID(thread);
+                    SDL_SetAtomicPointer((void **)&SDL_log_thread, thread);
+                }
+            }
+
+            if (SDL_log_thread) {
+                SDL_log_thread_state = SDL_LOG_THREAD_RUNNING;
+            } else {
+                // Don't try again for every message, just log synchronously
+                SDL_FreeLogQueue();
+                SDL_log_thread_state = SDL_LOG_THREAD_FAILED;
+            }
+        }
+        result = (SDL_log_thread_state == SDL_LOG_THREAD_RUNNING);
+    }
+    SDL_UnlockMutex(SDL_log_lock);
+
+    return result;
+}
+
+void SDL_StopLogThread(void)
+{
+    SDL_Thread *thread = (SDL_Thread *)SDL_GetAtomicPointer((void **)&SDL_log_thread);
+
+    // Everything after this is logged synchronously
+    SDL_SetAtomicInt(&SDL_log_mode, SDL_LOG_MODE_SYNC);
+
+    if (thread) {
+        // The log thread writes out everything queued before it exits
+        SDL_SetAtomicInt(&SDL_log_quit, 1);
+        SDL_SignalSemaphore(SDL_log_wakeup);
+        SDL_WaitThread(thread, NULL);
+        SDL_SetAtomicPointer((void **)&SDL_log_thread, NULL);
+
+        // Wait for anyone who saw the thread running to notice it's gone
+        while (SDL_GetAtomicInt(&SDL_log_producers) > 0) {
+            SDL_Delay(1);
+        }
+
+        SDL_log_thread_id = 0;
+        SDL_FreeLogQueue();
+        SDL_SetAtomicInt(&SDL_log_quit, 0);
+    }
+
+    SDL_LockMutex(SDL_log_lock);
+    SDL_log_thread_state = SDL_LOG_THREAD_STOPPED;
+    SDL_UnlockMutex(SDL_log_lock);
+}
+
+static bool SDL_QueueLogMessage(int category, SDL_LogPriority priority, char *message, size_t len, bool allocated, bool block)
+{
+    SDL_LogRecord *record;
+    Uint32 pos = SDL_GetAtomicU32(&SDL_log_enqueue_pos);
+
+    for ( ; ; ) {
+        record = &SDL_log_queue[pos & (SDL_LOG_QUEUE_SIZE - 1)];
+        const Sint32 diff = (Sint32)(SDL_GetAtomicU32(&record->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicU32(&SDL_log_enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The queue is full
+            if (!block) {
+                return false;
+            }
+            SDL_WakeLogThread();
+            SDL_DelayNS(SDL_US_TO_NS(100));
+        }
+        pos = SDL_GetAtomicU32(&SDL_log_enqueue_pos);
+    }
+
+    record->category = category;
+    record->priority = priority;
+    if (allocated) {
+        record->long_message = message;
+    } else if (len < sizeof(record->message)) {
+        SDL_memcpy(record->message, message, len + 1);
+    } else {
+        record->long_message = SDL_strdup(message);
+        if (!record->long_message) {
+            (void)SDL_strlcpy(record->message, message, sizeof(record->message));
+        }
+    }
+    SDL_SetAtomicU32(&record->sequence, pos + 1);
+
+    SDL_WakeLogThread();
+    return true;
+}
+
+// Returns true if the message was queued or dropped, false if it should be written synchronously.
+//  If the message was allocated, it's been taken care of if this returns true.
+static bool SDL_LogMessageAsync(int category, SDL_LogPriority priority, char *message, size_t len, bool allocated)
+{
+    bool handled = false;
+
+    SDL_AddAtomicInt(&SDL_log_producers, 1);
+    {
+        const SDL_LogMode mode = (SDL_LogMode)SDL_GetAtomicInt(&SDL_log_mode);
+        if (mode != SDL_LOG_MODE_SYNC && !SDL_GetAtomicInt(&SDL_log_quit) &&
+            SDL_StartLogThread() && SDL_GetCurrentThreadID() != SDL_log_thread_id) {
+            if (!SDL_QueueLogMessage(category, priority, message, len, allocated, (mode == SDL_LOG_MODE_ASYNC_BLOCK))) {
+                SDL_AddAtomicInt(&SDL_log_dropped, 1);
+                if (allocated) {
+                    SDL_free(message);
+                }
+            }
+            handled = true;
+        }
+    }
+    SDL_AddAtomicInt(&SDL_log_producers, -1);
+
+    // Make sure critical messages are out before the application has a chance to crash
+    if (handled && priority >= SDL_LOG_PRIORITY_CRITICAL) {
+        SDL_FlushLogs();
+    }
+    return handled;
+}
+
+void SDL_FlushLogs(void)
+{
+    SDL_AddAtomicInt(&SDL_log_producers, 1);
+    {
+        if (SDL_GetAtomicPointer((void **)&SDL_log_thread) && SDL_GetCurrentThreadID() != SDL_log_thread_id) {
+            const Uint32 target = SDL_GetAtomicU32(&SDL_log_enqueue_pos);
+
+            SDL_LockMutex(SDL_log_flush_lock);
+            while ((Sint32)(SDL_GetAtomicU32(&SDL_log_written) - target) < 0) {
+                SDL_WakeLogThread();
+                SDL_WaitConditionTimeout(SDL_log_flushed, SDL_log_flush_lock, 10);
+            }
+            SDL_UnlockMutex(SDL_log_flush_lock);
+        }
+    }
+    SDL_AddAtomicInt(&SDL_log_producers, -1);
+}
+
 void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_STRING const char *fmt, va_list ap)
 {
     char *message = NULL;
@@ -618,6 +948,15 @@ void SDL_LogMessageV(int category, SDL_LogPriority priority, SDL_PRINTF_FORMAT_S
         }
     }
 
+    if (SDL_GetAtomicInt(&SDL_log_mode) != SDL_LOG_MODE_SYNC) {
+        if (SDL_LogMessageAsync(category, priority, message, (size_t)len, (message != stack_buf))) {
+            return;
+        }
+    } else if (SDL_GetAtomicPointer((void **)&SDL_log_thread)) {
+        // Keep messages in order after switching back to synchronous logging
+        SDL_FlushLogs();
+    }
+
     SDL_LockMutex(SDL_log_function_lock);
     {
         SDL_log_function(SDL_log_userdata, category, priority, message);
@@ -796,6 +1135,9 @@ void SDL_GetLogOutputFunction(SDL_LogOutputFunction *callback, void **userdata)
 
 void SDL_SetLogOutputFunction(SDL_LogOutputFunction callback, void *userdata)
 {
+    // Messages that were logged before this go to the previous function
+    SDL_FlushLogs();
+
     SDL_LockMutex(SDL_log_function_lock);
     {
         SDL_log_function = callback;
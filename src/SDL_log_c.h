@@ -28,4 +28,7 @@
 extern void SDL_InitLog(void);
 extern void SDL_QuitLog(void);
 
+// Writes out any queued messages and stops the asynchronous log thread
+extern void SDL_StopLogThread(void);
+
 #endif // SDL_log_c_h_
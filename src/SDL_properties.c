@@ -22,6 +22,7 @@
 
 #include "SDL_hints_c.h"
 #include "SDL_properties_c.h"
+#include "thread/SDL_thread_c.h"
 
 
 typedef struct
@@ -42,49 +43,69 @@ typedef struct
     void *userdata;
 } SDL_Property;
 
+// Property names are interned into atoms, and each group keeps its properties
+//  in an array sorted by atom. Most groups are small enough that the array
+//  fits inside the group itself, so they take a single allocation. Every group
+//  pays for the inline entries, textures have 7 properties and IO streams 2.
+#define SDL_PROPERTIES_INLINE_ENTRIES 8
+
+typedef struct
+{
+    SDL_PropertyAtom atom;
+    const char *name;   // the interned name, valid as long as the atom
+    SDL_Property property;
+} SDL_PropertyEntry;
+
+typedef struct
+{
+    SDL_PropertyAtom atom;
+    char name[1];
+} SDL_PropertyName;
+
 typedef struct
 {
-    SDL_HashTable *props;
     SDL_Mutex *lock;
+    SDL_PropertyEntry *entries;
+    int num_entries;
+    int max_entries;
+    SDL_PropertyEntry inline_entries[SDL_PROPERTIES_INLINE_ENTRIES];
 } SDL_Properties;
 
 static SDL_InitState SDL_properties_init;
 static SDL_HashTable *SDL_properties;
 static SDL_AtomicU32 SDL_last_properties_id;
 static SDL_AtomicU32 SDL_global_properties;
+static SDL_HashTable *SDL_property_atoms;   // name -> SDL_PropertyName
+static SDL_Mutex *SDL_property_atoms_lock;
+static SDL_PropertyAtom SDL_last_property_atom;
 
 
-static void SDL_FreePropertyWithCleanup(const void *key, const void *value, void *data, bool cleanup)
+static void SDL_FreePropertyWithCleanup(SDL_Property *property, bool cleanup)
 {
-    SDL_Property *property = (SDL_Property *)value;
-    if (property) {
-        switch (property->type) {
-        case SDL_PROPERTY_TYPE_POINTER:
-            if (property->cleanup && cleanup) {
-                property->cleanup(property->userdata, property->value.pointer_value);
-            }
-            break;
-        case SDL_PROPERTY_TYPE_STRING:
-            SDL_free(property->value.string_value);
-            break;
-        default:
-            break;
+    switch (property->type) {
+    case SDL_PROPERTY_TYPE_POINTER:
+        if (property->cleanup && cleanup) {
+            property->cleanup(property->userdata, property->value.pointer_value);
         }
-        SDL_free(property->string_storage);
+        break;
+    case SDL_PROPERTY_TYPE_STRING:
+        SDL_free(property->value.string_value);
+        break;
+    default:
+        break;
     }
-    SDL_free((void *)key);
-    SDL_free((void *)value);
-}
-
-static void SDLCALL SDL_FreeProperty(void *data, const void *key, const void *value)
-{
-    SDL_FreePropertyWithCleanup(key, value, data, true);
+    SDL_free(property->string_storage);
 }
 
 static void SDL_FreeProperties(SDL_Properties *properties)
 {
     if (properties) {
-        SDL_DestroyHashTable(properties->props);
+        for (int i = 0; i < properties->num_entries; ++i) {
+            SDL_FreePropertyWithCleanup(&properties->entries[i].property, true);
+        }
+        if (properties->entries != properties->inline_entries) {
+            SDL_free(properties->entries);
+        }
         SDL_DestroyMutex(properties->lock);
         SDL_free(properties);
     }
@@ -96,8 +117,18 @@ bool SDL_InitProperties(void)
         return true;
     }
 
-    SDL_properties = SDL_CreateHashTable(0, true, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
-    const bool initialized = (SDL_properties != NULL);
+    SDL_properties = SDL_CreateConcurrentHashTable(0, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    SDL_property_atoms = SDL_CreateConcurrentHashTable(0, SDL_HashString, SDL_KeyMatchString, SDL_DestroyHashValue, NULL);
+    SDL_property_atoms_lock = SDL_CreateNamedMutex("SDL_property_atoms_lock");
+    const bool initialized = (SDL_properties && SDL_property_atoms && SDL_property_atoms_lock);
+    if (!initialized) {
+        SDL_DestroyHashTable(SDL_properties);
+        SDL_properties = NULL;
+        SDL_DestroyHashTable(SDL_property_atoms);
+        SDL_property_atoms = NULL;
+        SDL_DestroyMutex(SDL_property_atoms_lock);
+        SDL_property_atoms_lock = NULL;
+    }
     SDL_SetInitialized(&SDL_properties_init, initialized);
     return initialized;
 }
@@ -131,6 +162,13 @@ void SDL_QuitProperties(void)
     SDL_IterateHashTable(properties, FreeOneProperties, NULL);
     SDL_DestroyHashTable(properties);
 
+    // Property names are used until the last group is gone
+    SDL_DestroyHashTable(SDL_property_atoms);
+    SDL_property_atoms = NULL;
+    SDL_DestroyMutex(SDL_property_atoms_lock);
+    SDL_property_atoms_lock = NULL;
+    // SDL_last_property_atom is kept, so atoms an app cached before this don't match a different name later
+
     SDL_SetInitialized(&SDL_properties_init, false);
 }
 
@@ -139,6 +177,113 @@ static bool SDL_CheckInitProperties(void)
     return SDL_InitProperties();
 }
 
+static const SDL_PropertyName *SDL_FindPropertyName(const char *name)
+{
+    const SDL_PropertyName *interned = NULL;
+
+    if (!name || !*name || !SDL_property_atoms) {
+        return NULL;
+    }
+    SDL_FindInHashTable(SDL_property_atoms, name, (const void **)&interned);
+    return interned;
+}
+
+// Returns the atom for a name, or 0 if no property has ever had that name
+static SDL_PropertyAtom SDL_FindPropertyAtom(const char *name)
+{
+    const SDL_PropertyName *interned = SDL_FindPropertyName(name);
+    return interned ? interned->atom : 0;
+}
+
+static const SDL_PropertyName *SDL_InternPropertyName(const char *name)
+{
+    const SDL_PropertyName *interned = SDL_FindPropertyName(name);
+
+    if (interned || !name || !*name) {
+        return interned;
+    }
+    if (!SDL_CheckInitProperties()) {
+        return NULL;
+    }
+
+    SDL_LockMutex(SDL_property_atoms_lock);
+    {
+        // Check again, another thread may have added it while we were waiting
+        interned = SDL_FindPropertyName(name);
+        if (!interned) {
+            const size_t len = SDL_strlen(name);
+            SDL_PropertyName *entry = (SDL_PropertyName *)SDL_malloc(sizeof(*entry) + len);
+            if (entry) {
+                entry->atom = SDL_last_property_atom + 1;
+                SDL_memcpy(entry->name, name, len + 1);
+                if (SDL_InsertIntoHashTable(SDL_property_atoms, entry->name, entry, false)) {
+                    SDL_last_property_atom = entry->atom;
+                    interned = entry;
+                } else {
+                    SDL_free(entry);
+                }
+            }
+        }
+    }
+    SDL_UnlockMutex(SDL_property_atoms_lock);
+
+    return interned;
+}
+
+SDL_PropertyAtom SDL_GetPropertyAtom(const char *name)
+{
+    if (!name || !*name) {
+        SDL_InvalidParamError("name");
+        return 0;
+    }
+
+    const SDL_PropertyName *interned = SDL_InternPropertyName(name);
+    return interned ? interned->atom : 0;
+}
+
+// Returns the index of the entry with this atom, or -(insertion point + 1) if there isn't one
+static int SDL_FindPropertyEntry(const SDL_Properties *properties, SDL_PropertyAtom atom)
+{
+    int low = 0;
+    int high = properties->num_entries - 1;
+
+    while (low <= high) {
+        const int mid = low + (high - low) / 2;
+        const SDL_PropertyAtom mid_atom = properties->entries[mid].atom;
+        if (mid_atom < atom) {
+            low = mid + 1;
+        } else if (mid_atom > atom) {
+            high = mid - 1;
+        } else {
+            return mid;
+        }
+    }
+    return -(low + 1);
+}
+
+static SDL_Property *SDL_FindProperty(SDL_Properties *properties, SDL_PropertyAtom atom)
+{
+    if (!atom) {
+        return NULL;
+    }
+
+    const int index = SDL_FindPropertyEntry(properties, atom);
+    if (index < 0) {
+        return NULL;
+    }
+    return &properties->entries[index].property;
+}
+
+static SDL_Properties *SDL_GetProperties(SDL_PropertiesID props)
+{
+    SDL_Properties *properties = NULL;
+
+    if (props && SDL_properties) {
+        SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    }
+    return properties;
+}
+
 SDL_PropertiesID SDL_GetGlobalProperties(void)
 {
     SDL_PropertiesID props = SDL_GetAtomicU32(&SDL_global_properties);
@@ -159,24 +304,20 @@ SDL_PropertiesID SDL_CreateProperties(void)
         return 0;
     }
 
-    SDL_Properties *properties = (SDL_Properties *)SDL_calloc(1, sizeof(*properties));
+    SDL_Properties *properties = (SDL_Properties *)SDL_malloc(sizeof(*properties));
     if (!properties) {
         return 0;
     }
+    properties->entries = properties->inline_entries;
+    properties->num_entries = 0;
+    properties->max_entries = SDL_arraysize(properties->inline_entries);
 
-    properties->lock = SDL_CreateMutex();
+    properties->lock = SDL_CreateNamedMutex("SDL_Properties.lock");
     if (!properties->lock) {
         SDL_free(properties);
         return 0;
     }
 
-    properties->props = SDL_CreateHashTable(0, false, SDL_HashString, SDL_KeyMatchString, SDL_FreeProperty, NULL);
-    if (!properties->props) {
-        SDL_DestroyMutex(properties->lock);
-        SDL_free(properties);
-        return 0;
-    }
-
     SDL_PropertiesID props = 0;
     while (true) {
         props = (SDL_GetAtomicU32(&SDL_last_properties_id) + 1);
@@ -197,55 +338,57 @@ SDL_PropertiesID SDL_CreateProperties(void)
     return props;  // All done!
 }
 
-typedef struct CopyOnePropertyData
-{
-    SDL_Properties *dst_properties;
-    bool result;
-} CopyOnePropertyData;
-
-static bool SDLCALL CopyOneProperty(void *userdata, const SDL_HashTable *table, const void *key, const void *value)
+// Sets, replaces or (if property is NULL) removes a property, with the group locked.
+//  On failure, the property is freed.
+static bool SDL_SetPropertyEntry(SDL_Properties *properties, SDL_PropertyAtom atom, const char *name, const SDL_Property *property)
 {
-    const SDL_Property *src_property = (const SDL_Property *)value;
-    if (src_property->cleanup) {
-        // Can't copy properties with cleanup functions, we don't know how to duplicate the data
-        return true;  // keep iterating.
-    }
-
-    CopyOnePropertyData *data = (CopyOnePropertyData *) userdata;
-    SDL_Properties *dst_properties = data->dst_properties;
-    const char *src_name = (const char *)key;
-    SDL_Property *dst_property;
+    SDL_Property old;
+    int index = SDL_FindPropertyEntry(properties, atom);
 
-    char *dst_name = SDL_strdup(src_name);
-    if (!dst_name) {
-        data->result = false;
-        return true; // keep iterating (I guess...?)
+    if (index >= 0) {
+        old = properties->entries[index].property;
+        if (property) {
+            properties->entries[index].property = *property;
+        } else {
+            --properties->num_entries;
+            SDL_memmove(&properties->entries[index], &properties->entries[index + 1], (properties->num_entries - index) * sizeof(*properties->entries));
+        }
+        // The entries are consistent again, so it's safe for cleanup to use these properties
+        SDL_FreePropertyWithCleanup(&old, true);
+        return true;
     }
 
-    dst_property = (SDL_Property *)SDL_malloc(sizeof(*dst_property));
-    if (!dst_property) {
-        SDL_free(dst_name);
-        data->result = false;
-        return true; // keep iterating (I guess...?)
+    if (!property) {
+        return true;
     }
 
-    SDL_copyp(dst_property, src_property);
-    if (src_property->type == SDL_PROPERTY_TYPE_STRING) {
-        dst_property->value.string_value = SDL_strdup(src_property->value.string_value);
-        if (!dst_property->value.string_value) {
-            SDL_free(dst_name);
-            SDL_free(dst_property);
-            data->result = false;
-            return true; // keep iterating (I guess...?)
+    if (properties->num_entries == properties->max_entries) {
+        const int max_entries = properties->max_entries * 2;
+        SDL_PropertyEntry *entries;
+        if (properties->entries == properties->inline_entries) {
+            entries = (SDL_PropertyEntry *)SDL_malloc(max_entries * sizeof(*entries));
+            if (entries) {
+                SDL_memcpy(entries, properties->inline_entries, properties->num_entries * sizeof(*entries));
+            }
+        } else {
+            entries = (SDL_PropertyEntry *)SDL_realloc(properties->entries, max_entries * sizeof(*entries));
         }
+        if (!entries) {
+            SDL_Property failed = *property;
+            SDL_FreePropertyWithCleanup(&failed, true);
+            return false;
+        }
+        properties->entries = entries;
+        properties->max_entries = max_entries;
     }
 
-    if (!SDL_InsertIntoHashTable(dst_properties->props, dst_name, dst_property, true)) {
-        SDL_FreePropertyWithCleanup(dst_name, dst_property, NULL, false);
-        data->result = false;
-    }
-
-    return true;  // keep iterating.
+    index = -(index + 1);
+    SDL_memmove(&properties->entries[index + 1], &properties->entries[index], (properties->num_entries - index) * sizeof(*properties->entries));
+    properties->entries[index].atom = atom;
+    properties->entries[index].name = name;
+    properties->entries[index].property = *property;
+    ++properties->num_entries;
+    return true;
 }
 
 bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
@@ -257,14 +400,11 @@ bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
         return SDL_InvalidParamError("dst");
     }
 
-    SDL_Properties *src_properties = NULL;
-    SDL_Properties *dst_properties = NULL;
-
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)src, (const void **)&src_properties);
+    SDL_Properties *src_properties = SDL_GetProperties(src);
     if (!src_properties) {
         return SDL_InvalidParamError("src");
     }
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)dst, (const void **)&dst_properties);
+    SDL_Properties *dst_properties = SDL_GetProperties(dst);
     if (!dst_properties) {
         return SDL_InvalidParamError("dst");
     }
@@ -273,9 +413,27 @@ bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
     SDL_LockMutex(src_properties->lock);
     SDL_LockMutex(dst_properties->lock);
     {
-        CopyOnePropertyData data = { dst_properties, true };
-        SDL_IterateHashTable(src_properties->props, CopyOneProperty, &data);
-        result = data.result;
+        for (int i = 0; i < src_properties->num_entries; ++i) {
+            const SDL_PropertyEntry *src_entry = &src_properties->entries[i];
+            if (src_entry->property.cleanup) {
+                // Can't copy properties with cleanup functions, we don't know how to duplicate the data
+                continue;
+            }
+
+            SDL_Property dst_property;
+            SDL_copyp(&dst_property, &src_entry->property);
+            dst_property.string_storage = NULL;
+            if (src_entry->property.type == SDL_PROPERTY_TYPE_STRING) {
+                dst_property.value.string_value = SDL_strdup(src_entry->property.value.string_value);
+                if (!dst_property.value.string_value) {
+                    result = false;
+                    continue;
+                }
+            }
+            if (!SDL_SetPropertyEntry(dst_properties, src_entry->atom, src_entry->name, &dst_property)) {
+                result = false;
+            }
+        }
     }
     SDL_UnlockMutex(dst_properties->lock);
     SDL_UnlockMutex(src_properties->lock);
@@ -285,13 +443,11 @@ bool SDL_CopyProperties(SDL_PropertiesID src, SDL_PropertiesID dst)
 
 bool SDL_LockProperties(SDL_PropertiesID props)
 {
-    SDL_Properties *properties = NULL;
-
     if (!props) {
         return SDL_InvalidParamError("props");
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    SDL_Properties *properties = SDL_GetProperties(props);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
@@ -302,13 +458,7 @@ bool SDL_LockProperties(SDL_PropertiesID props)
 
 void SDL_UnlockProperties(SDL_PropertiesID props)
 {
-    SDL_Properties *properties = NULL;
-
-    if (!props) {
-        return;
-    }
-
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    SDL_Properties *properties = SDL_GetProperties(props);
     if (!properties) {
         return;
     }
@@ -319,33 +469,47 @@ void SDL_UnlockProperties(SDL_PropertiesID props)
 static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL_Property *property)
 {
     SDL_Properties *properties = NULL;
-    bool result = true;
+    const SDL_PropertyName *interned;
+    bool result;
 
     if (!props) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        if (property) {
+            SDL_FreePropertyWithCleanup(property, true);
+        }
         return SDL_InvalidParamError("props");
     }
     if (!name || !*name) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        if (property) {
+            SDL_FreePropertyWithCleanup(property, true);
+        }
         return SDL_InvalidParamError("name");
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, true);
+        if (property) {
+            SDL_FreePropertyWithCleanup(property, true);
+        }
         return SDL_InvalidParamError("props");
     }
 
+    if (property) {
+        interned = SDL_InternPropertyName(name);
+        if (!interned) {
+            SDL_FreePropertyWithCleanup(property, true);
+            return false;
+        }
+    } else {
+        interned = SDL_FindPropertyName(name);
+        if (!interned) {
+            // No property ever had this name, so there's nothing to clear
+            return true;
+        }
+    }
+
     SDL_LockMutex(properties->lock);
     {
-        SDL_RemoveFromHashTable(properties->props, name);
-        if (property) {
-            char *key = SDL_strdup(name);
-            if (!key || !SDL_InsertIntoHashTable(properties->props, key, property, false)) {
-                SDL_FreePropertyWithCleanup(key, property, NULL, true);
-                result = false;
-            }
-        }
+        result = SDL_SetPropertyEntry(properties, interned->atom, interned->name, property);
     }
     SDL_UnlockMutex(properties->lock);
 
@@ -354,7 +518,7 @@ static bool SDL_PrivateSetProperty(SDL_PropertiesID props, const char *name, SDL
 
 bool SDL_SetPointerPropertyWithCleanup(SDL_PropertiesID props, const char *name, void *value, SDL_CleanupPropertyCallback cleanup, void *userdata)
 {
-    SDL_Property *property;
+    SDL_Property property;
 
     if (!value) {
         if (cleanup) {
@@ -363,36 +527,26 @@ bool SDL_SetPointerPropertyWithCleanup(SDL_PropertiesID props, const char *name,
         return SDL_ClearProperty(props, name);
     }
 
-    property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        if (cleanup) {
-            cleanup(userdata, value);
-        }
-        SDL_FreePropertyWithCleanup(NULL, property, NULL, false);
-        return false;
-    }
-    property->type = SDL_PROPERTY_TYPE_POINTER;
-    property->value.pointer_value = value;
-    property->cleanup = cleanup;
-    property->userdata = userdata;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_POINTER;
+    property.value.pointer_value = value;
+    property.cleanup = cleanup;
+    property.userdata = userdata;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 bool SDL_SetPointerProperty(SDL_PropertiesID props, const char *name, void *value)
 {
-    SDL_Property *property;
+    SDL_Property property;
 
     if (!value) {
         return SDL_ClearProperty(props, name);
     }
 
-    property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return false;
-    }
-    property->type = SDL_PROPERTY_TYPE_POINTER;
-    property->value.pointer_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_POINTER;
+    property.value.pointer_value = value;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 static void SDLCALL CleanupFreeableProperty(void *userdata, void *value)
@@ -419,56 +573,49 @@ bool SDL_SetSurfaceProperty(SDL_PropertiesID props, const char *name, SDL_Surfac
 
 bool SDL_SetStringProperty(SDL_PropertiesID props, const char *name, const char *value)
 {
-    SDL_Property *property;
+    SDL_Property property;
 
     if (!value) {
         return SDL_ClearProperty(props, name);
     }
 
-    property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return false;
-    }
-    property->type = SDL_PROPERTY_TYPE_STRING;
-    property->value.string_value = SDL_strdup(value);
-    if (!property->value.string_value) {
-        SDL_free(property);
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_STRING;
+    property.value.string_value = SDL_strdup(value);
+    if (!property.value.string_value) {
         return false;
     }
-    return SDL_PrivateSetProperty(props, name, property);
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 bool SDL_SetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 value)
 {
-    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return false;
-    }
-    property->type = SDL_PROPERTY_TYPE_NUMBER;
-    property->value.number_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_Property property;
+
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_NUMBER;
+    property.value.number_value = value;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 bool SDL_SetFloatProperty(SDL_PropertiesID props, const char *name, float value)
 {
-    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return false;
-    }
-    property->type = SDL_PROPERTY_TYPE_FLOAT;
-    property->value.float_value = value;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_Property property;
+
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_FLOAT;
+    property.value.float_value = value;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 bool SDL_SetBooleanProperty(SDL_PropertiesID props, const char *name, bool value)
 {
-    SDL_Property *property = (SDL_Property *)SDL_calloc(1, sizeof(*property));
-    if (!property) {
-        return false;
-    }
-    property->type = SDL_PROPERTY_TYPE_BOOLEAN;
-    property->value.boolean_value = value ? true : false;
-    return SDL_PrivateSetProperty(props, name, property);
+    SDL_Property property;
+
+    SDL_zero(property);
+    property.type = SDL_PROPERTY_TYPE_BOOLEAN;
+    property.value.boolean_value = value ? true : false;
+    return SDL_PrivateSetProperty(props, name, &property);
 }
 
 bool SDL_HasProperty(SDL_PropertiesID props, const char *name)
@@ -488,15 +635,15 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return SDL_PROPERTY_TYPE_INVALID;
     }
 
     SDL_LockMutex(properties->lock);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, SDL_FindPropertyAtom(name));
+        if (property) {
             type = property->type;
         }
     }
@@ -505,30 +652,27 @@ SDL_PropertyType SDL_GetPropertyType(SDL_PropertiesID props, const char *name)
     return type;
 }
 
-void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
+void *SDL_GetPointerPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, void *default_value)
 {
     SDL_Properties *properties = NULL;
     void *value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
+    if (!props || !atom) {
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
     // Note that taking the lock here only guarantees that we won't read the
-    // hashtable while it's being modified. The value itself can easily be
+    // entries while they're being modified. The value itself can easily be
     // freed from another thread after it is returned here.
     SDL_LockMutex(properties->lock);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom);
+        if (property) {
             if (property->type == SDL_PROPERTY_TYPE_POINTER) {
                 value = property->value.pointer_value;
             }
@@ -539,27 +683,29 @@ void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *def
     return value;
 }
 
-const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
+void *SDL_GetPointerProperty(SDL_PropertiesID props, const char *name, void *default_value)
+{
+    return SDL_GetPointerPropertyByAtom(props, SDL_FindPropertyAtom(name), default_value);
+}
+
+const char *SDL_GetStringPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, const char *default_value)
 {
     SDL_Properties *properties = NULL;
     const char *value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
+    if (!props || !atom) {
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
     SDL_LockMutex(properties->lock);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = property->value.string_value;
@@ -597,27 +743,29 @@ const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, cons
     return value;
 }
 
-Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+const char *SDL_GetStringProperty(SDL_PropertiesID props, const char *name, const char *default_value)
+{
+    return SDL_GetStringPropertyByAtom(props, SDL_FindPropertyAtom(name), default_value);
+}
+
+Sint64 SDL_GetNumberPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, Sint64 default_value)
 {
     SDL_Properties *properties = NULL;
     Sint64 value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
+    if (!props || !atom) {
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
     SDL_LockMutex(properties->lock);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (Sint64)SDL_strtoll(property->value.string_value, NULL, 0);
@@ -641,27 +789,29 @@ Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 de
     return value;
 }
 
-float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+Sint64 SDL_GetNumberProperty(SDL_PropertiesID props, const char *name, Sint64 default_value)
+{
+    return SDL_GetNumberPropertyByAtom(props, SDL_FindPropertyAtom(name), default_value);
+}
+
+float SDL_GetFloatPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, float default_value)
 {
     SDL_Properties *properties = NULL;
     float value = default_value;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
+    if (!props || !atom) {
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
     SDL_LockMutex(properties->lock);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = (float)SDL_atof(property->value.string_value);
@@ -685,27 +835,29 @@ float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float defau
     return value;
 }
 
-bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value)
+float SDL_GetFloatProperty(SDL_PropertiesID props, const char *name, float default_value)
+{
+    return SDL_GetFloatPropertyByAtom(props, SDL_FindPropertyAtom(name), default_value);
+}
+
+bool SDL_GetBooleanPropertyByAtom(SDL_PropertiesID props, SDL_PropertyAtom atom, bool default_value)
 {
     SDL_Properties *properties = NULL;
     bool value = default_value ? true : false;
 
-    if (!props) {
-        return value;
-    }
-    if (!name || !*name) {
+    if (!props || !atom) {
         return value;
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return value;
     }
 
     SDL_LockMutex(properties->lock);
     {
-        SDL_Property *property = NULL;
-        if (SDL_FindInHashTable(properties->props, name, (const void **)&property)) {
+        SDL_Property *property = SDL_FindProperty(properties, atom);
+        if (property) {
             switch (property->type) {
             case SDL_PROPERTY_TYPE_STRING:
                 value = SDL_GetStringBoolean(property->value.string_value, default_value);
@@ -729,26 +881,14 @@ bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool defau
     return value;
 }
 
-bool SDL_ClearProperty(SDL_PropertiesID props, const char *name)
+bool SDL_GetBooleanProperty(SDL_PropertiesID props, const char *name, bool default_value)
 {
-    return SDL_PrivateSetProperty(props, name, NULL);
+    return SDL_GetBooleanPropertyByAtom(props, SDL_FindPropertyAtom(name), default_value);
 }
 
-typedef struct EnumerateOnePropertyData
-{
-    SDL_EnumeratePropertiesCallback callback;
-    void *userdata;
-    SDL_PropertiesID props;
-} EnumerateOnePropertyData;
-
-
-static bool SDLCALL EnumerateOneProperty(void *userdata, const SDL_HashTable *table, const void *key, const void *value)
+bool SDL_ClearProperty(SDL_PropertiesID props, const char *name)
 {
-    (void) table;
-    (void) value;
-    const EnumerateOnePropertyData *data = (const EnumerateOnePropertyData *) userdata;
-    data->callback(data->userdata, data->props, (const char *)key);
-    return true;  // keep iterating.
+    return SDL_PrivateSetProperty(props, name, NULL);
 }
 
 bool SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCallback callback, void *userdata)
@@ -762,15 +902,16 @@ bool SDL_EnumerateProperties(SDL_PropertiesID props, SDL_EnumeratePropertiesCall
         return SDL_InvalidParamError("callback");
     }
 
-    SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties);
+    properties = SDL_GetProperties(props);
     if (!properties) {
         return SDL_InvalidParamError("props");
     }
 
     SDL_LockMutex(properties->lock);
     {
-        EnumerateOnePropertyData data = { callback, userdata, props };
-        SDL_IterateHashTable(properties->props, EnumerateOneProperty, &data);
+        for (int i = 0; i < properties->num_entries; ++i) {
+            callback(userdata, props, properties->entries[i].name);
+        }
     }
     SDL_UnlockMutex(properties->lock);
 
@@ -815,8 +956,8 @@ void SDL_DestroyProperties(SDL_PropertiesID props)
         // this can't just use RemoveFromHashTable with SDL_FreeProperties as the destructor, because
         //  other destructors under this might cause use to attempt a recursive lock on SDL_properties,
         //  which isn't allowed with rwlocks. So manually look it up and remove/free it.
-        SDL_Properties *properties = NULL;
-        if (SDL_FindInHashTable(SDL_properties, (const void *)(uintptr_t)props, (const void **)&properties)) {
+        SDL_Properties *properties = SDL_GetProperties(props);
+        if (properties) {
             SDL_FreeProperties(properties);
             SDL_RemoveFromHashTable(SDL_properties, (const void *)(uintptr_t)props);
         }
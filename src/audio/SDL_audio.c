@@ -626,7 +626,7 @@ static SDL_AudioDevice *CreatePhysicalAudioDevice(const char *name, bool recordi
         return NULL;
     }
 
-    device->lock = SDL_CreateMutex();
+    device->lock = SDL_CreateNamedMutex("SDL_AudioDevice.lock");
     if (!device->lock) {
         SDL_free(device->name);
         SDL_free(device);
@@ -922,7 +922,7 @@ bool SDL_InitAudio(const char *driver_name)
     SDL_ChooseAudioConverters();
     SDL_SetupAudioResampler();
 
-    SDL_RWLock *device_hash_lock = SDL_CreateRWLock();  // create this early, so if it fails we don't have to tear down the whole audio subsystem.
+    SDL_RWLock *device_hash_lock = SDL_CreateNamedRWLock("current_audio.device_hash_lock");  // create this early, so if it fails we don't have to tear down the whole audio subsystem.
     if (!device_hash_lock) {
         return false;
     }
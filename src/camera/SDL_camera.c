@@ -431,7 +431,7 @@ SDL_Camera *SDL_AddCamera(const char *name, SDL_CameraPosition position, int num
 
     device->position = position;
 
-    device->lock = SDL_CreateMutex();
+    device->lock = SDL_CreateNamedMutex("SDL_Camera.lock");
     if (!device->lock) {
         SDL_free(device->name);
         SDL_free(device);
@@ -1450,7 +1450,7 @@ bool SDL_CameraInit(const char *driver_name)
         SDL_QuitCamera(); // shutdown driver if already running.
     }
 
-    SDL_RWLock *device_hash_lock = SDL_CreateRWLock();  // create this early, so if it fails we don't have to tear down the whole camera subsystem.
+    SDL_RWLock *device_hash_lock = SDL_CreateNamedRWLock("camera_driver.device_hash_lock");  // create this early, so if it fails we don't have to tear down the whole camera subsystem.
     if (!device_hash_lock) {
         return false;
     }
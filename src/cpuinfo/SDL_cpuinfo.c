@@ -110,6 +110,8 @@
 #define CPU_HAS_ARM_SIMD (1 << 11)
 #define CPU_HAS_LSX      (1 << 12)
 #define CPU_HAS_LASX     (1 << 13)
+#define CPU_HAS_PCLMUL   (1 << 14)
+#define CPU_HAS_ARM_PMULL (1 << 15)
 
 #define CPU_CFG2      0x2
 #define CPU_CFG2_LSX  (1 << 6)
@@ -519,6 +521,33 @@ static int CPU_haveNEON(void)
 #endif
 }
 
+static int CPU_haveARMPMULL(void)
+{
+/* PMULL is part of the optional ARMv8 crypto extension. */
+#if defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES)
+    return 1; // the compiler was told it can always use it.
+#elif defined(SDL_PLATFORM_WINDOWS) && defined(_M_ARM64)
+#ifndef PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE
+#define PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE 30
+#endif
+    return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != 0;
+#elif !defined(__aarch64__)
+    return 0; // 32-bit ARM code can't use it, and it's not an ARM CPU otherwise.
+#elif defined(SDL_PLATFORM_APPLE)
+    return 1; // every 64-bit Apple chip has it.
+#elif defined(HAVE_ELF_AUX_INFO)
+    unsigned long hwcap = 0;
+    if (elf_aux_info(AT_HWCAP, (void *)&hwcap, (int)sizeof(hwcap)) != 0) {
+        return 0;
+    }
+    return (hwcap & (1 << 4)) != 0; // HWCAP_PMULL
+#elif (defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_ANDROID)) && defined(HAVE_GETAUXVAL)
+    return (getauxval(AT_HWCAP) & (1 << 4)) != 0; // HWCAP_PMULL
+#else
+    return 0;
+#endif
+}
+
 static int CPU_readCPUCFG(void)
 {
     uint32_t cfg2 = 0;
@@ -570,6 +599,11 @@ static int CPU_readCPUCFG(void)
 #else
 #define CPU_haveAVX() (0)
 #endif
+#ifdef __PCLMUL__
+#define CPU_havePCLMUL() (1)
+#else
+#define CPU_havePCLMUL() (0)
+#endif
 #else
 #define CPU_haveMMX()   (CPU_CPUIDFeatures[3] & 0x00800000)
 #define CPU_haveSSE()   (CPU_CPUIDFeatures[3] & 0x02000000)
@@ -578,6 +612,7 @@ static int CPU_readCPUCFG(void)
 #define CPU_haveSSE41() (CPU_CPUIDFeatures[2] & 0x00080000)
 #define CPU_haveSSE42() (CPU_CPUIDFeatures[2] & 0x00100000)
 #define CPU_haveAVX()   (CPU_OSSavesYMM && (CPU_CPUIDFeatures[2] & 0x10000000))
+#define CPU_havePCLMUL() (CPU_CPUIDFeatures[2] & 0x00000002)
 #endif
 
 #ifdef __e2k__
@@ -900,6 +935,54 @@ int SDL_GetCPUCacheLineSize(void)
     return cacheline_size;
 }
 
+size_t SDL_GetCPULastLevelCacheSize(void)
+{
+    size_t cache_size = 0;
+
+#if defined(HAVE_SYSCONF) && defined(_SC_LEVEL3_CACHE_SIZE) && defined(_SC_LEVEL2_CACHE_SIZE)
+    {
+        long size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+        if (size <= 0) {
+            size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        }
+        if (size > 0) {
+            cache_size = (size_t)size;
+        }
+    }
+#endif
+#if defined(SDL_PLATFORM_LINUX)
+    if (!cache_size) {
+        static const char *paths[] = {
+            "/sys/devices/system/cpu/cpu0/cache/index3/size",
+            "/sys/devices/system/cpu/cpu0/cache/index2/size"
+        };
+        int i;
+
+        for (i = 0; i < SDL_arraysize(paths) && !cache_size; ++i) {
+            FILE *f = fopen(paths[i], "r");
+            if (f) {
+                int size;
+                char unit = 0;
+                if (fscanf(f, "%d%c", &size, &unit) >= 1 && size > 0) {
+                    cache_size = (size_t)size;
+                    if (unit == 'K') {
+                        cache_size *= 1024;
+                    } else if (unit == 'M') {
+                        cache_size *= 1024 * 1024;
+                    }
+                }
+                fclose(f);
+            }
+        }
+    }
+#endif
+    if (!cache_size) {
+        // A reasonable guess for a desktop CPU
+        cache_size = 8 * 1024 * 1024;
+    }
+    return cache_size;
+}
+
 #define SDL_CPUFEATURES_RESET_VALUE 0xFFFFFFFF
 
 static Uint32 SDL_CPUFeatures = SDL_CPUFEATURES_RESET_VALUE;
@@ -965,6 +1048,10 @@ static Uint32 SDLCALL SDL_CPUFeatureMaskFromHint(void)
                 spot_mask = CPU_HAS_LSX;
             } else if (ref_string_equals("lasx", spot, end)) {
                 spot_mask = CPU_HAS_LASX;
+            } else if (ref_string_equals("pclmul", spot, end)) {
+                spot_mask = CPU_HAS_PCLMUL;
+            } else if (ref_string_equals("pmull", spot, end)) {
+                spot_mask = CPU_HAS_ARM_PMULL;
             } else {
                 // Ignore unknown/incorrect cpu feature(s)
                 continue;
@@ -1041,6 +1128,12 @@ static Uint32 SDL_GetCPUFeatures(void)
             SDL_CPUFeatures |= CPU_HAS_LASX;
             SDL_SIMDAlignment = SDL_max(SDL_SIMDAlignment, 32);
         }
+        if (CPU_havePCLMUL()) {
+            SDL_CPUFeatures |= CPU_HAS_PCLMUL;
+        }
+        if (CPU_haveARMPMULL()) {
+            SDL_CPUFeatures |= CPU_HAS_ARM_PMULL;
+        }
         SDL_CPUFeatures &= SDL_CPUFeatureMaskFromHint();
     }
     return SDL_CPUFeatures;
@@ -1122,6 +1215,16 @@ bool SDL_HasLASX(void)
     return CPU_FEATURE_AVAILABLE(CPU_HAS_LASX);
 }
 
+bool SDL_HasPCLMUL(void)
+{
+    return CPU_FEATURE_AVAILABLE(CPU_HAS_PCLMUL);
+}
+
+bool SDL_HasARMPMULL(void)
+{
+    return CPU_FEATURE_AVAILABLE(CPU_HAS_ARM_PMULL);
+}
+
 static int SDL_SystemRAM = 0;
 
 int SDL_GetSystemRAM(void)
@@ -24,4 +24,11 @@
 
 extern void SDL_QuitCPUInfo(void);
 
+// Features that only SDL itself dispatches on, so they aren't in the public API.
+extern bool SDL_HasPCLMUL(void);
+extern bool SDL_HasARMPMULL(void);
+
+// Returns the size in bytes of the largest CPU cache, or a guess if it can't be found.
+extern size_t SDL_GetCPULastLevelCacheSize(void);
+
 #endif // SDL_cpuinfo_c_h_
@@ -1278,3 +1278,40 @@
 #define SDL_PutAudioStreamPlanarData SDL_PutAudioStreamPlanarData_REAL
 #define SDL_SetAudioIterationCallbacks SDL_SetAudioIterationCallbacks_REAL
 #define SDL_GetEventDescription SDL_GetEventDescription_REAL
+#define SDL_SetMemoryThreadCache SDL_SetMemoryThreadCache_REAL
+#define SDL_GetMotionHistory SDL_GetMotionHistory_REAL
+#define SDL_PushEvents SDL_PushEvents_REAL
+#define SDL_GetTimerStats SDL_GetTimerStats_REAL
+#define SDL_GetDelayStats SDL_GetDelayStats_REAL
+#define SDL_ResetDelayStats SDL_ResetDelayStats_REAL
+#define SDL_GetPropertyAtom SDL_GetPropertyAtom_REAL
+#define SDL_GetPointerPropertyByAtom SDL_GetPointerPropertyByAtom_REAL
+#define SDL_GetStringPropertyByAtom SDL_GetStringPropertyByAtom_REAL
+#define SDL_GetNumberPropertyByAtom SDL_GetNumberPropertyByAtom_REAL
+#define SDL_GetFloatPropertyByAtom SDL_GetFloatPropertyByAtom_REAL
+#define SDL_GetBooleanPropertyByAtom SDL_GetBooleanPropertyByAtom_REAL
+#define SDL_FlushLogs SDL_FlushLogs_REAL
+#define SDL_SortKeys32 SDL_SortKeys32_REAL
+#define SDL_SortKeys64 SDL_SortKeys64_REAL
+#define SDL_ParallelSort SDL_ParallelSort_REAL
+#define SDL_InitRandomStream SDL_InitRandomStream_REAL
+#define SDL_RandFillBits SDL_RandFillBits_REAL
+#define SDL_RandFillFloats SDL_RandFillFloats_REAL
+#define SDL_RandFillInts SDL_RandFillInts_REAL
+#define SDL_CreateJobSystem SDL_CreateJobSystem_REAL
+#define SDL_GetJobSystemThreadCount SDL_GetJobSystemThreadCount_REAL
+#define SDL_DestroyJobSystem SDL_DestroyJobSystem_REAL
+#define SDL_SubmitJob SDL_SubmitJob_REAL
+#define SDL_WaitJob SDL_WaitJob_REAL
+#define SDL_ReleaseJob SDL_ReleaseJob_REAL
+#define SDL_WaitAtomicInt SDL_WaitAtomicInt_REAL
+#define SDL_WaitAtomicIntTimeout SDL_WaitAtomicIntTimeout_REAL
+#define SDL_NotifyAtomicIntOne SDL_NotifyAtomicIntOne_REAL
+#define SDL_NotifyAtomicIntAll SDL_NotifyAtomicIntAll_REAL
+#define SDL_CreateMutexWithProperties SDL_CreateMutexWithProperties_REAL
+#define SDL_CreateRWLockWithProperties SDL_CreateRWLockWithProperties_REAL
+#define SDL_DumpLockProfile SDL_DumpLockProfile_REAL
+#define SDL_ResetLockProfile SDL_ResetLockProfile_REAL
+#define SDL_IOFromBufferedIO SDL_IOFromBufferedIO_REAL
+#define SDL_MapFile SDL_MapFile_REAL
+#define SDL_UnmapFile SDL_UnmapFile_REAL
@@ -1286,3 +1286,40 @@ SDL_DYNAPI_PROC(SDL_Renderer*,SDL_CreateGPURenderer,(SDL_Window *a,SDL_GPUShader
 SDL_DYNAPI_PROC(bool,SDL_PutAudioStreamPlanarData,(SDL_AudioStream *a,const void * const*b,int c,int d),(a,b,c,d),return)
 SDL_DYNAPI_PROC(bool,SDL_SetAudioIterationCallbacks,(SDL_AudioDeviceID a,SDL_AudioIterationCallback b,SDL_AudioIterationCallback c,void *d),(a,b,c,d),return)
 SDL_DYNAPI_PROC(int,SDL_GetEventDescription,(const SDL_Event *a,char *b,int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_SetMemoryThreadCache,(bool a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetMotionHistory,(SDL_EventType a,Uint64 b,SDL_Event *c,int d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(int,SDL_PushEvents,(const SDL_Event *a,int b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetTimerStats,(SDL_TimerID a, SDL_TimerStats *b),(a,b),return)
+SDL_DYNAPI_PROC(bool,SDL_GetDelayStats,(SDL_DelayStats *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ResetDelayStats,(void),(),)
+SDL_DYNAPI_PROC(SDL_PropertyAtom,SDL_GetPropertyAtom,(const char *a),(a),return)
+SDL_DYNAPI_PROC(void*,SDL_GetPointerPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, void *c),(a,b,c),return)
+SDL_DYNAPI_PROC(const char*,SDL_GetStringPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, const char *c),(a,b,c),return)
+SDL_DYNAPI_PROC(Sint64,SDL_GetNumberPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, Sint64 c),(a,b,c),return)
+SDL_DYNAPI_PROC(float,SDL_GetFloatPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, float c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_GetBooleanPropertyByAtom,(SDL_PropertiesID a, SDL_PropertyAtom b, bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_FlushLogs,(void),(),)
+SDL_DYNAPI_PROC(bool,SDL_SortKeys32,(void *a, size_t b, size_t c, size_t d, SDL_SortKeyType e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_SortKeys64,(void *a, size_t b, size_t c, size_t d, SDL_SortKeyType e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(void,SDL_ParallelSort,(void *a, size_t b, size_t c, SDL_CompareCallback_r d, void *e),(a,b,c,d,e),)
+SDL_DYNAPI_PROC(void,SDL_InitRandomStream,(SDL_RandomStream *a, Uint64 b),(a,b),)
+SDL_DYNAPI_PROC(bool,SDL_RandFillBits,(SDL_RandomStream *a, Uint32 *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_RandFillFloats,(SDL_RandomStream *a, float *b, int c),(a,b,c),return)
+SDL_DYNAPI_PROC(bool,SDL_RandFillInts,(SDL_RandomStream *a, Sint32 *b, int c, Sint32 d),(a,b,c,d),return)
+SDL_DYNAPI_PROC(SDL_JobSystem*,SDL_CreateJobSystem,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(int,SDL_GetJobSystemThreadCount,(SDL_JobSystem *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_DestroyJobSystem,(SDL_JobSystem *a),(a),)
+SDL_DYNAPI_PROC(SDL_Job*,SDL_SubmitJob,(SDL_JobSystem *a, SDL_JobFunction b, void *c, SDL_Job * const *d, int e),(a,b,c,d,e),return)
+SDL_DYNAPI_PROC(bool,SDL_WaitJob,(SDL_Job *a),(a),return)
+SDL_DYNAPI_PROC(void,SDL_ReleaseJob,(SDL_Job *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_WaitAtomicInt,(SDL_AtomicInt *a, int b),(a,b),)
+SDL_DYNAPI_PROC(bool,SDL_WaitAtomicIntTimeout,(SDL_AtomicInt *a, int b, Sint32 c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_NotifyAtomicIntOne,(SDL_AtomicInt *a),(a),)
+SDL_DYNAPI_PROC(void,SDL_NotifyAtomicIntAll,(SDL_AtomicInt *a),(a),)
+SDL_DYNAPI_PROC(SDL_Mutex*,SDL_CreateMutexWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(SDL_RWLock*,SDL_CreateRWLockWithProperties,(SDL_PropertiesID a),(a),return)
+SDL_DYNAPI_PROC(bool,SDL_DumpLockProfile,(void),(),return)
+SDL_DYNAPI_PROC(void,SDL_ResetLockProfile,(void),(),)
+SDL_DYNAPI_PROC(SDL_IOStream*,SDL_IOFromBufferedIO,(SDL_IOStream *a, size_t b, bool c),(a,b,c),return)
+SDL_DYNAPI_PROC(const void*,SDL_MapFile,(const char *a, SDL_MapFileFlags b, size_t *c),(a,b,c),return)
+SDL_DYNAPI_PROC(void,SDL_UnmapFile,(const void *a, size_t b),(a,b),)
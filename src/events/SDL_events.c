@@ -29,6 +29,7 @@
 #include "../audio/SDL_audio_c.h"
 #include "../camera/SDL_camera_c.h"
 #include "../timer/SDL_timer_c.h"
+#include "../thread/SDL_thread_c.h"
 #ifndef SDL_JOYSTICK_DISABLED
 #include "../joystick/SDL_joystick_c.h"
 #endif
@@ -112,17 +113,42 @@ typedef struct
 static SDL_DisabledEventBlock *SDL_disabled_events[256];
 static SDL_AtomicInt SDL_userevents;
 
-typedef struct SDL_TemporaryMemory
+/* Temporary memory is carved out of per-thread chunks. An allocation is
+   owned by the thread that made it until it's linked to an event, then by
+   the event, and once the event is cut from the queue, by the thread that
+   cut it, until that thread frees its temporary memory. A chunk is freed
+   when all of its allocations have been released, and a thread starts its
+   current chunk over when it gets all of them back.
+ */
+#define SDL_TEMPORARY_MEMORY_CHUNK_SIZE     4096
+#define SDL_TEMPORARY_MEMORY_MAX_CHUNK_SIZE (64 * 1024)
+#define SDL_TEMPORARY_MEMORY_ALIGN(x) (((x) + 15) & ~(size_t)15)
+
+typedef struct SDL_TemporaryMemoryChunk
+{
+    SDL_AtomicInt refcount; // live allocations, plus one while the thread keeps the chunk
+    int thread_allocations; // allocations still owned by the thread
+    size_t size;
+    size_t used;
+    struct SDL_TemporaryMemoryChunk *next;
+} SDL_TemporaryMemoryChunk;
+
+typedef struct SDL_TemporaryMemoryHeader
 {
-    void *memory;
-    struct SDL_TemporaryMemory *prev;
-    struct SDL_TemporaryMemory *next;
-} SDL_TemporaryMemory;
+    SDL_TemporaryMemoryChunk *chunk;
+    Uint32 size;
+    bool thread_owned;
+} SDL_TemporaryMemoryHeader;
+
+#define SDL_TEMPORARY_MEMORY_CHUNK_HEADER_SIZE SDL_TEMPORARY_MEMORY_ALIGN(sizeof(SDL_TemporaryMemoryChunk))
+#define SDL_TEMPORARY_MEMORY_HEADER_SIZE       SDL_TEMPORARY_MEMORY_ALIGN(sizeof(SDL_TemporaryMemoryHeader))
 
 typedef struct SDL_TemporaryMemoryState
 {
-    SDL_TemporaryMemory *head;
-    SDL_TemporaryMemory *tail;
+    SDL_TemporaryMemoryChunk *chunks; // chunks this thread allocated from, the first one is current
+    void **adopted;                   // memory from events cut from the queue on this thread
+    int num_adopted;
+    int max_adopted;
 } SDL_TemporaryMemoryState;
 
 static SDL_TLSID SDL_temporary_memory;
@@ -130,28 +156,108 @@ static SDL_TLSID SDL_temporary_memory;
 typedef struct SDL_EventEntry
 {
     SDL_Event event;
-    SDL_TemporaryMemory *memory;
+    void *memory[2]; // temporary memory owned by the event
+    Uint64 sequence; // position in the queue, used to merge the category lists in order
+    int category;
     struct SDL_EventEntry *prev;
     struct SDL_EventEntry *next;
+    struct SDL_EventEntry *category_prev;
+    struct SDL_EventEntry *category_next;
 } SDL_EventEntry;
 
+/* Besides the queue itself, events are linked into one list per category,
+   the high byte of the event type, with one more for types past
+   SDL_EVENT_LAST. Queries for a range of event types only look at the
+   categories that overlap the range, merging them in queue order.
+ */
+#define SDL_EVENT_CATEGORY_OTHER 256
+#define SDL_EVENT_CATEGORY_COUNT (SDL_EVENT_CATEGORY_OTHER + 1)
+
+typedef struct SDL_EventCategory
+{
+    SDL_EventEntry *head;
+    SDL_EventEntry *tail;
+    int count;
+} SDL_EventCategory;
+
+/* SDL_PushEvent() doesn't take the queue lock, it claims a cell in a bounded
+   multi-producer ring instead, and the events are moved into the queue in
+   order the next time the queue is locked. If the ring is full, events are
+   added to the queue under the lock as usual.
+
+   Producers count themselves in ring_users while they use the ring, so that
+   SDL_StopEventLoop() can close it and wait for them before freeing it.
+ */
+#define SDL_EVENT_RING_SIZE 4096 // must be a power of two
+
+typedef struct SDL_EventRingCell
+{
+    SDL_AtomicInt sequence;
+    SDL_EventEntry entry;
+} SDL_EventRingCell;
+
+/* With SDL_HINT_EVENT_COALESCE_MOTION, the last raw motion events of each
+   device are kept here, for SDL_GetMotionHistory().
+ */
+#define SDL_MOTION_HISTORY_SIZE 128
+
+typedef struct SDL_MotionHistory
+{
+    Uint32 type;
+    Uint64 which;
+    int first;
+    int count;
+    SDL_Event events[SDL_MOTION_HISTORY_SIZE];
+} SDL_MotionHistory;
+
+static bool SDL_coalesce_motion = false;
+
 static struct
 {
     SDL_Mutex *lock;
     bool active;
-    SDL_AtomicInt count;
+    SDL_AtomicInt count; // includes events waiting in the ring
     int max_events_seen;
     SDL_EventEntry *head;
     SDL_EventEntry *tail;
     SDL_EventEntry *free;
-} SDL_EventQ = { NULL, false, { 0 }, 0, NULL, NULL, NULL };
+    SDL_EventRingCell *ring;
+    SDL_AtomicInt ring_open;  // whether producers may start using the ring
+    SDL_AtomicInt ring_users; // producers using the ring right now
+    SDL_AtomicInt ring_head; // next cell for producers to claim
+    Uint32 ring_tail;        // next cell to move into the queue, protected by the lock
+    Uint64 sequence;
+    Uint32 categories_used[(SDL_EVENT_CATEGORY_COUNT + 31) / 32];
+    SDL_EventCategory categories[SDL_EVENT_CATEGORY_COUNT];
+    SDL_MotionHistory **motion_history;
+    int num_motion_history;
+} SDL_EventQ;
 
 
+static void SDL_ReleaseTemporaryMemoryChunk(SDL_TemporaryMemoryChunk *chunk, int count)
+{
+    if (SDL_AddAtomicInt(&chunk->refcount, -count) == count) {
+        SDL_free(chunk);
+    }
+}
+
+static SDL_TemporaryMemoryHeader *SDL_GetTemporaryMemoryHeader(const void *mem)
+{
+    return (SDL_TemporaryMemoryHeader *)((Uint8 *)mem - SDL_TEMPORARY_MEMORY_HEADER_SIZE);
+}
+
 static void SDL_CleanupTemporaryMemory(void *data)
 {
     SDL_TemporaryMemoryState *state = (SDL_TemporaryMemoryState *)data;
 
     SDL_FreeTemporaryMemory();
+
+    while (state->chunks) {
+        SDL_TemporaryMemoryChunk *chunk = state->chunks;
+        state->chunks = chunk->next;
+        SDL_ReleaseTemporaryMemoryChunk(chunk, 1);
+    }
+    SDL_free(state->adopted);
     SDL_free(state);
 }
 
@@ -178,75 +284,80 @@ static SDL_TemporaryMemoryState *SDL_GetTemporaryMemoryState(bool create)
     return state;
 }
 
-static SDL_TemporaryMemory *SDL_GetTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, const void *mem)
+// Take temporary memory away from the thread, returns false if the thread doesn't own it
+static bool SDL_DetachTemporaryMemory(SDL_TemporaryMemoryState *state, const void *mem)
 {
-    SDL_TemporaryMemory *entry;
+    SDL_TemporaryMemoryChunk *chunk;
+    int i;
 
-    // Start from the end, it's likely to have been recently allocated
-    for (entry = state->tail; entry; entry = entry->prev) {
-        if (mem == entry->memory) {
-            return entry;
+    for (chunk = state->chunks; chunk; chunk = chunk->next) {
+        const Uint8 *data = (const Uint8 *)chunk + SDL_TEMPORARY_MEMORY_CHUNK_HEADER_SIZE;
+        if ((const Uint8 *)mem >= data && (const Uint8 *)mem < data + chunk->used) {
+            SDL_TemporaryMemoryHeader *header = SDL_GetTemporaryMemoryHeader(mem);
+            if (header->chunk == chunk && header->thread_owned) {
+                header->thread_owned = false;
+                --chunk->thread_allocations;
+                return true;
+            }
+            break;
         }
     }
-    return NULL;
-}
-
-static void SDL_LinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry)
-{
-    entry->prev = state->tail;
-    entry->next = NULL;
 
-    if (state->tail) {
-        state->tail->next = entry;
-    } else {
-        state->head = entry;
+    // Start from the end, it's likely to have been recently adopted
+    for (i = state->num_adopted; i--; ) {
+        if (state->adopted[i] == mem) {
+            state->adopted[i] = state->adopted[--state->num_adopted];
+            return true;
+        }
     }
-    state->tail = entry;
+    return false;
 }
 
-static void SDL_UnlinkTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry)
+// Hand temporary memory to the thread, to be released the next time it frees its temporary memory
+static void SDL_AdoptTemporaryMemory(void *mem)
 {
-    if (state->head == entry) {
-        state->head = entry->next;
-    }
-    if (state->tail == entry) {
-        state->tail = entry->prev;
-    }
+    SDL_TemporaryMemoryState *state;
 
-    if (entry->prev) {
-        entry->prev->next = entry->next;
-    }
-    if (entry->next) {
-        entry->next->prev = entry->prev;
+    state = SDL_GetTemporaryMemoryState(true);
+    if (!state) {
+        return;  // this is now a leak, but you probably have bigger problems if malloc failed.
     }
 
-    entry->prev = NULL;
-    entry->next = NULL;
-}
-
-static void SDL_FreeTemporaryMemoryEntry(SDL_TemporaryMemoryState *state, SDL_TemporaryMemory *entry, bool free_data)
-{
-    if (free_data) {
-        SDL_free(entry->memory);
+    if (state->num_adopted == state->max_adopted) {
+        const int max_adopted = state->max_adopted ? (state->max_adopted * 2) : 16;
+        void **adopted = (void **)SDL_realloc(state->adopted, max_adopted * sizeof(*adopted));
+        if (!adopted) {
+            return;  // this is now a leak, but you probably have bigger problems if malloc failed.
+        }
+        state->adopted = adopted;
+        state->max_adopted = max_adopted;
     }
-    SDL_free(entry);
+    state->adopted[state->num_adopted++] = mem;
 }
 
 static void SDL_LinkTemporaryMemoryToEvent(SDL_EventEntry *event, const void *mem)
 {
     SDL_TemporaryMemoryState *state;
-    SDL_TemporaryMemory *entry;
+    int i;
+
+    if (!mem) {
+        return;
+    }
 
     state = SDL_GetTemporaryMemoryState(false);
     if (!state) {
         return;
     }
 
-    entry = SDL_GetTemporaryMemoryEntry(state, mem);
-    if (entry) {
-        SDL_UnlinkTemporaryMemoryEntry(state, entry);
-        entry->next = event->memory;
-        event->memory = entry;
+    if (SDL_DetachTemporaryMemory(state, mem)) {
+        for (i = 0; i < SDL_arraysize(event->memory); ++i) {
+            if (!event->memory[i]) {
+                event->memory[i] = (void *)mem;
+                return;
+            }
+        }
+        SDL_assert(!"Not enough room for temporary memory in the event");
+        SDL_AdoptTemporaryMemory((void *)mem);
     }
 }
 
@@ -261,7 +372,7 @@ static void SDL_TransferSysWMMemoryToEvent(SDL_EventEntry *event)
     }
 }
 
-// Transfer the event memory from the thread-local event memory list to the event
+// Transfer the event memory from the thread-local event memory to the event
 static void SDL_TransferTemporaryMemoryToEvent(SDL_EventEntry *event)
 {
     switch (event->event.type) {
@@ -294,65 +405,82 @@ static void SDL_TransferTemporaryMemoryToEvent(SDL_EventEntry *event)
     }
 }
 
-// Transfer the event memory from the event to the thread-local event memory list
+// Transfer the event memory from the event to the thread-local event memory
 static void SDL_TransferTemporaryMemoryFromEvent(SDL_EventEntry *event)
 {
-    SDL_TemporaryMemoryState *state;
-    SDL_TemporaryMemory *entry, *next;
-
-    if (!event->memory) {
-        return;
-    }
-
-    state = SDL_GetTemporaryMemoryState(true);
-    if (!state) {
-        return;  // this is now a leak, but you probably have bigger problems if malloc failed.
-    }
+    int i;
 
-    for (entry = event->memory; entry; entry = next) {
-        next = entry->next;
-        SDL_LinkTemporaryMemoryEntry(state, entry);
+    for (i = 0; i < SDL_arraysize(event->memory); ++i) {
+        if (event->memory[i]) {
+            SDL_AdoptTemporaryMemory(event->memory[i]);
+            event->memory[i] = NULL;
+        }
     }
-    event->memory = NULL;
 }
 
-static void *SDL_FreeLater(void *memory)
+void *SDL_AllocateTemporaryMemory(size_t size)
 {
     SDL_TemporaryMemoryState *state;
+    SDL_TemporaryMemoryChunk *chunk;
+    SDL_TemporaryMemoryHeader *header;
+    size_t total;
 
-    if (memory == NULL) {
+    if (size > SDL_MAX_SINT32) {
+        SDL_OutOfMemory();
         return NULL;
     }
 
-    // Make sure we're not adding this to the list twice
-    //SDL_assert(!SDL_ClaimTemporaryMemory(memory));
-
     state = SDL_GetTemporaryMemoryState(true);
     if (!state) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed.
-    }
-
-    SDL_TemporaryMemory *entry = (SDL_TemporaryMemory *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        return memory;  // this is now a leak, but you probably have bigger problems if malloc failed. We could probably pool up and reuse entries, though.
+        return NULL;
     }
 
-    entry->memory = memory;
+    total = SDL_TEMPORARY_MEMORY_HEADER_SIZE + SDL_TEMPORARY_MEMORY_ALIGN(SDL_max(size, 1));
+    chunk = state->chunks;
+    if (!chunk || (chunk->size - chunk->used) < total) {
+        // Grow the chunks until a whole frame's worth of memory fits in one
+        size_t chunk_size = chunk ? SDL_min(chunk->size * 2, SDL_TEMPORARY_MEMORY_MAX_CHUNK_SIZE) : SDL_TEMPORARY_MEMORY_CHUNK_SIZE;
+        chunk_size = SDL_max(chunk_size, total);
 
-    SDL_LinkTemporaryMemoryEntry(state, entry);
+        chunk = (SDL_TemporaryMemoryChunk *)SDL_malloc(SDL_TEMPORARY_MEMORY_CHUNK_HEADER_SIZE + chunk_size);
+        if (!chunk) {
+            return NULL;
+        }
+        SDL_SetAtomicInt(&chunk->refcount, 1);
+        chunk->thread_allocations = 0;
+        chunk->size = chunk_size;
+        chunk->used = 0;
+
+        // The previous chunk can be let go if none of its memory is ours anymore
+        if (state->chunks && state->chunks->thread_allocations == 0) {
+            SDL_TemporaryMemoryChunk *previous = state->chunks;
+            state->chunks = previous->next;
+            SDL_ReleaseTemporaryMemoryChunk(previous, 1);
+        }
+        chunk->next = state->chunks;
+        state->chunks = chunk;
+    }
 
-    return memory;
-}
+    header = (SDL_TemporaryMemoryHeader *)((Uint8 *)chunk + SDL_TEMPORARY_MEMORY_CHUNK_HEADER_SIZE + chunk->used);
+    header->chunk = chunk;
+    header->size = (Uint32)size;
+    header->thread_owned = true;
+    chunk->used += total;
+    ++chunk->thread_allocations;
+    SDL_AddAtomicInt(&chunk->refcount, 1);
 
-void *SDL_AllocateTemporaryMemory(size_t size)
-{
-    return SDL_FreeLater(SDL_malloc(size));
+    return (Uint8 *)header + SDL_TEMPORARY_MEMORY_HEADER_SIZE;
 }
 
 const char *SDL_CreateTemporaryString(const char *string)
 {
     if (string) {
-        return (const char *)SDL_FreeLater(SDL_strdup(string));
+        const size_t len = SDL_strlen(string) + 1;
+        char *copy = (char *)SDL_AllocateTemporaryMemory(len);
+        if (copy) {
+            SDL_memcpy(copy, string, len);
+        }
+        return copy;
     }
     return NULL;
 }
@@ -362,13 +490,18 @@ void *SDL_ClaimTemporaryMemory(const void *mem)
     SDL_TemporaryMemoryState *state;
 
     state = SDL_GetTemporaryMemoryState(false);
-    if (state && mem) {
-        SDL_TemporaryMemory *entry = SDL_GetTemporaryMemoryEntry(state, mem);
-        if (entry) {
-            SDL_UnlinkTemporaryMemoryEntry(state, entry);
-            SDL_FreeTemporaryMemoryEntry(state, entry, false);
-            return (void *)mem;
+    if (state && mem && SDL_DetachTemporaryMemory(state, mem)) {
+        // Chunk memory can't be passed to SDL_free(), so the caller gets a copy and the original is released
+        SDL_TemporaryMemoryHeader *header = SDL_GetTemporaryMemoryHeader(mem);
+        void *copy = SDL_malloc(SDL_max(header->size, 1));
+        if (copy) {
+            SDL_memcpy(copy, mem, header->size);
+            SDL_ReleaseTemporaryMemoryChunk(header->chunk, 1);
+        } else {
+            // Give it back, it stays valid until the thread frees its temporary memory
+            SDL_AdoptTemporaryMemory((void *)mem);
         }
+        return copy;
     }
     return NULL;
 }
@@ -376,17 +509,38 @@ void *SDL_ClaimTemporaryMemory(const void *mem)
 void SDL_FreeTemporaryMemory(void)
 {
     SDL_TemporaryMemoryState *state;
+    SDL_TemporaryMemoryChunk *chunk, *next, **prev;
+    int i;
 
     state = SDL_GetTemporaryMemoryState(false);
     if (!state) {
         return;
     }
 
-    while (state->head) {
-        SDL_TemporaryMemory *entry = state->head;
+    for (i = 0; i < state->num_adopted; ++i) {
+        SDL_ReleaseTemporaryMemoryChunk(SDL_GetTemporaryMemoryHeader(state->adopted[i])->chunk, 1);
+    }
+    state->num_adopted = 0;
+
+    prev = &state->chunks;
+    for (chunk = state->chunks; chunk; chunk = next) {
+        next = chunk->next;
 
-        SDL_UnlinkTemporaryMemoryEntry(state, entry);
-        SDL_FreeTemporaryMemoryEntry(state, entry, true);
+        if (chunk->thread_allocations > 0) {
+            SDL_ReleaseTemporaryMemoryChunk(chunk, chunk->thread_allocations);
+            chunk->thread_allocations = 0;
+        }
+
+        if (chunk == state->chunks) {
+            // Keep the current chunk, and start it over if nobody else is using it
+            if (SDL_GetAtomicInt(&chunk->refcount) == 1) {
+                chunk->used = 0;
+            }
+            prev = &chunk->next;
+        } else {
+            *prev = next;
+            SDL_ReleaseTemporaryMemoryChunk(chunk, 1);
+        }
     }
 }
 
@@ -412,6 +566,11 @@ static void SDLCALL SDL_AutoUpdateSensorsChanged(void *userdata, const char *nam
 
 #endif // !SDL_SENSOR_DISABLED
 
+static void SDLCALL SDL_CoalesceMotionChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
+{
+    SDL_coalesce_motion = SDL_GetStringBoolean(hint, false);
+}
+
 static void SDLCALL SDL_PollSentinelChanged(void *userdata, const char *name, const char *oldValue, const char *hint)
 {
     SDL_SetEventEnabled(SDL_EVENT_POLL_SENTINEL, SDL_GetStringBoolean(hint, true));
@@ -909,6 +1068,470 @@ static void SDL_LogEvent(const SDL_Event *event)
     }
 }
 
+// Count an event against the queue limit, before it's added to the queue or the ring
+static bool SDL_ReserveEvent(void)
+{
+    const int count = SDL_AddAtomicInt(&SDL_EventQ.count, 1);
+
+    if (count >= SDL_MAX_QUEUED_EVENTS) {
+        SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        SDL_SetError("Event queue is full (%d events)", count);
+        return false;
+    }
+    return true;
+}
+
+// Fill in a new entry, this runs on the thread adding the event because temporary memory is per-thread
+static void SDL_InitEventEntry(SDL_EventEntry *entry, const SDL_Event *event)
+{
+    SDL_copyp(&entry->event, event);
+    if (event->type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    }
+    SDL_zeroa(entry->memory);
+    SDL_TransferTemporaryMemoryToEvent(entry);
+}
+
+static int SDL_GetEventCategory(Uint32 type)
+{
+    if (type > SDL_EVENT_LAST) {
+        return SDL_EVENT_CATEGORY_OTHER;
+    }
+    return (int)(type >> 8);
+}
+
+// Returns true if every event type in the category is within the range
+static bool SDL_EventCategoryInRange(int category, Uint32 minType, Uint32 maxType)
+{
+    Uint32 first, last;
+
+    if (category == SDL_EVENT_CATEGORY_OTHER) {
+        first = SDL_EVENT_LAST + 1;
+        last = 0xFFFFFFFF;
+    } else {
+        first = ((Uint32)category << 8);
+        last = first | 0xFF;
+    }
+    return minType <= first && last <= maxType;
+}
+
+// Returns the first category from `category` on that has events queued, or -1 if there are none -- called with the queue locked
+static int SDL_NextEventCategory(int category)
+{
+    while (category < SDL_EVENT_CATEGORY_COUNT) {
+        Uint32 bits = SDL_EventQ.categories_used[category / 32] >> (category % 32);
+        if (bits) {
+            while (!(bits & 1)) {
+                bits >>= 1;
+                ++category;
+            }
+            return category;
+        }
+        category = (category | 31) + 1;
+    }
+    return -1;
+}
+
+// Returns the first event from `entry` on in the category list with a type in the range
+static SDL_EventEntry *SDL_FindEventInCategory(SDL_EventEntry *entry, Uint32 minType, Uint32 maxType)
+{
+    while (entry && (entry->event.type < minType || entry->event.type > maxType)) {
+        entry = entry->category_next;
+    }
+    return entry;
+}
+
+static void SDL_LinkEventCategory(SDL_EventEntry *entry)
+{
+    const int category = SDL_GetEventCategory(entry->event.type);
+    SDL_EventCategory *list = &SDL_EventQ.categories[category];
+
+    entry->category = category;
+    entry->category_prev = list->tail;
+    entry->category_next = NULL;
+    if (list->tail) {
+        list->tail->category_next = entry;
+    } else {
+        list->head = entry;
+        SDL_EventQ.categories_used[category / 32] |= (1u << (category % 32));
+    }
+    list->tail = entry;
+    ++list->count;
+}
+
+static void SDL_UnlinkEventCategory(SDL_EventEntry *entry)
+{
+    const int category = entry->category;
+    SDL_EventCategory *list = &SDL_EventQ.categories[category];
+
+    if (entry->category_prev) {
+        entry->category_prev->category_next = entry->category_next;
+    } else {
+        list->head = entry->category_next;
+    }
+    if (entry->category_next) {
+        entry->category_next->category_prev = entry->category_prev;
+    } else {
+        list->tail = entry->category_prev;
+    }
+
+    SDL_assert(list->count > 0);
+    if (--list->count == 0) {
+        SDL_EventQ.categories_used[category / 32] &= ~(1u << (category % 32));
+    }
+}
+
+// Append an entry to the event queue -- called with the queue locked
+static void SDL_LinkEvent(SDL_EventEntry *entry)
+{
+    const int count = SDL_GetAtomicInt(&SDL_EventQ.count);
+
+    if (SDL_EventQ.tail) {
+        SDL_EventQ.tail->next = entry;
+        entry->prev = SDL_EventQ.tail;
+        SDL_EventQ.tail = entry;
+        entry->next = NULL;
+    } else {
+        SDL_assert(!SDL_EventQ.head);
+        SDL_EventQ.head = entry;
+        SDL_EventQ.tail = entry;
+        entry->prev = NULL;
+        entry->next = NULL;
+    }
+
+    entry->sequence = SDL_EventQ.sequence++;
+    SDL_LinkEventCategory(entry);
+
+    if (count > SDL_EventQ.max_events_seen) {
+        SDL_EventQ.max_events_seen = count;
+    }
+
+    ++SDL_last_event_id;
+}
+
+// Get an unused entry -- called with the queue locked
+static SDL_EventEntry *SDL_AllocEventEntry(void)
+{
+    SDL_EventEntry *entry;
+
+    if (SDL_EventQ.free == NULL) {
+        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
+    } else {
+        entry = SDL_EventQ.free;
+        SDL_EventQ.free = entry->next;
+    }
+    return entry;
+}
+
+// Returns true if the event is a motion event, and which device it came from
+static bool SDL_GetMotionDevice(const SDL_Event *event, Uint64 *which)
+{
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        *which = event->motion.which;
+        return true;
+    case SDL_EVENT_PEN_MOTION:
+        *which = event->pmotion.which;
+        return true;
+    case SDL_EVENT_FINGER_MOTION:
+        *which = event->tfinger.touchID;
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Get the motion history for a device -- called with the queue locked
+static SDL_MotionHistory *SDL_GetMotionHistoryForDevice(Uint32 type, Uint64 which, bool create)
+{
+    SDL_MotionHistory *history, **histories;
+    int i;
+
+    for (i = 0; i < SDL_EventQ.num_motion_history; ++i) {
+        history = SDL_EventQ.motion_history[i];
+        if (history->type == type && history->which == which) {
+            return history;
+        }
+    }
+    if (!create) {
+        return NULL;
+    }
+
+    history = (SDL_MotionHistory *)SDL_malloc(sizeof(*history));
+    if (!history) {
+        return NULL;
+    }
+    histories = (SDL_MotionHistory **)SDL_realloc(SDL_EventQ.motion_history, (SDL_EventQ.num_motion_history + 1) * sizeof(*histories));
+    if (!histories) {
+        SDL_free(history);
+        return NULL;
+    }
+    history->type = type;
+    history->which = which;
+    history->first = 0;
+    history->count = 0;
+    histories[SDL_EventQ.num_motion_history++] = history;
+    SDL_EventQ.motion_history = histories;
+    return history;
+}
+
+/* Record a motion event in the history of its device, and merge it into the
+   last event in the queue if that is motion from the same device and window.
+   Returns true if the event was merged -- called with the queue locked
+ */
+static bool SDL_CoalesceMotionEvent(const SDL_Event *event)
+{
+    SDL_MotionHistory *history;
+    SDL_Event *last;
+    Uint64 which;
+
+    if (!SDL_GetMotionDevice(event, &which)) {
+        return false;
+    }
+
+    history = SDL_GetMotionHistoryForDevice(event->type, which, true);
+    if (history) {
+        if (history->count == SDL_MOTION_HISTORY_SIZE) {
+            // Drop the oldest event
+            history->first = (history->first + 1) % SDL_MOTION_HISTORY_SIZE;
+            --history->count;
+        }
+        SDL_copyp(&history->events[(history->first + history->count) % SDL_MOTION_HISTORY_SIZE], event);
+        ++history->count;
+    }
+
+    if (!SDL_EventQ.tail || SDL_EventQ.tail->event.type != event->type) {
+        return false;
+    }
+
+    last = &SDL_EventQ.tail->event;
+    switch (event->type) {
+    case SDL_EVENT_MOUSE_MOTION:
+        if (last->motion.which != event->motion.which ||
+            last->motion.windowID != event->motion.windowID ||
+            last->motion.state != event->motion.state) {
+            return false;
+        }
+        last->motion.x = event->motion.x;
+        last->motion.y = event->motion.y;
+        last->motion.xrel += event->motion.xrel;
+        last->motion.yrel += event->motion.yrel;
+        break;
+    case SDL_EVENT_PEN_MOTION:
+        if (last->pmotion.which != event->pmotion.which ||
+            last->pmotion.windowID != event->pmotion.windowID ||
+            last->pmotion.pen_state != event->pmotion.pen_state) {
+            return false;
+        }
+        last->pmotion.x = event->pmotion.x;
+        last->pmotion.y = event->pmotion.y;
+        break;
+    case SDL_EVENT_FINGER_MOTION:
+        if (last->tfinger.touchID != event->tfinger.touchID ||
+            last->tfinger.fingerID != event->tfinger.fingerID ||
+            last->tfinger.windowID != event->tfinger.windowID) {
+            return false;
+        }
+        last->tfinger.x = event->tfinger.x;
+        last->tfinger.y = event->tfinger.y;
+        last->tfinger.dx += event->tfinger.dx;
+        last->tfinger.dy += event->tfinger.dy;
+        last->tfinger.pressure = event->tfinger.pressure;
+        break;
+    default:
+        return false;
+    }
+    last->common.timestamp = event->common.timestamp;
+    return true;
+}
+
+int SDL_GetMotionHistory(SDL_EventType type, Uint64 which, SDL_Event *events, int numevents)
+{
+    SDL_MotionHistory *history;
+    int i, count = 0;
+
+    if (!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    }
+    if (numevents < 0) {
+        SDL_InvalidParamError("numevents");
+        return -1;
+    }
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        history = SDL_GetMotionHistoryForDevice(type, which, false);
+        if (history) {
+            count = SDL_min(numevents, history->count);
+            for (i = 0; i < count; ++i) {
+                SDL_copyp(&events[i], &history->events[(history->first + i) % SDL_MOTION_HISTORY_SIZE]);
+            }
+            history->first = (history->first + count) % SDL_MOTION_HISTORY_SIZE;
+            history->count -= count;
+        }
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+
+    return count;
+}
+
+// Add an event to the ring without locking the queue, returns false if the ring is full
+static bool SDL_EnqueueEvent(const SDL_Event *event)
+{
+    SDL_EventRingCell *cell;
+    Uint32 pos = (Uint32)SDL_GetAtomicInt(&SDL_EventQ.ring_head);
+
+    for (;;) {
+        int diff;
+
+        cell = &SDL_EventQ.ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+        diff = (int)((Uint32)SDL_GetAtomicInt(&cell->sequence) - pos);
+        if (diff == 0) {
+            if (SDL_CompareAndSwapAtomicInt(&SDL_EventQ.ring_head, (int)pos, (int)(pos + 1))) {
+                break;
+            }
+        } else if (diff < 0) {
+            // The cell hasn't been moved into the queue since the last lap
+            return false;
+        }
+        pos = (Uint32)SDL_GetAtomicInt(&SDL_EventQ.ring_head);
+    }
+
+    SDL_InitEventEntry(&cell->entry, event);
+
+    // Publish the cell
+    SDL_SetAtomicInt(&cell->sequence, (int)(pos + 1));
+    return true;
+}
+
+// Start using the ring, returns false if it's closed. Nothing in between may take the queue lock.
+static bool SDL_EnterEventRing(void)
+{
+    SDL_AddAtomicInt(&SDL_EventQ.ring_users, 1);
+    if (SDL_GetAtomicInt(&SDL_EventQ.ring_open)) {
+        return true;
+    }
+    SDL_AddAtomicInt(&SDL_EventQ.ring_users, -1);
+    return false;
+}
+
+static void SDL_LeaveEventRing(void)
+{
+    SDL_AddAtomicInt(&SDL_EventQ.ring_users, -1);
+}
+
+// Release a published cell without adding its event to the queue -- called with the queue locked
+static void SDL_DropEventRingCell(SDL_EventRingCell *cell)
+{
+    SDL_TransferTemporaryMemoryFromEvent(&cell->entry);
+    if (cell->entry.event.type == SDL_EVENT_POLL_SENTINEL) {
+        SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
+    }
+    SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+}
+
+/* Move events from the ring into the queue, in the order they were claimed -- called with the queue locked
+
+   Before adding an event to the queue directly, `wait` has to be set, so that
+   it can't overtake events already claimed in the ring that another producer
+   is still writing, which might be stuck behind them.
+
+   This returns false if there wasn't memory for a queue entry. The remaining
+   events stay in the ring, and are moved the next time this is called.
+ */
+static bool SDL_FlushEventRing(bool wait)
+{
+    Uint32 end;
+    int spins = 0;
+
+    if (!SDL_EventQ.ring) {
+        return true;
+    }
+
+    end = (Uint32)SDL_GetAtomicInt(&SDL_EventQ.ring_head);
+    for (;;) {
+        const Uint32 pos = SDL_EventQ.ring_tail;
+        SDL_EventRingCell *cell = &SDL_EventQ.ring[pos & (SDL_EVENT_RING_SIZE - 1)];
+        SDL_EventEntry *entry;
+
+        if ((Uint32)SDL_GetAtomicInt(&cell->sequence) != pos + 1) {
+            // Either empty, or the next producer hasn't finished writing yet
+            if (!wait || (int)(end - pos) <= 0) {
+                break;
+            }
+            if (++spins < 100) {
+                SDL_CPUPauseInstruction();
+            } else {
+                SDL_DelayNS(0);
+            }
+            continue;
+        }
+
+        if (SDL_coalesce_motion && SDL_CoalesceMotionEvent(&cell->entry.event)) {
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        } else {
+            entry = SDL_AllocEventEntry();
+            if (!entry) {
+                return false;
+            }
+            SDL_copyp(&entry->event, &cell->entry.event);
+            SDL_memcpy(entry->memory, cell->entry.memory, sizeof(entry->memory));
+            SDL_LinkEvent(entry);
+        }
+
+        // Hand the cell back to the producers for the next lap
+        SDL_SetAtomicInt(&cell->sequence, (int)(pos + SDL_EVENT_RING_SIZE));
+        SDL_EventQ.ring_tail = pos + 1;
+    }
+    return true;
+}
+
+// Close the ring, wait for the producers still using it, and drop what's left in it -- called with the queue locked
+static void SDL_CloseEventRing(void)
+{
+    Uint32 pos, end;
+
+    SDL_SetAtomicInt(&SDL_EventQ.ring_open, 0);
+    while (SDL_GetAtomicInt(&SDL_EventQ.ring_users) > 0) {
+        SDL_DelayNS(0);
+    }
+
+    if (!SDL_EventQ.ring) {
+        return;
+    }
+
+    // Every claimed cell has been published now
+    end = (Uint32)SDL_GetAtomicInt(&SDL_EventQ.ring_head);
+    for (pos = SDL_EventQ.ring_tail; pos != end; ++pos) {
+        SDL_DropEventRingCell(&SDL_EventQ.ring[pos & (SDL_EVENT_RING_SIZE - 1)]);
+    }
+    SDL_EventQ.ring_tail = end;
+}
+
+void SDL_DropMotionHistory(Uint32 type, Uint64 which)
+{
+    int i;
+
+    SDL_LockMutex(SDL_EventQ.lock);
+    {
+        if (SDL_EventQ.num_motion_history > 0) {
+            // Motion still in the ring would bring the history back
+            SDL_FlushEventRing(false);
+
+            for (i = 0; i < SDL_EventQ.num_motion_history; ++i) {
+                SDL_MotionHistory *history = SDL_EventQ.motion_history[i];
+                if (history->type == type && history->which == which) {
+                    SDL_EventQ.motion_history[i] = SDL_EventQ.motion_history[--SDL_EventQ.num_motion_history];
+                    SDL_free(history);
+                    break;
+                }
+            }
+        }
+    }
+    SDL_UnlockMutex(SDL_EventQ.lock);
+}
+
 void SDL_StopEventLoop(void)
 {
     const char *report = SDL_GetHint("SDL_EVENT_QUEUE_STATISTICS");
@@ -919,6 +1542,8 @@ void SDL_StopEventLoop(void)
 
     SDL_EventQ.active = false;
 
+    SDL_CloseEventRing();
+
     if (report && SDL_atoi(report)) {
         SDL_Log("SDL EVENT QUEUE: Maximum events in-flight: %d",
                 SDL_EventQ.max_events_seen);
@@ -937,11 +1562,25 @@ void SDL_StopEventLoop(void)
         entry = next;
     }
 
+    SDL_free(SDL_EventQ.ring);
+    for (i = 0; i < SDL_EventQ.num_motion_history; ++i) {
+        SDL_free(SDL_EventQ.motion_history[i]);
+    }
+    SDL_free(SDL_EventQ.motion_history);
+
     SDL_SetAtomicInt(&SDL_EventQ.count, 0);
     SDL_EventQ.max_events_seen = 0;
     SDL_EventQ.head = NULL;
     SDL_EventQ.tail = NULL;
     SDL_EventQ.free = NULL;
+    SDL_EventQ.ring = NULL;
+    SDL_EventQ.motion_history = NULL;
+    SDL_EventQ.num_motion_history = 0;
+    SDL_SetAtomicInt(&SDL_EventQ.ring_head, 0);
+    SDL_EventQ.ring_tail = 0;
+    SDL_EventQ.sequence = 0;
+    SDL_zeroa(SDL_EventQ.categories_used);
+    SDL_zeroa(SDL_EventQ.categories);
     SDL_SetAtomicInt(&SDL_sentinel_pending, 0);
 
     // Clear disabled event state
@@ -978,7 +1617,7 @@ bool SDL_StartEventLoop(void)
     // Create the lock and set ourselves active
 #ifndef SDL_THREADS_DISABLED
     if (!SDL_EventQ.lock) {
-        SDL_EventQ.lock = SDL_CreateMutex();
+        SDL_EventQ.lock = SDL_CreateNamedMutex("SDL_EventQ.lock");
         if (SDL_EventQ.lock == NULL) {
             return false;
         }
@@ -993,7 +1632,23 @@ bool SDL_StartEventLoop(void)
 
     SDL_InitWindowEventWatch();
 
+    if (!SDL_EventQ.ring) {
+        // If this fails, events are added under the lock instead
+        SDL_EventQ.ring = (SDL_EventRingCell *)SDL_malloc(SDL_EVENT_RING_SIZE * sizeof(*SDL_EventQ.ring));
+        if (SDL_EventQ.ring) {
+            Uint32 i;
+            for (i = 0; i < SDL_EVENT_RING_SIZE; ++i) {
+                SDL_SetAtomicInt(&SDL_EventQ.ring[i].sequence, (int)i);
+            }
+            SDL_SetAtomicInt(&SDL_EventQ.ring_head, 0);
+            SDL_EventQ.ring_tail = 0;
+        }
+    }
+
     SDL_EventQ.active = true;
+    if (SDL_EventQ.ring) {
+        SDL_SetAtomicInt(&SDL_EventQ.ring_open, 1);
+    }
 
 #ifndef SDL_THREADS_DISABLED
     SDL_UnlockMutex(SDL_EventQ.lock);
@@ -1005,54 +1660,27 @@ bool SDL_StartEventLoop(void)
 static int SDL_AddEvent(SDL_Event *event)
 {
     SDL_EventEntry *entry;
-    const int initial_count = SDL_GetAtomicInt(&SDL_EventQ.count);
-    int final_count;
-
-    if (initial_count >= SDL_MAX_QUEUED_EVENTS) {
-        SDL_SetError("Event queue is full (%d events)", initial_count);
-        return 0;
-    }
-
-    if (SDL_EventQ.free == NULL) {
-        entry = (SDL_EventEntry *)SDL_malloc(sizeof(*entry));
-        if (entry == NULL) {
-            return 0;
-        }
-    } else {
-        entry = SDL_EventQ.free;
-        SDL_EventQ.free = entry->next;
-    }
 
     if (SDL_EventLoggingVerbosity > 0) {
         SDL_LogEvent(event);
     }
 
-    SDL_copyp(&entry->event, event);
-    if (event->type == SDL_EVENT_POLL_SENTINEL) {
-        SDL_AddAtomicInt(&SDL_sentinel_pending, 1);
+    if (SDL_coalesce_motion && SDL_CoalesceMotionEvent(event)) {
+        return 1;
     }
-    entry->memory = NULL;
-    SDL_TransferTemporaryMemoryToEvent(entry);
 
-    if (SDL_EventQ.tail) {
-        SDL_EventQ.tail->next = entry;
-        entry->prev = SDL_EventQ.tail;
-        SDL_EventQ.tail = entry;
-        entry->next = NULL;
-    } else {
-        SDL_assert(!SDL_EventQ.head);
-        SDL_EventQ.head = entry;
-        SDL_EventQ.tail = entry;
-        entry->prev = NULL;
-        entry->next = NULL;
+    if (!SDL_ReserveEvent()) {
+        return 0;
     }
 
-    final_count = SDL_AddAtomicInt(&SDL_EventQ.count, 1) + 1;
-    if (final_count > SDL_EventQ.max_events_seen) {
-        SDL_EventQ.max_events_seen = final_count;
+    entry = SDL_AllocEventEntry();
+    if (entry == NULL) {
+        SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        return 0;
     }
 
-    ++SDL_last_event_id;
+    SDL_InitEventEntry(entry, event);
+    SDL_LinkEvent(entry);
 
     return 1;
 }
@@ -1077,6 +1705,7 @@ static void SDL_CutEvent(SDL_EventEntry *entry)
         SDL_assert(entry->next == NULL);
         SDL_EventQ.tail = entry->prev;
     }
+    SDL_UnlinkEventCategory(entry);
 
     if (entry->event.type == SDL_EVENT_POLL_SENTINEL) {
         SDL_AddAtomicInt(&SDL_sentinel_pending, -1);
@@ -1111,6 +1740,85 @@ static void SDL_SendWakeupEvent(void)
 #endif
 }
 
+typedef struct SDL_EventRange
+{
+    Uint32 minType;
+    Uint32 maxType;
+    bool all; // every queued event is in the range
+    int num_cursors;
+    SDL_EventEntry *cursors[SDL_EVENT_CATEGORY_COUNT];
+} SDL_EventRange;
+
+// Start walking the events with a type in the range, in queue order -- called with the queue locked
+static void SDL_BeginEventRange(SDL_EventRange *range, Uint32 minType, Uint32 maxType)
+{
+    int category, last;
+    bool all = true;
+
+    range->minType = minType;
+    range->maxType = maxType;
+    range->all = false;
+    range->num_cursors = 0;
+
+    if (minType > maxType) {
+        return;
+    }
+
+    for (category = SDL_NextEventCategory(0); category >= 0; category = SDL_NextEventCategory(category + 1)) {
+        if (!SDL_EventCategoryInRange(category, minType, maxType)) {
+            all = false;
+            break;
+        }
+    }
+    if (all) {
+        // Every queued event matches, walk the queue itself
+        range->all = true;
+        if (SDL_EventQ.head) {
+            range->cursors[range->num_cursors++] = SDL_EventQ.head;
+        }
+        return;
+    }
+
+    last = SDL_GetEventCategory(maxType);
+    for (category = SDL_NextEventCategory(SDL_GetEventCategory(minType)); category >= 0 && category <= last; category = SDL_NextEventCategory(category + 1)) {
+        SDL_EventEntry *entry = SDL_FindEventInCategory(SDL_EventQ.categories[category].head, minType, maxType);
+        if (entry) {
+            range->cursors[range->num_cursors++] = entry;
+        }
+    }
+}
+
+/* Returns the next event in the range, or NULL if there are no more -- called with the queue locked
+
+   The returned event may be cut from the queue before asking for the next one.
+ */
+static SDL_EventEntry *SDL_NextEventInRange(SDL_EventRange *range)
+{
+    SDL_EventEntry *entry;
+    int i, index = 0;
+
+    if (range->num_cursors == 0) {
+        return NULL;
+    }
+
+    for (i = 1; i < range->num_cursors; ++i) {
+        if (range->cursors[i]->sequence < range->cursors[index]->sequence) {
+            index = i;
+        }
+    }
+    entry = range->cursors[index];
+
+    if (range->all) {
+        range->cursors[index] = entry->next;
+    } else {
+        range->cursors[index] = SDL_FindEventInCategory(entry->category_next, range->minType, range->maxType);
+    }
+    if (!range->cursors[index]) {
+        range->cursors[index] = range->cursors[--range->num_cursors];
+    }
+    return entry;
+}
+
 // Lock the event queue, take a peep at it, and unlock it
 static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAction action,
                                   Uint32 minType, Uint32 maxType, bool include_sentinel)
@@ -1131,6 +1839,13 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
             SDL_UnlockMutex(SDL_EventQ.lock);
             return -1;
         }
+
+        // Anything pushed to the ring so far goes ahead of these events
+        if (!SDL_FlushEventRing(action == SDL_ADDEVENT)) {
+            SDL_UnlockMutex(SDL_EventQ.lock);
+            return -1;
+        }
+
         if (action == SDL_ADDEVENT) {
             if (!events) {
                 SDL_UnlockMutex(SDL_EventQ.lock);
@@ -1140,36 +1855,35 @@ static int SDL_PeepEventsInternal(SDL_Event *events, int numevents, SDL_EventAct
                 used += SDL_AddEvent(&events[i]);
             }
         } else {
-            SDL_EventEntry *entry, *next;
+            SDL_EventRange range;
+            SDL_EventEntry *entry;
             Uint32 type;
 
-            for (entry = SDL_EventQ.head; entry && (events == NULL || used < numevents); entry = next) {
-                next = entry->next;
+            SDL_BeginEventRange(&range, minType, maxType);
+            while ((events == NULL || used < numevents) && (entry = SDL_NextEventInRange(&range)) != NULL) {
                 type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    if (events) {
-                        SDL_copyp(&events[used], &entry->event);
+                if (events) {
+                    SDL_copyp(&events[used], &entry->event);
 
-                        if (action == SDL_GETEVENT) {
-                            SDL_CutEvent(entry);
-                        }
+                    if (action == SDL_GETEVENT) {
+                        SDL_CutEvent(entry);
+                    }
+                }
+                if (type == SDL_EVENT_POLL_SENTINEL) {
+                    // Special handling for the sentinel event
+                    if (!include_sentinel) {
+                        // Skip it, we don't want to include it
+                        continue;
+                    }
+                    if (events == NULL || action != SDL_GETEVENT) {
+                        ++sentinels_expected;
                     }
-                    if (type == SDL_EVENT_POLL_SENTINEL) {
-                        // Special handling for the sentinel event
-                        if (!include_sentinel) {
-                            // Skip it, we don't want to include it
-                            continue;
-                        }
-                        if (events == NULL || action != SDL_GETEVENT) {
-                            ++sentinels_expected;
-                        }
-                        if (SDL_GetAtomicInt(&SDL_sentinel_pending) > sentinels_expected) {
-                            // Skip it, there's another one pending
-                            continue;
-                        }
+                    if (SDL_GetAtomicInt(&SDL_sentinel_pending) > sentinels_expected) {
+                        // Skip it, there's another one pending
+                        continue;
                     }
-                    ++used;
                 }
+                ++used;
             }
         }
     }
@@ -1199,11 +1913,18 @@ bool SDL_HasEvents(Uint32 minType, Uint32 maxType)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         if (SDL_EventQ.active) {
-            for (SDL_EventEntry *entry = SDL_EventQ.head; entry; entry = entry->next) {
-                const Uint32 type = entry->event.type;
-                if (minType <= type && type <= maxType) {
-                    found = true;
-                    break;
+            SDL_FlushEventRing(false);
+
+            if (minType <= maxType) {
+                const int last = SDL_GetEventCategory(maxType);
+                int category;
+
+                for (category = SDL_NextEventCategory(SDL_GetEventCategory(minType)); category >= 0 && category <= last; category = SDL_NextEventCategory(category + 1)) {
+                    if (SDL_EventCategoryInRange(category, minType, maxType) ||
+                        SDL_FindEventInCategory(SDL_EventQ.categories[category].head, minType, maxType)) {
+                        found = true;
+                        break;
+                    }
                 }
             }
         }
@@ -1221,7 +1942,7 @@ void SDL_FlushEvent(Uint32 type)
 void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
 {
     SDL_EventEntry *entry, *next;
-    Uint32 type;
+    int category, last;
 
     // Make sure the events are current
 #if 0
@@ -1239,11 +1960,14 @@ void SDL_FlushEvents(Uint32 minType, Uint32 maxType)
             SDL_UnlockMutex(SDL_EventQ.lock);
             return;
         }
-        for (entry = SDL_EventQ.head; entry; entry = next) {
-            next = entry->next;
-            type = entry->event.type;
-            if (minType <= type && type <= maxType) {
-                SDL_CutEvent(entry);
+        SDL_FlushEventRing(false);
+        if (minType <= maxType) {
+            last = SDL_GetEventCategory(maxType);
+            for (category = SDL_NextEventCategory(SDL_GetEventCategory(minType)); category >= 0 && category <= last; category = SDL_NextEventCategory(category + 1)) {
+                for (entry = SDL_FindEventInCategory(SDL_EventQ.categories[category].head, minType, maxType); entry; entry = next) {
+                    next = SDL_FindEventInCategory(entry->category_next, minType, maxType);
+                    SDL_CutEvent(entry);
+                }
             }
         }
     }
@@ -1304,7 +2028,7 @@ static void SDL_DestroyMainThreadCallback(SDL_MainThreadCallbackEntry *entry)
 
 static void SDL_InitMainThreadCallbacks(void)
 {
-    SDL_main_callbacks_lock = SDL_CreateMutex();
+    SDL_main_callbacks_lock = SDL_CreateNamedMutex("SDL_main_callbacks_lock");
     SDL_assert(SDL_main_callbacks_head == NULL &&
                SDL_main_callbacks_tail == NULL);
 }
@@ -1760,6 +2484,30 @@ bool SDL_PushEvent(SDL_Event *event)
         return false;
     }
 
+    // Try the lock-free path first
+    if (SDL_EnterEventRing()) {
+        const bool reserved = SDL_ReserveEvent();
+        const bool enqueued = reserved && SDL_EnqueueEvent(event);
+
+        if (reserved && !enqueued) {
+            // The ring is full, add it to the queue directly
+            SDL_AddAtomicInt(&SDL_EventQ.count, -1);
+        }
+        SDL_LeaveEventRing();
+
+        if (!reserved) {
+            return false;
+        }
+        if (enqueued) {
+            // Not before leaving the ring, a log callback might add events of its own
+            if (SDL_EventLoggingVerbosity > 0) {
+                SDL_LogEvent(event);
+            }
+            SDL_SendWakeupEvent();
+            return true;
+        }
+    }
+
     if (SDL_PeepEvents(event, 1, SDL_ADDEVENT, 0, 0) <= 0) {
         return false;
     }
@@ -1767,6 +2515,50 @@ bool SDL_PushEvent(SDL_Event *event)
     return true;
 }
 
+int SDL_PushEvents(const SDL_Event *events, int count)
+{
+    SDL_Event *accepted;
+    bool isstack;
+    int i, num_accepted = 0, result;
+
+    if (!events) {
+        SDL_InvalidParamError("events");
+        return -1;
+    }
+    if (count <= 0) {
+        return 0;
+    }
+
+    accepted = SDL_small_alloc(SDL_Event, count, &isstack);
+    if (!accepted) {
+        return -1;
+    }
+
+    for (i = 0; i < count; ++i) {
+        SDL_Event *event = &accepted[num_accepted];
+
+        SDL_copyp(event, &events[i]);
+        if (!event->common.timestamp) {
+            event->common.timestamp = SDL_GetTicksNS();
+        }
+        if (SDL_CallEventWatchers(event)) {
+            ++num_accepted;
+        }
+    }
+
+    // This takes the queue lock once and sends one wakeup event
+    if (num_accepted > 0) {
+        result = SDL_PeepEvents(accepted, num_accepted, SDL_ADDEVENT, 0, 0);
+    } else {
+        SDL_ClearError();
+        result = 0;
+    }
+
+    SDL_small_free(accepted, isstack);
+
+    return result;
+}
+
 void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
 {
     SDL_EventEntry *event, *next;
@@ -1779,6 +2571,7 @@ void SDL_SetEventFilter(SDL_EventFilter filter, void *userdata)
             // Cut all events not accepted by the filter
             SDL_LockMutex(SDL_EventQ.lock);
             {
+                SDL_FlushEventRing(false);
                 for (event = SDL_EventQ.head; event; event = next) {
                     next = event->next;
                     if (!filter(userdata, &event->event)) {
@@ -1826,6 +2619,7 @@ void SDL_FilterEvents(SDL_EventFilter filter, void *userdata)
     SDL_LockMutex(SDL_EventQ.lock);
     {
         SDL_EventEntry *entry, *next;
+        SDL_FlushEventRing(false);
         for (entry = SDL_EventQ.head; entry; entry = next) {
             next = entry->next;
             if (!filter(userdata, &entry->event)) {
@@ -1976,6 +2770,7 @@ bool SDL_InitEvents(void)
     SDL_AddHintCallback(SDL_HINT_AUTO_UPDATE_SENSORS, SDL_AutoUpdateSensorsChanged, NULL);
 #endif
     SDL_AddHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
+    SDL_AddHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_AddHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
     SDL_InitMainThreadCallbacks();
     if (!SDL_StartEventLoop()) {
@@ -1994,6 +2789,7 @@ void SDL_QuitEvents(void)
     SDL_StopEventLoop();
     SDL_QuitMainThreadCallbacks();
     SDL_RemoveHintCallback(SDL_HINT_POLL_SENTINEL, SDL_PollSentinelChanged, NULL);
+    SDL_RemoveHintCallback(SDL_HINT_EVENT_COALESCE_MOTION, SDL_CoalesceMotionChanged, NULL);
     SDL_RemoveHintCallback(SDL_HINT_EVENT_LOGGING, SDL_EventLoggingChanged, NULL);
 #ifndef SDL_JOYSTICK_DISABLED
     SDL_RemoveHintCallback(SDL_HINT_AUTO_UPDATE_JOYSTICKS, SDL_AutoUpdateJoysticksChanged, NULL);
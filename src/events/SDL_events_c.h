@@ -48,11 +48,17 @@ extern void SDL_SendSystemThemeChangedEvent(void);
 
 extern void *SDL_AllocateTemporaryMemory(size_t size);
 extern const char *SDL_CreateTemporaryString(const char *string);
+// Takes temporary memory away from the calling thread, returning a copy made with SDL_malloc() that the
+//  caller frees with SDL_free(). `mem` itself is released and must not be used afterwards. Returns NULL
+//  if the thread doesn't own `mem`, or if there isn't memory for the copy, in which case the thread keeps it.
 extern void *SDL_ClaimTemporaryMemory(const void *mem);
 extern void SDL_FreeTemporaryMemory(void);
 
 extern void SDL_PumpEventMaintenance(void);
 
+// Forget the motion history of a removed device, see SDL_GetMotionHistory()
+extern void SDL_DropMotionHistory(Uint32 type, Uint64 which);
+
 extern void SDL_SendQuit(void);
 
 extern bool SDL_InitEvents(void);
@@ -400,6 +400,8 @@ void SDL_RemoveMouse(SDL_MouseID mouseID, bool send_event)
         }
     }
 
+    SDL_DropMotionHistory(SDL_EVENT_MOUSE_MOTION, mouseID);
+
     if (send_event) {
         SDL_Event event;
         SDL_zero(event);
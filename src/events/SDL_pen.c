@@ -25,6 +25,7 @@
 #include "../SDL_hints_c.h"
 #include "SDL_events_c.h"
 #include "SDL_pen_c.h"
+#include "../thread/SDL_thread_c.h"
 
 static SDL_PenID pen_touching = 0;  // used for synthetic mouse/touch events.
 
@@ -99,7 +100,7 @@ bool SDL_InitPen(void)
     SDL_assert(pen_device_rwlock == NULL);
     SDL_assert(pen_devices == NULL);
     SDL_assert(pen_device_count == 0);
-    pen_device_rwlock = SDL_CreateRWLock();
+    pen_device_rwlock = SDL_CreateNamedRWLock("pen_device_rwlock");
     if (!pen_device_rwlock) {
         return false;
     }
@@ -291,6 +292,10 @@ void SDL_RemovePenDevice(Uint64 timestamp, SDL_PenID instance_id)
     }
     SDL_UnlockRWLock(pen_device_rwlock);
 
+    if (pen) {
+        SDL_DropMotionHistory(SDL_EVENT_PEN_MOTION, instance_id);
+    }
+
     if (pen && SDL_EventEnabled(SDL_EVENT_PEN_PROXIMITY_OUT)) {
         SDL_Event event;
         SDL_zero(event);
@@ -309,6 +314,7 @@ void SDL_RemoveAllPenDevices(void (*callback)(SDL_PenID instance_id, void *handl
         SDL_assert(pen_devices != NULL);
         for (int i = 0; i < pen_device_count; i++) {
             callback(pen_devices[i].instance_id, pen_devices[i].driverdata, userdata);
+            SDL_DropMotionHistory(SDL_EVENT_PEN_MOTION, pen_devices[i].instance_id);
             SDL_free(pen_devices[i].name);
         }
     }
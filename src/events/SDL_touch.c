@@ -496,6 +496,8 @@ void SDL_DelTouch(SDL_TouchID id)
 
     SDL_num_touch--;
     SDL_touchDevices[index] = SDL_touchDevices[SDL_num_touch];
+
+    SDL_DropMotionHistory(SDL_EVENT_FINGER_MOTION, id);
 }
 
 void SDL_QuitTouch(void)
@@ -39,6 +39,13 @@
 #include <fcntl.h>
 #endif
 
+#ifdef HAVE_MMAP
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 #include "SDL_iostream_c.h"
 
 /* This file provides a general interface for SDL to read and write
@@ -783,6 +790,255 @@ static bool SDLCALL mem_close(void *userdata)
     return true;
 }
 
+// Functions to map files into memory
+
+#if defined(SDL_PLATFORM_WINDOWS) && !defined(SDL_PLATFORM_XBOXONE) && !defined(SDL_PLATFORM_XBOXSERIES)
+#define SDL_MAPFILE_WINDOWS
+#elif defined(HAVE_MMAP)
+#define SDL_MAPFILE_MMAP
+#endif
+
+#ifdef SDL_MAPFILE_WINDOWS
+
+/* Maps the file into memory, or reads it if it can't be mapped.
+   Returns false if the file couldn't be opened. */
+static bool MapFileDirectly(const char *file, SDL_MapFileFlags flags, const void **mem, void **data, size_t *datasize)
+{
+    DWORD attributes = FILE_ATTRIBUTE_NORMAL;
+    LARGE_INTEGER size;
+    HANDLE h, mapping;
+
+    if (flags & SDL_MAPFILE_SEQUENTIAL) {
+        attributes |= FILE_FLAG_SEQUENTIAL_SCAN;
+    } else if (flags & SDL_MAPFILE_RANDOM) {
+        attributes |= FILE_FLAG_RANDOM_ACCESS;
+    }
+
+    {
+        LPWSTR str = WIN_UTF8ToStringW(file);
+        if (!str) {
+            return false;
+        }
+        h = CreateFileW(str, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, attributes, NULL);
+        SDL_free(str);
+    }
+    if (h == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    // Empty files can't be mapped
+    if (GetFileSizeEx(h, &size) && size.QuadPart > 0 && (Uint64)size.QuadPart <= SDL_SIZE_MAX) {
+        mapping = CreateFileMappingW(h, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping) {
+            *mem = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+    }
+
+    if (*mem) {
+        CloseHandle(h);
+        *datasize = (size_t)size.QuadPart;
+    } else {
+        *data = SDL_LoadFile_IO(SDL_IOFromHandle(h, "rb", true), datasize, true);
+    }
+    return true;
+}
+
+// Data that couldn't be mapped goes in memory that is released the same way
+static const void *CopyToMapping(const void *data, size_t datasize)
+{
+    const Uint64 size = SDL_max(datasize, 1);
+    HANDLE mapping;
+    void *mem;
+
+    mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)(size >> 32), (DWORD)size, NULL);
+    if (!mapping) {
+        WIN_SetError("Couldn't create file mapping");
+        return NULL;
+    }
+    mem = MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!mem) {
+        WIN_SetError("Couldn't map view of file");
+        return NULL;
+    }
+    SDL_memcpy(mem, data, datasize);
+    return mem;
+}
+
+#elif defined(SDL_MAPFILE_MMAP)
+
+/* Maps the file into memory, or reads it if it can't be mapped.
+   Returns false if the file couldn't be opened. */
+static bool MapFileDirectly(const char *file, SDL_MapFileFlags flags, const void **mem, void **data, size_t *datasize)
+{
+    struct stat st;
+    void *mapping = MAP_FAILED;
+    int fd;
+
+#ifdef SDL_PLATFORM_ANDROID
+    // Relative paths are looked up in internal storage and assets by SDL_IOFromFile()
+    if (*file != '/') {
+        return false;
+    }
+#endif
+
+    fd = open(file, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    // Empty files can't be mapped, and pipes and devices might not be
+    if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0 && (Uint64)st.st_size <= SDL_SIZE_MAX) {
+        mapping = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+
+    if (mapping == MAP_FAILED) {
+        // Opening a pipe again would wait for another writer, so read from this descriptor
+        *data = SDL_LoadFile_IO(SDL_IOFromFD(fd, true), datasize, true);
+        return true;
+    }
+    close(fd);
+
+#ifdef HAVE_MADVISE
+    if (flags & SDL_MAPFILE_SEQUENTIAL) {
+        madvise(mapping, (size_t)st.st_size, MADV_SEQUENTIAL);
+    } else if (flags & SDL_MAPFILE_RANDOM) {
+        madvise(mapping, (size_t)st.st_size, MADV_RANDOM);
+    }
+#endif
+
+    *mem = mapping;
+    *datasize = (size_t)st.st_size;
+    return true;
+}
+
+// Data that couldn't be mapped goes in memory that is released the same way
+static const void *CopyToMapping(const void *data, size_t datasize)
+{
+    const size_t size = SDL_max(datasize, 1);
+    void *mem;
+
+    mem = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (mem == MAP_FAILED) {
+        SDL_SetError("Couldn't map memory: %s", strerror(errno));
+        return NULL;
+    }
+    SDL_memcpy(mem, data, datasize);
+    mprotect(mem, size, PROT_READ);
+    return mem;
+}
+
+#endif // SDL_MAPFILE_MMAP
+
+const void *SDL_MapFile(const char *file, SDL_MapFileFlags flags, size_t *datasize)
+{
+    const void *mem = NULL;
+    size_t size = 0;
+
+    if (datasize) {
+        *datasize = 0;
+    }
+    if (!file || !*file) {
+        SDL_InvalidParamError("file");
+        return NULL;
+    }
+
+#if defined(SDL_MAPFILE_WINDOWS) || defined(SDL_MAPFILE_MMAP)
+    void *data = NULL;
+
+    if (!MapFileDirectly(file, flags, &mem, &data, &size)) {
+        // Let SDL_IOFromFile() look for it, and set the error if it's not there
+        data = SDL_LoadFile(file, &size);
+    }
+    if (!mem) {
+        if (!data) {
+            return NULL;
+        }
+        mem = CopyToMapping(data, size);
+        SDL_free(data);
+        if (!mem) {
+            return NULL;
+        }
+    }
+#else
+    mem = SDL_LoadFile(file, &size);
+    if (!mem) {
+        return NULL;
+    }
+#endif
+
+    if (datasize) {
+        *datasize = size;
+    }
+    return mem;
+}
+
+void SDL_UnmapFile(const void *mem, size_t datasize)
+{
+    if (!mem) {
+        return;
+    }
+
+#ifdef SDL_MAPFILE_WINDOWS
+    UnmapViewOfFile(mem);
+#elif defined(SDL_MAPFILE_MMAP)
+    munmap((void *)mem, SDL_max(datasize, 1));
+#else
+    SDL_free((void *)mem);
+#endif
+}
+
+static bool SDLCALL mapped_close(void *userdata)
+{
+    IOStreamMemData *iodata = (IOStreamMemData *) userdata;
+    SDL_UnmapFile(iodata->base, (size_t)(iodata->stop - iodata->base));
+    SDL_free(iodata);
+    return true;
+}
+
+static SDL_IOStream *SDL_IOFromMappedFile(const char *file, SDL_MapFileFlags flags)
+{
+    IOStreamMemData *iodata;
+    const void *mem;
+    size_t size;
+
+    mem = SDL_MapFile(file, flags, &size);
+    if (!mem) {
+        return NULL;
+    }
+
+    iodata = (IOStreamMemData *) SDL_calloc(1, sizeof (*iodata));
+    if (!iodata) {
+        SDL_UnmapFile(mem, size);
+        return NULL;
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = mem_size;
+    iface.seek = mem_seek;
+    iface.read = mem_read;
+    // leave iface.write as NULL.
+    iface.close = mapped_close;
+
+    iodata->base = (Uint8 *)mem;
+    iodata->here = iodata->base;
+    iodata->stop = iodata->base + size;
+
+    SDL_IOStream *iostr = SDL_OpenIO(&iface, iodata);
+    if (!iostr) {
+        iface.close(iodata);
+    } else {
+        const SDL_PropertiesID props = SDL_GetIOProperties(iostr);
+        if (props) {
+            SDL_SetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, (void *)mem);
+            SDL_SetNumberProperty(props, SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, size);
+        }
+    }
+    return iostr;
+}
+
 // Functions to create SDL_IOStream structures from various data sources
 
 #if defined(HAVE_STDIO_H) && !defined(SDL_PLATFORM_WINDOWS)
@@ -812,6 +1068,17 @@ SDL_IOStream *SDL_IOFromFile(const char *file, const char *mode)
         return NULL;
     }
 
+    if (SDL_strchr(mode, 'm') && !SDL_strpbrk(mode, "wa+")) {
+        SDL_MapFileFlags flags = 0;
+
+        if (SDL_strchr(mode, 'S')) {
+            flags |= SDL_MAPFILE_SEQUENTIAL;
+        } else if (SDL_strchr(mode, 'R')) {
+            flags |= SDL_MAPFILE_RANDOM;
+        }
+        return SDL_IOFromMappedFile(file, flags);
+    }
+
 #ifdef SDL_PLATFORM_ANDROID
 #ifdef HAVE_STDIO_H
     // Try to open the file on the filesystem first
@@ -1095,6 +1362,293 @@ SDL_IOStream *SDL_IOFromDynamicMem(void)
     return iostr;
 }
 
+// Functions to buffer another SDL_IOStream
+
+#define DEFAULT_BUFFERED_IO_SIZE 4096
+
+/* The buffer holds either data read ahead from the source or writes that
+   haven't gone to the source yet, never both. In the first case the source
+   is at offset + read_len, in the second case it's at offset. */
+typedef struct IOStreamBufferedData
+{
+    SDL_IOStream *src;
+    bool closeio;
+    bool seekable;
+    Uint8 *buffer;
+    size_t size;
+    size_t read_pos;
+    size_t read_len;
+    size_t write_len;
+    Sint64 offset; // the position of the start of the buffer in the source
+} IOStreamBufferedData;
+
+static void buffered_update_status(IOStreamBufferedData *iodata, SDL_IOStatus *status)
+{
+    // Errors and the end of the stream are reported by SDL_ReadIO() and SDL_WriteIO() for us
+    if (SDL_GetIOStatus(iodata->src) == SDL_IO_STATUS_NOT_READY) {
+        *status = SDL_IO_STATUS_NOT_READY;
+    }
+}
+
+static bool buffered_write_pending(IOStreamBufferedData *iodata, SDL_IOStatus *status)
+{
+    size_t written = 0;
+
+    while (written < iodata->write_len) {
+        const size_t bytes = SDL_WriteIO(iodata->src, iodata->buffer + written, iodata->write_len - written);
+        if (bytes == 0) {
+            buffered_update_status(iodata, status);
+            break;
+        }
+        written += bytes;
+    }
+
+    iodata->offset += written;
+    iodata->write_len -= written;
+    if (iodata->write_len > 0) {
+        SDL_memmove(iodata->buffer, iodata->buffer + written, iodata->write_len);
+        return false;
+    }
+    return true;
+}
+
+// Puts the source back at the current position, for writing or for leaving it to the caller
+static bool buffered_drop_readahead(IOStreamBufferedData *iodata)
+{
+    const Sint64 position = iodata->offset + iodata->read_pos;
+
+    if (iodata->read_pos < iodata->read_len) {
+        if (SDL_SeekIO(iodata->src, position, SDL_IO_SEEK_SET) != position) {
+            return false;
+        }
+    }
+    iodata->offset = position;
+    iodata->read_pos = 0;
+    iodata->read_len = 0;
+    return true;
+}
+
+static Sint64 SDLCALL buffered_size(void *userdata)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    SDL_IOStatus status = SDL_IO_STATUS_READY;
+
+    if (!buffered_write_pending(iodata, &status)) {
+        return -1;
+    }
+    return SDL_GetIOSize(iodata->src);
+}
+
+static Sint64 SDLCALL buffered_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    const Sint64 position = iodata->offset + iodata->read_pos + iodata->write_len;
+    SDL_IOStatus status = SDL_IO_STATUS_READY;
+    Sint64 result;
+
+    if (!iodata->seekable) {
+        return SDL_SeekIO(iodata->src, offset, whence);
+    }
+
+    switch (whence) {
+    case SDL_IO_SEEK_SET:
+        break;
+    case SDL_IO_SEEK_CUR:
+        offset += position;
+        break;
+    case SDL_IO_SEEK_END:
+        if (!buffered_write_pending(iodata, &status) || !buffered_drop_readahead(iodata)) {
+            return -1;
+        }
+        result = SDL_SeekIO(iodata->src, offset, SDL_IO_SEEK_END);
+        if (result >= 0) {
+            iodata->offset = result;
+        }
+        return result;
+    default:
+        SDL_SetError("Unknown value for 'whence'");
+        return -1;
+    }
+
+    if (offset == position) {
+        return position;
+    }
+    if (iodata->read_len > 0 && offset >= iodata->offset && offset <= iodata->offset + (Sint64)iodata->read_len) {
+        iodata->read_pos = (size_t)(offset - iodata->offset);
+        return offset;
+    }
+
+    if (!buffered_write_pending(iodata, &status)) {
+        return -1;
+    }
+    result = SDL_SeekIO(iodata->src, offset, SDL_IO_SEEK_SET);
+    if (result >= 0) {
+        iodata->offset = result;
+        iodata->read_pos = 0;
+        iodata->read_len = 0;
+    }
+    return result;
+}
+
+static size_t SDLCALL buffered_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    Uint8 *dst = (Uint8 *)ptr;
+    size_t total = 0;
+    size_t bytes;
+
+    if (!buffered_write_pending(iodata, status)) {
+        return 0;
+    }
+
+    bytes = SDL_min(size, iodata->read_len - iodata->read_pos);
+    if (bytes > 0) {
+        SDL_memcpy(dst, iodata->buffer + iodata->read_pos, bytes);
+        iodata->read_pos += bytes;
+        total += bytes;
+        size -= bytes;
+        if (size == 0) {
+            return total;
+        }
+        dst += bytes;
+    }
+
+    // The buffer is used up, go to the source once for the rest
+    iodata->offset += iodata->read_len;
+    iodata->read_pos = 0;
+    iodata->read_len = 0;
+
+    if (size >= iodata->size) {
+        bytes = SDL_ReadIO(iodata->src, dst, size);
+        iodata->offset += bytes;
+    } else {
+        iodata->read_len = SDL_ReadIO(iodata->src, iodata->buffer, iodata->size);
+        bytes = SDL_min(size, iodata->read_len);
+        SDL_memcpy(dst, iodata->buffer, bytes);
+        iodata->read_pos = bytes;
+    }
+    if (bytes == 0) {
+        buffered_update_status(iodata, status);
+    }
+    return total + bytes;
+}
+
+static size_t SDLCALL buffered_write(void *userdata, const void *ptr, size_t size, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    size_t bytes;
+
+    if (iodata->read_len > 0 && !buffered_drop_readahead(iodata)) {
+        return 0;
+    }
+
+    if (size > iodata->size - iodata->write_len) {
+        if (!buffered_write_pending(iodata, status)) {
+            return 0;
+        }
+    }
+
+    if (size >= iodata->size) {
+        bytes = SDL_WriteIO(iodata->src, ptr, size);
+        iodata->offset += bytes;
+        if (bytes == 0) {
+            buffered_update_status(iodata, status);
+        }
+        return bytes;
+    }
+
+    SDL_memcpy(iodata->buffer + iodata->write_len, ptr, size);
+    iodata->write_len += size;
+    return size;
+}
+
+static bool SDLCALL buffered_flush(void *userdata, SDL_IOStatus *status)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+
+    if (!buffered_write_pending(iodata, status)) {
+        return false;
+    }
+    if (!SDL_FlushIO(iodata->src)) {
+        buffered_update_status(iodata, status);
+        return false;
+    }
+    return true;
+}
+
+static bool SDLCALL buffered_close(void *userdata)
+{
+    IOStreamBufferedData *iodata = (IOStreamBufferedData *) userdata;
+    SDL_IOStatus status = SDL_IO_STATUS_READY;
+    bool result = buffered_write_pending(iodata, &status);
+
+    if (iodata->closeio) {
+        if (!SDL_CloseIO(iodata->src)) {
+            result = false;
+        }
+    } else if (iodata->seekable && iodata->read_len > 0) {
+        buffered_drop_readahead(iodata);
+    }
+    SDL_free(iodata->buffer);
+    SDL_free(iodata);
+    return result;
+}
+
+SDL_IOStream *SDL_IOFromBufferedIO(SDL_IOStream *src, size_t buffer_size, bool closeio)
+{
+    IOStreamBufferedData *iodata = NULL;
+    SDL_IOStream *iostr = NULL;
+
+    if (!src) {
+        SDL_InvalidParamError("src");
+        goto done;
+    }
+    if (buffer_size == 0) {
+        buffer_size = DEFAULT_BUFFERED_IO_SIZE;
+    }
+
+    iodata = (IOStreamBufferedData *) SDL_calloc(1, sizeof (*iodata));
+    if (!iodata) {
+        goto done;
+    }
+    iodata->buffer = (Uint8 *)SDL_malloc(buffer_size);
+    if (!iodata->buffer) {
+        goto done;
+    }
+    iodata->src = src;
+    iodata->closeio = closeio;
+    iodata->size = buffer_size;
+    iodata->offset = SDL_TellIO(src);
+    if (iodata->offset >= 0) {
+        iodata->seekable = true;
+    } else {
+        iodata->offset = 0;
+    }
+
+    SDL_IOStreamInterface iface;
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = buffered_size;
+    iface.seek = buffered_seek;
+    iface.read = buffered_read;
+    iface.write = buffered_write;
+    iface.flush = buffered_flush;
+    iface.close = buffered_close;
+
+    iostr = SDL_OpenIO(&iface, iodata);
+
+done:
+    if (!iostr) {
+        if (iodata) {
+            SDL_free(iodata->buffer);
+            SDL_free(iodata);
+        }
+        if (closeio && src) {
+            SDL_CloseIO(src);
+        }
+    }
+    return iostr;
+}
+
 SDL_IOStatus SDL_GetIOStatus(SDL_IOStream *context)
 {
     if (!context) {
@@ -1438,12 +1992,27 @@ bool SDL_FlushIO(SDL_IOStream *context)
 
 // Functions for dynamically reading and writing endian-specific values
 
+// Small reads from a buffered stream come straight out of its buffer, skipping the SDL_ReadIO() bookkeeping
+static SDL_INLINE bool SDL_ReadIOValue(SDL_IOStream *src, void *ptr, size_t size)
+{
+    if (src && src->iface.read == buffered_read) {
+        IOStreamBufferedData *iodata = (IOStreamBufferedData *) src->userdata;
+        if (size <= iodata->read_len - iodata->read_pos) {
+            SDL_memcpy(ptr, iodata->buffer + iodata->read_pos, size);
+            iodata->read_pos += size;
+            src->status = SDL_IO_STATUS_READY;
+            return true;
+        }
+    }
+    return (SDL_ReadIO(src, ptr, size) == size);
+}
+
 bool SDL_ReadU8(SDL_IOStream *src, Uint8 *value)
 {
     Uint8 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1457,7 +2026,7 @@ bool SDL_ReadS8(SDL_IOStream *src, Sint8 *value)
     Sint8 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1471,7 +2040,7 @@ bool SDL_ReadU16LE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1490,7 +2059,7 @@ bool SDL_ReadU16BE(SDL_IOStream *src, Uint16 *value)
     Uint16 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1509,7 +2078,7 @@ bool SDL_ReadU32LE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1528,7 +2097,7 @@ bool SDL_ReadU32BE(SDL_IOStream *src, Uint32 *value)
     Uint32 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1547,7 +2116,7 @@ bool SDL_ReadU64LE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
@@ -1566,7 +2135,7 @@ bool SDL_ReadU64BE(SDL_IOStream *src, Uint64 *value)
     Uint64 data = 0;
     bool result = false;
 
-    if (SDL_ReadIO(src, &data, sizeof(data)) == sizeof(data)) {
+    if (SDL_ReadIOValue(src, &data, sizeof(data))) {
         result = true;
     }
     if (value) {
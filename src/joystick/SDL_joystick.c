@@ -31,6 +31,7 @@
 #include "../events/SDL_events_c.h"
 #include "../video/SDL_sysvideo.h"
 #include "../sensor/SDL_sensor_c.h"
+#include "../thread/SDL_thread_c.h"
 #include "hidapi/SDL_hidapijoystick_c.h"
 
 // This is included in only one place because it has a large static list of controllers
@@ -817,7 +818,7 @@ bool SDL_InitJoysticks(void)
 
     // Create the joystick list lock
     if (SDL_joystick_lock == NULL) {
-        SDL_joystick_lock = SDL_CreateMutex();
+        SDL_joystick_lock = SDL_CreateNamedMutex("SDL_joystick_lock");
     }
 
     if (!SDL_InitSubSystem(SDL_INIT_EVENTS)) {
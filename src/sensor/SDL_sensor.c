@@ -26,6 +26,7 @@
 
 #include "../events/SDL_events_c.h"
 #include "../joystick/SDL_gamepad_c.h"
+#include "../thread/SDL_thread_c.h"
 
 static SDL_SensorDriver *SDL_sensor_drivers[] = {
 #ifdef SDL_SENSOR_ANDROID
@@ -127,7 +128,7 @@ bool SDL_InitSensors(void)
 
     // Create the sensor list lock
     if (SDL_sensor_lock == NULL) {
-        SDL_sensor_lock = SDL_CreateMutex();
+        SDL_sensor_lock = SDL_CreateNamedMutex("SDL_sensor_lock");
     }
 
     if (!SDL_InitSubSystem(SDL_INIT_EVENTS)) {
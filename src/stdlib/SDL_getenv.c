@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "SDL_getenv_c.h"
+#include "../SDL_hints_c.h"
 
 #if defined(SDL_PLATFORM_WINDOWS)
 #include "../core/windows/SDL_windows.h"
@@ -78,6 +79,7 @@ void SDL_QuitEnvironment(void)
     if (env) {
         SDL_environment = NULL;
         SDL_DestroyEnvironment(env);
+        SDL_InvalidateHintCache();
     }
 }
 
@@ -280,6 +282,10 @@ bool SDL_SetEnvironmentVariable(SDL_Environment *env, const char *name, const ch
     }
     SDL_UnlockMutex(env->lock);
 
+    if (result && env == SDL_environment) {
+        // Hints can come from the environment
+        SDL_InvalidateHintCache();
+    }
     return result;
 }
 
@@ -304,6 +310,9 @@ bool SDL_UnsetEnvironmentVariable(SDL_Environment *env, const char *name)
     }
     SDL_UnlockMutex(env->lock);
 
+    if (result && env == SDL_environment) {
+        SDL_InvalidateHintCache();
+    }
     return result;
 }
 
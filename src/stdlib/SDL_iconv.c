@@ -22,6 +22,8 @@
 
 // This file contains portable iconv functions for SDL
 
+#include "SDL_sysstdlib.h"
+
 #if defined(HAVE_ICONV) && defined(HAVE_ICONV_H)
 #ifndef SDL_USE_LIBICONV
 // Define LIBICONV_PLUG to use iconv from the base instead of ports and avoid linker errors.
@@ -787,6 +789,474 @@ int SDL_iconv_close(SDL_iconv_t cd)
 
 #endif // !HAVE_ICONV
 
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+/* Fast paths for the conversions SDL does most, between UTF-8 and little
+   endian UTF-16 or UCS-4, for large text like clipboard contents.
+
+   These validate the whole input first and only handle well formed text,
+   anything else goes through SDL_iconv() so that invalid sequences are
+   treated the same way regardless of the iconv implementation. Noncharacters
+   U+FFFE and U+FFFF are left to SDL_iconv() for the same reason.
+*/
+typedef enum
+{
+    FAST_ENCODING_UNKNOWN,
+    FAST_ENCODING_UTF8,
+    FAST_ENCODING_UTF16LE,
+    FAST_ENCODING_UCS4LE
+} SDL_FastEncoding;
+
+static SDL_FastEncoding GetFastEncoding(const char *code)
+{
+    static const struct
+    {
+        const char *name;
+        SDL_FastEncoding encoding;
+    } fast_encodings[] = {
+        /* *INDENT-OFF* */ // clang-format off
+        { "UTF8", FAST_ENCODING_UTF8 },
+        { "UTF-8", FAST_ENCODING_UTF8 },
+        { "UTF16LE", FAST_ENCODING_UTF16LE },
+        { "UTF-16LE", FAST_ENCODING_UTF16LE },
+        { "UTF32LE", FAST_ENCODING_UCS4LE },
+        { "UTF-32LE", FAST_ENCODING_UCS4LE },
+        { "UCS-4LE", FAST_ENCODING_UCS4LE },
+        { "UCS-4-INTERNAL", FAST_ENCODING_UCS4LE },
+#if defined(SDL_PLATFORM_WINDOWS) || defined(SDL_PLATFORM_OS2)
+        { "WCHAR_T", FAST_ENCODING_UTF16LE },
+#else
+        { "WCHAR_T", FAST_ENCODING_UCS4LE },
+#endif
+        /* *INDENT-ON* */ // clang-format on
+    };
+
+    for (int i = 0; i < SDL_arraysize(fast_encodings); ++i) {
+        if (SDL_strcasecmp(code, fast_encodings[i].name) == 0) {
+            return fast_encodings[i].encoding;
+        }
+    }
+    return FAST_ENCODING_UNKNOWN;
+}
+
+// Decodes a multi-byte UTF-8 sequence, returns its length, or 0 if it isn't valid
+static size_t DecodeUTF8Sequence(const Uint8 *src, size_t srclen, Uint32 *codepoint)
+{
+    const Uint8 c = src[0];
+    Uint32 ch;
+
+    if (c >= 0xC2 && c <= 0xDF) {
+        if (srclen < 2 || (src[1] & 0xC0) != 0x80) {
+            return 0;
+        }
+        *codepoint = ((Uint32)(c & 0x1F) << 6) | (src[1] & 0x3F);
+        return 2;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        if (srclen < 3 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80) {
+            return 0;
+        }
+        ch = ((Uint32)(c & 0x0F) << 12) | ((Uint32)(src[1] & 0x3F) << 6) | (src[2] & 0x3F);
+        if (ch < 0x800 || (ch >= 0xD800 && ch <= 0xDFFF) || ch >= 0xFFFE) {
+            return 0;
+        }
+        *codepoint = ch;
+        return 3;
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        if (srclen < 4 || (src[1] & 0xC0) != 0x80 || (src[2] & 0xC0) != 0x80 || (src[3] & 0xC0) != 0x80) {
+            return 0;
+        }
+        ch = ((Uint32)(c & 0x07) << 18) | ((Uint32)(src[1] & 0x3F) << 12) | ((Uint32)(src[2] & 0x3F) << 6) | (src[3] & 0x3F);
+        if (ch < 0x10000 || ch > 0x10FFFF) {
+            return 0;
+        }
+        *codepoint = ch;
+        return 4;
+    }
+    return 0;
+}
+
+static size_t EncodeUTF8(Uint32 ch, Uint8 *dst)
+{
+    if (ch <= 0x7F) {
+        dst[0] = (Uint8)ch;
+        return 1;
+    } else if (ch <= 0x7FF) {
+        dst[0] = 0xC0 | (Uint8)(ch >> 6);
+        dst[1] = 0x80 | (Uint8)(ch & 0x3F);
+        return 2;
+    } else if (ch <= 0xFFFF) {
+        dst[0] = 0xE0 | (Uint8)(ch >> 12);
+        dst[1] = 0x80 | (Uint8)((ch >> 6) & 0x3F);
+        dst[2] = 0x80 | (Uint8)(ch & 0x3F);
+        return 3;
+    } else {
+        dst[0] = 0xF0 | (Uint8)(ch >> 18);
+        dst[1] = 0x80 | (Uint8)((ch >> 12) & 0x3F);
+        dst[2] = 0x80 | (Uint8)((ch >> 6) & 0x3F);
+        dst[3] = 0x80 | (Uint8)(ch & 0x3F);
+        return 4;
+    }
+}
+
+// Validates UTF-8 and counts the code units needed to store it as UTF-16 and UCS-4
+static bool ValidateUTF8(const Uint8 *src, size_t srclen, size_t *utf16_units, size_t *ucs4_units)
+{
+    size_t utf16 = 0;
+    size_t ucs4 = 0;
+    size_t i = 0;
+
+    while (i < srclen) {
+        if (src[i] < 0x80) {
+            const size_t ascii = SDL_ScanASCII((const char *)src + i, srclen - i);
+            utf16 += ascii;
+            ucs4 += ascii;
+            i += ascii;
+        } else {
+            Uint32 ch;
+            const size_t len = DecodeUTF8Sequence(src + i, srclen - i, &ch);
+            if (!len) {
+                return false;
+            }
+            utf16 += (ch >= 0x10000) ? 2 : 1;
+            ucs4 += 1;
+            i += len;
+        }
+    }
+    *utf16_units = utf16;
+    *ucs4_units = ucs4;
+    return true;
+}
+
+// The SIMD paths below store whole blocks and then only advance past the ASCII
+//  part, so they may write this far past the end of the converted text. The
+//  terminator is written once the conversion is done.
+#define CONVERSION_SLACK 64
+
+SDL_FORCE_INLINE int CountTrailingZeros(Uint32 mask)
+{
+    return SDL_MostSignificantBitIndex32(mask & (~mask + 1));
+}
+
+static char *AllocateConversion(size_t size)
+{
+    return (char *)SDL_malloc(size + CONVERSION_SLACK + sizeof(Uint32));
+}
+
+// The conversions to UTF-16 and UCS-4 mostly gain on runs of ASCII. Text that is mostly multibyte
+// characters, like CJK, converts faster in a single pass through SDL_iconv(), so sample the start of it.
+static bool IsMostlyASCII(const Uint8 *src, size_t srclen)
+{
+    const size_t len = SDL_min(srclen, 256);
+    size_t ascii = 0;
+
+    for (size_t i = 0; i < len; ++i) {
+        ascii += (src[i] < 0x80);
+    }
+    return (ascii * 2) >= len;
+}
+
+static char *ConvertUTF8ToUTF8(const Uint8 *src, size_t srclen)
+{
+    size_t utf16_units, ucs4_units;
+    if (!ValidateUTF8(src, srclen, &utf16_units, &ucs4_units)) {
+        return NULL;
+    }
+
+    char *string = AllocateConversion(srclen);
+    if (string) {
+        SDL_memcpy(string, src, srclen);
+        SDL_memset(string + srclen, 0, sizeof(Uint32));
+    }
+    return string;
+}
+
+static char *ConvertUTF8ToUTF16LE(const Uint8 *src, size_t srclen)
+{
+    size_t utf16_units, ucs4_units;
+    if (!ValidateUTF8(src, srclen, &utf16_units, &ucs4_units)) {
+        return NULL;
+    }
+
+    char *string = AllocateConversion(utf16_units * sizeof(Uint16));
+    if (!string) {
+        return NULL;
+    }
+
+    Uint16 *dst = (Uint16 *)string;
+    size_t i = 0;
+    while (i < srclen) {
+#if defined(SDL_STDLIB_USE_SSE2)
+        if (src[i] < 0x80 && (srclen - i) >= 16) {
+            const __m128i chunk = _mm_loadu_si128((const __m128i *)(src + i));
+            const __m128i zero = _mm_setzero_si128();
+            const Uint32 mask = (Uint32)_mm_movemask_epi8(chunk);
+            const size_t ascii = mask ? CountTrailingZeros(mask) : 16;
+            _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi8(chunk, zero));
+            _mm_storeu_si128((__m128i *)(dst + 8), _mm_unpackhi_epi8(chunk, zero));
+            dst += ascii;
+            i += ascii;
+            if (i == srclen) {
+                break;
+            }
+        }
+#elif defined(SDL_STDLIB_USE_NEON)
+        if (src[i] < 0x80 && (srclen - i) >= 16) {
+            const uint8x16_t chunk = vld1q_u8(src + i);
+            if ((vmaxvq_u8(chunk) & 0x80) == 0) {
+                vst1q_u16(dst, vmovl_u8(vget_low_u8(chunk)));
+                vst1q_u16(dst + 8, vmovl_high_u8(chunk));
+                dst += 16;
+                i += 16;
+                continue;
+            }
+        }
+#endif
+        if (src[i] < 0x80) {
+            *dst++ = src[i++];
+        } else {
+            Uint32 ch = 0;
+            i += DecodeUTF8Sequence(src + i, srclen - i, &ch);
+            if (ch >= 0x10000) {
+                ch -= 0x10000;
+                *dst++ = (Uint16)(0xD800 | (ch >> 10));
+                *dst++ = (Uint16)(0xDC00 | (ch & 0x3FF));
+            } else {
+                *dst++ = (Uint16)ch;
+            }
+        }
+    }
+    SDL_memset(dst, 0, sizeof(Uint32));
+    return string;
+}
+
+static char *ConvertUTF8ToUCS4LE(const Uint8 *src, size_t srclen)
+{
+    size_t utf16_units, ucs4_units;
+    if (!ValidateUTF8(src, srclen, &utf16_units, &ucs4_units)) {
+        return NULL;
+    }
+
+    char *string = AllocateConversion(ucs4_units * sizeof(Uint32));
+    if (!string) {
+        return NULL;
+    }
+
+    Uint32 *dst = (Uint32 *)string;
+    size_t i = 0;
+    while (i < srclen) {
+#if defined(SDL_STDLIB_USE_SSE2)
+        if (src[i] < 0x80 && (srclen - i) >= 16) {
+            const __m128i chunk = _mm_loadu_si128((const __m128i *)(src + i));
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i lo = _mm_unpacklo_epi8(chunk, zero);
+            const __m128i hi = _mm_unpackhi_epi8(chunk, zero);
+            const Uint32 mask = (Uint32)_mm_movemask_epi8(chunk);
+            const size_t ascii = mask ? CountTrailingZeros(mask) : 16;
+            _mm_storeu_si128((__m128i *)dst, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i *)(dst + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i *)(dst + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i *)(dst + 12), _mm_unpackhi_epi16(hi, zero));
+            dst += ascii;
+            i += ascii;
+            if (i == srclen) {
+                break;
+            }
+        }
+#elif defined(SDL_STDLIB_USE_NEON)
+        if (src[i] < 0x80 && (srclen - i) >= 16) {
+            const uint8x16_t chunk = vld1q_u8(src + i);
+            if ((vmaxvq_u8(chunk) & 0x80) == 0) {
+                const uint16x8_t lo = vmovl_u8(vget_low_u8(chunk));
+                const uint16x8_t hi = vmovl_high_u8(chunk);
+                vst1q_u32(dst, vmovl_u16(vget_low_u16(lo)));
+                vst1q_u32(dst + 4, vmovl_high_u16(lo));
+                vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(hi)));
+                vst1q_u32(dst + 12, vmovl_high_u16(hi));
+                dst += 16;
+                i += 16;
+                continue;
+            }
+        }
+#endif
+        if (src[i] < 0x80) {
+            *dst++ = src[i++];
+        } else {
+            Uint32 ch = 0;
+            i += DecodeUTF8Sequence(src + i, srclen - i, &ch);
+            *dst++ = ch;
+        }
+    }
+    SDL_memset(dst, 0, sizeof(Uint32));
+    return string;
+}
+
+static char *ConvertUTF16LEToUTF8(const Uint16 *src, size_t srclen)
+{
+    size_t size = 0;
+    size_t i;
+
+    // Validate the surrogate pairs and count the output size
+    for (i = 0; i < srclen; ++i) {
+        const Uint16 ch = src[i];
+        if (ch < 0x80) {
+            size += 1;
+        } else if (ch < 0x800) {
+            size += 2;
+        } else if (ch >= 0xD800 && ch <= 0xDBFF) {
+            if ((i + 1) >= srclen || src[i + 1] < 0xDC00 || src[i + 1] > 0xDFFF) {
+                return NULL;
+            }
+            size += 4;
+            ++i;
+        } else if ((ch >= 0xDC00 && ch <= 0xDFFF) || ch >= 0xFFFE) {
+            return NULL;
+        } else {
+            size += 3;
+        }
+    }
+
+    char *string = AllocateConversion(size);
+    if (!string) {
+        return NULL;
+    }
+
+    Uint8 *dst = (Uint8 *)string;
+    i = 0;
+    while (i < srclen) {
+#if defined(SDL_STDLIB_USE_SSE2)
+        if (src[i] < 0x80 && (srclen - i) >= 8) {
+            const __m128i chunk = _mm_loadu_si128((const __m128i *)(src + i));
+            const __m128i high = _mm_and_si128(chunk, _mm_set1_epi16((short)0xFF80));
+            const Uint32 mask = (Uint32)_mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) ^ 0xFFFF;
+            const size_t ascii = mask ? (CountTrailingZeros(mask) / 2) : 8;
+            _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(chunk, chunk));
+            dst += ascii;
+            i += ascii;
+            if (i == srclen) {
+                break;
+            }
+        }
+#elif defined(SDL_STDLIB_USE_NEON)
+        if (src[i] < 0x80 && (srclen - i) >= 8) {
+            const uint16x8_t chunk = vld1q_u16(src + i);
+            if (vmaxvq_u16(chunk) < 0x80) {
+                vst1_u8(dst, vmovn_u16(chunk));
+                dst += 8;
+                i += 8;
+                continue;
+            }
+        }
+#endif
+        Uint32 ch = src[i++];
+        if (ch >= 0xD800 && ch <= 0xDBFF) {
+            ch = (((ch & 0x3FF) << 10) | (src[i++] & 0x3FF)) + 0x10000;
+        }
+        dst += EncodeUTF8(ch, dst);
+    }
+    SDL_memset(dst, 0, sizeof(Uint32));
+    return string;
+}
+
+static char *ConvertUCS4LEToUTF8(const Uint32 *src, size_t srclen)
+{
+    size_t size = 0;
+    size_t i;
+
+    for (i = 0; i < srclen; ++i) {
+        const Uint32 ch = src[i];
+        if (ch < 0x80) {
+            size += 1;
+        } else if (ch < 0x800) {
+            size += 2;
+        } else if (ch < 0x10000) {
+            if ((ch >= 0xD800 && ch <= 0xDFFF) || ch >= 0xFFFE) {
+                return NULL;
+            }
+            size += 3;
+        } else if (ch <= 0x10FFFF) {
+            size += 4;
+        } else {
+            return NULL;
+        }
+    }
+
+    char *string = AllocateConversion(size);
+    if (!string) {
+        return NULL;
+    }
+
+    Uint8 *dst = (Uint8 *)string;
+    i = 0;
+    while (i < srclen) {
+#if defined(SDL_STDLIB_USE_SSE2)
+        if (src[i] < 0x80 && (srclen - i) >= 8) {
+            const __m128i lo = _mm_loadu_si128((const __m128i *)(src + i));
+            const __m128i hi = _mm_loadu_si128((const __m128i *)(src + i + 4));
+            const __m128i high = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi32((int)0xFFFFFF80));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xFFFF) {
+                const __m128i words = _mm_packs_epi32(lo, hi);
+                _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(words, words));
+                dst += 8;
+                i += 8;
+                continue;
+            }
+        }
+#elif defined(SDL_STDLIB_USE_NEON)
+        if (src[i] < 0x80 && (srclen - i) >= 8) {
+            const uint32x4_t lo = vld1q_u32(src + i);
+            const uint32x4_t hi = vld1q_u32(src + i + 4);
+            if (vmaxvq_u32(vorrq_u32(lo, hi)) < 0x80) {
+                vst1_u8(dst, vmovn_u16(vcombine_u16(vmovn_u32(lo), vmovn_u32(hi))));
+                dst += 8;
+                i += 8;
+                continue;
+            }
+        }
+#endif
+        dst += EncodeUTF8(src[i++], dst);
+    }
+    SDL_memset(dst, 0, sizeof(Uint32));
+    return string;
+}
+
+// Returns NULL if this conversion doesn't have a fast path or the input isn't valid
+static char *SDL_iconv_string_fast(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft)
+{
+    const SDL_FastEncoding to = GetFastEncoding(tocode);
+    const SDL_FastEncoding from = GetFastEncoding(fromcode);
+
+    if (!inbuf || !inbytesleft) {
+        return NULL;
+    }
+
+    if (from == FAST_ENCODING_UTF8) {
+        switch (to) {
+        case FAST_ENCODING_UTF8:
+            return ConvertUTF8ToUTF8((const Uint8 *)inbuf, inbytesleft);
+        case FAST_ENCODING_UTF16LE:
+            if (IsMostlyASCII((const Uint8 *)inbuf, inbytesleft)) {
+                return ConvertUTF8ToUTF16LE((const Uint8 *)inbuf, inbytesleft);
+            }
+            break;
+        case FAST_ENCODING_UCS4LE:
+            if (IsMostlyASCII((const Uint8 *)inbuf, inbytesleft)) {
+                return ConvertUTF8ToUCS4LE((const Uint8 *)inbuf, inbytesleft);
+            }
+            break;
+        default:
+            break;
+        }
+    } else if (to == FAST_ENCODING_UTF8) {
+        // The input might not be aligned, in which case SDL_iconv() will handle it
+        if (from == FAST_ENCODING_UTF16LE && (inbytesleft % 2) == 0 && ((uintptr_t)inbuf % sizeof(Uint16)) == 0) {
+            return ConvertUTF16LEToUTF8((const Uint16 *)inbuf, inbytesleft / 2);
+        } else if (from == FAST_ENCODING_UCS4LE && (inbytesleft % 4) == 0 && ((uintptr_t)inbuf % sizeof(Uint32)) == 0) {
+            return ConvertUCS4LEToUTF8((const Uint32 *)inbuf, inbytesleft / 4);
+        }
+    }
+    return NULL;
+}
+#endif // SDL_BYTEORDER == SDL_LIL_ENDIAN
+
 char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inbuf, size_t inbytesleft)
 {
     SDL_iconv_t cd;
@@ -802,6 +1272,14 @@ char *SDL_iconv_string(const char *tocode, const char *fromcode, const char *inb
     if (!fromcode || !*fromcode) {
         fromcode = "UTF-8";
     }
+
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    string = SDL_iconv_string_fast(tocode, fromcode, inbuf, inbytesleft);
+    if (string) {
+        return string;
+    }
+#endif
+
     cd = SDL_iconv_open(tocode, fromcode);
     if (cd == (SDL_iconv_t)-1) {
         return NULL;
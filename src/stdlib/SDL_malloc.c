@@ -19,6 +19,7 @@
   3. This notice may not be removed or altered from any source distribution.
 */
 #include "SDL_internal.h"
+#include "SDL_sysstdlib.h"
 
 /* This file contains portable memory management functions for SDL */
 
@@ -6354,8 +6355,10 @@ static struct
     SDL_realloc_func realloc_func;
     SDL_free_func free_func;
     SDL_AtomicInt num_allocations;
+    bool used;
+    bool thread_cache;
 } s_mem = {
-    real_malloc, real_calloc, real_realloc, real_free, { 0 }
+    real_malloc, real_calloc, real_realloc, real_free, { 0 }, false, false
 };
 
 // Define this if you want to track the number of allocations active
@@ -6368,6 +6371,392 @@ static struct
 #define DECREMENT_ALLOCATION_COUNT()
 #endif
 
+// Only checked before it's set, so this doesn't bounce a cache line between threads
+#define MARK_MEMORY_USED()      \
+    do {                        \
+        if (!s_mem.used) {      \
+            s_mem.used = true;  \
+        }                       \
+    } while (0)
+
+// The thread cache needs compiler supported thread-local storage, because SDL_SetTLS() allocates memory
+#ifndef SDL_THREADS_DISABLED
+#ifdef _MSC_VER
+#define SDL_MEMCACHE_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__) && (defined(SDL_PLATFORM_LINUX) || defined(SDL_PLATFORM_APPLE) || defined(SDL_PLATFORM_WINDOWS) || \
+                            defined(SDL_PLATFORM_FREEBSD) || defined(SDL_PLATFORM_NETBSD) || defined(SDL_PLATFORM_OPENBSD))
+#define SDL_MEMCACHE_THREAD_LOCAL __thread
+#endif
+#endif
+#ifdef SDL_MEMCACHE_THREAD_LOCAL
+#define SDL_MEMORY_THREAD_CACHE
+#endif
+
+#ifdef SDL_MEMORY_THREAD_CACHE
+
+/* When the thread cache is enabled, every allocation gets a small header in
+   front of it recording its size class and the allocator it came from, so
+   SDL_free() knows where it belongs even after SDL_SetMemoryFunctions().
+   Large blocks also record the allocator's realloc function, in a second
+   header in front of the first one.
+
+   Small blocks are kept on per-thread freelists. When a thread frees more
+   than it will reuse, half of that freelist moves to a shared depot as one
+   batch, and threads that run dry take a whole batch back from the depot.
+   Only when the depot is empty or full does the underlying allocator (and
+   its lock) get involved.
+ */
+#define MEMCACHE_NUM_CLASSES    20
+#define MEMCACHE_MAX_SIZE       1024
+#define MEMCACHE_LARGE          0xFFFFFFFF
+#define MEMCACHE_CLASS_BYTES    (16 * 1024) // roughly how much a thread keeps per size class
+#define MEMCACHE_DEPOT_BATCHES  8
+
+typedef union SDL_MemCacheBlock
+{
+    struct
+    {
+        union
+        {
+            union SDL_MemCacheBlock *next; // while the block is cached
+            SDL_free_func free_func;       // while the block is in use
+        } link;
+        Uint32 size_class;
+    } info;
+    Uint8 padding[16]; // keeps the caller's memory 16 byte aligned
+} SDL_MemCacheBlock;
+
+typedef union SDL_MemCacheLargeBlock
+{
+    SDL_realloc_func realloc_func;
+    Uint8 padding[16];
+} SDL_MemCacheLargeBlock;
+
+#define MEMCACHE_LARGE_HEADER (sizeof(SDL_MemCacheLargeBlock) + sizeof(SDL_MemCacheBlock))
+
+typedef struct SDL_MemCacheBin
+{
+    SDL_MemCacheBlock *head;
+    int count;
+} SDL_MemCacheBin;
+
+typedef struct SDL_MemThreadCache
+{
+    SDL_MemCacheBin bins[MEMCACHE_NUM_CLASSES];
+    SDL_free_func free_func; // the allocator the cached blocks came from
+    bool registered;
+} SDL_MemThreadCache;
+
+typedef struct SDL_MemCacheDepot
+{
+    SDL_SpinLock lock;
+    int num_batches;
+    SDL_MemCacheBlock *batches[MEMCACHE_DEPOT_BATCHES];
+    int counts[MEMCACHE_DEPOT_BATCHES];
+} SDL_MemCacheDepot;
+
+static const Uint32 memcache_sizes[MEMCACHE_NUM_CLASSES] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    160, 192, 224, 256, 320, 384, 448, 512,
+    640, 768, 896, 1024
+};
+
+static SDL_MEMCACHE_THREAD_LOCAL SDL_MemThreadCache memcache_thread;
+static SDL_MemCacheDepot memcache_depot[MEMCACHE_NUM_CLASSES];
+static SDL_TLSID memcache_tls;
+
+static Uint32 memcache_class(size_t size)
+{
+    Uint32 bits;
+
+    SDL_assert(size > 0 && size <= MEMCACHE_MAX_SIZE);
+
+    if (size <= 128) {
+        return (Uint32)(size - 1) >> 4;
+    }
+
+    // There are four size classes for each power of two above 128 bytes
+    bits = (Uint32)SDL_MostSignificantBitIndex32((Uint32)(size - 1));
+    return 8 + (bits - 7) * 4 + ((Uint32)(size - 1) >> (bits - 2)) - 4;
+}
+
+static int memcache_limit(Uint32 size_class)
+{
+    return SDL_clamp((int)(MEMCACHE_CLASS_BYTES / memcache_sizes[size_class]), 16, 64);
+}
+
+static void memcache_release_list(SDL_MemCacheBlock *block, SDL_free_func free_func)
+{
+    while (block) {
+        SDL_MemCacheBlock *next = block->info.link.next;
+        free_func(block);
+        block = next;
+    }
+}
+
+static void memcache_put_batch(Uint32 size_class, SDL_MemCacheBlock *batch, int count)
+{
+    SDL_MemCacheDepot *depot = &memcache_depot[size_class];
+
+    SDL_LockSpinlock(&depot->lock);
+    if (depot->num_batches < MEMCACHE_DEPOT_BATCHES) {
+        depot->batches[depot->num_batches] = batch;
+        depot->counts[depot->num_batches] = count;
+        ++depot->num_batches;
+        batch = NULL;
+    }
+    SDL_UnlockSpinlock(&depot->lock);
+
+    if (batch) {
+        // The depot is full, give the memory back to the allocator
+        memcache_release_list(batch, s_mem.free_func);
+    }
+}
+
+static bool memcache_get_batch(Uint32 size_class, SDL_MemCacheBin *bin)
+{
+    SDL_MemCacheDepot *depot = &memcache_depot[size_class];
+    bool result = false;
+
+    SDL_LockSpinlock(&depot->lock);
+    if (depot->num_batches > 0) {
+        --depot->num_batches;
+        bin->head = depot->batches[depot->num_batches];
+        bin->count = depot->counts[depot->num_batches];
+        result = true;
+    }
+    SDL_UnlockSpinlock(&depot->lock);
+
+    return result;
+}
+
+static void memcache_release_depot(void)
+{
+    Uint32 i;
+
+    for (i = 0; i < MEMCACHE_NUM_CLASSES; ++i) {
+        SDL_MemCacheBin bin = { NULL, 0 };
+        while (memcache_get_batch(i, &bin)) {
+            memcache_release_list(bin.head, s_mem.free_func);
+        }
+    }
+}
+
+static void memcache_flush_thread(SDL_MemThreadCache *cache)
+{
+    Uint32 i;
+
+    for (i = 0; i < MEMCACHE_NUM_CLASSES; ++i) {
+        SDL_MemCacheBin *bin = &cache->bins[i];
+        if (bin->head) {
+            if (cache->free_func == s_mem.free_func) {
+                memcache_put_batch(i, bin->head, bin->count);
+            } else {
+                memcache_release_list(bin->head, cache->free_func);
+            }
+            bin->head = NULL;
+            bin->count = 0;
+        }
+    }
+}
+
+static void SDLCALL memcache_cleanup_thread(void *data)
+{
+    SDL_MemThreadCache *cache = (SDL_MemThreadCache *)data;
+
+    memcache_flush_thread(cache);
+
+    // Anything this thread frees from now on goes straight to the allocator
+    cache->registered = false;
+}
+
+static SDL_MemThreadCache *memcache_get_thread(void)
+{
+    SDL_MemThreadCache *cache = &memcache_thread;
+
+    if (cache->free_func != s_mem.free_func) {
+        // The memory functions changed, don't mix up blocks from different allocators
+        memcache_flush_thread(cache);
+        cache->free_func = s_mem.free_func;
+    }
+
+    if (!cache->registered) {
+        // Set this first, SDL_SetTLS() allocates memory too
+        cache->registered = true;
+        SDL_SetTLS(&memcache_tls, cache, memcache_cleanup_thread);
+    }
+    return cache;
+}
+
+// Fills in the headers of a large block fresh from the current allocator
+static void *memcache_init_large(void *mem)
+{
+    SDL_MemCacheLargeBlock *large = (SDL_MemCacheLargeBlock *)mem;
+    SDL_MemCacheBlock *block = (SDL_MemCacheBlock *)(large + 1);
+
+    large->realloc_func = s_mem.realloc_func;
+    block->info.link.free_func = s_mem.free_func;
+    block->info.size_class = MEMCACHE_LARGE;
+    return block + 1;
+}
+
+static void *memcache_malloc(size_t size)
+{
+    SDL_MemCacheBlock *block;
+    void *mem;
+
+    if (size <= MEMCACHE_MAX_SIZE) {
+        const Uint32 size_class = memcache_class(size);
+        SDL_MemCacheBin *bin = &memcache_get_thread()->bins[size_class];
+
+        if (bin->head || memcache_get_batch(size_class, bin)) {
+            block = bin->head;
+            bin->head = block->info.link.next;
+            --bin->count;
+        } else {
+            block = (SDL_MemCacheBlock *)s_mem.malloc_func(sizeof(*block) + memcache_sizes[size_class]);
+            if (!block) {
+                return NULL;
+            }
+        }
+        block->info.link.free_func = s_mem.free_func;
+        block->info.size_class = size_class;
+        return block + 1;
+    }
+
+    if (size > SDL_SIZE_MAX - MEMCACHE_LARGE_HEADER) {
+        return NULL;
+    }
+    mem = s_mem.malloc_func(MEMCACHE_LARGE_HEADER + size);
+    if (!mem) {
+        return NULL;
+    }
+    return memcache_init_large(mem);
+}
+
+static void *memcache_calloc(size_t nmemb, size_t size)
+{
+    size_t total;
+    void *mem;
+
+    if (!SDL_size_mul_check_overflow(nmemb, size, &total)) {
+        return NULL;
+    }
+
+    if (total <= MEMCACHE_MAX_SIZE) {
+        mem = memcache_malloc(total);
+        if (mem) {
+            SDL_memset(mem, 0, total);
+        }
+        return mem;
+    }
+
+    if (total > SDL_SIZE_MAX - MEMCACHE_LARGE_HEADER) {
+        return NULL;
+    }
+    mem = s_mem.calloc_func(1, MEMCACHE_LARGE_HEADER + total);
+    if (!mem) {
+        return NULL;
+    }
+    return memcache_init_large(mem);
+}
+
+static void memcache_free(void *ptr)
+{
+    SDL_MemCacheBlock *block = (SDL_MemCacheBlock *)ptr - 1;
+    const Uint32 size_class = block->info.size_class;
+    const SDL_free_func free_func = block->info.link.free_func;
+    SDL_MemThreadCache *cache = &memcache_thread;
+    SDL_MemCacheBin *bin;
+    int limit;
+
+    if (size_class == MEMCACHE_LARGE) {
+        free_func((SDL_MemCacheLargeBlock *)block - 1);
+        return;
+    }
+
+    // Only cache blocks from the current allocator, in a cache holding blocks from the current allocator
+    if (!cache->registered || free_func != s_mem.free_func || cache->free_func != s_mem.free_func) {
+        free_func(block);
+        return;
+    }
+
+    bin = &cache->bins[size_class];
+    block->info.link.next = bin->head;
+    bin->head = block;
+    ++bin->count;
+
+    limit = memcache_limit(size_class);
+    if (bin->count > limit) {
+        // Keep the most recently freed half, and share the rest with other threads
+        SDL_MemCacheBlock *last = bin->head;
+        SDL_MemCacheBlock *batch;
+        int i;
+
+        for (i = 1; i < limit / 2; ++i) {
+            last = last->info.link.next;
+        }
+        batch = last->info.link.next;
+        last->info.link.next = NULL;
+        memcache_put_batch(size_class, batch, bin->count - limit / 2);
+        bin->count = limit / 2;
+    }
+}
+
+static void *memcache_realloc(void *ptr, size_t size)
+{
+    SDL_MemCacheBlock *block;
+    size_t copy_size;
+    void *mem;
+
+    if (!ptr) {
+        return memcache_malloc(size);
+    }
+
+    block = (SDL_MemCacheBlock *)ptr - 1;
+    if (block->info.size_class == MEMCACHE_LARGE) {
+        if (size > MEMCACHE_MAX_SIZE) {
+            // Grow or shrink it with the allocator it came from, the headers move along with it
+            SDL_MemCacheLargeBlock *large = (SDL_MemCacheLargeBlock *)block - 1;
+
+            if (size > SDL_SIZE_MAX - MEMCACHE_LARGE_HEADER) {
+                return NULL;
+            }
+            mem = large->realloc_func(large, MEMCACHE_LARGE_HEADER + size);
+            if (!mem) {
+                return NULL;
+            }
+            return (Uint8 *)mem + MEMCACHE_LARGE_HEADER;
+        }
+        // Shrinking into a size class, the old block was bigger than that
+        copy_size = size;
+    } else {
+        if (size <= memcache_sizes[block->info.size_class]) {
+            return ptr;
+        }
+        copy_size = memcache_sizes[block->info.size_class];
+    }
+
+    mem = memcache_malloc(size);
+    if (!mem) {
+        return NULL;
+    }
+    SDL_memcpy(mem, ptr, copy_size);
+    memcache_free(ptr);
+    return mem;
+}
+
+#endif // SDL_MEMORY_THREAD_CACHE
+
+void SDL_QuitMemoryCaches(void)
+{
+#ifdef SDL_MEMORY_THREAD_CACHE
+    if (s_mem.thread_cache) {
+        memcache_flush_thread(&memcache_thread);
+        memcache_release_depot();
+    }
+#endif
+}
 
 void SDL_GetOriginalMemoryFunctions(SDL_malloc_func *malloc_func,
                                     SDL_calloc_func *calloc_func,
@@ -6425,6 +6814,13 @@ bool SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
         return SDL_InvalidParamError("free_func");
     }
 
+#ifdef SDL_MEMORY_THREAD_CACHE
+    if (s_mem.thread_cache) {
+        // Blocks sitting in the depot came from the old allocator
+        memcache_release_depot();
+    }
+#endif
+
     s_mem.malloc_func = malloc_func;
     s_mem.calloc_func = calloc_func;
     s_mem.realloc_func = realloc_func;
@@ -6432,6 +6828,23 @@ bool SDL_SetMemoryFunctions(SDL_malloc_func malloc_func,
     return true;
 }
 
+bool SDL_SetMemoryThreadCache(bool enabled)
+{
+    if (enabled == s_mem.thread_cache) {
+        return true;
+    }
+
+#ifdef SDL_MEMORY_THREAD_CACHE
+    if (s_mem.used) {
+        return SDL_SetError("Memory has already been allocated");
+    }
+    s_mem.thread_cache = enabled;
+    return true;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 int SDL_GetNumAllocations(void)
 {
 #ifdef SDL_TRACK_ALLOCATION_COUNT
@@ -6449,7 +6862,15 @@ void *SDL_malloc(size_t size)
         size = 1;
     }
 
-    mem = s_mem.malloc_func(size);
+    MARK_MEMORY_USED();
+#ifdef SDL_MEMORY_THREAD_CACHE
+    if (s_mem.thread_cache) {
+        mem = memcache_malloc(size);
+    } else
+#endif
+    {
+        mem = s_mem.malloc_func(size);
+    }
     if (mem) {
         INCREMENT_ALLOCATION_COUNT();
     } else {
@@ -6468,7 +6889,15 @@ void *SDL_calloc(size_t nmemb, size_t size)
         size = 1;
     }
 
-    mem = s_mem.calloc_func(nmemb, size);
+    MARK_MEMORY_USED();
+#ifdef SDL_MEMORY_THREAD_CACHE
+    if (s_mem.thread_cache) {
+        mem = memcache_calloc(nmemb, size);
+    } else
+#endif
+    {
+        mem = s_mem.calloc_func(nmemb, size);
+    }
     if (mem) {
         INCREMENT_ALLOCATION_COUNT();
     } else {
@@ -6486,7 +6915,15 @@ void *SDL_realloc(void *ptr, size_t size)
         size = 1;
     }
 
-    mem = s_mem.realloc_func(ptr, size);
+    MARK_MEMORY_USED();
+#ifdef SDL_MEMORY_THREAD_CACHE
+    if (s_mem.thread_cache) {
+        mem = memcache_realloc(ptr, size);
+    } else
+#endif
+    {
+        mem = s_mem.realloc_func(ptr, size);
+    }
     if (mem && !ptr) {
         INCREMENT_ALLOCATION_COUNT();
     } else if (!mem) {
@@ -6502,6 +6939,13 @@ void SDL_free(void *ptr)
         return;
     }
 
-    s_mem.free_func(ptr);
+#ifdef SDL_MEMORY_THREAD_CACHE
+    if (s_mem.thread_cache) {
+        memcache_free(ptr);
+    } else
+#endif
+    {
+        s_mem.free_func(ptr);
+    }
     DECREMENT_ALLOCATION_COUNT();
 }
@@ -20,6 +20,191 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_sysstdlib.h"
+#include "../cpuinfo/SDL_cpuinfo_c.h"
+
+// Smaller copies aren't worth setting up the vector loops for
+#define SDL_MEMCPY_VECTOR_MIN 64
+
+// Server CPUs report caches of hundreds of megabytes, shared by dozens of cores
+#define SDL_NONTEMPORAL_THRESHOLD_MAX (32 * 1024 * 1024)
+
+static size_t SDL_nontemporal_threshold;
+
+bool SDL_UseNonTemporalStores(size_t len)
+{
+    size_t threshold = SDL_nontemporal_threshold;
+    if (!threshold) {
+        // Once a copy doesn't fit in the cache, writing it through the cache just evicts everything else.
+        // Leave some of the cache for the source and whatever else is being worked on.
+        threshold = SDL_min((SDL_GetCPULastLevelCacheSize() / 4) * 3, SDL_NONTEMPORAL_THRESHOLD_MAX);
+        SDL_nontemporal_threshold = threshold;
+    }
+    return len >= threshold;
+}
+
+static void SDL_memcpy_small(Uint8 *dst, const Uint8 *src, size_t len)
+{
+    while (len--) {
+        *dst++ = *src++;
+    }
+}
+
+/* The vector copies all work the same way: the first block is stored unaligned, then the rest
+   is copied with aligned stores from the next aligned address in the destination, and the last
+   block is stored unaligned, ending exactly at the end of the copy. The first and last blocks
+   overlap the aligned ones, but with the same data, so there are no special cases for the
+   ends. This needs at least two blocks of data, which SDL_MEMCPY_VECTOR_MIN guarantees.
+
+   Non-temporal stores only go to whole cache lines: a line that's partly written through the
+   cache and partly streamed is flushed and read back from memory, which halves the bandwidth
+   when copying surfaces row by row. */
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_memcpy_AVX2(Uint8 *dst, const Uint8 *src, size_t len, bool nontemporal)
+{
+    const __m256i last = _mm256_loadu_si256((const __m256i *)(src + len - 32));
+    Uint8 *dst_end = dst + len;
+    size_t head;
+
+    _mm256_storeu_si256((__m256i *)dst, _mm256_loadu_si256((const __m256i *)src));
+    head = 32 - ((uintptr_t)dst & 31);
+    dst += head;
+    src += head;
+    len -= head;
+
+    if (nontemporal) {
+        for (; ((uintptr_t)dst & 63) && len >= 32; len -= 32, src += 32, dst += 32) {
+            _mm256_store_si256((__m256i *)dst, _mm256_loadu_si256((const __m256i *)src));
+        }
+        for (; len >= 128; len -= 128, src += 128, dst += 128) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)(src + 0));
+            const __m256i b = _mm256_loadu_si256((const __m256i *)(src + 32));
+            const __m256i c = _mm256_loadu_si256((const __m256i *)(src + 64));
+            const __m256i d = _mm256_loadu_si256((const __m256i *)(src + 96));
+            _mm256_stream_si256((__m256i *)(dst + 0), a);
+            _mm256_stream_si256((__m256i *)(dst + 32), b);
+            _mm256_stream_si256((__m256i *)(dst + 64), c);
+            _mm256_stream_si256((__m256i *)(dst + 96), d);
+        }
+        _mm_sfence();
+    } else {
+        for (; len >= 128; len -= 128, src += 128, dst += 128) {
+            const __m256i a = _mm256_loadu_si256((const __m256i *)(src + 0));
+            const __m256i b = _mm256_loadu_si256((const __m256i *)(src + 32));
+            const __m256i c = _mm256_loadu_si256((const __m256i *)(src + 64));
+            const __m256i d = _mm256_loadu_si256((const __m256i *)(src + 96));
+            _mm256_store_si256((__m256i *)(dst + 0), a);
+            _mm256_store_si256((__m256i *)(dst + 32), b);
+            _mm256_store_si256((__m256i *)(dst + 64), c);
+            _mm256_store_si256((__m256i *)(dst + 96), d);
+        }
+    }
+    for (; len >= 32; len -= 32, src += 32, dst += 32) {
+        _mm256_store_si256((__m256i *)dst, _mm256_loadu_si256((const __m256i *)src));
+    }
+    _mm256_storeu_si256((__m256i *)(dst_end - 32), last);
+}
+#endif
+
+#if defined(SDL_STDLIB_USE_SSE2)
+static void SDL_memcpy_SSE2(Uint8 *dst, const Uint8 *src, size_t len, bool nontemporal)
+{
+    const __m128i last = _mm_loadu_si128((const __m128i *)(src + len - 16));
+    Uint8 *dst_end = dst + len;
+    size_t head;
+
+    _mm_storeu_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+    head = 16 - ((uintptr_t)dst & 15);
+    dst += head;
+    src += head;
+    len -= head;
+
+    if (nontemporal) {
+        for (; ((uintptr_t)dst & 63) && len >= 16; len -= 16, src += 16, dst += 16) {
+            _mm_store_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+        }
+        for (; len >= 64; len -= 64, src += 64, dst += 64) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(src + 0));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+            const __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+            const __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+            _mm_stream_si128((__m128i *)(dst + 0), a);
+            _mm_stream_si128((__m128i *)(dst + 16), b);
+            _mm_stream_si128((__m128i *)(dst + 32), c);
+            _mm_stream_si128((__m128i *)(dst + 48), d);
+        }
+        _mm_sfence();
+    } else {
+        for (; len >= 64; len -= 64, src += 64, dst += 64) {
+            const __m128i a = _mm_loadu_si128((const __m128i *)(src + 0));
+            const __m128i b = _mm_loadu_si128((const __m128i *)(src + 16));
+            const __m128i c = _mm_loadu_si128((const __m128i *)(src + 32));
+            const __m128i d = _mm_loadu_si128((const __m128i *)(src + 48));
+            _mm_store_si128((__m128i *)(dst + 0), a);
+            _mm_store_si128((__m128i *)(dst + 16), b);
+            _mm_store_si128((__m128i *)(dst + 32), c);
+            _mm_store_si128((__m128i *)(dst + 48), d);
+        }
+    }
+    for (; len >= 16; len -= 16, src += 16, dst += 16) {
+        _mm_store_si128((__m128i *)dst, _mm_loadu_si128((const __m128i *)src));
+    }
+    _mm_storeu_si128((__m128i *)(dst_end - 16), last);
+}
+#elif defined(SDL_STDLIB_USE_NEON)
+// There's no non-temporal hint worth using here, the stores are just aligned
+static void SDL_memcpy_NEON(Uint8 *dst, const Uint8 *src, size_t len)
+{
+    const uint8x16_t last = vld1q_u8(src + len - 16);
+    Uint8 *dst_end = dst + len;
+    size_t head;
+
+    vst1q_u8(dst, vld1q_u8(src));
+    head = 16 - ((uintptr_t)dst & 15);
+    dst += head;
+    src += head;
+    len -= head;
+
+    for (; len >= 64; len -= 64, src += 64, dst += 64) {
+        const uint8x16_t a = vld1q_u8(src + 0);
+        const uint8x16_t b = vld1q_u8(src + 16);
+        const uint8x16_t c = vld1q_u8(src + 32);
+        const uint8x16_t d = vld1q_u8(src + 48);
+        vst1q_u8(dst + 0, a);
+        vst1q_u8(dst + 16, b);
+        vst1q_u8(dst + 32, c);
+        vst1q_u8(dst + 48, d);
+    }
+    for (; len >= 16; len -= 16, src += 16, dst += 16) {
+        vst1q_u8(dst, vld1q_u8(src));
+    }
+    vst1q_u8(dst_end - 16, last);
+}
+#endif
+
+void SDL_memcpy_vector(void *dst, const void *src, size_t len, bool nontemporal)
+{
+    if (len < SDL_MEMCPY_VECTOR_MIN) {
+        SDL_memcpy_small((Uint8 *)dst, (const Uint8 *)src, len);
+        return;
+    }
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_memcpy_AVX2((Uint8 *)dst, (const Uint8 *)src, len, nontemporal);
+        return;
+    }
+#endif
+#if defined(SDL_STDLIB_USE_SSE2)
+    SDL_memcpy_SSE2((Uint8 *)dst, (const Uint8 *)src, len, nontemporal);
+#elif defined(SDL_STDLIB_USE_NEON)
+    SDL_memcpy_NEON((Uint8 *)dst, (const Uint8 *)src, len);
+#else
+    SDL_memcpy_small((Uint8 *)dst, (const Uint8 *)src, len);
+#endif
+}
+
 
 #ifdef SDL_memcpy
 #undef SDL_memcpy
@@ -40,6 +225,11 @@ void *SDL_memcpy(SDL_OUT_BYTECAP(len) void *dst, SDL_IN_BYTECAP(len) const void
     bcopy(src, dst, len);
     return dst;
 #else
+    if (len >= SDL_MEMCPY_VECTOR_MIN) {
+        SDL_memcpy_vector(dst, src, len, SDL_UseNonTemporalStores(len));
+        return dst;
+    }
+
     /* GCC 4.9.0 with -O3 will generate movaps instructions with the loop
        using Uint32* pointers, so we need to make sure the pointers are
        aligned before we loop using them.
@@ -20,6 +20,167 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_sysstdlib.h"
+
+// Smaller fills aren't worth setting up the vector loops for
+#define SDL_MEMSET_VECTOR_MIN 64
+
+static void SDL_memset4_small(Uint8 *dst, Uint32 val, size_t dwords)
+{
+    while (dwords--) {
+        *dst++ = ((Uint8 *)&val)[0];
+        *dst++ = ((Uint8 *)&val)[1];
+        *dst++ = ((Uint8 *)&val)[2];
+        *dst++ = ((Uint8 *)&val)[3];
+    }
+}
+
+/* These work like the vector copies in SDL_memcpy.c: an unaligned first block, aligned blocks
+   from the next aligned address, and an unaligned last block. If the destination isn't 4-byte
+   aligned, the aligned blocks start partway through the pattern, so it's rotated to match.
+   Non-temporal stores only go to whole cache lines, for the same reason as the copies. */
+
+static SDL_INLINE Uint32 SDL_RotatePattern(Uint32 val, size_t offset)
+{
+    const unsigned int shift = (unsigned int)(offset & 3) * 8;
+    if (!shift) {
+        return val;
+    }
+#if SDL_BYTEORDER == SDL_LIL_ENDIAN
+    return (val >> shift) | (val << (32 - shift));
+#else
+    return (val << shift) | (val >> (32 - shift));
+#endif
+}
+
+#ifdef SDL_AVX2_INTRINSICS
+static void SDL_TARGETING("avx2") SDL_memset4_AVX2(Uint8 *dst, Uint32 val, size_t len, bool nontemporal)
+{
+    const __m256i first = _mm256_set1_epi32((int)val);
+    Uint8 *dst_end = dst + len;
+    size_t head;
+    __m256i value;
+
+    _mm256_storeu_si256((__m256i *)dst, first);
+    head = 32 - ((uintptr_t)dst & 31);
+    value = _mm256_set1_epi32((int)SDL_RotatePattern(val, head));
+    dst += head;
+    len -= head;
+
+    if (nontemporal) {
+        for (; ((uintptr_t)dst & 63) && len >= 32; len -= 32, dst += 32) {
+            _mm256_store_si256((__m256i *)dst, value);
+        }
+        for (; len >= 128; len -= 128, dst += 128) {
+            _mm256_stream_si256((__m256i *)(dst + 0), value);
+            _mm256_stream_si256((__m256i *)(dst + 32), value);
+            _mm256_stream_si256((__m256i *)(dst + 64), value);
+            _mm256_stream_si256((__m256i *)(dst + 96), value);
+        }
+        _mm_sfence();
+    } else {
+        for (; len >= 128; len -= 128, dst += 128) {
+            _mm256_store_si256((__m256i *)(dst + 0), value);
+            _mm256_store_si256((__m256i *)(dst + 32), value);
+            _mm256_store_si256((__m256i *)(dst + 64), value);
+            _mm256_store_si256((__m256i *)(dst + 96), value);
+        }
+    }
+    for (; len >= 32; len -= 32, dst += 32) {
+        _mm256_store_si256((__m256i *)dst, value);
+    }
+    // The total length is a multiple of 4, so the last block lines up with the original pattern
+    _mm256_storeu_si256((__m256i *)(dst_end - 32), first);
+}
+#endif
+
+#if defined(SDL_STDLIB_USE_SSE2)
+static void SDL_memset4_SSE2(Uint8 *dst, Uint32 val, size_t len, bool nontemporal)
+{
+    const __m128i first = _mm_set1_epi32((int)val);
+    Uint8 *dst_end = dst + len;
+    size_t head;
+    __m128i value;
+
+    _mm_storeu_si128((__m128i *)dst, first);
+    head = 16 - ((uintptr_t)dst & 15);
+    value = _mm_set1_epi32((int)SDL_RotatePattern(val, head));
+    dst += head;
+    len -= head;
+
+    if (nontemporal) {
+        for (; ((uintptr_t)dst & 63) && len >= 16; len -= 16, dst += 16) {
+            _mm_store_si128((__m128i *)dst, value);
+        }
+        for (; len >= 64; len -= 64, dst += 64) {
+            _mm_stream_si128((__m128i *)(dst + 0), value);
+            _mm_stream_si128((__m128i *)(dst + 16), value);
+            _mm_stream_si128((__m128i *)(dst + 32), value);
+            _mm_stream_si128((__m128i *)(dst + 48), value);
+        }
+        _mm_sfence();
+    } else {
+        for (; len >= 64; len -= 64, dst += 64) {
+            _mm_store_si128((__m128i *)(dst + 0), value);
+            _mm_store_si128((__m128i *)(dst + 16), value);
+            _mm_store_si128((__m128i *)(dst + 32), value);
+            _mm_store_si128((__m128i *)(dst + 48), value);
+        }
+    }
+    for (; len >= 16; len -= 16, dst += 16) {
+        _mm_store_si128((__m128i *)dst, value);
+    }
+    _mm_storeu_si128((__m128i *)(dst_end - 16), first);
+}
+#elif defined(SDL_STDLIB_USE_NEON)
+static void SDL_memset4_NEON(Uint8 *dst, Uint32 val, size_t len)
+{
+    const uint8x16_t first = vreinterpretq_u8_u32(vdupq_n_u32(val));
+    Uint8 *dst_end = dst + len;
+    size_t head;
+    uint8x16_t value;
+
+    vst1q_u8(dst, first);
+    head = 16 - ((uintptr_t)dst & 15);
+    value = vreinterpretq_u8_u32(vdupq_n_u32(SDL_RotatePattern(val, head)));
+    dst += head;
+    len -= head;
+
+    for (; len >= 64; len -= 64, dst += 64) {
+        vst1q_u8(dst + 0, value);
+        vst1q_u8(dst + 16, value);
+        vst1q_u8(dst + 32, value);
+        vst1q_u8(dst + 48, value);
+    }
+    for (; len >= 16; len -= 16, dst += 16) {
+        vst1q_u8(dst, value);
+    }
+    vst1q_u8(dst_end - 16, first);
+}
+#endif
+
+void SDL_memset4_vector(void *dst, Uint32 val, size_t dwords, bool nontemporal)
+{
+    if (dwords * 4 < SDL_MEMSET_VECTOR_MIN) {
+        SDL_memset4_small((Uint8 *)dst, val, dwords);
+        return;
+    }
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (SDL_HasAVX2()) {
+        SDL_memset4_AVX2((Uint8 *)dst, val, dwords * 4, nontemporal);
+        return;
+    }
+#endif
+#if defined(SDL_STDLIB_USE_SSE2)
+    SDL_memset4_SSE2((Uint8 *)dst, val, dwords * 4, nontemporal);
+#elif defined(SDL_STDLIB_USE_NEON)
+    SDL_memset4_NEON((Uint8 *)dst, val, dwords * 4);
+#else
+    SDL_memset4_small((Uint8 *)dst, val, dwords);
+#endif
+}
+
 
 #ifdef SDL_memset
 #undef SDL_memset
@@ -43,6 +204,22 @@ void *SDL_memset(SDL_OUT_BYTECAP(len) void *dst, int c, size_t len)
     // The value used in memset() is a byte, passed as an int
     c &= 0xff;
 
+    if (len >= SDL_MEMSET_VECTOR_MIN) {
+        SDL_memset4_vector(dst, (Uint32)c * 0x01010101, len / 4, SDL_UseNonTemporalStores(len));
+        dstp1 += (len & ~3);
+        switch (len & 3) {
+        case 3:
+            *dstp1++ = (Uint8)c;
+            SDL_FALLTHROUGH;
+        case 2:
+            *dstp1++ = (Uint8)c;
+            SDL_FALLTHROUGH;
+        case 1:
+            *dstp1++ = (Uint8)c;
+        }
+        return dst;
+    }
+
     /* The destination pointer needs to be aligned on a 4-byte boundary to
      * execute a 32-bit set. Set first bytes manually if needed until it is
      * aligned. */
@@ -93,6 +270,11 @@ void *SDL_memset4(void *dst, Uint32 val, size_t dwords)
         : "0"(dst), "1"(val), "2"(SDL_static_cast(Uint32, dwords))
         : "memory");
 #else
+    if (dwords * 4 >= SDL_MEMSET_VECTOR_MIN) {
+        SDL_memset4_vector(dst, val, dwords, SDL_UseNonTemporalStores(dwords * 4));
+        return dst;
+    }
+
     size_t _n = (dwords + 3) / 4;
     Uint32 *_p = SDL_static_cast(Uint32 *, dst);
     Uint32 _val = (val);
@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "../thread/SDL_thread_c.h"
+
 // SDL3 always uses its own internal qsort implementation, below, so
 // it can guarantee stable sorts across platforms and not have to
 // tapdance to support the various qsort_r interfaces, or bridge from
@@ -181,15 +183,18 @@ static char _ID[]="<qsort.c gjm WITH CHANGES FOR SDL3 1.16 2021-02-20>";
  */
 #define PIVOT_THRESHOLD 40
 
-typedef struct { char * first; char * last; } stack_entry;
-#define pushLeft {stack[stacktop].first=ffirst;stack[stacktop++].last=last;}
-#define pushRight {stack[stacktop].first=first;stack[stacktop++].last=llast;}
+/* BEGIN SDL CHANGE ... each stack entry remembers how deep it is, see DepthLimit below. */
+typedef struct { char * first; char * last; int depth; } stack_entry;
+#define pushLeft {stack[stacktop].first=ffirst;stack[stacktop].last=last;stack[stacktop++].depth=depth;}
+#define pushRight {stack[stacktop].first=first;stack[stacktop].last=llast;stack[stacktop++].depth=depth;}
 #define doLeft {first=ffirst;llast=last;continue;}
 #define doRight {ffirst=first;last=llast;continue;}
 #define pop {if (--stacktop<0) break;\
   first=ffirst=stack[stacktop].first;\
   last=llast=stack[stacktop].last;\
+  depth=stack[stacktop].depth;\
   continue;}
+/* END SDL CHANGE */
 
 /* Some comments on the implementation.
  * 1. When we finish partitioning the array into "low"
@@ -345,6 +350,18 @@ typedef struct { char * first; char * last; } stack_entry;
     }						\
   }
 
+/* BEGIN SDL CHANGE ... introsort: if partitioning goes deeper than twice
+ * log2(nmemb), the pivots are bad and quicksort is heading for n^2 (inputs
+ * that defeat the median-of-three-medians pivot can be built on purpose), so
+ * the current subarray is heapsorted instead. Heapsort is slower on average
+ * but guarantees n*log(n). The subarray ends up sorted, which doesn't upset
+ * the pre-insertion or insertion steps.
+ */
+#define MaxDepth(nmemb) { size_t n=(nmemb); maxdepth=0; while (n>1) { maxdepth+=2; n>>=1; } }
+#define DepthLimit(sz) \
+  if (++depth>maxdepth) { heapsort_r(first,(last-first)/sz+1,sz,compare,userdata); pop }
+/* END SDL CHANGE */
+
 #define SWAP_nonaligned(a,b) { \
   register char *aa=(a),*bb=(b); \
   register size_t sz=size; \
@@ -360,6 +377,35 @@ typedef struct { char * first; char * last; } stack_entry;
 
 /* ---------------------------------------------------------------------- */
 
+/* BEGIN SDL CHANGE ... heapsort for DepthLimit. */
+static void swap_bytes(char *a, char *b, size_t size) {
+  do { char t=*a; *a++=*b; *b++=t; } while (--size);
+}
+
+static void heapsort_r(char *base, size_t nmemb, size_t size,
+                       int (SDLCALL *compare)(void *, const void *, const void *), void *userdata) {
+  size_t start=nmemb/2, end=nmemb;
+  while (end>1) {
+    size_t root, child;
+    if (start>0) {
+      /* Building the heap */
+      --start;
+    } else {
+      /* Moving the largest element to the end */
+      --end;
+      swap_bytes(base,base+end*size,size);
+    }
+    for (root=start; (child=2*root+1)<end; root=child) {
+      if (child+1<end && compare(userdata,base+child*size,base+(child+1)*size)<0) ++child;
+      if (compare(userdata,base+root*size,base+child*size)>=0) break;
+      swap_bytes(base+root*size,base+child*size,size);
+    }
+  }
+}
+/* END SDL CHANGE */
+
+/* ---------------------------------------------------------------------- */
+
 static char * pivot_big(char *first, char *mid, char *last, size_t size,
                         int (SDLCALL *compare)(void *, const void *, const void *), void *userdata) {
   size_t d=(((last-first)/size)>>3)*size;
@@ -406,16 +452,19 @@ static void qsort_r_nonaligned(void *base, size_t nmemb, size_t size,
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
+  int depth=0,maxdepth;
   char *first,*last;
   char *pivot=malloc(size);
   size_t trunc=TRUNC_nonaligned*size;
   assert(pivot != NULL);
+  MaxDepth(nmemb);
 
   first=(char*)base; last=first+(nmemb-1)*size;
 
   if ((size_t)(last-first)>=trunc) {
     char *ffirst=first, *llast=last;
     while (1) {
+      DepthLimit(size)
       /* Select pivot */
       { char * mid=first+size*((last-first)/size >> 1);
         Pivot(SWAP_nonaligned,size);
@@ -437,16 +486,19 @@ static void qsort_r_aligned(void *base, size_t nmemb, size_t size,
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
+  int depth=0,maxdepth;
   char *first,*last;
   char *pivot=malloc(size);
   size_t trunc=TRUNC_aligned*size;
   assert(pivot != NULL);
+  MaxDepth(nmemb);
 
   first=(char*)base; last=first+(nmemb-1)*size;
 
   if ((size_t)(last-first)>=trunc) {
     char *ffirst=first,*llast=last;
     while (1) {
+      DepthLimit(size)
       /* Select pivot */
       { char * mid=first+size*((last-first)/size >> 1);
         Pivot(SWAP_aligned,size);
@@ -468,15 +520,18 @@ static void qsort_r_words(void *base, size_t nmemb,
 
   stack_entry stack[STACK_SIZE];
   int stacktop=0;
+  int depth=0,maxdepth;
   char *first,*last;
   char *pivot=malloc(WORD_BYTES);
   assert(pivot != NULL);
+  MaxDepth(nmemb);
 
   first=(char*)base; last=first+(nmemb-1)*WORD_BYTES;
 
   if (last-first>=TRUNC_words) {
     char *ffirst=first, *llast=last;
     while (1) {
+      DepthLimit(WORD_BYTES)
 #ifdef DEBUG_QSORT
 fprintf(stderr,"Doing %d:%d: ",
         (first-(char*)base)/WORD_BYTES,
@@ -572,3 +627,389 @@ void *SDL_bsearch(const void *key, const void *base, size_t nmemb, size_t size,
     return SDL_bsearch_r(key, base, nmemb, size, qsort_non_r_bridge, compare);
 }
 
+
+// The code below uses the SDL functions directly
+#undef assert
+#undef malloc
+#undef free
+#undef memcpy
+#undef memmove
+
+// Radix sort for elements with a fixed width key.
+// This is a least significant digit radix sort, 8 bits at a time, which is stable and
+// never calls a compare function. All the histograms are built in one pass up front,
+// and digits that are the same in every key are skipped, so sorting small integers
+// by a 64-bit key doesn't cost eight passes.
+
+#define RADIX_BITS  8
+#define RADIX_SIZE  (1 << RADIX_BITS)
+#define RADIX_MASK  (RADIX_SIZE - 1)
+
+// Below this, a stable insertion sort is faster than allocating the scratch buffer
+#define RADIX_INSERTION_THRESHOLD 32
+
+static SDL_INLINE Uint64 GetSortKey(const Uint8 *element, size_t key_offset, size_t key_size, SDL_SortKeyType type)
+{
+    // Map the keys to unsigned integers that sort in the same order
+    if (key_size == sizeof(Uint32)) {
+        Uint32 key;
+        SDL_memcpy(&key, element + key_offset, sizeof(key));
+        switch (type) {
+        case SDL_SORTKEY_SIGNED:
+            return key ^ 0x80000000u;
+        case SDL_SORTKEY_FLOAT:
+            // Flip all the bits of negative numbers, and just the sign bit of positive ones
+            return key ^ ((Uint32)((Sint32)key >> 31) | 0x80000000u);
+        default:
+            return key;
+        }
+    } else {
+        Uint64 key;
+        SDL_memcpy(&key, element + key_offset, sizeof(key));
+        switch (type) {
+        case SDL_SORTKEY_SIGNED:
+            return key ^ SDL_UINT64_C(0x8000000000000000);
+        case SDL_SORTKEY_FLOAT:
+            return key ^ ((Uint64)((Sint64)key >> 63) | SDL_UINT64_C(0x8000000000000000));
+        default:
+            return key;
+        }
+    }
+}
+
+static void InsertionSortKeys(Uint8 *base, size_t nmemb, size_t size, size_t key_offset, size_t key_size, SDL_SortKeyType type)
+{
+    size_t i, j, k;
+
+    for (i = 1; i < nmemb; ++i) {
+        const Uint64 key = GetSortKey(base + i * size, key_offset, key_size, type);
+        for (j = i; j > 0 && GetSortKey(base + (j - 1) * size, key_offset, key_size, type) > key; --j) {
+            Uint8 *a = base + (j - 1) * size;
+            Uint8 *b = a + size;
+            for (k = 0; k < size; ++k) {
+                const Uint8 t = a[k];
+                a[k] = b[k];
+                b[k] = t;
+            }
+        }
+    }
+}
+
+// Copying with a constant size lets the compiler turn the copies into plain loads and stores
+#define RADIX_SCATTER(SIZE)                                                                 \
+    for (i = 0; i < nmemb; ++i) {                                                           \
+        const Uint8 *element = src + i * (SIZE);                                            \
+        const size_t digit = (size_t)(GetSortKey(element, key_offset, key_size, type) >> shift) & RADIX_MASK; \
+        SDL_memcpy(dst + offsets[digit]++ * (SIZE), element, (SIZE));                       \
+    }
+
+static bool RadixSortKeys(void *base, size_t nmemb, size_t size, size_t key_offset, size_t key_size, SDL_SortKeyType type)
+{
+    size_t counts[sizeof(Uint64)][RADIX_SIZE];
+    size_t offsets[RADIX_SIZE];
+    Uint8 *scratch, *src, *dst;
+    size_t i, d;
+
+    if (!base && nmemb > 0) {
+        return SDL_InvalidParamError("base");
+    }
+    if (size < key_size || key_offset > (size - key_size)) {
+        return SDL_InvalidParamError("key_offset");
+    }
+    if (type != SDL_SORTKEY_UNSIGNED && type != SDL_SORTKEY_SIGNED && type != SDL_SORTKEY_FLOAT) {
+        return SDL_InvalidParamError("type");
+    }
+
+    if (nmemb < RADIX_INSERTION_THRESHOLD) {
+        InsertionSortKeys((Uint8 *)base, nmemb, size, key_offset, key_size, type);
+        return true;
+    }
+
+    if (nmemb > SDL_SIZE_MAX / size) {
+        return SDL_OutOfMemory();
+    }
+    scratch = (Uint8 *)SDL_malloc(nmemb * size);
+    if (!scratch) {
+        return false;
+    }
+
+    SDL_zeroa(counts);
+    src = (Uint8 *)base;
+    for (i = 0; i < nmemb; ++i) {
+        Uint64 key = GetSortKey(src + i * size, key_offset, key_size, type);
+        for (d = 0; d < key_size; ++d) {
+            ++counts[d][key & RADIX_MASK];
+            key >>= RADIX_BITS;
+        }
+    }
+
+    dst = scratch;
+    for (d = 0; d < key_size; ++d) {
+        const int shift = (int)(d * RADIX_BITS);
+        const size_t first_digit = (size_t)(GetSortKey(src, key_offset, key_size, type) >> shift) & RADIX_MASK;
+        size_t total = 0;
+        Uint8 *tmp;
+
+        if (counts[d][first_digit] == nmemb) {
+            // Every key has the same digit here, this pass wouldn't move anything
+            continue;
+        }
+
+        for (i = 0; i < RADIX_SIZE; ++i) {
+            offsets[i] = total;
+            total += counts[d][i];
+        }
+
+        switch (size) {
+        case 4:
+            RADIX_SCATTER(4)
+            break;
+        case 8:
+            RADIX_SCATTER(8)
+            break;
+        case 16:
+            RADIX_SCATTER(16)
+            break;
+        default:
+            RADIX_SCATTER(size)
+            break;
+        }
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != (Uint8 *)base) {
+        SDL_memcpy(base, src, nmemb * size);
+    }
+    SDL_free(scratch);
+    return true;
+}
+
+#undef RADIX_SCATTER
+
+bool SDL_SortKeys32(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_SortKeyType type)
+{
+    return RadixSortKeys(base, nmemb, size, key_offset, sizeof(Uint32), type);
+}
+
+bool SDL_SortKeys64(void *base, size_t nmemb, size_t size, size_t key_offset, SDL_SortKeyType type)
+{
+    return RadixSortKeys(base, nmemb, size, key_offset, sizeof(Uint64), type);
+}
+
+// Parallel merge sort.
+// The array is split into one chunk per thread, the chunks are sorted with SDL_qsort_r(),
+// and then pairs of runs are merged back and forth between the array and a scratch buffer.
+// Each merge is split into pieces at matching positions in both runs, so every round of
+// merging, including the last one, keeps all the threads busy.
+
+// Below this, the threads cost more than they save
+#define PARALLEL_SORT_THRESHOLD (64 * 1024)
+#define PARALLEL_SORT_MIN_CHUNK (16 * 1024)
+#define PARALLEL_SORT_MAX_THREADS 16
+
+typedef struct SDL_SortTask
+{
+    // Sorting a chunk in place, if dst is NULL
+    Uint8 *base;
+    size_t nmemb;
+
+    // Merging two sorted runs into dst
+    const Uint8 *a;
+    size_t na;
+    const Uint8 *b;
+    size_t nb;
+    Uint8 *dst;
+
+    size_t size;
+    SDL_CompareCallback_r compare;
+    void *userdata;
+} SDL_SortTask;
+
+// Returns the index of the first element in the run that isn't less than key
+static size_t LowerBound(const Uint8 *run, size_t nmemb, size_t size, const void *key, SDL_CompareCallback_r compare, void *userdata)
+{
+    size_t lo = 0, hi = nmemb;
+
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (compare(userdata, run + mid * size, key) < 0) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void MergeRuns(const SDL_SortTask *task)
+{
+    const Uint8 *a = task->a, *a_end = task->a + task->na * task->size;
+    const Uint8 *b = task->b, *b_end = task->b + task->nb * task->size;
+    const size_t size = task->size;
+    Uint8 *dst = task->dst;
+
+    while (a < a_end && b < b_end) {
+        // Take from the first run when the elements are equal
+        if (task->compare(task->userdata, b, a) < 0) {
+            SDL_memcpy(dst, b, size);
+            b += size;
+        } else {
+            SDL_memcpy(dst, a, size);
+            a += size;
+        }
+        dst += size;
+    }
+    if (a < a_end) {
+        SDL_memcpy(dst, a, a_end - a);
+        dst += (a_end - a);
+    }
+    if (b < b_end) {
+        SDL_memcpy(dst, b, b_end - b);
+    }
+}
+
+static void SDLCALL SortTaskJob(void *data)
+{
+    const SDL_SortTask *task = (const SDL_SortTask *)data;
+
+    if (task->dst) {
+        MergeRuns(task);
+    } else {
+        SDL_qsort_r(task->base, task->nmemb, task->size, task->compare, task->userdata);
+    }
+}
+
+static void RunSortTasks(SDL_SortTask *tasks, int num_tasks)
+{
+    SDL_JobSystem *system = SDL_GetGlobalJobSystem();
+    SDL_Job *jobs[PARALLEL_SORT_MAX_THREADS + 1];
+    int i;
+
+    // The calling thread does the first task itself, and helps with the rest while it waits
+    for (i = 1; i < num_tasks; ++i) {
+        jobs[i] = system ? SDL_SubmitJob(system, SortTaskJob, &tasks[i], NULL, 0) : NULL;
+    }
+    SortTaskJob(&tasks[0]);
+    for (i = 1; i < num_tasks; ++i) {
+        if (jobs[i]) {
+            SDL_WaitJob(jobs[i]);
+            SDL_ReleaseJob(jobs[i]);
+        } else {
+            SortTaskJob(&tasks[i]);
+        }
+    }
+}
+
+void SDL_ParallelSort(void *base, size_t nmemb, size_t size, SDL_CompareCallback_r compare, void *userdata)
+{
+    SDL_SortTask tasks[PARALLEL_SORT_MAX_THREADS + 1];
+    size_t bounds[PARALLEL_SORT_MAX_THREADS + 1];
+    Uint8 *scratch, *src, *dst;
+    int num_threads, num_runs, num_tasks;
+    int i, j;
+
+    num_threads = SDL_min(SDL_GetNumLogicalCPUCores(), PARALLEL_SORT_MAX_THREADS);
+    num_threads = (int)SDL_min((size_t)num_threads, nmemb / PARALLEL_SORT_MIN_CHUNK);
+    if (nmemb < PARALLEL_SORT_THRESHOLD || num_threads < 2 || size == 0 || nmemb > SDL_SIZE_MAX / size) {
+        SDL_qsort_r(base, nmemb, size, compare, userdata);
+        return;
+    }
+
+    scratch = (Uint8 *)SDL_malloc(nmemb * size);
+    if (!scratch) {
+        SDL_qsort_r(base, nmemb, size, compare, userdata);
+        return;
+    }
+
+    // Sort a chunk on each thread
+    num_runs = num_threads;
+    for (i = 0; i <= num_runs; ++i) {
+        bounds[i] = (nmemb * i) / num_runs;
+    }
+    for (i = 0; i < num_runs; ++i) {
+        SDL_zero(tasks[i]);
+        tasks[i].base = (Uint8 *)base + bounds[i] * size;
+        tasks[i].nmemb = bounds[i + 1] - bounds[i];
+        tasks[i].size = size;
+        tasks[i].compare = compare;
+        tasks[i].userdata = userdata;
+    }
+    RunSortTasks(tasks, num_runs);
+
+    // Merge pairs of runs until there's one left
+    src = (Uint8 *)base;
+    dst = scratch;
+    while (num_runs > 1) {
+        const int num_pairs = num_runs / 2;
+        const int pieces = SDL_max(num_threads / num_pairs, 1);
+        Uint8 *tmp;
+
+        num_tasks = 0;
+        for (i = 0; i < num_pairs; ++i) {
+            const Uint8 *a = src + bounds[2 * i] * size;
+            const Uint8 *b = src + bounds[2 * i + 1] * size;
+            const size_t na = bounds[2 * i + 1] - bounds[2 * i];
+            const size_t nb = bounds[2 * i + 2] - bounds[2 * i + 1];
+            Uint8 *out = dst + bounds[2 * i] * size;
+            size_t a_start = 0, b_start = 0;
+
+            for (j = 0; j < pieces; ++j) {
+                SDL_SortTask *task = &tasks[num_tasks++];
+                size_t a_end, b_end;
+
+                if (j == pieces - 1) {
+                    a_end = na;
+                    b_end = nb;
+                } else {
+                    // Everything in b before the first element of the next piece of a goes in this piece
+                    a_end = (na * (j + 1)) / pieces;
+                    b_end = b_start + LowerBound(b + b_start * size, nb - b_start, size, a + a_end * size, compare, userdata);
+                }
+
+                SDL_zerop(task);
+                task->a = a + a_start * size;
+                task->na = a_end - a_start;
+                task->b = b + b_start * size;
+                task->nb = b_end - b_start;
+                task->dst = out + (a_start + b_start) * size;
+                task->size = size;
+                task->compare = compare;
+                task->userdata = userdata;
+
+                a_start = a_end;
+                b_start = b_end;
+            }
+        }
+        if (num_runs & 1) {
+            // The last run has nothing to merge with, it just moves over
+            SDL_SortTask *task = &tasks[num_tasks++];
+            SDL_zerop(task);
+            task->a = src + bounds[num_runs - 1] * size;
+            task->na = nmemb - bounds[num_runs - 1];
+            task->b = task->a;
+            task->dst = dst + bounds[num_runs - 1] * size;
+            task->size = size;
+            task->compare = compare;
+            task->userdata = userdata;
+        }
+        RunSortTasks(tasks, num_tasks);
+
+        for (i = 0; i < num_runs; i += 2) {
+            bounds[i / 2] = bounds[i];
+        }
+        num_runs = (num_runs + 1) / 2;
+        bounds[num_runs] = nmemb;
+
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    if (src != (Uint8 *)base) {
+        SDL_memcpy(base, src, nmemb * size);
+    }
+    SDL_free(scratch);
+}
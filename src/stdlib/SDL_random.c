@@ -20,6 +20,8 @@
 */
 #include "SDL_internal.h"
 
+#include "SDL_sysstdlib.h"
+
 // This file contains portable random functions for SDL
 
 static Uint64 SDL_rand_state;
@@ -113,3 +115,374 @@ float SDL_randf_r(Uint64 *state)
     return (SDL_rand_bits_r(state) >> (32 - 24)) * 0x1p-24f;
 }
 
+
+// The random streams use Philox4x32-10, a counter-based generator: block n of a stream is
+// the 128-bit counter n encrypted with the seed as the key, by ten rounds of multiplies and
+// xors. Every block can be computed independently, so a batch is generated several blocks
+// at a time in vector registers, and any position in the stream can be reached directly.
+// Salmon JK, Moraes MA, Dror RO, Shaw DE. Parallel random numbers: as easy as 1, 2, 3.
+// SC '11: Proceedings of the International Conference for High Performance Computing.
+// doi: 10.1145/2063384.2063405
+
+#define PHILOX_M0     0xD2511F53u
+#define PHILOX_M1     0xCD9E8D57u
+#define PHILOX_W0     0x9E3779B9u
+#define PHILOX_W1     0xBB67AE85u
+#define PHILOX_ROUNDS 10
+
+// Values converted at a time by the float and int fills, small enough to stay in the L1 cache
+#define SDL_RAND_CHUNK 256
+
+static void SDL_PhiloxBlock(Uint64 seed, Uint64 block, Uint32 *out)
+{
+    Uint32 c0 = (Uint32)block;
+    Uint32 c1 = (Uint32)(block >> 32);
+    Uint32 c2 = 0;
+    Uint32 c3 = 0;
+    Uint32 k0 = (Uint32)seed;
+    Uint32 k1 = (Uint32)(seed >> 32);
+    int i;
+
+    for (i = 0; i < PHILOX_ROUNDS; ++i) {
+        const Uint64 p0 = (Uint64)PHILOX_M0 * c0;
+        const Uint64 p1 = (Uint64)PHILOX_M1 * c2;
+        c0 = (Uint32)(p1 >> 32) ^ c1 ^ k0;
+        c1 = (Uint32)p1;
+        c2 = (Uint32)(p0 >> 32) ^ c3 ^ k1;
+        c3 = (Uint32)p0;
+        k0 += PHILOX_W0;
+        k1 += PHILOX_W1;
+    }
+    out[0] = c0;
+    out[1] = c1;
+    out[2] = c2;
+    out[3] = c3;
+}
+
+/* The vector versions keep each word of the counter in its own register, with one block per
+   lane, so the rounds are the same as above. The blocks are transposed back into order as
+   they're stored. */
+
+#ifdef SDL_AVX2_INTRINSICS
+SDL_FORCE_INLINE void SDL_TARGETING("avx2") SDL_MulHiLo_AVX2(__m256i a, __m256i m, __m256i *hi, __m256i *lo)
+{
+    const __m256i even = _mm256_mul_epu32(a, m);
+    const __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), m);
+    *lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+    *hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+}
+
+// Generates 8 blocks at a time, num_blocks must be a multiple of 8
+static void SDL_TARGETING("avx2") SDL_PhiloxBlocks_AVX2(Uint64 seed, Uint64 block, Uint32 *out, size_t num_blocks)
+{
+    const __m256i m0 = _mm256_set1_epi32((int)PHILOX_M0);
+    const __m256i m1 = _mm256_set1_epi32((int)PHILOX_M1);
+    size_t i;
+    int r;
+
+    for (i = 0; i < num_blocks; i += 8, block += 8, out += 32) {
+        __m256i c0 = _mm256_set_epi32((int)(Uint32)(block + 7), (int)(Uint32)(block + 6), (int)(Uint32)(block + 5), (int)(Uint32)(block + 4),
+                                      (int)(Uint32)(block + 3), (int)(Uint32)(block + 2), (int)(Uint32)(block + 1), (int)(Uint32)block);
+        __m256i c1 = _mm256_set_epi32((int)((block + 7) >> 32), (int)((block + 6) >> 32), (int)((block + 5) >> 32), (int)((block + 4) >> 32),
+                                      (int)((block + 3) >> 32), (int)((block + 2) >> 32), (int)((block + 1) >> 32), (int)(block >> 32));
+        __m256i c2 = _mm256_setzero_si256();
+        __m256i c3 = _mm256_setzero_si256();
+        Uint32 k0 = (Uint32)seed;
+        Uint32 k1 = (Uint32)(seed >> 32);
+        __m256i hi0, lo0, hi1, lo1, t0, t1, t2, t3;
+
+        for (r = 0; r < PHILOX_ROUNDS; ++r) {
+            SDL_MulHiLo_AVX2(c0, m0, &hi0, &lo0);
+            SDL_MulHiLo_AVX2(c2, m1, &hi1, &lo1);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(hi1, c1), _mm256_set1_epi32((int)k0));
+            c1 = lo1;
+            c2 = _mm256_xor_si256(_mm256_xor_si256(hi0, c3), _mm256_set1_epi32((int)k1));
+            c3 = lo0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        // Each 128-bit half is transposed separately, leaving blocks n and n + 4 in one register
+        t0 = _mm256_unpacklo_epi32(c0, c1);
+        t1 = _mm256_unpacklo_epi32(c2, c3);
+        t2 = _mm256_unpackhi_epi32(c0, c1);
+        t3 = _mm256_unpackhi_epi32(c2, c3);
+        c0 = _mm256_unpacklo_epi64(t0, t1);
+        c1 = _mm256_unpackhi_epi64(t0, t1);
+        c2 = _mm256_unpacklo_epi64(t2, t3);
+        c3 = _mm256_unpackhi_epi64(t2, t3);
+        _mm256_storeu_si256((__m256i *)(out + 0), _mm256_permute2x128_si256(c0, c1, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 8), _mm256_permute2x128_si256(c2, c3, 0x20));
+        _mm256_storeu_si256((__m256i *)(out + 16), _mm256_permute2x128_si256(c0, c1, 0x31));
+        _mm256_storeu_si256((__m256i *)(out + 24), _mm256_permute2x128_si256(c2, c3, 0x31));
+    }
+}
+#endif
+
+#if defined(SDL_STDLIB_USE_SSE2)
+SDL_FORCE_INLINE void SDL_MulHiLo_SSE2(__m128i a, __m128i m, __m128i *hi, __m128i *lo)
+{
+    const __m128i mask = _mm_set_epi32(0, -1, 0, -1);
+    const __m128i even = _mm_mul_epu32(a, m);
+    const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), m);
+    *lo = _mm_or_si128(_mm_and_si128(even, mask), _mm_slli_epi64(odd, 32));
+    *hi = _mm_or_si128(_mm_srli_epi64(even, 32), _mm_andnot_si128(mask, odd));
+}
+
+// Generates 4 blocks at a time, num_blocks must be a multiple of 4
+static void SDL_PhiloxBlocks_SSE2(Uint64 seed, Uint64 block, Uint32 *out, size_t num_blocks)
+{
+    const __m128i m0 = _mm_set1_epi32((int)PHILOX_M0);
+    const __m128i m1 = _mm_set1_epi32((int)PHILOX_M1);
+    size_t i;
+    int r;
+
+    for (i = 0; i < num_blocks; i += 4, block += 4, out += 16) {
+        __m128i c0 = _mm_set_epi32((int)(Uint32)(block + 3), (int)(Uint32)(block + 2), (int)(Uint32)(block + 1), (int)(Uint32)block);
+        __m128i c1 = _mm_set_epi32((int)((block + 3) >> 32), (int)((block + 2) >> 32), (int)((block + 1) >> 32), (int)(block >> 32));
+        __m128i c2 = _mm_setzero_si128();
+        __m128i c3 = _mm_setzero_si128();
+        Uint32 k0 = (Uint32)seed;
+        Uint32 k1 = (Uint32)(seed >> 32);
+        __m128i hi0, lo0, hi1, lo1, t0, t1, t2, t3;
+
+        for (r = 0; r < PHILOX_ROUNDS; ++r) {
+            SDL_MulHiLo_SSE2(c0, m0, &hi0, &lo0);
+            SDL_MulHiLo_SSE2(c2, m1, &hi1, &lo1);
+            c0 = _mm_xor_si128(_mm_xor_si128(hi1, c1), _mm_set1_epi32((int)k0));
+            c1 = lo1;
+            c2 = _mm_xor_si128(_mm_xor_si128(hi0, c3), _mm_set1_epi32((int)k1));
+            c3 = lo0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        t0 = _mm_unpacklo_epi32(c0, c1);
+        t1 = _mm_unpacklo_epi32(c2, c3);
+        t2 = _mm_unpackhi_epi32(c0, c1);
+        t3 = _mm_unpackhi_epi32(c2, c3);
+        _mm_storeu_si128((__m128i *)(out + 0), _mm_unpacklo_epi64(t0, t1));
+        _mm_storeu_si128((__m128i *)(out + 4), _mm_unpackhi_epi64(t0, t1));
+        _mm_storeu_si128((__m128i *)(out + 8), _mm_unpacklo_epi64(t2, t3));
+        _mm_storeu_si128((__m128i *)(out + 12), _mm_unpackhi_epi64(t2, t3));
+    }
+}
+#elif defined(SDL_STDLIB_USE_NEON)
+SDL_FORCE_INLINE void SDL_MulHiLo_NEON(uint32x4_t a, uint32x2_t m, uint32x4_t *hi, uint32x4_t *lo)
+{
+    const uint32x4_t p01 = vreinterpretq_u32_u64(vmull_u32(vget_low_u32(a), m));
+    const uint32x4_t p23 = vreinterpretq_u32_u64(vmull_u32(vget_high_u32(a), m));
+    *lo = vuzp1q_u32(p01, p23);
+    *hi = vuzp2q_u32(p01, p23);
+}
+
+// Generates 4 blocks at a time, num_blocks must be a multiple of 4
+static void SDL_PhiloxBlocks_NEON(Uint64 seed, Uint64 block, Uint32 *out, size_t num_blocks)
+{
+    const uint32x2_t m0 = vdup_n_u32(PHILOX_M0);
+    const uint32x2_t m1 = vdup_n_u32(PHILOX_M1);
+    size_t i;
+    int r;
+
+    for (i = 0; i < num_blocks; i += 4, block += 4, out += 16) {
+        const Uint32 lo[4] = { (Uint32)block, (Uint32)(block + 1), (Uint32)(block + 2), (Uint32)(block + 3) };
+        const Uint32 hi[4] = { (Uint32)(block >> 32), (Uint32)((block + 1) >> 32), (Uint32)((block + 2) >> 32), (Uint32)((block + 3) >> 32) };
+        uint32x4x4_t c;
+        Uint32 k0 = (Uint32)seed;
+        Uint32 k1 = (Uint32)(seed >> 32);
+        uint32x4_t hi0, lo0, hi1, lo1;
+
+        c.val[0] = vld1q_u32(lo);
+        c.val[1] = vld1q_u32(hi);
+        c.val[2] = vdupq_n_u32(0);
+        c.val[3] = vdupq_n_u32(0);
+        for (r = 0; r < PHILOX_ROUNDS; ++r) {
+            SDL_MulHiLo_NEON(c.val[0], m0, &hi0, &lo0);
+            SDL_MulHiLo_NEON(c.val[2], m1, &hi1, &lo1);
+            c.val[0] = veorq_u32(veorq_u32(hi1, c.val[1]), vdupq_n_u32(k0));
+            c.val[1] = lo1;
+            c.val[2] = veorq_u32(veorq_u32(hi0, c.val[3]), vdupq_n_u32(k1));
+            c.val[3] = lo0;
+            k0 += PHILOX_W0;
+            k1 += PHILOX_W1;
+        }
+
+        // The interleaving store puts the words of each block back together
+        vst4q_u32(out, c);
+    }
+}
+#endif
+
+static void SDL_PhiloxBlocks(Uint64 seed, Uint64 block, Uint32 *out, size_t num_blocks)
+{
+    size_t done = 0;
+
+#ifdef SDL_AVX2_INTRINSICS
+    if (num_blocks >= 8 && SDL_HasAVX2()) {
+        done = num_blocks & ~(size_t)7;
+        SDL_PhiloxBlocks_AVX2(seed, block, out, done);
+    }
+#endif
+#if defined(SDL_STDLIB_USE_SSE2)
+    if ((num_blocks - done) >= 4) {
+        const size_t n = (num_blocks - done) & ~(size_t)3;
+        SDL_PhiloxBlocks_SSE2(seed, block + done, out + done * 4, n);
+        done += n;
+    }
+#elif defined(SDL_STDLIB_USE_NEON)
+    if ((num_blocks - done) >= 4) {
+        const size_t n = (num_blocks - done) & ~(size_t)3;
+        SDL_PhiloxBlocks_NEON(seed, block + done, out + done * 4, n);
+        done += n;
+    }
+#endif
+    for (; done < num_blocks; ++done) {
+        SDL_PhiloxBlock(seed, block + done, out + done * 4);
+    }
+}
+
+// Generates the next `count` values of the stream, the same ones however the calls are split up
+static void SDL_RandStreamBits(SDL_RandomStream *stream, Uint32 *values, size_t count)
+{
+    Uint64 position = stream->position;
+    Uint32 block[4];
+    size_t lane, n;
+
+    stream->position += count;
+
+    // Finish the block that the last call stopped in the middle of
+    lane = (size_t)(position & 3);
+    if (lane && count) {
+        n = SDL_min(4 - lane, count);
+        SDL_PhiloxBlock(stream->seed, position >> 2, block);
+        SDL_memcpy(values, block + lane, n * sizeof(Uint32));
+        values += n;
+        count -= n;
+        position += n;
+    }
+
+    n = count / 4;
+    SDL_PhiloxBlocks(stream->seed, position >> 2, values, n);
+    values += n * 4;
+    count -= n * 4;
+    position += n * 4;
+
+    // Start a block for the next call to finish
+    if (count) {
+        SDL_PhiloxBlock(stream->seed, position >> 2, block);
+        SDL_memcpy(values, block, count * sizeof(Uint32));
+    }
+}
+
+static bool SDL_CheckRandFill(SDL_RandomStream *stream, const void *values, int count)
+{
+    if (!stream) {
+        return SDL_InvalidParamError("stream");
+    }
+    if (count < 0) {
+        return SDL_InvalidParamError("count");
+    }
+    if (!values && count > 0) {
+        return SDL_InvalidParamError("values");
+    }
+    return true;
+}
+
+void SDL_InitRandomStream(SDL_RandomStream *stream, Uint64 seed)
+{
+    if (!stream) {
+        return;
+    }
+    if (!seed) {
+        seed = SDL_GetPerformanceCounter();
+    }
+    stream->seed = seed;
+    stream->position = 0;
+}
+
+bool SDL_RandFillBits(SDL_RandomStream *stream, Uint32 *values, int count)
+{
+    if (!SDL_CheckRandFill(stream, values, count)) {
+        return false;
+    }
+
+    SDL_RandStreamBits(stream, values, (size_t)count);
+    return true;
+}
+
+bool SDL_RandFillFloats(SDL_RandomStream *stream, float *values, int count)
+{
+    Uint32 bits[SDL_RAND_CHUNK];
+    int i, j, n;
+
+    if (!SDL_CheckRandFill(stream, values, count)) {
+        return false;
+    }
+
+    for (i = 0; i < count; i += n) {
+        n = SDL_min(count - i, SDL_RAND_CHUNK);
+        SDL_RandStreamBits(stream, bits, (size_t)n);
+
+        // The same conversion as SDL_randf_r(), 24 bits for the float significand
+        j = 0;
+#if defined(SDL_STDLIB_USE_SSE2)
+        for (; j + 4 <= n; j += 4) {
+            const __m128i x = _mm_srli_epi32(_mm_loadu_si128((const __m128i *)&bits[j]), 32 - 24);
+            _mm_storeu_ps(&values[i + j], _mm_mul_ps(_mm_cvtepi32_ps(x), _mm_set1_ps(0x1p-24f)));
+        }
+#elif defined(SDL_STDLIB_USE_NEON)
+        for (; j + 4 <= n; j += 4) {
+            const uint32x4_t x = vshrq_n_u32(vld1q_u32(&bits[j]), 32 - 24);
+            vst1q_f32(&values[i + j], vmulq_n_f32(vcvtq_f32_u32(x), 0x1p-24f));
+        }
+#endif
+        for (; j < n; ++j) {
+            values[i + j] = (bits[j] >> (32 - 24)) * 0x1p-24f;
+        }
+    }
+    return true;
+}
+
+bool SDL_RandFillInts(SDL_RandomStream *stream, Sint32 *values, int count, Sint32 n)
+{
+    Uint32 bits[SDL_RAND_CHUNK];
+    int i, j, chunk;
+
+    if (!SDL_CheckRandFill(stream, values, count)) {
+        return false;
+    }
+    if (n <= 0) {
+        return SDL_InvalidParamError("n");
+    }
+
+    for (i = 0; i < count; i += chunk) {
+        chunk = SDL_min(count - i, SDL_RAND_CHUNK);
+        SDL_RandStreamBits(stream, bits, (size_t)chunk);
+
+        // The same conversion as SDL_rand_r(), the high half of bits * n
+        j = 0;
+#if defined(SDL_STDLIB_USE_SSE2)
+        {
+            const __m128i range = _mm_set1_epi32(n);
+            __m128i hi, lo;
+            for (; j + 4 <= chunk; j += 4) {
+                SDL_MulHiLo_SSE2(_mm_loadu_si128((const __m128i *)&bits[j]), range, &hi, &lo);
+                _mm_storeu_si128((__m128i *)&values[i + j], hi);
+            }
+        }
+#elif defined(SDL_STDLIB_USE_NEON)
+        {
+            const uint32x2_t range = vdup_n_u32((Uint32)n);
+            uint32x4_t hi, lo;
+            for (; j + 4 <= chunk; j += 4) {
+                SDL_MulHiLo_NEON(vld1q_u32(&bits[j]), range, &hi, &lo);
+                vst1q_s32(&values[i + j], vreinterpretq_s32_u32(hi));
+            }
+        }
+#endif
+        for (; j < chunk; ++j) {
+            values[i + j] = (Sint32)(((Uint64)bits[j] * (Uint32)n) >> 32);
+        }
+    }
+    return true;
+}
@@ -971,24 +971,144 @@ size_t SDL_utf8strlcpy(SDL_OUT_Z_CAP(dst_bytes) char *dst, const char *src, size
     return bytes;
 }
 
-size_t SDL_utf8strlen(const char *str)
+#ifdef SDL_AVX2_INTRINSICS
+static size_t SDL_TARGETING("avx2") SDL_ScanASCII_AVX2(const Uint8 *str, size_t i, size_t len)
 {
-    size_t result = 0;
-    while (SDL_StepUTF8(&str, NULL)) {
-        result++;
+    for (; (i + 32) <= len; i += 32) {
+        const Uint32 mask = (Uint32)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i *)(str + i)));
+        if (mask) {
+            return i + SDL_MostSignificantBitIndex32(mask & (~mask + 1));
+        }
     }
-    return result;
+    return i;
 }
+#endif
 
-size_t SDL_utf8strnlen(const char *str, size_t bytes)
+// Scans 16 bytes at a time, returns the offset of the first non-ASCII byte or of the first incomplete block
+static size_t SDL_ScanASCIIBlocks(const Uint8 *str, size_t i, size_t len)
+{
+#if defined(SDL_STDLIB_USE_SSE2)
+    for (; (i + 16) <= len; i += 16) {
+        const Uint32 mask = (Uint32)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)(str + i)));
+        if (mask) {
+            return i + SDL_MostSignificantBitIndex32(mask & (~mask + 1));
+        }
+    }
+#elif defined(SDL_STDLIB_USE_NEON)
+    for (; (i + 16) <= len; i += 16) {
+        if (vmaxvq_u8(vld1q_u8(str + i)) & 0x80) {
+            break;
+        }
+    }
+#else
+    for (; (i + 16) <= len; i += 16) {
+        Uint64 chunk[2];
+        SDL_memcpy(chunk, str + i, sizeof(chunk));
+        if ((chunk[0] | chunk[1]) & 0x8080808080808080ull) {
+            break;
+        }
+    }
+#endif
+    return i;
+}
+
+size_t SDL_ScanASCII(const char *str, size_t len)
+{
+    const Uint8 *s = (const Uint8 *)str;
+    size_t i;
+
+    i = SDL_ScanASCIIBlocks(s, 0, SDL_min(len, 64));
+#ifdef SDL_AVX2_INTRINSICS
+    // Only worth checking the CPU for once it looks like a long run
+    if (i == 64 && (len - i) >= 256 && SDL_HasAVX2()) {
+        i = SDL_ScanASCII_AVX2(s, i, len);
+    }
+#endif
+    i = SDL_ScanASCIIBlocks(s, i, len);
+
+    while (i < len && s[i] < 0x80) {
+        ++i;
+    }
+    return i;
+}
+
+// Blocks are only read from 16 byte aligned addresses, so they never cross into another page,
+// but they can read past the terminator, which the address sanitizer would report.
+#if defined(__GNUC__) || defined(__clang__)
+#define SDL_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define SDL_NO_SANITIZE_ADDRESS
+#endif
+
+// Returns the number of bytes at the start of `str` that are 7-bit ASCII and not the terminator, up to `len`
+static size_t SDL_NO_SANITIZE_ADDRESS SDL_ScanASCIIString(const char *str, size_t len)
+{
+    const Uint8 *s = (const Uint8 *)str;
+    size_t i = 0;
+
+    // Short runs between multibyte characters usually end here
+    while (i < len && ((uintptr_t)(s + i) & 15) != 0) {
+        if ((Uint8)(s[i] - 1) >= 0x7F) {
+            return i;
+        }
+        ++i;
+    }
+
+#if defined(SDL_STDLIB_USE_SSE2)
+    for (; (i + 16) <= len; i += 16) {
+        const __m128i chunk = _mm_load_si128((const __m128i *)(s + i));
+        const Uint32 mask = (Uint32)(_mm_movemask_epi8(chunk) | _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_setzero_si128())));
+        if (mask) {
+            return i + SDL_MostSignificantBitIndex32(mask & (~mask + 1));
+        }
+    }
+#elif defined(SDL_STDLIB_USE_NEON)
+    for (; (i + 16) <= len; i += 16) {
+        const uint8x16_t chunk = vld1q_u8(s + i);
+        if ((vmaxvq_u8(chunk) & 0x80) || vminvq_u8(chunk) == 0) {
+            break;
+        }
+    }
+#endif
+
+    while (i < len && (Uint8)(s[i] - 1) < 0x7F) {
+        ++i;
+    }
+    return i;
+}
+
+// Counts codepoints up to the terminator, or up to *bytes if it isn't NULL
+static size_t UTF8_CountCodepoints(const char *str, size_t *bytes)
 {
     size_t result = 0;
-    while (SDL_StepUTF8(&str, &bytes)) {
-        result++;
+
+    while (*str && (!bytes || *bytes > 0)) {
+        if ((Uint8)*str < 0x80) {
+            // Runs of ASCII are one codepoint per byte
+            const size_t ascii = SDL_ScanASCIIString(str, bytes ? *bytes : SDL_SIZE_MAX);
+            result += ascii;
+            str += ascii;
+            if (bytes) {
+                *bytes -= ascii;
+            }
+        } else {
+            SDL_StepUTF8(&str, bytes);
+            result++;
+        }
     }
     return result;
 }
 
+size_t SDL_utf8strlen(const char *str)
+{
+    return UTF8_CountCodepoints(str, NULL);
+}
+
+size_t SDL_utf8strnlen(const char *str, size_t bytes)
+{
+    return UTF8_CountCodepoints(str, &bytes);
+}
+
 size_t SDL_strlcat(SDL_INOUT_Z_CAP(maxlen) char *dst, const char *src, size_t maxlen)
 {
 #ifdef HAVE_STRLCAT
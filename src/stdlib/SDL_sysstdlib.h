@@ -28,5 +28,25 @@
 // this expects `from` to be a Unicode codepoint, and `to` to point to AT LEAST THREE Uint32s.
 int SDL_CaseFoldUnicode(Uint32 from, Uint32 *to);
 
+// releases memory held by the allocation caches, see SDL_SetMemoryThreadCache()
+extern void SDL_QuitMemoryCaches(void);
+
+// SIMD that the string functions can use without checking the CPU at runtime
+#if defined(SDL_SSE2_INTRINSICS) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2)))
+#define SDL_STDLIB_USE_SSE2
+#elif defined(SDL_NEON_INTRINSICS) && (defined(__aarch64__) || defined(_M_ARM64))
+#define SDL_STDLIB_USE_NEON
+#endif
+
+// returns the number of bytes at the start of `str` that are 7-bit ASCII, up to `len`.
+extern size_t SDL_ScanASCII(const char *str, size_t len);
+
+// copies and fills for large buffers like surfaces, using the widest vector stores the CPU has.
+// with `nontemporal`, the stores bypass the cache, which is faster once the whole operation
+// (e.g. all the rows of a surface) is larger than the cache, see SDL_UseNonTemporalStores().
+extern void SDL_memcpy_vector(void *dst, const void *src, size_t len, bool nontemporal);
+extern void SDL_memset4_vector(void *dst, Uint32 val, size_t dwords, bool nontemporal);
+extern bool SDL_UseNonTemporalStores(size_t len);
+
 #endif
 
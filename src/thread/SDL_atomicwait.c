@@ -0,0 +1,285 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_thread_c.h"
+
+/* Waiting on atomic variables
+
+   On Linux, threads sleep on the variable itself with a futex, and on Windows 8 and newer with
+   WaitOnAddress(). Everywhere else, they park in a table of buckets, each with a mutex and a
+   condition variable, that the variable's address hashes into. Since several variables can
+   share a bucket, notifying a parked thread wakes up every thread in the bucket, and each one
+   checks whether its own variable changed.
+
+   Notifying is cheap when nobody waits: waiters are counted in a table indexed the same way,
+   a waiter counts itself before checking the variable, and a notifier checks the count after
+   the variable was changed, so one of them always sees the other. */
+
+#ifdef SDL_THREAD_LINUX_FUTEX
+#include "pthread/SDL_sysfutex_c.h"
+#elif defined(SDL_THREAD_WINDOWS)
+#include "../core/windows/SDL_windows.h"
+
+typedef BOOL(WINAPI *pfnWaitOnAddress)(volatile VOID *, PVOID, SIZE_T, DWORD);
+typedef VOID(WINAPI *pfnWakeByAddressSingle)(PVOID);
+typedef VOID(WINAPI *pfnWakeByAddressAll)(PVOID);
+
+static SDL_InitState SDL_wait_on_address_init;
+static pfnWaitOnAddress pWaitOnAddress = NULL;
+static pfnWakeByAddressSingle pWakeByAddressSingle = NULL;
+static pfnWakeByAddressAll pWakeByAddressAll = NULL;
+
+static bool SDL_HasWaitOnAddress(void)
+{
+    if (SDL_ShouldInit(&SDL_wait_on_address_init)) {
+        // See SDL_syssem.c for why loading this API set is fine
+        HMODULE synch120 = GetModuleHandle(TEXT("api-ms-win-core-synch-l1-2-0.dll"));
+        if (synch120) {
+            // Requires Windows 8 or newer
+            pWaitOnAddress = (pfnWaitOnAddress)GetProcAddress(synch120, "WaitOnAddress");
+            pWakeByAddressSingle = (pfnWakeByAddressSingle)GetProcAddress(synch120, "WakeByAddressSingle");
+            pWakeByAddressAll = (pfnWakeByAddressAll)GetProcAddress(synch120, "WakeByAddressAll");
+        }
+        SDL_SetInitialized(&SDL_wait_on_address_init, true);
+    }
+    return (pWaitOnAddress && pWakeByAddressSingle && pWakeByAddressAll);
+}
+#endif
+
+// Must be a power of two
+#define SDL_WAIT_TABLE_SIZE 64
+
+static SDL_AtomicInt SDL_atomic_waiters[SDL_WAIT_TABLE_SIZE];
+
+static int GetWaitIndex(SDL_AtomicInt *a)
+{
+    // Variables are often next to each other, so mix the upper bits of the address in too
+    return (int)((((Uint64)(uintptr_t)a * 0x9E3779B97F4A7C15ULL) >> 32) & (SDL_WAIT_TABLE_SIZE - 1));
+}
+
+#ifndef SDL_THREAD_LINUX_FUTEX
+
+typedef struct SDL_ParkingBucket
+{
+    SDL_Mutex *lock;
+    SDL_Condition *condition;
+} SDL_ParkingBucket;
+
+static SDL_InitState SDL_parking_lot_init;
+static SDL_ParkingBucket *SDL_parking_lot;
+
+static void DestroyParkingLot(void)
+{
+    if (SDL_parking_lot) {
+        int i;
+
+        for (i = 0; i < SDL_WAIT_TABLE_SIZE; ++i) {
+            SDL_DestroyCondition(SDL_parking_lot[i].condition);
+            SDL_DestroyMutex(SDL_parking_lot[i].lock);
+        }
+        SDL_free(SDL_parking_lot);
+        SDL_parking_lot = NULL;
+    }
+}
+
+static SDL_ParkingBucket *GetParkingBucket(int index)
+{
+    if (SDL_ShouldInit(&SDL_parking_lot_init)) {
+        bool initialized = false;
+
+        SDL_parking_lot = (SDL_ParkingBucket *)SDL_calloc(SDL_WAIT_TABLE_SIZE, sizeof(*SDL_parking_lot));
+        if (SDL_parking_lot) {
+            int i;
+
+            initialized = true;
+            for (i = 0; i < SDL_WAIT_TABLE_SIZE; ++i) {
+                SDL_parking_lot[i].lock = SDL_CreateMutex();
+                SDL_parking_lot[i].condition = SDL_CreateCondition();
+                if (!SDL_parking_lot[i].lock || !SDL_parking_lot[i].condition) {
+                    initialized = false;
+                }
+            }
+        }
+        if (!initialized) {
+            DestroyParkingLot();
+        }
+        SDL_SetInitialized(&SDL_parking_lot_init, initialized);
+    }
+    if (!SDL_parking_lot) {
+        return NULL;
+    }
+    return &SDL_parking_lot[index];
+}
+
+#endif // !SDL_THREAD_LINUX_FUTEX
+
+// Sleeps until the value might have changed or the timeout expires, the caller checks which
+static void SDL_SYS_WaitAtomicInt(SDL_AtomicInt *a, int index, int value, Sint64 timeoutNS)
+{
+#ifdef SDL_THREAD_LINUX_FUTEX
+    SDL_FutexWait(a, value, timeoutNS);
+#else
+    SDL_ParkingBucket *bucket;
+
+#ifdef SDL_THREAD_WINDOWS
+    if (SDL_HasWaitOnAddress()) {
+        const DWORD timeout = (timeoutNS < 0) ? INFINITE : (DWORD)SDL_NS_TO_MS(timeoutNS + SDL_NS_PER_MS - 1);
+        pWaitOnAddress(&a->value, &value, sizeof(a->value), timeout);
+        return;
+    }
+#endif
+
+    bucket = GetParkingBucket(index);
+    if (!bucket) {
+        // Couldn't create the parking lot, all we can do is poll
+        SDL_DelayNS(timeoutNS >= 0 ? SDL_min(timeoutNS, SDL_US_TO_NS(100)) : SDL_US_TO_NS(100));
+        return;
+    }
+
+    // The value is checked under the lock, which the notifying thread takes after changing it
+    SDL_LockMutex(bucket->lock);
+    if (SDL_GetAtomicInt(a) == value) {
+        SDL_WaitConditionTimeoutNS(bucket->condition, bucket->lock, timeoutNS);
+    }
+    SDL_UnlockMutex(bucket->lock);
+#endif
+}
+
+static void SDL_SYS_NotifyAtomicInt(SDL_AtomicInt *a, int index, bool all)
+{
+#ifdef SDL_THREAD_LINUX_FUTEX
+    SDL_FutexWake(a, all ? SDL_MAX_SINT32 : 1);
+#else
+    SDL_ParkingBucket *bucket;
+
+#ifdef SDL_THREAD_WINDOWS
+    if (SDL_HasWaitOnAddress()) {
+        if (all) {
+            pWakeByAddressAll(&a->value);
+        } else {
+            pWakeByAddressSingle(&a->value);
+        }
+        return;
+    }
+#endif
+
+    // Threads waiting on other variables might share the bucket, so wake them all
+    bucket = GetParkingBucket(index);
+    if (bucket) {
+        SDL_LockMutex(bucket->lock);
+        SDL_BroadcastCondition(bucket->condition);
+        SDL_UnlockMutex(bucket->lock);
+    }
+#endif
+}
+
+bool SDL_WaitAtomicIntTimeoutNS(SDL_AtomicInt *a, int value, Sint64 timeoutNS)
+{
+    Uint64 deadline = 0;
+    bool result = true;
+    int index;
+
+    if (!a) {
+        return SDL_InvalidParamError("a");
+    }
+
+    if (SDL_GetAtomicInt(a) != value) {
+        return true;
+    }
+    if (timeoutNS == 0) {
+        return false;
+    }
+    if (timeoutNS > 0) {
+        deadline = SDL_GetTicksNS() + timeoutNS;
+    }
+
+    index = GetWaitIndex(a);
+    SDL_AddAtomicInt(&SDL_atomic_waiters[index], 1);
+    while (SDL_GetAtomicInt(a) == value) {
+        if (timeoutNS > 0) {
+            const Uint64 now = SDL_GetTicksNS();
+            if (now >= deadline) {
+                result = false;
+                break;
+            }
+            timeoutNS = (Sint64)(deadline - now);
+        }
+        SDL_SYS_WaitAtomicInt(a, index, value, timeoutNS);
+    }
+    SDL_AddAtomicInt(&SDL_atomic_waiters[index], -1);
+
+    return result;
+}
+
+void SDL_WaitAtomicInt(SDL_AtomicInt *a, int value)
+{
+    SDL_WaitAtomicIntTimeoutNS(a, value, -1);
+}
+
+bool SDL_WaitAtomicIntTimeout(SDL_AtomicInt *a, int value, Sint32 timeoutMS)
+{
+    Sint64 timeoutNS;
+
+    if (timeoutMS >= 0) {
+        timeoutNS = SDL_MS_TO_NS(timeoutMS);
+    } else {
+        timeoutNS = -1;
+    }
+    return SDL_WaitAtomicIntTimeoutNS(a, value, timeoutNS);
+}
+
+static void SDL_NotifyAtomicInt(SDL_AtomicInt *a, bool all)
+{
+    int index;
+
+    if (!a) {
+        return;
+    }
+
+    index = GetWaitIndex(a);
+    if (SDL_GetAtomicInt(&SDL_atomic_waiters[index]) > 0) {
+        SDL_SYS_NotifyAtomicInt(a, index, all);
+    }
+}
+
+void SDL_NotifyAtomicIntOne(SDL_AtomicInt *a)
+{
+    SDL_NotifyAtomicInt(a, false);
+}
+
+void SDL_NotifyAtomicIntAll(SDL_AtomicInt *a)
+{
+    SDL_NotifyAtomicInt(a, true);
+}
+
+void SDL_QuitAtomicWait(void)
+{
+#ifndef SDL_THREAD_LINUX_FUTEX
+    if (!SDL_ShouldQuit(&SDL_parking_lot_init)) {
+        return;
+    }
+
+    DestroyParkingLot();
+
+    SDL_SetInitialized(&SDL_parking_lot_init, false);
+#endif
+}
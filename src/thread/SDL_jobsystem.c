@@ -0,0 +1,589 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_systhread.h"
+
+/* The job system: a fixed pool of worker threads with work stealing.
+
+   Every worker has a deque of jobs. The worker pushes and pops jobs at the bottom of its own
+   deque, so the pieces a job splits into are run most recent first, while they're still in the
+   cache. Idle threads steal from the top of the other deques, taking the oldest jobs, which are
+   usually the biggest pieces of work. The deque is the one from Chase and Lev, with a fixed
+   size instead of growing: when it's full, jobs go on the shared queue instead.
+   Chase D, Lev Y. Dynamic circular work-stealing deque. SPAA '05. doi: 10.1145/1073970.1073974
+
+   Jobs submitted from threads that aren't workers go on the shared queue, which is protected by
+   a mutex. Workers take the oldest jobs from it, while other threads take the newest, which are
+   the last ones they submitted themselves, just like a worker with its own deque. Otherwise a
+   thread waiting on a job that it split up would go on to start the biggest piece of some other
+   work, wait on a piece of that, and so on, until it ran out of stack.
+
+   Threads waiting for a job run other jobs in the meantime, and only sleep when there is
+   nothing to run. They wait on the epoch counter until it changes, which happens whenever
+   there is new work or a job with waiters is done. */
+
+// Jobs a worker can queue on its own deque, must be a power of two
+#define SDL_JOB_DEQUE_SIZE 1024
+
+// How many times an idle thread checks for new work before going to sleep
+#define SDL_JOB_SPIN_COUNT 200
+
+struct SDL_Job
+{
+    SDL_JobSystem *system;
+    SDL_JobFunction func;
+    void *userdata;
+
+    // One for the handle returned to the app, one until the job is done
+    SDL_AtomicInt refcount;
+
+    // Dependencies that aren't done yet, plus one until the job is completely submitted
+    SDL_AtomicInt pending;
+
+    SDL_AtomicInt done;
+    SDL_AtomicInt waiters;
+
+    // Jobs that depend on this one, protected by the spinlock until this job is done
+    SDL_SpinLock lock;
+    SDL_Job **dependents;
+    int num_dependents;
+    int max_dependents;
+
+    // The neighbors of the job in the shared queue
+    SDL_Job *prev;
+    SDL_Job *next;
+};
+
+typedef struct SDL_JobWorker
+{
+    SDL_JobSystem *system;
+    SDL_Thread *thread;
+    int index;
+    Uint64 steal_state;
+
+    // Thieves take jobs from the top, the owner pushes and pops them at the bottom
+    SDL_AtomicInt top;
+    Uint8 padding[SDL_CACHELINE_SIZE];
+    SDL_AtomicInt bottom;
+    void *jobs[SDL_JOB_DEQUE_SIZE];
+} SDL_JobWorker;
+
+struct SDL_JobSystem
+{
+    SDL_JobWorker *workers;
+    int num_workers;
+    bool pin_threads;
+    SDL_ThreadPriority priority;
+    SDL_AtomicInt shutdown;
+
+    SDL_Mutex *queue_lock;
+    SDL_Job *queue_head;
+    SDL_Job *queue_tail;
+    SDL_AtomicInt queue_length;
+
+    SDL_AtomicInt epoch;
+    SDL_AtomicInt next_victim;  // where threads that aren't workers start stealing
+};
+
+// The worker that the current thread is, if it is one
+static SDL_TLSID SDL_job_worker;
+
+static SDL_InitState SDL_global_job_system_init;
+static SDL_JobSystem *SDL_global_job_system;
+
+static SDL_JobWorker *GetCurrentWorker(SDL_JobSystem *system)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)SDL_GetTLS(&SDL_job_worker);
+    if (worker && worker->system == system) {
+        return worker;
+    }
+    return NULL;
+}
+
+static bool PushLocalJob(SDL_JobWorker *worker, SDL_Job *job)
+{
+    const Uint32 bottom = (Uint32)SDL_GetAtomicInt(&worker->bottom);
+    const Uint32 top = (Uint32)SDL_GetAtomicInt(&worker->top);
+
+    if (bottom - top >= SDL_JOB_DEQUE_SIZE) {
+        return false;
+    }
+    SDL_SetAtomicPointer(&worker->jobs[bottom & (SDL_JOB_DEQUE_SIZE - 1)], job);
+    SDL_MemoryBarrierRelease();
+    SDL_SetAtomicInt(&worker->bottom, (int)(bottom + 1));
+    return true;
+}
+
+static SDL_Job *PopLocalJob(SDL_JobWorker *worker)
+{
+    // The atomic add is a full barrier, so thieves see the new bottom before we look at the top
+    const Uint32 bottom = (Uint32)SDL_AddAtomicInt(&worker->bottom, -1) - 1;
+    const Uint32 top = (Uint32)SDL_GetAtomicInt(&worker->top);
+    SDL_Job *job;
+
+    if ((Sint32)(bottom - top) < 0) {
+        // The deque is empty
+        SDL_SetAtomicInt(&worker->bottom, (int)(bottom + 1));
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_GetAtomicPointer(&worker->jobs[bottom & (SDL_JOB_DEQUE_SIZE - 1)]);
+    if (bottom == top) {
+        // This is the last job, race the thieves for it
+        if (!SDL_CompareAndSwapAtomicInt(&worker->top, (int)top, (int)(top + 1))) {
+            job = NULL;
+        }
+        SDL_SetAtomicInt(&worker->bottom, (int)(bottom + 1));
+    }
+    return job;
+}
+
+static SDL_Job *StealJob(SDL_JobWorker *victim)
+{
+    for (;;) {
+        const Uint32 top = (Uint32)SDL_GetAtomicInt(&victim->top);
+        const Uint32 bottom = (Uint32)SDL_GetAtomicInt(&victim->bottom);
+        SDL_Job *job;
+
+        if ((Sint32)(bottom - top) <= 0) {
+            return NULL;
+        }
+        job = (SDL_Job *)SDL_GetAtomicPointer(&victim->jobs[top & (SDL_JOB_DEQUE_SIZE - 1)]);
+        if (SDL_CompareAndSwapAtomicInt(&victim->top, (int)top, (int)(top + 1))) {
+            return job;
+        }
+        // Another thread took that job, try the next one
+    }
+}
+
+static void WakeJobThreads(SDL_JobSystem *system)
+{
+    // This doesn't cost more than the increment when nobody is sleeping
+    SDL_AddAtomicInt(&system->epoch, 1);
+    SDL_NotifyAtomicIntAll(&system->epoch);
+}
+
+// Sleeps until the epoch changes, or the job is done
+static void SleepJobThread(SDL_JobSystem *system, int epoch, SDL_Job *job)
+{
+    int i;
+
+    // New work often comes right away, when a job is split into pieces, so don't give up the CPU yet
+    for (i = 0; i < SDL_JOB_SPIN_COUNT; ++i) {
+        if (SDL_GetAtomicInt(&system->epoch) != epoch || (job && SDL_GetAtomicInt(&job->done))) {
+            return;
+        }
+        SDL_CPUPauseInstruction();
+    }
+
+    // Shutting down and finishing a job with waiters both change the epoch too
+    if (!SDL_GetAtomicInt(&system->shutdown) && !(job && SDL_GetAtomicInt(&job->done))) {
+        SDL_WaitAtomicInt(&system->epoch, epoch);
+    }
+}
+
+static void ScheduleJob(SDL_Job *job)
+{
+    SDL_JobSystem *system = job->system;
+    SDL_JobWorker *worker = GetCurrentWorker(system);
+
+    if (!worker || !PushLocalJob(worker, job)) {
+        SDL_LockMutex(system->queue_lock);
+        job->prev = system->queue_tail;
+        job->next = NULL;
+        if (system->queue_tail) {
+            system->queue_tail->next = job;
+        } else {
+            system->queue_head = job;
+        }
+        system->queue_tail = job;
+        SDL_AddAtomicInt(&system->queue_length, 1);
+        SDL_UnlockMutex(system->queue_lock);
+    }
+    WakeJobThreads(system);
+}
+
+static SDL_Job *FindJob(SDL_JobSystem *system, SDL_JobWorker *worker)
+{
+    SDL_Job *job = NULL;
+    int i, start;
+
+    if (worker) {
+        job = PopLocalJob(worker);
+        if (job) {
+            return job;
+        }
+    }
+
+    if (SDL_GetAtomicInt(&system->queue_length) > 0) {
+        SDL_LockMutex(system->queue_lock);
+        if (worker) {
+            job = system->queue_head;
+            if (job) {
+                system->queue_head = job->next;
+                if (system->queue_head) {
+                    system->queue_head->prev = NULL;
+                } else {
+                    system->queue_tail = NULL;
+                }
+            }
+        } else {
+            job = system->queue_tail;
+            if (job) {
+                system->queue_tail = job->prev;
+                if (system->queue_tail) {
+                    system->queue_tail->next = NULL;
+                } else {
+                    system->queue_head = NULL;
+                }
+            }
+        }
+        if (job) {
+            SDL_AddAtomicInt(&system->queue_length, -1);
+        }
+        SDL_UnlockMutex(system->queue_lock);
+        if (job) {
+            return job;
+        }
+    }
+
+    if (system->num_workers == 0) {
+        return NULL;
+    }
+
+    // Start with a random victim, so the thieves don't all go after the same worker
+    if (worker) {
+        start = SDL_rand_r(&worker->steal_state, system->num_workers);
+    } else {
+        start = (int)((Uint32)SDL_AddAtomicInt(&system->next_victim, 1) % (Uint32)system->num_workers);
+    }
+    for (i = 0; i < system->num_workers; ++i) {
+        SDL_JobWorker *victim = &system->workers[(start + i) % system->num_workers];
+        if (victim != worker) {
+            job = StealJob(victim);
+            if (job) {
+                return job;
+            }
+        }
+    }
+    return NULL;
+}
+
+static void ReleaseDependency(SDL_Job *job)
+{
+    if (SDL_AddAtomicInt(&job->pending, -1) == 1) {
+        ScheduleJob(job);
+    }
+}
+
+static void RunJob(SDL_Job *job)
+{
+    SDL_Job **dependents;
+    int i, num_dependents;
+
+    if (job->func) {
+        job->func(job->userdata);
+    }
+
+    SDL_LockSpinlock(&job->lock);
+    SDL_SetAtomicInt(&job->done, 1);
+    dependents = job->dependents;
+    num_dependents = job->num_dependents;
+    job->dependents = NULL;
+    job->num_dependents = 0;
+    job->max_dependents = 0;
+    SDL_UnlockSpinlock(&job->lock);
+
+    for (i = 0; i < num_dependents; ++i) {
+        ReleaseDependency(dependents[i]);
+    }
+    SDL_free(dependents);
+
+    if (SDL_GetAtomicInt(&job->waiters) > 0) {
+        WakeJobThreads(job->system);
+    }
+    SDL_ReleaseJob(job);
+}
+
+static int SDLCALL JobWorkerThread(void *data)
+{
+    SDL_JobWorker *worker = (SDL_JobWorker *)data;
+    SDL_JobSystem *system = worker->system;
+
+    SDL_SetTLS(&SDL_job_worker, worker, NULL);
+    if (system->priority != SDL_THREAD_PRIORITY_NORMAL) {
+        SDL_SetCurrentThreadPriority(system->priority);
+    }
+    if (system->pin_threads) {
+        // This is only a hint, the worker runs fine wherever it is
+        SDL_SYS_SetThreadAffinity(worker->index % SDL_GetNumLogicalCPUCores());
+    }
+
+    for (;;) {
+        const int epoch = SDL_GetAtomicInt(&system->epoch);
+        SDL_Job *job = FindJob(system, worker);
+        if (job) {
+            RunJob(job);
+        } else if (SDL_GetAtomicInt(&system->shutdown)) {
+            break;
+        } else {
+            SleepJobThread(system, epoch, NULL);
+        }
+    }
+
+    SDL_SetTLS(&SDL_job_worker, NULL, NULL);
+    return 0;
+}
+
+SDL_JobSystem *SDL_CreateJobSystem(SDL_PropertiesID props)
+{
+    SDL_JobSystem *system;
+    int i, num_threads;
+
+    num_threads = (int)SDL_GetNumberProperty(props, SDL_PROP_JOBSYSTEM_CREATE_THREADS_NUMBER, 0);
+    if (num_threads <= 0) {
+        num_threads = SDL_GetNumLogicalCPUCores();
+    }
+#ifdef SDL_THREADS_DISABLED
+    // Jobs run on the threads that wait for them
+    num_threads = 0;
+#endif
+
+    system = (SDL_JobSystem *)SDL_calloc(1, sizeof(*system));
+    if (!system) {
+        return NULL;
+    }
+    system->pin_threads = SDL_GetBooleanProperty(props, SDL_PROP_JOBSYSTEM_CREATE_PIN_THREADS_BOOLEAN, false);
+    system->priority = (SDL_ThreadPriority)SDL_GetNumberProperty(props, SDL_PROP_JOBSYSTEM_CREATE_PRIORITY_NUMBER, SDL_THREAD_PRIORITY_NORMAL);
+    system->queue_lock = SDL_CreateMutex();
+    if (num_threads > 0) {
+        system->workers = (SDL_JobWorker *)SDL_aligned_alloc(SDL_CACHELINE_SIZE, num_threads * sizeof(*system->workers));
+    }
+    if (!system->queue_lock || (num_threads > 0 && !system->workers)) {
+        SDL_DestroyJobSystem(system);
+        return NULL;
+    }
+
+    if (num_threads > 0) {
+        SDL_memset(system->workers, 0, num_threads * sizeof(*system->workers));
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_JobWorker *worker = &system->workers[i];
+        char name[32];
+
+        worker->system = system;
+        worker->index = i;
+        worker->steal_state = (Uint64)(i + 1) * 0x9E3779B97F4A7C15ULL;
+        SDL_snprintf(name, sizeof(name), "SDLJobWorker%d", i);
+        worker->thread = SDL_CreateThread(JobWorkerThread, name, worker);
+        if (!worker->thread) {
+            SDL_DestroyJobSystem(system);
+            return NULL;
+        }
+        system->num_workers = i + 1;
+    }
+    return system;
+}
+
+int SDL_GetJobSystemThreadCount(SDL_JobSystem *system)
+{
+    if (!system) {
+        SDL_InvalidParamError("system");
+        return -1;
+    }
+    return system->num_workers;
+}
+
+void SDL_DestroyJobSystem(SDL_JobSystem *system)
+{
+    SDL_Job *job;
+    int i;
+
+    if (!system) {
+        return;
+    }
+
+    // The workers run everything that's left before they exit
+    SDL_SetAtomicInt(&system->shutdown, 1);
+    WakeJobThreads(system);
+    for (i = 0; i < system->num_workers; ++i) {
+        SDL_WaitThread(system->workers[i].thread, NULL);
+    }
+
+    // Without workers, whatever is left in the shared queue is run here
+    while ((job = FindJob(system, NULL)) != NULL) {
+        RunJob(job);
+    }
+
+    SDL_aligned_free(system->workers);
+    SDL_DestroyMutex(system->queue_lock);
+    SDL_free(system);
+}
+
+// Returns false if the dependency is already done
+static bool AddDependent(SDL_Job *dependency, SDL_Job *job)
+{
+    SDL_Job **grown = NULL;
+    int grown_size = 0;
+
+    for (;;) {
+        SDL_Job **old = NULL;
+        bool added = false;
+        bool done = false;
+        int needed = 0;
+
+        SDL_LockSpinlock(&dependency->lock);
+        if (SDL_GetAtomicInt(&dependency->done)) {
+            done = true;
+        } else {
+            if (dependency->num_dependents == dependency->max_dependents && grown_size > dependency->max_dependents) {
+                if (dependency->num_dependents > 0) {
+                    SDL_memcpy(grown, dependency->dependents, dependency->num_dependents * sizeof(*grown));
+                }
+                old = dependency->dependents;
+                dependency->dependents = grown;
+                dependency->max_dependents = grown_size;
+                grown = NULL;
+                grown_size = 0;
+            }
+            if (dependency->num_dependents < dependency->max_dependents) {
+                dependency->dependents[dependency->num_dependents++] = job;
+                added = true;
+            } else {
+                needed = SDL_max(dependency->max_dependents * 2, 4);
+            }
+        }
+        SDL_UnlockSpinlock(&dependency->lock);
+
+        SDL_free(old);
+        if (added || done) {
+            SDL_free(grown);
+            return added;
+        }
+
+        // The array is full, grow it without holding the spinlock and try again
+        SDL_free(grown);
+        grown = (SDL_Job **)SDL_malloc(needed * sizeof(*grown));
+        grown_size = grown ? needed : 0;
+        if (!grown) {
+            // We're out of memory, so there's nowhere to record the dependency, wait for it instead
+            SDL_WaitJob(dependency);
+            return false;
+        }
+    }
+}
+
+SDL_Job *SDL_SubmitJob(SDL_JobSystem *system, SDL_JobFunction func, void *userdata, SDL_Job * const *dependencies, int num_dependencies)
+{
+    SDL_Job *job;
+    int i;
+
+    if (!system) {
+        SDL_InvalidParamError("system");
+        return NULL;
+    }
+    if (num_dependencies < 0 || (num_dependencies > 0 && !dependencies)) {
+        SDL_InvalidParamError("dependencies");
+        return NULL;
+    }
+
+    job = (SDL_Job *)SDL_calloc(1, sizeof(*job));
+    if (!job) {
+        return NULL;
+    }
+    job->system = system;
+    job->func = func;
+    job->userdata = userdata;
+    SDL_SetAtomicInt(&job->refcount, 2);
+    SDL_SetAtomicInt(&job->pending, 1);
+
+    for (i = 0; i < num_dependencies; ++i) {
+        if (dependencies[i]) {
+            SDL_AddAtomicInt(&job->pending, 1);
+            if (!AddDependent(dependencies[i], job)) {
+                SDL_AddAtomicInt(&job->pending, -1);
+            }
+        }
+    }
+
+    ReleaseDependency(job);
+    return job;
+}
+
+bool SDL_WaitJob(SDL_Job *job)
+{
+    SDL_JobSystem *system;
+    SDL_JobWorker *worker;
+
+    if (!job) {
+        return SDL_InvalidParamError("job");
+    }
+    if (SDL_GetAtomicInt(&job->done)) {
+        return true;
+    }
+
+    system = job->system;
+    worker = GetCurrentWorker(system);
+    SDL_AddAtomicInt(&job->waiters, 1);
+    while (!SDL_GetAtomicInt(&job->done)) {
+        const int epoch = SDL_GetAtomicInt(&system->epoch);
+        SDL_Job *other = FindJob(system, worker);
+        if (other) {
+            RunJob(other);
+        } else {
+            SleepJobThread(system, epoch, job);
+        }
+    }
+    SDL_AddAtomicInt(&job->waiters, -1);
+    return true;
+}
+
+void SDL_ReleaseJob(SDL_Job *job)
+{
+    if (!job) {
+        return;
+    }
+    if (SDL_AddAtomicInt(&job->refcount, -1) == 1) {
+        SDL_free(job->dependents);
+        SDL_free(job);
+    }
+}
+
+SDL_JobSystem *SDL_GetGlobalJobSystem(void)
+{
+    if (SDL_ShouldInit(&SDL_global_job_system_init)) {
+        SDL_global_job_system = SDL_CreateJobSystem(0);
+        SDL_SetInitialized(&SDL_global_job_system_init, SDL_global_job_system != NULL);
+    }
+    return SDL_global_job_system;
+}
+
+void SDL_QuitJobSystem(void)
+{
+    if (!SDL_ShouldQuit(&SDL_global_job_system_init)) {
+        return;
+    }
+
+    SDL_DestroyJobSystem(SDL_global_job_system);
+    SDL_global_job_system = NULL;
+    SDL_SetInitialized(&SDL_global_job_system_init, false);
+}
@@ -0,0 +1,397 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#include "SDL_thread_c.h"
+#include "../SDL_hints_c.h"
+
+/* Lock profiling
+
+   When SDL_HINT_LOCK_PROFILING is set, every named mutex and rwlock gets a
+   profile, which the lock implementation tells about each acquisition and
+   release. Locks with the same name share their statistics, so all the
+   instances of a kind of lock show up as one line in the table.
+
+   The statistics are updated under a spinlock, never a mutex, since the
+   mutexes might be profiled themselves. For the same reason, times come
+   from the performance counter rather than SDL_GetTicksNS(), which has to
+   set up the timer hint the first time it's called. This only costs
+   anything for locks that are profiled, everything else just checks for a
+   NULL profile. */
+
+#define SDL_LOCK_HISTOGRAM_BUCKETS 32
+
+typedef struct SDL_LockStats
+{
+    char *name;
+    int refcount;
+    SDL_SpinLock lock;
+    Uint64 acquisitions;
+    Uint64 shared_acquisitions;
+    Uint64 contended;
+    Uint64 wait_total;
+    Uint64 wait_max;
+    Uint64 holds;
+    Uint64 hold_total;
+    Uint64 hold_max;
+    Uint64 wait_histogram[SDL_LOCK_HISTOGRAM_BUCKETS];
+    Uint64 hold_histogram[SDL_LOCK_HISTOGRAM_BUCKETS];
+    struct SDL_LockStats *next;
+} SDL_LockStats;
+
+struct SDL_LockProfile
+{
+    SDL_LockStats *stats;
+    // Only changed by the thread holding the lock exclusively
+    SDL_ThreadID owner;
+    int depth;
+    Uint64 locked_at;
+};
+
+static SDL_SpinLock SDL_lock_stats_lock;
+static SDL_LockStats *SDL_lock_stats;
+
+static Uint64 CountsToNS(Uint64 counts)
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    // Split up so long waits don't overflow
+    return (counts / frequency) * SDL_NS_PER_SECOND + ((counts % frequency) * SDL_NS_PER_SECOND) / frequency;
+}
+
+// Bucket i counts times from 2^i up to 2^(i+1) nanoseconds
+static int GetHistogramBucket(Uint64 ns)
+{
+    if (ns >= ((Uint64)1 << (SDL_LOCK_HISTOGRAM_BUCKETS - 1))) {
+        return SDL_LOCK_HISTOGRAM_BUCKETS - 1;
+    }
+    if (ns == 0) {
+        return 0;
+    }
+    return SDL_MostSignificantBitIndex32((Uint32)ns);
+}
+
+SDL_LockProfile *SDL_CreateLockProfile(const char *name)
+{
+    SDL_LockProfile *profile;
+    SDL_LockStats *stats, *new_stats;
+
+    /* The hint is read straight from the environment, because the hint system
+       uses locks itself, which might be the ones being created. */
+    if (!name || !SDL_GetStringBoolean(SDL_getenv_unsafe(SDL_HINT_LOCK_PROFILING), false)) {
+        return NULL;
+    }
+
+    // Allocate everything up front, other threads spin on the lock for as long as we hold it
+    profile = (SDL_LockProfile *)SDL_calloc(1, sizeof(*profile));
+    new_stats = (SDL_LockStats *)SDL_calloc(1, sizeof(*new_stats));
+    if (new_stats) {
+        new_stats->name = SDL_strdup(name);
+    }
+    if (!profile || !new_stats || !new_stats->name) {
+        if (new_stats) {
+            SDL_free(new_stats->name);
+        }
+        SDL_free(new_stats);
+        SDL_free(profile);
+        return NULL;
+    }
+
+    SDL_LockSpinlock(&SDL_lock_stats_lock);
+    for (stats = SDL_lock_stats; stats; stats = stats->next) {
+        if (SDL_strcmp(stats->name, name) == 0) {
+            break;
+        }
+    }
+    if (!stats) {
+        stats = new_stats;
+        stats->next = SDL_lock_stats;
+        SDL_lock_stats = stats;
+        new_stats = NULL;
+    }
+    ++stats->refcount;
+    SDL_UnlockSpinlock(&SDL_lock_stats_lock);
+
+    if (new_stats) {
+        // Another lock with this name got there first
+        SDL_free(new_stats->name);
+        SDL_free(new_stats);
+    }
+    profile->stats = stats;
+    return profile;
+}
+
+void SDL_DestroyLockProfile(SDL_LockProfile *profile)
+{
+    if (profile) {
+        // The statistics stay around after the lock is gone, until SDL_Quit()
+        SDL_LockSpinlock(&SDL_lock_stats_lock);
+        --profile->stats->refcount;
+        SDL_UnlockSpinlock(&SDL_lock_stats_lock);
+        SDL_free(profile);
+    }
+}
+
+void SDL_LockProfileAcquired(SDL_LockProfile *profile, bool exclusive, bool contended, Uint64 wait_start)
+{
+    SDL_LockStats *stats = profile->stats;
+    const Uint64 now = SDL_GetPerformanceCounter();
+
+    SDL_LockSpinlock(&stats->lock);
+    ++stats->acquisitions;
+    if (!exclusive) {
+        ++stats->shared_acquisitions;
+    }
+    if (contended) {
+        const Uint64 wait = CountsToNS(now - wait_start);
+        ++stats->contended;
+        stats->wait_total += wait;
+        stats->wait_max = SDL_max(stats->wait_max, wait);
+        ++stats->wait_histogram[GetHistogramBucket(wait)];
+    }
+    SDL_UnlockSpinlock(&stats->lock);
+
+    // Shared locks can be held by any number of threads, so only exclusive holds are timed
+    if (exclusive && profile->depth++ == 0) {
+        profile->owner = SDL_GetCurrentThreadID();
+        profile->locked_at = now;
+    }
+}
+
+void SDL_LockProfileReleased(SDL_LockProfile *profile)
+{
+    SDL_LockStats *stats = profile->stats;
+    Uint64 hold;
+
+    if (profile->owner != SDL_GetCurrentThreadID() || --profile->depth > 0) {
+        return;
+    }
+    hold = CountsToNS(SDL_GetPerformanceCounter() - profile->locked_at);
+    profile->owner = 0;
+
+    SDL_LockSpinlock(&stats->lock);
+    ++stats->holds;
+    stats->hold_total += hold;
+    stats->hold_max = SDL_max(stats->hold_max, hold);
+    ++stats->hold_histogram[GetHistogramBucket(hold)];
+    SDL_UnlockSpinlock(&stats->lock);
+}
+
+static int SDLCALL CompareLockStats(const void *a, const void *b)
+{
+    const SDL_LockStats *A = (const SDL_LockStats *)a;
+    const SDL_LockStats *B = (const SDL_LockStats *)b;
+
+    // The locks that threads spent the most time waiting for come first
+    if (A->wait_total != B->wait_total) {
+        return (A->wait_total > B->wait_total) ? -1 : 1;
+    }
+    if (A->acquisitions != B->acquisitions) {
+        return (A->acquisitions > B->acquisitions) ? -1 : 1;
+    }
+    return SDL_strcmp(A->name, B->name);
+}
+
+// Returns the upper bound of the bucket that the given fraction of the samples falls into
+static Uint64 GetPercentile(const Uint64 *histogram, Uint64 count, Uint64 max, int percent)
+{
+    const Uint64 target = (count * percent + 99) / 100;
+    Uint64 seen = 0;
+    int i;
+
+    for (i = 0; i < SDL_LOCK_HISTOGRAM_BUCKETS; ++i) {
+        seen += histogram[i];
+        if (seen >= target) {
+            break;
+        }
+    }
+    return SDL_min(((Uint64)1 << (i + 1)), max);
+}
+
+static const char *FormatTime(Uint64 ns, char *text, size_t maxlen)
+{
+    if (ns < SDL_NS_PER_US) {
+        SDL_snprintf(text, maxlen, "%" SDL_PRIu64 "ns", ns);
+    } else if (ns < SDL_NS_PER_MS) {
+        SDL_snprintf(text, maxlen, "%.1fus", (double)ns / SDL_NS_PER_US);
+    } else if (ns < SDL_NS_PER_SECOND) {
+        SDL_snprintf(text, maxlen, "%.1fms", (double)ns / SDL_NS_PER_MS);
+    } else {
+        SDL_snprintf(text, maxlen, "%.2fs", (double)ns / SDL_NS_PER_SECOND);
+    }
+    return text;
+}
+
+bool SDL_DumpLockProfile(void)
+{
+    SDL_LockStats *stats, *snapshot;
+    int count = 0, i;
+
+    if (!SDL_GetStringBoolean(SDL_getenv_unsafe(SDL_HINT_LOCK_PROFILING), false)) {
+        return SDL_SetError("Lock profiling isn't enabled, set the " SDL_HINT_LOCK_PROFILING " environment variable");
+    }
+
+    // Copy the statistics, so nothing is locked while logging, which takes locks itself.
+    // The snapshot is allocated without holding the spinlock, and allocated again if more
+    // locks were created in the meantime.
+    snapshot = NULL;
+    for (;;) {
+        int needed = 0;
+
+        SDL_LockSpinlock(&SDL_lock_stats_lock);
+        for (stats = SDL_lock_stats; stats; stats = stats->next) {
+            ++needed;
+        }
+        if (snapshot && needed <= count) {
+            break;  // still holding the spinlock
+        }
+        SDL_UnlockSpinlock(&SDL_lock_stats_lock);
+
+        SDL_free(snapshot);
+        count = needed;
+        snapshot = (SDL_LockStats *)SDL_malloc(SDL_max(count, 1) * sizeof(*snapshot));
+        if (!snapshot) {
+            return false;
+        }
+    }
+    count = 0;
+    for (stats = SDL_lock_stats; stats; stats = stats->next) {
+        SDL_LockSpinlock(&stats->lock);
+        SDL_copyp(&snapshot[count], stats);
+        SDL_UnlockSpinlock(&stats->lock);
+        ++count;
+    }
+    SDL_UnlockSpinlock(&SDL_lock_stats_lock);
+
+    // The names are used without copying them, statistics are only freed by SDL_QuitLockProfiling()
+    SDL_qsort(snapshot, count, sizeof(*snapshot), CompareLockStats);
+
+    SDL_Log("%-32s %12s %12s %10s %10s %10s %10s %10s %10s",
+            "lock", "acquired", "contended", "wait", "wait p99", "wait max", "hold p50", "hold p99", "hold max");
+    for (i = 0; i < count; ++i) {
+        const SDL_LockStats *s = &snapshot[i];
+        char wait[16], wait_p99[16], wait_max[16], hold_p50[16], hold_p99[16], hold_max[16];
+
+        if (s->contended > 0) {
+            FormatTime(s->wait_total, wait, sizeof(wait));
+            FormatTime(GetPercentile(s->wait_histogram, s->contended, s->wait_max, 99), wait_p99, sizeof(wait_p99));
+            FormatTime(s->wait_max, wait_max, sizeof(wait_max));
+        } else {
+            SDL_strlcpy(wait, "-", sizeof(wait));
+            SDL_strlcpy(wait_p99, "-", sizeof(wait_p99));
+            SDL_strlcpy(wait_max, "-", sizeof(wait_max));
+        }
+        if (s->holds > 0) {
+            FormatTime(GetPercentile(s->hold_histogram, s->holds, s->hold_max, 50), hold_p50, sizeof(hold_p50));
+            FormatTime(GetPercentile(s->hold_histogram, s->holds, s->hold_max, 99), hold_p99, sizeof(hold_p99));
+            FormatTime(s->hold_max, hold_max, sizeof(hold_max));
+        } else {
+            SDL_strlcpy(hold_p50, "-", sizeof(hold_p50));
+            SDL_strlcpy(hold_p99, "-", sizeof(hold_p99));
+            SDL_strlcpy(hold_max, "-", sizeof(hold_max));
+        }
+        SDL_Log("%-32s %12" SDL_PRIu64 " %12" SDL_PRIu64 " %10s %10s %10s %10s %10s %10s",
+                s->name ? s->name : "?", s->acquisitions, s->contended,
+                wait, wait_p99, wait_max, hold_p50, hold_p99, hold_max);
+    }
+    SDL_free(snapshot);
+
+    return true;
+}
+
+void SDL_ResetLockProfile(void)
+{
+    SDL_LockStats *stats;
+
+    SDL_LockSpinlock(&SDL_lock_stats_lock);
+    for (stats = SDL_lock_stats; stats; stats = stats->next) {
+        SDL_LockSpinlock(&stats->lock);
+        stats->acquisitions = 0;
+        stats->shared_acquisitions = 0;
+        stats->contended = 0;
+        stats->wait_total = 0;
+        stats->wait_max = 0;
+        stats->holds = 0;
+        stats->hold_total = 0;
+        stats->hold_max = 0;
+        SDL_zeroa(stats->wait_histogram);
+        SDL_zeroa(stats->hold_histogram);
+        SDL_UnlockSpinlock(&stats->lock);
+    }
+    SDL_UnlockSpinlock(&SDL_lock_stats_lock);
+}
+
+void SDL_QuitLockProfiling(void)
+{
+    SDL_LockStats *stats, *prev = NULL, *next;
+
+    if (!SDL_lock_stats) {
+        return;
+    }
+
+    SDL_DumpLockProfile();
+
+    // Locks that are still around keep their statistics
+    SDL_LockSpinlock(&SDL_lock_stats_lock);
+    for (stats = SDL_lock_stats; stats; stats = next) {
+        next = stats->next;
+        if (stats->refcount == 0) {
+            if (prev) {
+                prev->next = next;
+            } else {
+                SDL_lock_stats = next;
+            }
+            SDL_free(stats->name);
+            SDL_free(stats);
+        } else {
+            prev = stats;
+        }
+    }
+    SDL_UnlockSpinlock(&SDL_lock_stats_lock);
+}
+
+SDL_Mutex *SDL_CreateMutexWithProperties(SDL_PropertiesID props)
+{
+    return SDL_CreateNamedMutex(SDL_GetStringProperty(props, SDL_PROP_MUTEX_CREATE_NAME_STRING, NULL));
+}
+
+SDL_RWLock *SDL_CreateRWLockWithProperties(SDL_PropertiesID props)
+{
+    return SDL_CreateNamedRWLock(SDL_GetStringProperty(props, SDL_PROP_RWLOCK_CREATE_NAME_STRING, NULL));
+}
+
+#ifndef SDL_THREAD_LOCK_PROFILING
+
+// This platform's locks don't have room for a profile, so the name isn't used
+
+SDL_Mutex *SDL_CreateNamedMutex(const char *name)
+{
+    (void)name;
+    return SDL_CreateMutex();
+}
+
+SDL_RWLock *SDL_CreateNamedRWLock(const char *name)
+{
+    (void)name;
+    return SDL_CreateRWLock();
+}
+
+#endif // !SDL_THREAD_LOCK_PROFILING
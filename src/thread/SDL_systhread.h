@@ -46,6 +46,9 @@ extern void SDL_SYS_SetupThread(const char *name);
 // This function sets the current thread priority
 extern bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority);
 
+// This function keeps the current thread on a single CPU core, if the platform supports it
+extern bool SDL_SYS_SetThreadAffinity(int cpu);
+
 /* This function waits for the thread to finish and frees any data
    allocated by SDL_SYS_CreateThread()
  */
@@ -80,6 +80,35 @@ typedef struct
 extern void SDL_InitTLSData(void);
 extern void SDL_QuitTLSData(void);
 
+// The job system SDL uses internally, created the first time it's needed
+extern SDL_JobSystem *SDL_GetGlobalJobSystem(void);
+extern void SDL_QuitJobSystem(void);
+
+// Waiting on atomic variables
+extern bool SDL_WaitAtomicIntTimeoutNS(SDL_AtomicInt *a, int value, Sint64 timeoutNS);
+extern void SDL_QuitAtomicWait(void);
+
+// Locks that SDL creates for itself are named this way, since creating properties takes a lock
+extern SDL_Mutex *SDL_CreateNamedMutex(const char *name);
+extern SDL_RWLock *SDL_CreateNamedRWLock(const char *name);
+
+/* Lock profiling, see SDL_HINT_LOCK_PROFILING.
+   The lock implementations that support it keep a profile in every lock,
+   which is NULL unless the lock was named and profiling is enabled. */
+#if defined(SDL_THREAD_PTHREAD) || defined(SDL_THREAD_WINDOWS)
+#define SDL_THREAD_LOCK_PROFILING 1
+#endif
+
+typedef struct SDL_LockProfile SDL_LockProfile;
+
+extern SDL_LockProfile *SDL_CreateLockProfile(const char *name);
+extern void SDL_DestroyLockProfile(SDL_LockProfile *profile);
+// wait_start is the SDL_GetPerformanceCounter() value when the thread started to block, if the lock was contended
+extern void SDL_LockProfileAcquired(SDL_LockProfile *profile, bool exclusive, bool contended, Uint64 wait_start);
+// Call this before the lock is actually released
+extern void SDL_LockProfileReleased(SDL_LockProfile *profile);
+extern void SDL_QuitLockProfiling(void);
+
 /* Generic TLS support.
    This is only intended as a fallback if getting real thread-local
    storage fails or isn't supported on this platform.
@@ -46,6 +46,11 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
     return true;
 }
 
+bool SDL_SYS_SetThreadAffinity(int cpu)
+{
+    return SDL_Unsupported();
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     return;
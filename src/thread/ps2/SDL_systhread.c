@@ -108,6 +108,11 @@ SDL_ThreadID SDL_GetCurrentThreadID(void)
     return (SDL_ThreadID)GetThreadId();
 }
 
+bool SDL_SYS_SetThreadAffinity(int cpu)
+{
+    return SDL_Unsupported();
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     WaitSema((int)thread->endfunc);
@@ -27,6 +27,7 @@
 #include <pthread.h>
 
 #include "SDL_sysmutex_c.h"
+#include "SDL_sysfutex_c.h"
 
 struct SDL_Condition
 {
@@ -34,7 +35,7 @@ struct SDL_Condition
 };
 
 // Create a condition variable
-SDL_Condition *SDL_CreateCondition(void)
+static SDL_Condition *SDL_CreateCondition_pthread(void)
 {
     SDL_Condition *cond;
 
@@ -50,47 +51,41 @@ SDL_Condition *SDL_CreateCondition(void)
 }
 
 // Destroy a condition variable
-void SDL_DestroyCondition(SDL_Condition *cond)
+static void SDL_DestroyCondition_pthread(SDL_Condition *cond)
 {
-    if (cond) {
-        pthread_cond_destroy(&cond->cond);
-        SDL_free(cond);
-    }
+    pthread_cond_destroy(&cond->cond);
+    SDL_free(cond);
 }
 
 // Restart one of the threads that are waiting on the condition variable
-void SDL_SignalCondition(SDL_Condition *cond)
+static void SDL_SignalCondition_pthread(SDL_Condition *cond)
 {
-    if (!cond) {
-        return;
-    }
-
     pthread_cond_signal(&cond->cond);
 }
 
 // Restart all threads that are waiting on the condition variable
-void SDL_BroadcastCondition(SDL_Condition *cond)
+static void SDL_BroadcastCondition_pthread(SDL_Condition *cond)
 {
-    if (!cond) {
-        return;
-    }
-
     pthread_cond_broadcast(&cond->cond);
 }
 
-bool SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS)
+static bool SDL_WaitConditionTimeoutNS_pthread(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS)
 {
 #ifndef HAVE_CLOCK_GETTIME
     struct timeval delta;
 #endif
     struct timespec abstime;
+    bool result;
+    int rc;
 
-    if (!cond || !mutex) {
-        return true;
+    // The mutex isn't held while waiting, so that doesn't count towards its hold time
+    if (mutex->profile) {
+        SDL_LockProfileReleased(mutex->profile);
     }
 
     if (timeoutNS < 0) {
-        return (pthread_cond_wait(&cond->cond, &mutex->id) == 0);
+        result = (pthread_cond_wait(&cond->cond, &mutex->id) == 0);
+        goto done;
     }
 
 #ifdef HAVE_CLOCK_GETTIME
@@ -109,8 +104,6 @@ bool SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 ti
         abstime.tv_nsec -= 1000000000;
     }
 
-    bool result;
-    int rc;
 tryagain:
     rc = pthread_cond_timedwait(&cond->cond, &mutex->id, &abstime);
     switch (rc) {
@@ -124,5 +117,219 @@ tryagain:
         result = true;
         break;
     }
+
+done:
+    if (mutex->profile) {
+        SDL_LockProfileAcquired(mutex->profile, true, false, 0);
+    }
+    return result;
+}
+
+#ifdef SDL_THREAD_LINUX_FUTEX
+
+typedef SDL_Condition *(*pfnSDL_CreateCondition)(void);
+typedef void (*pfnSDL_DestroyCondition)(SDL_Condition *);
+typedef void (*pfnSDL_SignalCondition)(SDL_Condition *);
+typedef void (*pfnSDL_BroadcastCondition)(SDL_Condition *);
+typedef bool (*pfnSDL_WaitConditionTimeoutNS)(SDL_Condition *, SDL_Mutex *, Sint64);
+
+typedef struct SDL_cond_impl_t
+{
+    pfnSDL_CreateCondition Create;
+    pfnSDL_DestroyCondition Destroy;
+    pfnSDL_SignalCondition Signal;
+    pfnSDL_BroadcastCondition Broadcast;
+    pfnSDL_WaitConditionTimeoutNS WaitTimeoutNS;
+} SDL_cond_impl_t;
+
+// Implementation will be chosen at runtime to match the mutex implementation
+static SDL_cond_impl_t SDL_cond_impl_active = { 0 };
+
+/**
+ * Condition variable implementation using Linux futexes
+ *
+ * Waiters sleep on a sequence number that every signal and broadcast bumps.
+ * A waiter reads the sequence number while it still holds the mutex, so a
+ * wakeup that comes after it let go of the mutex can't be missed. Signaling
+ * only makes a system call if somebody is waiting.
+ */
+
+typedef struct SDL_cond_futex
+{
+    SDL_AtomicInt sequence;
+    SDL_AtomicInt waiters;
+} SDL_cond_futex;
+
+static SDL_Condition *SDL_CreateCondition_futex(void)
+{
+    return (SDL_Condition *)SDL_calloc(1, sizeof(SDL_cond_futex));
+}
+
+static void SDL_DestroyCondition_futex(SDL_Condition *cond)
+{
+    // There are no kernel allocated resources
+    SDL_free(cond);
+}
+
+static void SDL_SignalCondition_futex(SDL_Condition *_cond)
+{
+    SDL_cond_futex *cond = (SDL_cond_futex *)_cond;
+
+    SDL_AddAtomicInt(&cond->sequence, 1);
+    if (SDL_GetAtomicInt(&cond->waiters) > 0) {
+        SDL_FutexWake(&cond->sequence, 1);
+    }
+}
+
+static void SDL_BroadcastCondition_futex(SDL_Condition *_cond)
+{
+    SDL_cond_futex *cond = (SDL_cond_futex *)_cond;
+
+    SDL_AddAtomicInt(&cond->sequence, 1);
+    if (SDL_GetAtomicInt(&cond->waiters) > 0) {
+        SDL_FutexWake(&cond->sequence, SDL_MAX_SINT32);
+    }
+}
+
+static bool SDL_WaitConditionTimeoutNS_futex(SDL_Condition *_cond, SDL_Mutex *_mutex, Sint64 timeoutNS) SDL_NO_THREAD_SAFETY_ANALYSIS // the mutex is released while waiting
+{
+    SDL_cond_futex *cond = (SDL_cond_futex *)_cond;
+    SDL_mutex_futex *mutex = (SDL_mutex_futex *)_mutex;
+    int sequence;
+    bool result;
+
+    if (mutex->count != 1 || mutex->owner != SDL_GetCurrentThreadID()) {
+        // Passed mutex is not locked or locked recursively
+        return false;
+    }
+
+    SDL_AddAtomicInt(&cond->waiters, 1);
+    sequence = SDL_GetAtomicInt(&cond->sequence);
+    SDL_UnlockMutex(_mutex);
+
+    result = SDL_FutexWait(&cond->sequence, sequence, timeoutNS);
+
+    SDL_LockMutex(_mutex);
+    SDL_AddAtomicInt(&cond->waiters, -1);
+
     return result;
 }
+
+static const SDL_cond_impl_t SDL_cond_impl_futex = {
+    &SDL_CreateCondition_futex,
+    &SDL_DestroyCondition_futex,
+    &SDL_SignalCondition_futex,
+    &SDL_BroadcastCondition_futex,
+    &SDL_WaitConditionTimeoutNS_futex,
+};
+
+static const SDL_cond_impl_t SDL_cond_impl_pthread = {
+    &SDL_CreateCondition_pthread,
+    &SDL_DestroyCondition_pthread,
+    &SDL_SignalCondition_pthread,
+    &SDL_BroadcastCondition_pthread,
+    &SDL_WaitConditionTimeoutNS_pthread,
+};
+
+SDL_Condition *SDL_CreateCondition(void)
+{
+    if (!SDL_cond_impl_active.Create) {
+        const SDL_cond_impl_t *impl = &SDL_cond_impl_pthread;
+
+        if (SDL_mutex_impl_active.Type == SDL_MUTEX_INVALID) {
+            // The mutex implementation isn't decided yet, trigger it
+            SDL_Mutex *mutex = SDL_CreateMutex();
+            if (!mutex) {
+                return NULL;
+            }
+            SDL_DestroyMutex(mutex);
+
+            SDL_assert(SDL_mutex_impl_active.Type != SDL_MUTEX_INVALID);
+        }
+
+        // The condition variable has to work with the mutex implementation
+        if (SDL_mutex_impl_active.Type == SDL_MUTEX_FUTEX) {
+            impl = &SDL_cond_impl_futex;
+        }
+
+        SDL_copyp(&SDL_cond_impl_active, impl);
+    }
+    return SDL_cond_impl_active.Create();
+}
+
+void SDL_DestroyCondition(SDL_Condition *cond)
+{
+    if (cond) {
+        SDL_cond_impl_active.Destroy(cond);
+    }
+}
+
+void SDL_SignalCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return;
+    }
+
+    SDL_cond_impl_active.Signal(cond);
+}
+
+void SDL_BroadcastCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return;
+    }
+
+    SDL_cond_impl_active.Broadcast(cond);
+}
+
+bool SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS)
+{
+    if (!cond || !mutex) {
+        return true;
+    }
+
+    return SDL_cond_impl_active.WaitTimeoutNS(cond, mutex, timeoutNS);
+}
+
+#else
+
+SDL_Condition *SDL_CreateCondition(void)
+{
+    return SDL_CreateCondition_pthread();
+}
+
+void SDL_DestroyCondition(SDL_Condition *cond)
+{
+    if (cond) {
+        SDL_DestroyCondition_pthread(cond);
+    }
+}
+
+void SDL_SignalCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return;
+    }
+
+    SDL_SignalCondition_pthread(cond);
+}
+
+void SDL_BroadcastCondition(SDL_Condition *cond)
+{
+    if (!cond) {
+        return;
+    }
+
+    SDL_BroadcastCondition_pthread(cond);
+}
+
+bool SDL_WaitConditionTimeoutNS(SDL_Condition *cond, SDL_Mutex *mutex, Sint64 timeoutNS)
+{
+    if (!cond || !mutex) {
+        return true;
+    }
+
+    return SDL_WaitConditionTimeoutNS_pthread(cond, mutex, timeoutNS);
+}
+
+#endif // SDL_THREAD_LINUX_FUTEX
@@ -0,0 +1,81 @@
+/*
+  Simple DirectMedia Layer
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely, subject to the following restrictions:
+
+  1. The origin of this software must not be misrepresented; you must not
+     claim that you wrote the original software. If you use this software
+     in a product, an acknowledgment in the product documentation would be
+     appreciated but is not required.
+  2. Altered source versions must be plainly marked as such, and must not be
+     misrepresented as being the original software.
+  3. This notice may not be removed or altered from any source distribution.
+*/
+#include "SDL_internal.h"
+
+#ifndef SDL_sysfutex_c_h_
+#define SDL_sysfutex_c_h_
+
+#ifdef SDL_THREAD_LINUX_FUTEX
+
+#include <errno.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "../../SDL_hints_c.h"
+
+/* The hint is read straight from the environment, because the hint system
+   creates mutexes itself and the implementation has to be chosen first. */
+static SDL_INLINE bool SDL_UseFutex(void)
+{
+    return !SDL_GetStringBoolean(SDL_getenv_unsafe(SDL_HINT_LINUX_FORCE_PTHREAD_SYNC), false);
+}
+
+/* The lock and unlock fast paths use the compiler's atomics directly, so
+   they're inlined and only have the ordering a lock needs. */
+static SDL_INLINE bool SDL_FutexAcquire(SDL_AtomicInt *atomic, int oldval, int newval)
+{
+    return __atomic_compare_exchange_n(&atomic->value, &oldval, newval, false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED);
+}
+
+static SDL_INLINE int SDL_FutexRelease(SDL_AtomicInt *atomic, int newval)
+{
+    return __atomic_exchange_n(&atomic->value, newval, __ATOMIC_RELEASE);
+}
+
+// Sleep as long as the atomic still holds value, returns false if the timeout expired
+static SDL_INLINE bool SDL_FutexWait(SDL_AtomicInt *atomic, int value, Sint64 timeoutNS)
+{
+    struct timespec timeout;
+    struct timespec *ptimeout = NULL;
+
+    if (timeoutNS >= 0) {
+        timeout.tv_sec = (time_t)(timeoutNS / SDL_NS_PER_SECOND);
+        timeout.tv_nsec = (long)(timeoutNS % SDL_NS_PER_SECOND);
+        ptimeout = &timeout;
+    }
+
+    if (syscall(SYS_futex, &atomic->value, FUTEX_WAIT_PRIVATE, value, ptimeout, NULL, 0) < 0) {
+        return (errno != ETIMEDOUT);
+    }
+    return true;
+}
+
+// Wake up to count threads sleeping on the atomic
+static SDL_INLINE void SDL_FutexWake(SDL_AtomicInt *atomic, int count)
+{
+    syscall(SYS_futex, &atomic->value, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+
+#endif // SDL_THREAD_LINUX_FUTEX
+
+#endif // SDL_sysfutex_c_h_
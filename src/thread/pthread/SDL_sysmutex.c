@@ -24,8 +24,9 @@
 #include <pthread.h>
 
 #include "SDL_sysmutex_c.h"
+#include "SDL_sysfutex_c.h"
 
-SDL_Mutex *SDL_CreateMutex(void)
+static SDL_Mutex *SDL_CreateMutex_pthread(void)
 {
     SDL_Mutex *mutex;
     pthread_mutexattr_t attr;
@@ -50,105 +51,325 @@ SDL_Mutex *SDL_CreateMutex(void)
     return mutex;
 }
 
-void SDL_DestroyMutex(SDL_Mutex *mutex)
+static void SDL_DestroyMutex_pthread(SDL_Mutex *mutex)
 {
-    if (mutex) {
-        pthread_mutex_destroy(&mutex->id);
-        SDL_free(mutex);
+    pthread_mutex_destroy(&mutex->id);
+    SDL_free(mutex);
+}
+
+static void SDL_LockMutex_pthread(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+#ifdef FAKE_RECURSIVE_MUTEX
+    pthread_t this_thread = pthread_self();
+    if (mutex->owner == this_thread) {
+        ++mutex->recursive;
+    } else {
+        /* The order of operations is important.
+           We set the locking thread id after we obtain the lock
+           so unlocks from other threads will fail.
+         */
+        const int rc = pthread_mutex_lock(&mutex->id);
+        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        mutex->owner = this_thread;
+        mutex->recursive = 0;
     }
+#else
+    const int rc = pthread_mutex_lock(&mutex->id);
+    SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+#endif
 }
 
-void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+static bool SDL_TryLockMutex_pthread(SDL_Mutex *mutex)
 {
-    if (mutex) {
+    bool result = true;
+
 #ifdef FAKE_RECURSIVE_MUTEX
-        pthread_t this_thread = pthread_self();
-        if (mutex->owner == this_thread) {
-            ++mutex->recursive;
-        } else {
-            /* The order of operations is important.
-               We set the locking thread id after we obtain the lock
-               so unlocks from other threads will fail.
-             */
-            const int rc = pthread_mutex_lock(&mutex->id);
-            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+    pthread_t this_thread = pthread_self();
+    if (mutex->owner == this_thread) {
+        ++mutex->recursive;
+    } else {
+        /* The order of operations is important.
+           We set the locking thread id after we obtain the lock
+           so unlocks from other threads will fail.
+         */
+        const int rc = pthread_mutex_trylock(&mutex->id);
+        if (rc == 0) {
             mutex->owner = this_thread;
             mutex->recursive = 0;
+        } else if (rc == EBUSY) {
+            result = false;
+        } else {
+            SDL_assert(!"Error trying to lock mutex");  // assume we're in a lot of trouble if this assert fails.
+            result = false;
         }
+    }
 #else
-        const int rc = pthread_mutex_lock(&mutex->id);
-        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
-#endif
+    const int rc = pthread_mutex_trylock(&mutex->id);
+    if (rc != 0) {
+        if (rc == EBUSY) {
+            result = false;
+        } else {
+            SDL_assert(!"Error trying to lock mutex");  // assume we're in a lot of trouble if this assert fails.
+            result = false;
+        }
     }
+#endif
+
+    return result;
 }
 
-bool SDL_TryLockMutex(SDL_Mutex *mutex)
+static void SDL_UnlockMutex_pthread(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
 {
-    bool result = true;
-
-    if (mutex) {
 #ifdef FAKE_RECURSIVE_MUTEX
-        pthread_t this_thread = pthread_self();
-        if (mutex->owner == this_thread) {
-            ++mutex->recursive;
+    // We can only unlock the mutex if we own it
+    if (pthread_self() == mutex->owner) {
+        if (mutex->recursive) {
+            --mutex->recursive;
         } else {
             /* The order of operations is important.
-               We set the locking thread id after we obtain the lock
-               so unlocks from other threads will fail.
+               First reset the owner so another thread doesn't lock
+               the mutex and set the ownership before we reset it,
+               then release the lock semaphore.
              */
-            const int rc = pthread_mutex_trylock(&mutex->id);
-            if (rc == 0) {
-                mutex->owner = this_thread;
-                mutex->recursive = 0;
-            } else if (rc == EBUSY) {
-                result = false;
-            } else {
-                SDL_assert(!"Error trying to lock mutex");  // assume we're in a lot of trouble if this assert fails.
-                result = false;
-            }
+            mutex->owner = 0;
+            pthread_mutex_unlock(&mutex->id);
         }
+    } else {
+        SDL_SetError("mutex not owned by this thread");
+        return;
+    }
+
 #else
-        const int rc = pthread_mutex_trylock(&mutex->id);
-        if (rc != 0) {
-            if (rc == EBUSY) {
-                result = false;
-            } else {
-                SDL_assert(!"Error trying to lock mutex");  // assume we're in a lot of trouble if this assert fails.
-                result = false;
+    const int rc = pthread_mutex_unlock(&mutex->id);
+    SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+#endif // FAKE_RECURSIVE_MUTEX
+}
+
+#ifdef SDL_THREAD_LINUX_FUTEX
+
+/**
+ * Mutex implementation using Linux futexes
+ *
+ * An uncontended lock or unlock is a single atomic operation. A contended
+ * lock spins for a while in case the owner is about to release it, and then
+ * sleeps in the kernel until the owner wakes it up. As with glibc's adaptive
+ * mutexes, the spin limit follows how long recent contended locks had to
+ * spin, so locks that are held for a long time stop wasting CPU time.
+ */
+
+// Implementation will be chosen at runtime based on the hint
+SDL_mutex_impl_t SDL_mutex_impl_active = { 0 };
+
+#define SDL_FUTEX_MAX_SPINS 100
+
+// There's no point in spinning if the owner can't run at the same time
+static bool SDL_futex_spin;
+
+static SDL_Mutex *SDL_CreateMutex_futex(void)
+{
+    return (SDL_Mutex *)SDL_calloc(1, sizeof(SDL_mutex_futex));
+}
+
+static void SDL_DestroyMutex_futex(SDL_Mutex *mutex)
+{
+    // There are no kernel allocated resources
+    SDL_free(mutex);
+}
+
+static void SDL_LockMutexContended_futex(SDL_mutex_futex *mutex)
+{
+    if (SDL_futex_spin) {
+        const int max_spins = SDL_min(mutex->spins * 2 + 10, SDL_FUTEX_MAX_SPINS);
+        int spins;
+
+        for (spins = 0; spins < max_spins; ++spins) {
+            SDL_CPUPauseInstruction();
+            if (SDL_GetAtomicInt(&mutex->state) == 0 && SDL_FutexAcquire(&mutex->state, 0, 1)) {
+                break;
             }
         }
-#endif
+        mutex->spins += (spins - mutex->spins) / 8;
+        if (spins < max_spins) {
+            return;
+        }
+    }
+
+    /* Mark the lock as contended before sleeping, so the owner knows it has
+       to wake somebody up. Once we get it, it stays marked, since we can't
+       tell whether anybody else is still sleeping on it. */
+    while (SDL_SetAtomicInt(&mutex->state, 2) != 0) {
+        SDL_FutexWait(&mutex->state, 2, -1);
+    }
+}
+
+static void SDL_LockMutex_futex(SDL_Mutex *_mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    SDL_mutex_futex *mutex = (SDL_mutex_futex *)_mutex;
+    const SDL_ThreadID this_thread = SDL_GetCurrentThreadID();
+
+    if (mutex->owner == this_thread) {
+        ++mutex->count;
+    } else {
+        /* The order of operations is important.
+           We set the locking thread id after we obtain the lock
+           so unlocks from other threads will fail.
+         */
+        if (!SDL_FutexAcquire(&mutex->state, 0, 1)) {
+            SDL_LockMutexContended_futex(mutex);
+        }
+        SDL_assert(mutex->count == 0 && mutex->owner == 0);
+        mutex->owner = this_thread;
+        mutex->count = 1;
     }
+}
 
+static bool SDL_TryLockMutex_futex(SDL_Mutex *_mutex)
+{
+    SDL_mutex_futex *mutex = (SDL_mutex_futex *)_mutex;
+    const SDL_ThreadID this_thread = SDL_GetCurrentThreadID();
+    bool result = true;
+
+    if (mutex->owner == this_thread) {
+        ++mutex->count;
+    } else if (SDL_FutexAcquire(&mutex->state, 0, 1)) {
+        SDL_assert(mutex->count == 0 && mutex->owner == 0);
+        mutex->owner = this_thread;
+        mutex->count = 1;
+    } else {
+        result = false;
+    }
     return result;
 }
 
-void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+static void SDL_UnlockMutex_futex(SDL_Mutex *_mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    SDL_mutex_futex *mutex = (SDL_mutex_futex *)_mutex;
+
+    if (mutex->owner == SDL_GetCurrentThreadID()) {
+        if (--mutex->count == 0) {
+            mutex->owner = 0;
+            if (SDL_FutexRelease(&mutex->state, 0) == 2) {
+                SDL_FutexWake(&mutex->state, 1);
+            }
+        }
+    } else {
+        SDL_assert(!"mutex not owned by this thread");  // undefined behavior...!
+    }
+}
+
+static const SDL_mutex_impl_t SDL_mutex_impl_futex = {
+    &SDL_CreateMutex_futex,
+    &SDL_DestroyMutex_futex,
+    &SDL_LockMutex_futex,
+    &SDL_TryLockMutex_futex,
+    &SDL_UnlockMutex_futex,
+    SDL_MUTEX_FUTEX,
+};
+
+static const SDL_mutex_impl_t SDL_mutex_impl_pthread = {
+    &SDL_CreateMutex_pthread,
+    &SDL_DestroyMutex_pthread,
+    &SDL_LockMutex_pthread,
+    &SDL_TryLockMutex_pthread,
+    &SDL_UnlockMutex_pthread,
+    SDL_MUTEX_PTHREAD,
+};
+
+/**
+ * Runtime selection and redirection
+ */
+
+#define SDL_CreateMutex_active()       SDL_mutex_impl_active.Create()
+#define SDL_DestroyMutex_active(mutex) SDL_mutex_impl_active.Destroy(mutex)
+#define SDL_LockMutex_active(mutex)    SDL_mutex_impl_active.Lock(mutex)
+#define SDL_TryLockMutex_active(mutex) SDL_mutex_impl_active.TryLock(mutex)
+#define SDL_UnlockMutex_active(mutex)  SDL_mutex_impl_active.Unlock(mutex)
+
+SDL_Mutex *SDL_CreateMutex(void)
 {
+    if (!SDL_mutex_impl_active.Create) {
+        const SDL_mutex_impl_t *impl = &SDL_mutex_impl_pthread;
+
+        if (SDL_UseFutex()) {
+            impl = &SDL_mutex_impl_futex;
+            SDL_futex_spin = (SDL_GetNumLogicalCPUCores() > 1);
+        }
+
+        // Copy instead of using pointer to save one level of indirection
+        SDL_copyp(&SDL_mutex_impl_active, impl);
+    }
+    return SDL_CreateMutex_active();
+}
+
+#else
+
+#define SDL_CreateMutex_active()       SDL_CreateMutex_pthread()
+#define SDL_DestroyMutex_active(mutex) SDL_DestroyMutex_pthread(mutex)
+#define SDL_LockMutex_active(mutex)    SDL_LockMutex_pthread(mutex)
+#define SDL_TryLockMutex_active(mutex) SDL_TryLockMutex_pthread(mutex)
+#define SDL_UnlockMutex_active(mutex)  SDL_UnlockMutex_pthread(mutex)
+
+SDL_Mutex *SDL_CreateMutex(void)
+{
+    return SDL_CreateMutex_active();
+}
+
+#endif // SDL_THREAD_LINUX_FUTEX
+
+SDL_Mutex *SDL_CreateNamedMutex(const char *name)
+{
+    SDL_Mutex *mutex = SDL_CreateMutex();
     if (mutex) {
-#ifdef FAKE_RECURSIVE_MUTEX
-        // We can only unlock the mutex if we own it
-        if (pthread_self() == mutex->owner) {
-            if (mutex->recursive) {
-                --mutex->recursive;
-            } else {
-                /* The order of operations is important.
-                   First reset the owner so another thread doesn't lock
-                   the mutex and set the ownership before we reset it,
-                   then release the lock semaphore.
-                 */
-                mutex->owner = 0;
-                pthread_mutex_unlock(&mutex->id);
+        SDL_MUTEX_PROFILE(mutex) = SDL_CreateLockProfile(name);
+    }
+    return mutex;
+}
+
+void SDL_DestroyMutex(SDL_Mutex *mutex)
+{
+    if (mutex) {
+        SDL_DestroyLockProfile(SDL_MUTEX_PROFILE(mutex));
+        SDL_DestroyMutex_active(mutex);
+    }
+}
+
+void SDL_LockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex) {
+        SDL_LockProfile *profile = SDL_MUTEX_PROFILE(mutex);
+        if (profile) {
+            // Trying first is the only way to tell whether the lock is contended
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            const bool contended = !SDL_TryLockMutex_active(mutex);
+            if (contended) {
+                SDL_LockMutex_active(mutex);
             }
+            SDL_LockProfileAcquired(profile, true, contended, wait_start);
         } else {
-            SDL_SetError("mutex not owned by this thread");
-            return;
+            SDL_LockMutex_active(mutex);
         }
+    }
+}
 
-#else
-        const int rc = pthread_mutex_unlock(&mutex->id);
-        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
-#endif // FAKE_RECURSIVE_MUTEX
+bool SDL_TryLockMutex(SDL_Mutex *mutex)
+{
+    bool result = true;
+
+    if (mutex) {
+        result = SDL_TryLockMutex_active(mutex);
+        if (result && SDL_MUTEX_PROFILE(mutex)) {
+            SDL_LockProfileAcquired(SDL_MUTEX_PROFILE(mutex), true, false, 0);
+        }
     }
+    return result;
 }
 
+void SDL_UnlockMutex(SDL_Mutex *mutex) SDL_NO_THREAD_SAFETY_ANALYSIS // clang doesn't know about NULL mutexes
+{
+    if (mutex) {
+        if (SDL_MUTEX_PROFILE(mutex)) {
+            SDL_LockProfileReleased(SDL_MUTEX_PROFILE(mutex));
+        }
+        SDL_UnlockMutex_active(mutex);
+    }
+}
@@ -23,13 +23,20 @@
 #ifndef SDL_mutex_c_h_
 #define SDL_mutex_c_h_
 
+#include "../SDL_thread_c.h"
+
 #if !(defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX) || \
     defined(SDL_THREAD_PTHREAD_RECURSIVE_MUTEX_NP))
 #define FAKE_RECURSIVE_MUTEX
 #endif
 
+/* Every mutex implementation starts with the lock profile, so it can be
+   found without knowing which implementation is active. */
+#define SDL_MUTEX_PROFILE(mutex) (*(SDL_LockProfile **)(mutex))
+
 struct SDL_Mutex
 {
+    SDL_LockProfile *profile;
     pthread_mutex_t id;
 #ifdef FAKE_RECURSIVE_MUTEX
     int recursive;
@@ -37,4 +44,46 @@ struct SDL_Mutex
 #endif
 };
 
+#ifdef SDL_THREAD_LINUX_FUTEX
+
+typedef SDL_Mutex *(*pfnSDL_CreateMutex)(void);
+typedef void (*pfnSDL_LockMutex)(SDL_Mutex *);
+typedef bool (*pfnSDL_TryLockMutex)(SDL_Mutex *);
+typedef void (*pfnSDL_UnlockMutex)(SDL_Mutex *);
+typedef void (*pfnSDL_DestroyMutex)(SDL_Mutex *);
+
+typedef enum
+{
+    SDL_MUTEX_INVALID = 0,
+    SDL_MUTEX_PTHREAD,
+    SDL_MUTEX_FUTEX,
+} SDL_MutexType;
+
+typedef struct SDL_mutex_impl_t
+{
+    pfnSDL_CreateMutex Create;
+    pfnSDL_DestroyMutex Destroy;
+    pfnSDL_LockMutex Lock;
+    pfnSDL_TryLockMutex TryLock;
+    pfnSDL_UnlockMutex Unlock;
+    // Needed by SDL_Condition:
+    SDL_MutexType Type;
+} SDL_mutex_impl_t;
+
+extern SDL_mutex_impl_t SDL_mutex_impl_active;
+
+typedef struct SDL_mutex_futex
+{
+    SDL_LockProfile *profile;
+    // 0 if unlocked, 1 if locked, 2 if locked and other threads may be sleeping on it
+    SDL_AtomicInt state;
+    // How long contended locks have spun lately, only a hint so races are harmless
+    int spins;
+    // The futex isn't recursive, that has to be handled by SDL:
+    int count;
+    SDL_ThreadID owner;
+} SDL_mutex_futex;
+
+#endif // SDL_THREAD_LINUX_FUTEX
+
 #endif // SDL_mutex_c_h_
@@ -23,9 +23,12 @@
 #include <errno.h>
 #include <pthread.h>
 
+#include "../SDL_thread_c.h"
+
 struct SDL_RWLock
 {
     pthread_rwlock_t id;
+    SDL_LockProfile *profile;
 };
 
 
@@ -45,9 +48,19 @@ SDL_RWLock *SDL_CreateRWLock(void)
     return rwlock;
 }
 
+SDL_RWLock *SDL_CreateNamedRWLock(const char *name)
+{
+    SDL_RWLock *rwlock = SDL_CreateRWLock();
+    if (rwlock) {
+        rwlock->profile = SDL_CreateLockProfile(name);
+    }
+    return rwlock;
+}
+
 void SDL_DestroyRWLock(SDL_RWLock *rwlock)
 {
     if (rwlock) {
+        SDL_DestroyLockProfile(rwlock->profile);
         pthread_rwlock_destroy(&rwlock->id);
         SDL_free(rwlock);
     }
@@ -56,16 +69,37 @@ void SDL_DestroyRWLock(SDL_RWLock *rwlock)
 void SDL_LockRWLockForReading(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        const int rc = pthread_rwlock_rdlock(&rwlock->id);
-        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        if (rwlock->profile) {
+            // Trying first is the only way to tell whether the lock is contended
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            const bool contended = (pthread_rwlock_tryrdlock(&rwlock->id) != 0);
+            if (contended) {
+                const int rc = pthread_rwlock_rdlock(&rwlock->id);
+                SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+            }
+            SDL_LockProfileAcquired(rwlock->profile, false, contended, wait_start);
+        } else {
+            const int rc = pthread_rwlock_rdlock(&rwlock->id);
+            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        }
     }
 }
 
 void SDL_LockRWLockForWriting(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        const int rc = pthread_rwlock_wrlock(&rwlock->id);
-        SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        if (rwlock->profile) {
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            const bool contended = (pthread_rwlock_trywrlock(&rwlock->id) != 0);
+            if (contended) {
+                const int rc = pthread_rwlock_wrlock(&rwlock->id);
+                SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+            }
+            SDL_LockProfileAcquired(rwlock->profile, true, contended, wait_start);
+        } else {
+            const int rc = pthread_rwlock_wrlock(&rwlock->id);
+            SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
+        }
     }
 }
 
@@ -80,6 +114,8 @@ bool SDL_TryLockRWLockForReading(SDL_RWLock *rwlock)
             if (rc != EBUSY) {
                 SDL_assert(!"Error trying to lock rwlock for reading");  // assume we're in a lot of trouble if this assert fails.
             }
+        } else if (rwlock->profile) {
+            SDL_LockProfileAcquired(rwlock->profile, false, false, 0);
         }
     }
 
@@ -97,6 +133,8 @@ bool SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
             if (rc != EBUSY) {
                 SDL_assert(!"Error trying to lock rwlock for writing");  // assume we're in a lot of trouble if this assert fails.
             }
+        } else if (rwlock->profile) {
+            SDL_LockProfileAcquired(rwlock->profile, true, false, 0);
         }
     }
 
@@ -106,7 +144,12 @@ bool SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
 void SDL_UnlockRWLock(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        const int rc = pthread_rwlock_unlock(&rwlock->id);
+        int rc;
+
+        if (rwlock->profile) {
+            SDL_LockProfileReleased(rwlock->profile);
+        }
+        rc = pthread_rwlock_unlock(&rwlock->id);
         SDL_assert(rc == 0);  // assume we're in a lot of trouble if this assert fails.
     }
 }
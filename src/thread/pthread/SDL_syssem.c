@@ -26,6 +26,8 @@
 #include <sys/time.h>
 #include <time.h>
 
+#include "SDL_sysfutex_c.h"
+
 // Wrapper around POSIX 1003.1b semaphores
 
 #if defined(SDL_PLATFORM_MACOS) || defined(SDL_PLATFORM_IOS)
@@ -39,7 +41,7 @@ struct SDL_Semaphore
 };
 
 // Create a semaphore, initialized with value
-SDL_Semaphore *SDL_CreateSemaphore(Uint32 initial_value)
+static SDL_Semaphore *SDL_CreateSemaphore_pthread(Uint32 initial_value)
 {
     SDL_Semaphore *sem = (SDL_Semaphore *)SDL_malloc(sizeof(SDL_Semaphore));
     if (sem) {
@@ -52,15 +54,13 @@ SDL_Semaphore *SDL_CreateSemaphore(Uint32 initial_value)
     return sem;
 }
 
-void SDL_DestroySemaphore(SDL_Semaphore *sem)
+static void SDL_DestroySemaphore_pthread(SDL_Semaphore *sem)
 {
-    if (sem) {
-        sem_destroy(&sem->sem);
-        SDL_free(sem);
-    }
+    sem_destroy(&sem->sem);
+    SDL_free(sem);
 }
 
-bool SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS)
+static bool SDL_WaitSemaphoreTimeoutNS_pthread(SDL_Semaphore *sem, Sint64 timeoutNS)
 {
 #ifdef HAVE_SEM_TIMEDWAIT
 #ifndef HAVE_CLOCK_GETTIME
@@ -71,10 +71,6 @@ bool SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS)
     Uint64 stop_time;
 #endif
 
-    if (!sem) {
-        return true;
-    }
-
     // Try the easy cases first
     if (timeoutNS == 0) {
         return (sem_trywait(&sem->sem) == 0);
@@ -133,14 +129,10 @@ bool SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS)
 #endif // HAVE_SEM_TIMEDWAIT
 }
 
-Uint32 SDL_GetSemaphoreValue(SDL_Semaphore *sem)
+static Uint32 SDL_GetSemaphoreValue_pthread(SDL_Semaphore *sem)
 {
     int ret = 0;
 
-    if (!sem) {
-        return 0;
-    }
-
     sem_getvalue(&sem->sem, &ret);
     if (ret < 0) {
         ret = 0;
@@ -148,13 +140,238 @@ Uint32 SDL_GetSemaphoreValue(SDL_Semaphore *sem)
     return (Uint32)ret;
 }
 
+static void SDL_SignalSemaphore_pthread(SDL_Semaphore *sem)
+{
+    sem_post(&sem->sem);
+}
+
+#ifdef SDL_THREAD_LINUX_FUTEX
+
+typedef SDL_Semaphore *(*pfnSDL_CreateSemaphore)(Uint32);
+typedef void (*pfnSDL_DestroySemaphore)(SDL_Semaphore *);
+typedef bool (*pfnSDL_WaitSemaphoreTimeoutNS)(SDL_Semaphore *, Sint64);
+typedef Uint32 (*pfnSDL_GetSemaphoreValue)(SDL_Semaphore *);
+typedef void (*pfnSDL_SignalSemaphore)(SDL_Semaphore *);
+
+typedef struct SDL_semaphore_impl_t
+{
+    pfnSDL_CreateSemaphore Create;
+    pfnSDL_DestroySemaphore Destroy;
+    pfnSDL_WaitSemaphoreTimeoutNS WaitTimeoutNS;
+    pfnSDL_GetSemaphoreValue Value;
+    pfnSDL_SignalSemaphore Signal;
+} SDL_sem_impl_t;
+
+// Implementation will be chosen at runtime based on the hint
+static SDL_sem_impl_t SDL_sem_impl_active = { 0 };
+
+/**
+ * Semaphore implementation using Linux futexes
+ *
+ * The count lives in the futex word, so posting and waiting on a semaphore
+ * that has a value are single atomic operations. Threads only sleep in the
+ * kernel when the count is zero, and posting only makes a system call if
+ * somebody is sleeping.
+ */
+
+typedef struct SDL_semaphore_futex
+{
+    SDL_AtomicInt count;
+    SDL_AtomicInt waiters;
+} SDL_sem_futex;
+
+static SDL_Semaphore *SDL_CreateSemaphore_futex(Uint32 initial_value)
+{
+    SDL_sem_futex *sem;
+
+    sem = (SDL_sem_futex *)SDL_malloc(sizeof(*sem));
+    if (sem) {
+        SDL_SetAtomicInt(&sem->count, (int)initial_value);
+        SDL_SetAtomicInt(&sem->waiters, 0);
+    }
+    return (SDL_Semaphore *)sem;
+}
+
+static void SDL_DestroySemaphore_futex(SDL_Semaphore *sem)
+{
+    // There are no kernel allocated resources
+    SDL_free(sem);
+}
+
+static bool SDL_TryWaitSemaphore_futex(SDL_sem_futex *sem)
+{
+    int count = SDL_GetAtomicInt(&sem->count);
+
+    while (count > 0) {
+        if (SDL_CompareAndSwapAtomicInt(&sem->count, count, count - 1)) {
+            return true;
+        }
+        count = SDL_GetAtomicInt(&sem->count);
+    }
+    return false;
+}
+
+static bool SDL_WaitSemaphoreTimeoutNS_futex(SDL_Semaphore *_sem, Sint64 timeoutNS)
+{
+    SDL_sem_futex *sem = (SDL_sem_futex *)_sem;
+    Uint64 deadline = 0;
+    bool result = true;
+
+    if (SDL_TryWaitSemaphore_futex(sem)) {
+        return true;
+    }
+    if (timeoutNS == 0) {
+        return false;
+    }
+
+    if (timeoutNS > 0) {
+        deadline = SDL_GetTicksNS() + timeoutNS;
+    }
+
+    SDL_AddAtomicInt(&sem->waiters, 1);
+    while (!SDL_TryWaitSemaphore_futex(sem)) {
+        if (timeoutNS > 0) {
+            const Uint64 now = SDL_GetTicksNS();
+            if (now >= deadline) {
+                result = false;
+                break;
+            }
+            timeoutNS = (Sint64)(deadline - now);
+        }
+        SDL_FutexWait(&sem->count, 0, timeoutNS);
+    }
+    SDL_AddAtomicInt(&sem->waiters, -1);
+
+    return result;
+}
+
+static Uint32 SDL_GetSemaphoreValue_futex(SDL_Semaphore *_sem)
+{
+    SDL_sem_futex *sem = (SDL_sem_futex *)_sem;
+
+    return (Uint32)SDL_GetAtomicInt(&sem->count);
+}
+
+static void SDL_SignalSemaphore_futex(SDL_Semaphore *_sem)
+{
+    SDL_sem_futex *sem = (SDL_sem_futex *)_sem;
+
+    SDL_AddAtomicInt(&sem->count, 1);
+    if (SDL_GetAtomicInt(&sem->waiters) > 0) {
+        SDL_FutexWake(&sem->count, 1);
+    }
+}
+
+static const SDL_sem_impl_t SDL_sem_impl_futex = {
+    &SDL_CreateSemaphore_futex,
+    &SDL_DestroySemaphore_futex,
+    &SDL_WaitSemaphoreTimeoutNS_futex,
+    &SDL_GetSemaphoreValue_futex,
+    &SDL_SignalSemaphore_futex,
+};
+
+static const SDL_sem_impl_t SDL_sem_impl_pthread = {
+    &SDL_CreateSemaphore_pthread,
+    &SDL_DestroySemaphore_pthread,
+    &SDL_WaitSemaphoreTimeoutNS_pthread,
+    &SDL_GetSemaphoreValue_pthread,
+    &SDL_SignalSemaphore_pthread,
+};
+
+/**
+ * Runtime selection and redirection
+ */
+
+SDL_Semaphore *SDL_CreateSemaphore(Uint32 initial_value)
+{
+    if (!SDL_sem_impl_active.Create) {
+        const SDL_sem_impl_t *impl = &SDL_sem_impl_pthread;
+
+        if (SDL_UseFutex()) {
+            impl = &SDL_sem_impl_futex;
+        }
+
+        // Copy instead of using pointer to save one level of indirection
+        SDL_copyp(&SDL_sem_impl_active, impl);
+    }
+    return SDL_sem_impl_active.Create(initial_value);
+}
+
+void SDL_DestroySemaphore(SDL_Semaphore *sem)
+{
+    if (sem) {
+        SDL_sem_impl_active.Destroy(sem);
+    }
+}
+
+bool SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS)
+{
+    if (!sem) {
+        return true;
+    }
+
+    return SDL_sem_impl_active.WaitTimeoutNS(sem, timeoutNS);
+}
+
+Uint32 SDL_GetSemaphoreValue(SDL_Semaphore *sem)
+{
+    if (!sem) {
+        return 0;
+    }
+
+    return SDL_sem_impl_active.Value(sem);
+}
+
 void SDL_SignalSemaphore(SDL_Semaphore *sem)
 {
     if (!sem) {
         return;
     }
 
-    sem_post(&sem->sem);
+    SDL_sem_impl_active.Signal(sem);
 }
 
+#else
+
+SDL_Semaphore *SDL_CreateSemaphore(Uint32 initial_value)
+{
+    return SDL_CreateSemaphore_pthread(initial_value);
+}
+
+void SDL_DestroySemaphore(SDL_Semaphore *sem)
+{
+    if (sem) {
+        SDL_DestroySemaphore_pthread(sem);
+    }
+}
+
+bool SDL_WaitSemaphoreTimeoutNS(SDL_Semaphore *sem, Sint64 timeoutNS)
+{
+    if (!sem) {
+        return true;
+    }
+
+    return SDL_WaitSemaphoreTimeoutNS_pthread(sem, timeoutNS);
+}
+
+Uint32 SDL_GetSemaphoreValue(SDL_Semaphore *sem)
+{
+    if (!sem) {
+        return 0;
+    }
+
+    return SDL_GetSemaphoreValue_pthread(sem);
+}
+
+void SDL_SignalSemaphore(SDL_Semaphore *sem)
+{
+    if (!sem) {
+        return;
+    }
+
+    SDL_SignalSemaphore_pthread(sem);
+}
+
+#endif // SDL_THREAD_LINUX_FUTEX
+
 #endif // SDL_PLATFORM_MACOS
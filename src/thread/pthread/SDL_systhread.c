@@ -32,6 +32,7 @@
 #include <errno.h>
 
 #ifdef SDL_PLATFORM_LINUX
+#include <sched.h>
 #include <sys/time.h>
 #include <sys/resource.h>
 #include <sys/syscall.h>
@@ -282,6 +283,25 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
 #endif // #if SDL_PLATFORM_RISCOS
 }
 
+bool SDL_SYS_SetThreadAffinity(int cpu)
+{
+#ifdef SDL_PLATFORM_LINUX
+    cpu_set_t set;
+
+    if (cpu < 0 || cpu >= CPU_SETSIZE) {
+        return SDL_InvalidParamError("cpu");
+    }
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) < 0) {
+        return SDL_SetError("sched_setaffinity() failed");
+    }
+    return true;
+#else
+    return SDL_Unsupported();
+#endif
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     pthread_join(thread->handle, 0);
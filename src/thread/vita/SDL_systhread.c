@@ -100,6 +100,11 @@ SDL_ThreadID SDL_GetCurrentThreadID(void)
     return (SDL_ThreadID)sceKernelGetThreadId();
 }
 
+bool SDL_SYS_SetThreadAffinity(int cpu)
+{
+    return SDL_Unsupported();
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     sceKernelWaitThreadEnd(thread->handle, NULL, NULL);
@@ -98,6 +98,7 @@ static void SDL_BroadcastCondition_cv(SDL_Condition *_cond)
 static bool SDL_WaitConditionTimeoutNS_cv(SDL_Condition *_cond, SDL_Mutex *_mutex, Sint64 timeoutNS)
 {
     SDL_cond_cv *cond = (SDL_cond_cv *)_cond;
+    SDL_LockProfile *profile = SDL_MUTEX_PROFILE(_mutex);
     DWORD timeout;
     bool result;
 
@@ -107,11 +108,19 @@ static bool SDL_WaitConditionTimeoutNS_cv(SDL_Condition *_cond, SDL_Mutex *_mute
         timeout = (DWORD)SDL_NS_TO_MS(timeoutNS);
     }
 
+    // The mutex isn't held while waiting, so that doesn't count towards its hold time
+    if (profile) {
+        SDL_LockProfileReleased(profile);
+    }
+
     if (SDL_mutex_impl_active.Type == SDL_MUTEX_SRW) {
         SDL_mutex_srw *mutex = (SDL_mutex_srw *)_mutex;
 
         if (mutex->count != 1 || mutex->owner != GetCurrentThreadId()) {
             // Passed mutex is not locked or locked recursively"
+            if (profile) {
+                SDL_LockProfileAcquired(profile, true, false, 0);
+            }
             return false;
         }
 
@@ -133,6 +142,9 @@ static bool SDL_WaitConditionTimeoutNS_cv(SDL_Condition *_cond, SDL_Mutex *_mute
         result = (pSleepConditionVariableCS(&cond->cond, &mutex->cs, timeout) == TRUE);
     }
 
+    if (profile) {
+        SDL_LockProfileAcquired(profile, true, false, 0);
+    }
     return result;
 }
 
@@ -131,7 +131,7 @@ static const SDL_mutex_impl_t SDL_mutex_impl_srw = {
 
 static SDL_Mutex *SDL_CreateMutex_cs(void)
 {
-    SDL_mutex_cs *mutex = (SDL_mutex_cs *)SDL_malloc(sizeof(*mutex));
+    SDL_mutex_cs *mutex = (SDL_mutex_cs *)SDL_calloc(1, sizeof(*mutex));
     if (mutex) {
         // Initialize
         // On SMP systems, a non-zero spin count generally helps performance
@@ -204,9 +204,19 @@ SDL_Mutex *SDL_CreateMutex(void)
     return SDL_mutex_impl_active.Create();
 }
 
+SDL_Mutex *SDL_CreateNamedMutex(const char *name)
+{
+    SDL_Mutex *mutex = SDL_CreateMutex();
+    if (mutex) {
+        SDL_MUTEX_PROFILE(mutex) = SDL_CreateLockProfile(name);
+    }
+    return mutex;
+}
+
 void SDL_DestroyMutex(SDL_Mutex *mutex)
 {
     if (mutex) {
+        SDL_DestroyLockProfile(SDL_MUTEX_PROFILE(mutex));
         SDL_mutex_impl_active.Destroy(mutex);
     }
 }
@@ -214,7 +224,18 @@ void SDL_DestroyMutex(SDL_Mutex *mutex)
 void SDL_LockMutex(SDL_Mutex *mutex)
 {
     if (mutex) {
-        SDL_mutex_impl_active.Lock(mutex);
+        SDL_LockProfile *profile = SDL_MUTEX_PROFILE(mutex);
+        if (profile) {
+            // Trying first is the only way to tell whether the lock is contended
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            const bool contended = !SDL_mutex_impl_active.TryLock(mutex);
+            if (contended) {
+                SDL_mutex_impl_active.Lock(mutex);
+            }
+            SDL_LockProfileAcquired(profile, true, contended, wait_start);
+        } else {
+            SDL_mutex_impl_active.Lock(mutex);
+        }
     }
 }
 
@@ -224,6 +245,9 @@ bool SDL_TryLockMutex(SDL_Mutex *mutex)
 
     if (mutex) {
         result = SDL_mutex_impl_active.TryLock(mutex);
+        if (result && SDL_MUTEX_PROFILE(mutex)) {
+            SDL_LockProfileAcquired(SDL_MUTEX_PROFILE(mutex), true, false, 0);
+        }
     }
     return result;
 }
@@ -231,6 +255,9 @@ bool SDL_TryLockMutex(SDL_Mutex *mutex)
 void SDL_UnlockMutex(SDL_Mutex *mutex)
 {
     if (mutex) {
+        if (SDL_MUTEX_PROFILE(mutex)) {
+            SDL_LockProfileReleased(SDL_MUTEX_PROFILE(mutex));
+        }
         SDL_mutex_impl_active.Unlock(mutex);
     }
 }
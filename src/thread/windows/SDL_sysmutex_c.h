@@ -21,6 +21,7 @@
 #include "SDL_internal.h"
 
 #include "../../core/windows/SDL_windows.h"
+#include "../SDL_thread_c.h"
 
 typedef SDL_Mutex *(*pfnSDL_CreateMutex)(void);
 typedef void (*pfnSDL_LockMutex)(SDL_Mutex *);
@@ -59,8 +60,13 @@ typedef struct _SRWLOCK
 } SRWLOCK, *PSRWLOCK;
 #endif
 
+/* Every mutex implementation starts with the lock profile, so it can be
+   found without knowing which implementation is active. */
+#define SDL_MUTEX_PROFILE(mutex) (*(SDL_LockProfile **)(mutex))
+
 typedef struct SDL_mutex_srw
 {
+    SDL_LockProfile *profile;
     SRWLOCK srw;
     // SRW Locks are not recursive, that has to be handled by SDL:
     DWORD count;
@@ -69,5 +75,6 @@ typedef struct SDL_mutex_srw
 
 typedef struct SDL_mutex_cs
 {
+    SDL_LockProfile *profile;
     CRITICAL_SECTION cs;
 } SDL_mutex_cs;
@@ -26,6 +26,7 @@
 
 // This header makes sure SRWLOCK is actually declared, even on ancient WinSDKs.
 #include "SDL_sysmutex_c.h"
+#include "../SDL_thread_c.h"
 
 typedef VOID(WINAPI *pfnInitializeSRWLock)(PSRWLOCK);
 typedef VOID(WINAPI *pfnReleaseSRWLockShared)(PSRWLOCK);
@@ -65,10 +66,14 @@ typedef struct SDL_rwlock_impl_t
 // Implementation will be chosen at runtime based on available Kernel features
 static SDL_rwlock_impl_t SDL_rwlock_impl_active = { 0 };
 
+// Only the SRW implementation has room for a lock profile
+static bool SDL_rwlock_profiling;
+
 // rwlock implementation using Win7+ slim read/write locks (SRWLOCK)
 
 typedef struct SDL_rwlock_srw
 {
+    SDL_LockProfile *profile;
     SRWLOCK srw;
     SDL_ThreadID write_owner;
 } SDL_rwlock_srw;
@@ -174,6 +179,7 @@ SDL_RWLock *SDL_CreateRWLock(void)
                 #undef LOOKUP_SRW_SYM
                 if (okay) {
                     impl = &SDL_rwlock_impl_srw;  // Use the Windows provided API instead of generic fallback
+                    SDL_rwlock_profiling = true;
                 }
             }
         }
@@ -183,9 +189,27 @@ SDL_RWLock *SDL_CreateRWLock(void)
     return SDL_rwlock_impl_active.Create();
 }
 
+static SDL_LockProfile *GetRWLockProfile(SDL_RWLock *rwlock)
+{
+    if (SDL_rwlock_profiling) {
+        return ((SDL_rwlock_srw *)rwlock)->profile;
+    }
+    return NULL;
+}
+
+SDL_RWLock *SDL_CreateNamedRWLock(const char *name)
+{
+    SDL_RWLock *rwlock = SDL_CreateRWLock();
+    if (rwlock && SDL_rwlock_profiling) {
+        ((SDL_rwlock_srw *)rwlock)->profile = SDL_CreateLockProfile(name);
+    }
+    return rwlock;
+}
+
 void SDL_DestroyRWLock(SDL_RWLock *rwlock)
 {
     if (rwlock) {
+        SDL_DestroyLockProfile(GetRWLockProfile(rwlock));
         SDL_rwlock_impl_active.Destroy(rwlock);
     }
 }
@@ -193,14 +217,35 @@ void SDL_DestroyRWLock(SDL_RWLock *rwlock)
 void SDL_LockRWLockForReading(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        SDL_rwlock_impl_active.LockForReading(rwlock);
+        SDL_LockProfile *profile = GetRWLockProfile(rwlock);
+        if (profile) {
+            // Trying first is the only way to tell whether the lock is contended
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            const bool contended = !SDL_rwlock_impl_active.TryLockForReading(rwlock);
+            if (contended) {
+                SDL_rwlock_impl_active.LockForReading(rwlock);
+            }
+            SDL_LockProfileAcquired(profile, false, contended, wait_start);
+        } else {
+            SDL_rwlock_impl_active.LockForReading(rwlock);
+        }
     }
 }
 
 void SDL_LockRWLockForWriting(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
-        SDL_rwlock_impl_active.LockForWriting(rwlock);
+        SDL_LockProfile *profile = GetRWLockProfile(rwlock);
+        if (profile) {
+            const Uint64 wait_start = SDL_GetPerformanceCounter();
+            const bool contended = !SDL_rwlock_impl_active.TryLockForWriting(rwlock);
+            if (contended) {
+                SDL_rwlock_impl_active.LockForWriting(rwlock);
+            }
+            SDL_LockProfileAcquired(profile, true, contended, wait_start);
+        } else {
+            SDL_rwlock_impl_active.LockForWriting(rwlock);
+        }
     }
 }
 
@@ -209,6 +254,9 @@ bool SDL_TryLockRWLockForReading(SDL_RWLock *rwlock)
     bool result = true;
     if (rwlock) {
         result = SDL_rwlock_impl_active.TryLockForReading(rwlock);
+        if (result && GetRWLockProfile(rwlock)) {
+            SDL_LockProfileAcquired(GetRWLockProfile(rwlock), false, false, 0);
+        }
     }
     return result;
 }
@@ -218,6 +266,9 @@ bool SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
     bool result = true;
     if (rwlock) {
         result = SDL_rwlock_impl_active.TryLockForWriting(rwlock);
+        if (result && GetRWLockProfile(rwlock)) {
+            SDL_LockProfileAcquired(GetRWLockProfile(rwlock), true, false, 0);
+        }
     }
     return result;
 }
@@ -225,6 +276,9 @@ bool SDL_TryLockRWLockForWriting(SDL_RWLock *rwlock)
 void SDL_UnlockRWLock(SDL_RWLock *rwlock) SDL_NO_THREAD_SAFETY_ANALYSIS  // clang doesn't know about NULL mutexes
 {
     if (rwlock) {
+        if (GetRWLockProfile(rwlock)) {
+            SDL_LockProfileReleased(GetRWLockProfile(rwlock));
+        }
         SDL_rwlock_impl_active.Unlock(rwlock);
     }
 }
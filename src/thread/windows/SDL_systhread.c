@@ -183,6 +183,18 @@ bool SDL_SYS_SetThreadPriority(SDL_ThreadPriority priority)
     return true;
 }
 
+bool SDL_SYS_SetThreadAffinity(int cpu)
+{
+    // Cores beyond the first processor group would need SetThreadGroupAffinity()
+    if (cpu < 0 || cpu >= (int)(sizeof(DWORD_PTR) * 8)) {
+        return SDL_Unsupported();
+    }
+    if (!SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << cpu)) {
+        return WIN_SetError("SetThreadAffinityMask()");
+    }
+    return true;
+}
+
 void SDL_SYS_WaitThread(SDL_Thread *thread)
 {
     WaitForSingleObjectEx(thread->handle, INFINITE, FALSE);
@@ -35,24 +35,21 @@ typedef struct SDL_Timer
     void *userdata;
     Uint64 interval;
     Uint64 scheduled;
+    Uint64 dispatched;
+    Uint64 sequence;
     SDL_AtomicInt canceled;
+    SDL_SpinLock stats_lock;
+    SDL_TimerStats stats;
     struct SDL_Timer *next;
 } SDL_Timer;
 
-typedef struct SDL_TimerMap
-{
-    SDL_TimerID timerID;
-    SDL_Timer *timer;
-    struct SDL_TimerMap *next;
-} SDL_TimerMap;
-
-// The timers are kept in a sorted list
+// The timers are kept in a 4-ary min-heap, ordered by scheduling time
 typedef struct
 {
     // Data used by the main thread
     SDL_InitState init;
     SDL_Thread *thread;
-    SDL_TimerMap *timermap;
+    SDL_HashTable *timermap;
     SDL_Mutex *timermap_lock;
 
     // Padding to separate cache lines between threads
@@ -65,8 +62,20 @@ typedef struct
     SDL_Timer *freelist;
     SDL_AtomicInt active;
 
-    // List of timers - this is only touched by the timer thread
-    SDL_Timer *timers;
+    // Timers waiting for a worker thread, if SDL_HINT_TIMER_THREADS is set
+    SDL_Thread **workers;
+    int num_workers;
+    SDL_Mutex *work_lock;
+    SDL_Condition *work_cond;
+    SDL_Timer *work_head;
+    SDL_Timer *work_tail;
+    bool work_quit;
+
+    // Heap of timers - this is only touched by the timer thread
+    SDL_Timer **timers;
+    int num_timers;
+    int max_timers;
+    Uint64 sequence;
 } SDL_TimerData;
 
 static SDL_TimerData SDL_timer_data;
@@ -75,26 +84,156 @@ static SDL_TimerData SDL_timer_data;
  * thread manages the active timer queue, sorted by scheduling time.
  *
  * Timers are removed by simply setting a canceled flag
+ *
+ * If there are worker threads, the timer thread hands due timers to them
+ * instead of running the callbacks itself. A timer isn't in the queue while
+ * a worker runs it, and goes back through the pending list afterwards, so it
+ * never runs concurrently with itself.
  */
 
-static void SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+#define SDL_TIMER_HEAP_ARITY 4
+
+// Timers scheduled for the same time run in the order they were queued
+static bool SDL_TimerBefore(const SDL_Timer *a, const SDL_Timer *b)
 {
-    SDL_Timer *prev, *curr;
+    if (a->scheduled != b->scheduled) {
+        return a->scheduled < b->scheduled;
+    }
+    return a->sequence < b->sequence;
+}
 
-    prev = NULL;
-    for (curr = data->timers; curr; prev = curr, curr = curr->next) {
-        if (curr->scheduled > timer->scheduled) {
+static bool SDL_AddTimerInternal(SDL_TimerData *data, SDL_Timer *timer)
+{
+    if (data->num_timers == data->max_timers) {
+        int max_timers = data->max_timers ? data->max_timers * 2 : 64;
+        SDL_Timer **timers = (SDL_Timer **)SDL_realloc(data->timers, max_timers * sizeof(*timers));
+        if (!timers) {
+            return false;
+        }
+        data->timers = timers;
+        data->max_timers = max_timers;
+    }
+
+    timer->sequence = data->sequence++;
+
+    // Sift up from the end of the heap
+    int i = data->num_timers++;
+    while (i > 0) {
+        const int parent = (i - 1) / SDL_TIMER_HEAP_ARITY;
+        if (!SDL_TimerBefore(timer, data->timers[parent])) {
             break;
         }
+        data->timers[i] = data->timers[parent];
+        i = parent;
     }
+    data->timers[i] = timer;
+    return true;
+}
+
+static SDL_Timer *SDL_RemoveFirstTimerInternal(SDL_TimerData *data)
+{
+    SDL_Timer *first = data->timers[0];
+    SDL_Timer *last = data->timers[--data->num_timers];
+    const int count = data->num_timers;
 
-    // Insert the timer here!
-    if (prev) {
-        prev->next = timer;
+    // Sift the last timer down from the top of the heap
+    int i = 0;
+    for (;;) {
+        const int child = i * SDL_TIMER_HEAP_ARITY + 1;
+        if (child >= count) {
+            break;
+        }
+        const int end = SDL_min(child + SDL_TIMER_HEAP_ARITY, count);
+        int best = child;
+        for (int j = child + 1; j < end; ++j) {
+            if (SDL_TimerBefore(data->timers[j], data->timers[best])) {
+                best = j;
+            }
+        }
+        if (!SDL_TimerBefore(data->timers[best], last)) {
+            break;
+        }
+        data->timers[i] = data->timers[best];
+        i = best;
+    }
+    if (count > 0) {
+        data->timers[i] = last;
+    }
+    return first;
+}
+
+static Uint64 SDL_RunTimer(SDL_Timer *timer)
+{
+    Uint64 interval, start, lateness;
+
+    if (SDL_GetAtomicInt(&timer->canceled)) {
+        return 0;
+    }
+
+    start = SDL_GetTicksNS();
+    if (timer->callback_ms) {
+        interval = SDL_MS_TO_NS(timer->callback_ms(timer->userdata, timer->timerID, (Uint32)SDL_NS_TO_MS(timer->interval)));
     } else {
-        data->timers = timer;
+        interval = timer->callback_ns(timer->userdata, timer->timerID, timer->interval);
+    }
+    lateness = (start > timer->scheduled) ? (start - timer->scheduled) : 0;
+
+    SDL_LockSpinlock(&timer->stats_lock);
+    {
+        SDL_TimerStats *stats = &timer->stats;
+        ++stats->num_calls;
+        stats->total_lateness += lateness;
+        stats->max_lateness = SDL_max(stats->max_lateness, lateness);
+        stats->last_lateness = lateness;
+        stats->total_runtime += SDL_GetTicksNS() - start;
     }
-    timer->next = curr;
+    SDL_UnlockSpinlock(&timer->stats_lock);
+
+    return interval;
+}
+
+static int SDLCALL SDL_TimerWorkerThread(void *_data)
+{
+    SDL_TimerData *data = (SDL_TimerData *)_data;
+    SDL_Timer *timer;
+    Uint64 interval;
+
+    for (;;) {
+        SDL_LockMutex(data->work_lock);
+        while (!data->work_head && !data->work_quit) {
+            SDL_WaitCondition(data->work_cond, data->work_lock);
+        }
+        if (data->work_quit) {
+            SDL_UnlockMutex(data->work_lock);
+            break;
+        }
+        timer = data->work_head;
+        data->work_head = timer->next;
+        if (!data->work_head) {
+            data->work_tail = NULL;
+        }
+        SDL_UnlockMutex(data->work_lock);
+
+        interval = SDL_RunTimer(timer);
+
+        if (interval > 0) {
+            // Hand the timer back to the timer thread to be rescheduled
+            timer->interval = interval;
+            timer->scheduled = timer->dispatched + interval;
+            SDL_LockSpinlock(&data->lock);
+            timer->next = data->pending;
+            data->pending = timer;
+            SDL_UnlockSpinlock(&data->lock);
+            SDL_SignalSemaphore(data->sem);
+        } else {
+            SDL_SetAtomicInt(&timer->canceled, 1);
+            SDL_LockSpinlock(&data->lock);
+            timer->next = data->freelist;
+            data->freelist = timer;
+            SDL_UnlockSpinlock(&data->lock);
+        }
+    }
+    return 0;
 }
 
 static int SDLCALL SDL_TimerThread(void *_data)
@@ -127,11 +266,13 @@ static int SDLCALL SDL_TimerThread(void *_data)
         }
         SDL_UnlockSpinlock(&data->lock);
 
-        // Sort the pending timers into our list
+        // Sort the pending timers into our heap
         while (pending) {
             current = pending;
+            if (!SDL_AddTimerInternal(data, current)) {
+                break;
+            }
             pending = pending->next;
-            SDL_AddTimerInternal(data, current);
         }
         freelist_head = NULL;
         freelist_tail = NULL;
@@ -144,33 +285,53 @@ static int SDLCALL SDL_TimerThread(void *_data)
         // Initial delay if there are no timers
         delay = (Uint64)-1;
 
+        if (pending) {
+            // We ran out of memory, put the rest back and try again shortly
+            SDL_Timer *last = pending;
+            while (last->next) {
+                last = last->next;
+            }
+            SDL_LockSpinlock(&data->lock);
+            last->next = data->pending;
+            data->pending = pending;
+            SDL_UnlockSpinlock(&data->lock);
+            delay = SDL_MS_TO_NS(1);
+        }
+
         tick = SDL_GetTicksNS();
 
         // Process all the pending timers for this tick
-        while (data->timers) {
-            current = data->timers;
+        while (data->num_timers > 0) {
+            current = data->timers[0];
 
             if (tick < current->scheduled) {
                 // Scheduled for the future, wait a bit
-                delay = (current->scheduled - tick);
+                delay = SDL_min(delay, current->scheduled - tick);
                 break;
             }
 
             // We're going to do something with this timer
-            data->timers = current->next;
-
-            if (SDL_GetAtomicInt(&current->canceled)) {
-                interval = 0;
-            } else {
-                if (current->callback_ms) {
-                    interval = SDL_MS_TO_NS(current->callback_ms(current->userdata, current->timerID, (Uint32)SDL_NS_TO_MS(current->interval)));
+            SDL_RemoveFirstTimerInternal(data);
+
+            if (data->num_workers > 0 && !SDL_GetAtomicInt(&current->canceled)) {
+                current->dispatched = tick;
+                current->next = NULL;
+                SDL_LockMutex(data->work_lock);
+                if (data->work_tail) {
+                    data->work_tail->next = current;
                 } else {
-                    interval = current->callback_ns(current->userdata, current->timerID, current->interval);
+                    data->work_head = current;
                 }
+                data->work_tail = current;
+                SDL_UnlockMutex(data->work_lock);
+                SDL_SignalCondition(data->work_cond);
+                continue;
             }
 
+            interval = SDL_RunTimer(current);
+
             if (interval > 0) {
-                // Reschedule this timer
+                // Reschedule this timer, there's room since we just removed it
                 current->interval = interval;
                 current->scheduled = tick + interval;
                 SDL_AddTimerInternal(data, current);
@@ -214,11 +375,16 @@ bool SDL_InitTimers(void)
         return true;
     }
 
-    data->timermap_lock = SDL_CreateMutex();
+    data->timermap_lock = SDL_CreateNamedMutex("SDL_TimerData.timermap_lock");
     if (!data->timermap_lock) {
         goto error;
     }
 
+    data->timermap = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    if (!data->timermap) {
+        goto error;
+    }
+
     data->sem = SDL_CreateSemaphore(0);
     if (!data->sem) {
         goto error;
@@ -226,6 +392,26 @@ bool SDL_InitTimers(void)
 
     SDL_SetAtomicInt(&data->active, true);
 
+    const char *hint = SDL_GetHint(SDL_HINT_TIMER_THREADS);
+    const int num_workers = hint ? SDL_clamp(SDL_atoi(hint), 0, 64) : 0;
+    if (num_workers > 0) {
+        data->work_lock = SDL_CreateNamedMutex("SDL_TimerData.work_lock");
+        data->work_cond = SDL_CreateCondition();
+        data->workers = (SDL_Thread **)SDL_calloc(num_workers, sizeof(*data->workers));
+        if (!data->work_lock || !data->work_cond || !data->workers) {
+            goto error;
+        }
+        data->work_quit = false;
+        for (int i = 0; i < num_workers; ++i) {
+            // Timer threads use a callback into the app, so we can't set a limited stack size here.
+            data->workers[i] = SDL_CreateThread(SDL_TimerWorkerThread, "SDLTimerWorker", data);
+            if (!data->workers[i]) {
+                goto error;
+            }
+            ++data->num_workers;
+        }
+    }
+
     // Timer threads use a callback into the app, so we can't set a limited stack size here.
     data->thread = SDL_CreateThread(SDL_TimerThread, "SDLTimer", data);
     if (!data->thread) {
@@ -245,7 +431,6 @@ void SDL_QuitTimers(void)
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
 
     if (!SDL_ShouldQuit(&data->init)) {
         return;
@@ -260,15 +445,49 @@ void SDL_QuitTimers(void)
         data->thread = NULL;
     }
 
+    // Shutdown the worker threads, any timers they're running go back on the pending list
+    if (data->workers) {
+        SDL_LockMutex(data->work_lock);
+        data->work_quit = true;
+        SDL_BroadcastCondition(data->work_cond);
+        SDL_UnlockMutex(data->work_lock);
+        for (int i = 0; i < data->num_workers; ++i) {
+            SDL_WaitThread(data->workers[i], NULL);
+        }
+        SDL_free(data->workers);
+        data->workers = NULL;
+        data->num_workers = 0;
+    }
+    while (data->work_head) {
+        timer = data->work_head;
+        data->work_head = timer->next;
+        SDL_free(timer);
+    }
+    data->work_tail = NULL;
+    if (data->work_cond) {
+        SDL_DestroyCondition(data->work_cond);
+        data->work_cond = NULL;
+    }
+    if (data->work_lock) {
+        SDL_DestroyMutex(data->work_lock);
+        data->work_lock = NULL;
+    }
+
     if (data->sem) {
         SDL_DestroySemaphore(data->sem);
         data->sem = NULL;
     }
 
     // Clean up the timer entries
-    while (data->timers) {
-        timer = data->timers;
-        data->timers = timer->next;
+    while (data->num_timers > 0) {
+        SDL_free(data->timers[--data->num_timers]);
+    }
+    SDL_free(data->timers);
+    data->timers = NULL;
+    data->max_timers = 0;
+    while (data->pending) {
+        timer = data->pending;
+        data->pending = timer->next;
         SDL_free(timer);
     }
     while (data->freelist) {
@@ -276,10 +495,9 @@ void SDL_QuitTimers(void)
         data->freelist = timer->next;
         SDL_free(timer);
     }
-    while (data->timermap) {
-        entry = data->timermap;
-        data->timermap = entry->next;
-        SDL_free(entry);
+    if (data->timermap) {
+        SDL_DestroyHashTable(data->timermap);
+        data->timermap = NULL;
     }
 
     if (data->timermap_lock) {
@@ -299,7 +517,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
 {
     SDL_TimerData *data = &SDL_timer_data;
     SDL_Timer *timer;
-    SDL_TimerMap *entry;
+    bool added = false;
 
     if (!callback_ms && !callback_ns) {
         SDL_InvalidParamError("callback");
@@ -317,15 +535,28 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     }
     SDL_UnlockSpinlock(&data->lock);
 
+    SDL_LockMutex(data->timermap_lock);
     if (timer) {
-        SDL_RemoveTimer(timer->timerID);
+        // The previous ID might still be mapped if the timer stopped by itself
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID);
     } else {
         timer = (SDL_Timer *)SDL_malloc(sizeof(*timer));
-        if (!timer) {
-            return 0;
-        }
     }
-    timer->timerID = SDL_GetNextObjectID();
+    if (timer) {
+        timer->timerID = SDL_GetNextObjectID();
+        timer->stats_lock = 0;
+        SDL_zero(timer->stats);
+        added = SDL_InsertIntoHashTable(data->timermap, (const void *)(uintptr_t)timer->timerID, timer, false);
+    }
+    SDL_UnlockMutex(data->timermap_lock);
+
+    if (!timer) {
+        return 0;
+    }
+    if (!added) {
+        SDL_free(timer);
+        return 0;
+    }
     timer->callback_ms = callback_ms;
     timer->callback_ns = callback_ns;
     timer->userdata = userdata;
@@ -333,18 +564,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     timer->scheduled = SDL_GetTicksNS() + timer->interval;
     SDL_SetAtomicInt(&timer->canceled, 0);
 
-    entry = (SDL_TimerMap *)SDL_malloc(sizeof(*entry));
-    if (!entry) {
-        SDL_free(timer);
-        return 0;
-    }
-    entry->timer = timer;
-    entry->timerID = timer->timerID;
-
-    SDL_LockMutex(data->timermap_lock);
-    entry->next = data->timermap;
-    data->timermap = entry;
-    SDL_UnlockMutex(data->timermap_lock);
+    const SDL_TimerID timerID = timer->timerID;
 
     // Add the timer to the pending list for the timer thread
     SDL_LockSpinlock(&data->lock);
@@ -355,7 +575,7 @@ static SDL_TimerID SDL_CreateTimer(Uint64 interval, SDL_TimerCallback callback_m
     // Wake up the timer thread if necessary
     SDL_SignalSemaphore(data->sem);
 
-    return entry->timerID;
+    return timerID;
 }
 
 SDL_TimerID SDL_AddTimer(Uint32 interval, SDL_TimerCallback callback, void *userdata)
@@ -371,7 +591,7 @@ SDL_TimerID SDL_AddTimerNS(Uint64 interval, SDL_NSTimerCallback callback, void *
 bool SDL_RemoveTimer(SDL_TimerID id)
 {
     SDL_TimerData *data = &SDL_timer_data;
-    SDL_TimerMap *prev, *entry;
+    SDL_Timer *timer = NULL;
     bool canceled = false;
 
     if (!id) {
@@ -380,26 +600,18 @@ bool SDL_RemoveTimer(SDL_TimerID id)
 
     // Find the timer
     SDL_LockMutex(data->timermap_lock);
-    prev = NULL;
-    for (entry = data->timermap; entry; prev = entry, entry = entry->next) {
-        if (entry->timerID == id) {
-            if (prev) {
-                prev->next = entry->next;
-            } else {
-                data->timermap = entry->next;
-            }
-            break;
-        }
-    }
-    SDL_UnlockMutex(data->timermap_lock);
+    if (data->timermap &&
+        SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, (const void **)&timer)) {
+        SDL_RemoveFromHashTable(data->timermap, (const void *)(uintptr_t)id);
 
-    if (entry) {
-        if (!SDL_GetAtomicInt(&entry->timer->canceled)) {
-            SDL_SetAtomicInt(&entry->timer->canceled, 1);
+        // Reused timers are unmapped under this lock, so this is still the timer with this ID
+        if (!SDL_GetAtomicInt(&timer->canceled)) {
+            SDL_SetAtomicInt(&timer->canceled, 1);
             canceled = true;
         }
-        SDL_free(entry);
     }
+    SDL_UnlockMutex(data->timermap_lock);
+
     if (canceled) {
         return true;
     } else {
@@ -407,6 +619,35 @@ bool SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+bool SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats)
+{
+    SDL_TimerData *data = &SDL_timer_data;
+    SDL_Timer *timer = NULL;
+    bool found = false;
+
+    if (!id) {
+        return SDL_InvalidParamError("id");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockMutex(data->timermap_lock);
+    if (data->timermap &&
+        SDL_FindInHashTable(data->timermap, (const void *)(uintptr_t)id, (const void **)&timer)) {
+        SDL_LockSpinlock(&timer->stats_lock);
+        SDL_copyp(stats, &timer->stats);
+        SDL_UnlockSpinlock(&timer->stats_lock);
+        found = true;
+    }
+    SDL_UnlockMutex(data->timermap_lock);
+
+    if (!found) {
+        return SDL_SetError("Timer not found");
+    }
+    return true;
+}
+
 #else
 
 #include <emscripten/emscripten.h>
@@ -533,6 +774,17 @@ bool SDL_RemoveTimer(SDL_TimerID id)
     }
 }
 
+bool SDL_GetTimerStats(SDL_TimerID id, SDL_TimerStats *stats)
+{
+    if (!id) {
+        return SDL_InvalidParamError("id");
+    }
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+    return SDL_Unsupported();
+}
+
 #endif // !SDL_PLATFORM_EMSCRIPTEN || !SDL_THREADS_DISABLED
 
 static Uint64 tick_start;
@@ -661,74 +913,164 @@ void SDL_DelayNS(Uint64 ns)
     SDL_SYS_DelayNS(ns);
 }
 
+#if defined(SDL_PLATFORM_LINUX)
+#include <sys/prctl.h>
+#ifdef PR_SET_TIMERSLACK
+#define HAVE_TIMERSLACK
+#endif
+#endif
+
+// SDL_DelayPrecise() sleeps for most of the delay and busy waits for the
+// rest. The time left for busy waiting is based on how much sleeps actually
+// overshoot on the current thread: it keeps the most recent overshoots and
+// reserves one that's larger than 7 out of 8 of them. Sleeps are noisy, and
+// reserving enough for the rare long overshoot would mean busy waiting most
+// of the time.
+//
+// On Linux, the timer slack of the thread is lowered while sleeping, so the
+// kernel doesn't add up to 50 us to coalesce wakeups.
+#define SDL_DELAY_SAMPLES 32
+
+typedef struct SDL_DelayCalibration
+{
+    Uint64 samples[SDL_DELAY_SAMPLES];
+    int num_samples;
+    int next_sample;
+    Uint64 reserve;
+} SDL_DelayCalibration;
+
+static SDL_TLSID SDL_delay_calibration;
+static SDL_SpinLock SDL_delay_stats_lock;
+static SDL_DelayStats SDL_delay_stats;
+
+static SDL_DelayCalibration *SDL_GetDelayCalibration(SDL_DelayCalibration *fallback)
+{
+    SDL_DelayCalibration *calibration = (SDL_DelayCalibration *)SDL_GetTLS(&SDL_delay_calibration);
+    if (!calibration) {
+        calibration = (SDL_DelayCalibration *)SDL_calloc(1, sizeof(*calibration));
+        if (!calibration || !SDL_SetTLS(&SDL_delay_calibration, calibration, SDL_free)) {
+            SDL_free(calibration);
+            calibration = fallback;
+        }
+    }
+    return calibration;
+}
+
+static void SDL_CalibrateDelay(SDL_DelayCalibration *calibration, Uint64 overshoot)
+{
+    calibration->samples[calibration->next_sample] = overshoot;
+    calibration->next_sample = (calibration->next_sample + 1) % SDL_DELAY_SAMPLES;
+    if (calibration->num_samples < SDL_DELAY_SAMPLES) {
+        ++calibration->num_samples;
+    }
+
+    // Find the sample that's larger than 7/8 of the others
+    const int n = calibration->num_samples;
+    const int rank = n - 1 - (n / 8);
+    Uint64 sorted[SDL_DELAY_SAMPLES];
+    SDL_memcpy(sorted, calibration->samples, n * sizeof(*sorted));
+    for (int i = 1; i < n; ++i) {
+        const Uint64 value = sorted[i];
+        int j = i;
+        while (j > 0 && sorted[j - 1] > value) {
+            sorted[j] = sorted[j - 1];
+            --j;
+        }
+        sorted[j] = value;
+    }
+    calibration->reserve = sorted[rank];
+}
+
 void SDL_DelayPrecise(Uint64 ns)
 {
+    SDL_DelayCalibration fallback;
+    SDL_zero(fallback);
+    SDL_DelayCalibration *calibration = SDL_GetDelayCalibration(&fallback);
     Uint64 current_value = SDL_GetTicksNS();
     const Uint64 target_value = current_value + ns;
+    Uint64 sleep_ns = 0, spin_ns;
+#ifdef HAVE_TIMERSLACK
+    int timer_slack = -1;
+#endif
 
-    // Sleep for a short number of cycles when real sleeps are desired.
-    // We'll use 1 ms, it's the minimum guaranteed to produce real sleeps across
-    // all platforms.
-    const Uint64 SHORT_SLEEP_NS = 1 * SDL_NS_PER_MS;
+    for (;;) {
+        // Until we've measured anything, keep 1 ms in reserve, it's the
+        // minimum guaranteed to produce real sleeps across all platforms.
+        Uint64 reserve = SDL_NS_PER_MS;
+        if (calibration->num_samples > 0) {
+            reserve = calibration->reserve;
+        }
+        if (current_value + reserve >= target_value) {
+            break;
+        }
+        const Uint64 request = target_value - current_value - reserve;
 
-    // Try to sleep short of target_value. If for some crazy reason
-    // a particular platform sleeps for less than 1 ms when 1 ms was requested,
-    // that's fine, the code below can cope with that, but in practice no
-    // platforms behave that way.
-    Uint64 max_sleep_ns = SHORT_SLEEP_NS;
-    while (current_value + max_sleep_ns < target_value) {
-        // Sleep for a short time
-        SDL_SYS_DelayNS(SHORT_SLEEP_NS);
+#ifdef HAVE_TIMERSLACK
+        if (timer_slack < 0) {
+            timer_slack = prctl(PR_GET_TIMERSLACK, 0, 0, 0, 0);
+            if (timer_slack > 1) {
+                prctl(PR_SET_TIMERSLACK, 1, 0, 0, 0);
+            }
+        }
+#endif
+        SDL_SYS_DelayNS(request);
 
         const Uint64 now = SDL_GetTicksNS();
-        const Uint64 next_sleep_ns = (now - current_value);
-        if (next_sleep_ns > max_sleep_ns) {
-            max_sleep_ns = next_sleep_ns;
-        }
+        const Uint64 slept = now - current_value;
+        SDL_CalibrateDelay(calibration, (slept > request) ? (slept - request) : 0);
+        sleep_ns += slept;
         current_value = now;
     }
 
-    // Do a shorter sleep of the remaining time here, less the max overshoot in
-    // the first loop. Due to maintaining max_sleep_ns as
-    // greater-than-or-equal-to-1 ms, we can always subtract off 1 ms to get
-    // the duration overshot beyond a 1 ms sleep request; if the system never
-    // overshot, great, it's zero duration. By choosing the max overshoot
-    // amount, we're likely to not overshoot here. If the sleep here ends up
-    // functioning like SDL_DelayNS(0) internally, that's fine, we just don't
-    // get to do a more-precise-than-1 ms-resolution sleep to undershoot by a
-    // small amount on the current system, but SDL_DelayNS(0) does at least
-    // introduce a small, yielding delay on many platforms, better than an
-    // unyielding busyloop.
-    //
-    // Note that we'll always do at least one sleep in this function, so the
-    // minimum resolution will be that of SDL_SYS_DelayNS()
-    if (current_value < target_value && (target_value - current_value) > (max_sleep_ns - SHORT_SLEEP_NS)) {
-        const Uint64 delay_ns = (target_value - current_value) - (max_sleep_ns - SHORT_SLEEP_NS);
-        SDL_SYS_DelayNS(delay_ns);
-        current_value = SDL_GetTicksNS();
-    }
-
-    // We've likely undershot target_value at this point by a pretty small
-    // amount, but maybe not. The footgun case if not handled here is where
-    // we've undershot by a large amount, like several ms, but still smaller
-    // than the amount max_sleep_ns overshot by; in such a situation, the above
-    // shorter-sleep block didn't do any delay, the if-block wasn't entered.
-    // Also, maybe the shorter-sleep undershot by several ms, so we still don't
-    // want to spin a lot then. In such a case, we accept the possibility of
-    // overshooting to not spin much, or if overshot here, not at all, keeping
-    // CPU/power usage down in any case. Due to scheduler sloppiness, it's
-    // entirely possible to end up undershooting/overshooting here by much less
-    // than 1 ms even if the current system's sleep function is only 1
-    // ms-resolution, as SDL_GetTicksNS() generally is better resolution than 1
-    // ms on the systems SDL supports.
-    while (current_value + SHORT_SLEEP_NS < target_value) {
-        SDL_SYS_DelayNS(SHORT_SLEEP_NS);
-        current_value = SDL_GetTicksNS();
+#ifdef HAVE_TIMERSLACK
+    if (timer_slack > 1) {
+        prctl(PR_SET_TIMERSLACK, timer_slack, 0, 0, 0);
     }
+#endif
 
     // Spin for any remaining time
+    const Uint64 spin_start = current_value;
     while (current_value < target_value) {
         SDL_CPUPauseInstruction();
         current_value = SDL_GetTicksNS();
     }
+    spin_ns = current_value - spin_start;
+
+    const Uint64 error = current_value - target_value;
+    const Uint64 error_us = error / SDL_NS_PER_US;
+    int bucket = 0;
+    while (bucket < SDL_DELAY_STATS_BUCKETS - 1 && error_us >= ((Uint64)1 << bucket)) {
+        ++bucket;
+    }
+
+    SDL_LockSpinlock(&SDL_delay_stats_lock);
+    {
+        SDL_DelayStats *stats = &SDL_delay_stats;
+        ++stats->num_delays;
+        stats->total_error += error;
+        stats->max_error = SDL_max(stats->max_error, error);
+        stats->total_sleep += sleep_ns;
+        stats->total_spin += spin_ns;
+        ++stats->histogram[bucket];
+    }
+    SDL_UnlockSpinlock(&SDL_delay_stats_lock);
+}
+
+bool SDL_GetDelayStats(SDL_DelayStats *stats)
+{
+    if (!stats) {
+        return SDL_InvalidParamError("stats");
+    }
+
+    SDL_LockSpinlock(&SDL_delay_stats_lock);
+    SDL_copyp(stats, &SDL_delay_stats);
+    SDL_UnlockSpinlock(&SDL_delay_stats_lock);
+    return true;
+}
+
+void SDL_ResetDelayStats(void)
+{
+    SDL_LockSpinlock(&SDL_delay_stats_lock);
+    SDL_zero(SDL_delay_stats);
+    SDL_UnlockSpinlock(&SDL_delay_stats_lock);
 }
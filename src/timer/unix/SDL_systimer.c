@@ -139,6 +139,9 @@ void SDL_SYS_DelayNS(Uint64 ns)
 {
     int was_error;
 
+#if defined(HAVE_CLOCK_NANOSLEEP) && defined(CLOCK_MONOTONIC) && defined(TIMER_ABSTIME)
+    struct timespec deadline;
+#endif
 #ifdef HAVE_NANOSLEEP
     struct timespec tv, remaining;
 #else
@@ -154,6 +157,23 @@ void SDL_SYS_DelayNS(Uint64 ns)
     }
 #endif
 
+#if defined(HAVE_CLOCK_NANOSLEEP) && defined(CLOCK_MONOTONIC) && defined(TIMER_ABSTIME)
+    // Sleep until an absolute time, so being interrupted doesn't make us sleep longer
+    if (clock_gettime(CLOCK_MONOTONIC, &deadline) == 0) {
+        const Uint64 now = (Uint64)deadline.tv_sec * SDL_NS_PER_SECOND + deadline.tv_nsec;
+        const Uint64 end = (ns > SDL_MAX_UINT64 - now) ? SDL_MAX_UINT64 : (now + ns);
+        deadline.tv_sec = (time_t)(end / SDL_NS_PER_SECOND);
+        deadline.tv_nsec = (long)(end % SDL_NS_PER_SECOND);
+        if (deadline.tv_sec >= 0 && (Uint64)deadline.tv_sec == end / SDL_NS_PER_SECOND) {
+            do {
+                was_error = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL);
+            } while (was_error == EINTR);
+            return;
+        }
+        // The deadline doesn't fit in a time_t, sleep for a relative time instead
+    }
+#endif
+
     // Set the timeout interval
 #ifdef HAVE_NANOSLEEP
     remaining.tv_sec = (time_t)(ns / SDL_NS_PER_SECOND);
@@ -214,6 +214,8 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
     Uint32 biClrUsed = 0;
     // Uint32 biClrImportant;
 
+    SDL_IOStream *unbuffered = NULL;
+
     // Make sure we are passed a valid data source
     surface = NULL;
     if (!src) {
@@ -221,6 +223,19 @@ SDL_Surface *SDL_LoadBMP_IO(SDL_IOStream *src, bool closeio)
         goto done;
     }
 
+    // The headers, palette, RLE data and row padding are read a few bytes at a time, which is only cheap for memory
+    {
+        const SDL_PropertiesID props = SDL_GetIOProperties(src);
+        if (!SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL) &&
+            !SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL)) {
+            SDL_IOStream *buffered = SDL_IOFromBufferedIO(src, 0, false);
+            if (buffered) {
+                unbuffered = src;
+                src = buffered;
+            }
+        }
+    }
+
     // Read in the BMP file header
     fp_offset = SDL_TellIO(src);
     if (fp_offset < 0) {
@@ -567,6 +582,11 @@ done:
         SDL_DestroySurface(surface);
         surface = NULL;
     }
+    if (unbuffered) {
+        // This leaves the original stream where the buffered one was
+        SDL_CloseIO(src);
+        src = unbuffered;
+    }
     if (closeio && src) {
         SDL_CloseIO(src);
     }
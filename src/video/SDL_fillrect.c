@@ -21,120 +21,12 @@
 #include "SDL_internal.h"
 
 #include "SDL_surface_c.h"
-
-#ifdef SDL_SSE_INTRINSICS
-/* *INDENT-OFF* */ // clang-format off
-
-#if defined(_MSC_VER) && !defined(__clang__)
-#define SSE_BEGIN \
-    __m128 c128; \
-    c128.m128_u32[0] = color; \
-    c128.m128_u32[1] = color; \
-    c128.m128_u32[2] = color; \
-    c128.m128_u32[3] = color;
-#else
-#define SSE_BEGIN \
-    __m128 c128; \
-    DECLARE_ALIGNED(Uint32, cccc[4], 16); \
-    cccc[0] = color; \
-    cccc[1] = color; \
-    cccc[2] = color; \
-    cccc[3] = color; \
-    c128 = *(__m128 *)cccc;
-#endif
-
-#define SSE_WORK \
-    for (i = n / 64; i--;) { \
-        _mm_stream_ps((float *)(p+0), c128); \
-        _mm_stream_ps((float *)(p+16), c128); \
-        _mm_stream_ps((float *)(p+32), c128); \
-        _mm_stream_ps((float *)(p+48), c128); \
-        p += 64; \
-    }
-
-#define SSE_END
-
-#define DEFINE_SSE_FILLRECT(bpp, type) \
-static void SDL_TARGETING("sse") SDL_FillSurfaceRect##bpp##SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h) \
-{ \
-    int i, n; \
-    Uint8 *p = NULL; \
-  \
-    /* If the number of bytes per row is equal to the pitch, treat */ \
-    /* all rows as one long continuous row (for better performance) */ \
-    if ((w) * (bpp) == pitch) { \
-        w = w * h; \
-        h = 1; \
-    } \
- \
-    SSE_BEGIN; \
- \
-    while (h--) { \
-        n = (w) * (bpp); \
-        p = pixels; \
- \
-        if (n > 63) { \
-            int adjust = 16 - ((uintptr_t)p & 15); \
-            if (adjust < 16) { \
-                n -= adjust; \
-                adjust /= (bpp); \
-                while (adjust--) { \
-                    *((type *)p) = (type)color; \
-                    p += (bpp); \
-                } \
-            } \
-            SSE_WORK; \
-        } \
-        if (n & 63) { \
-            int remainder = (n & 63); \
-            remainder /= (bpp); \
-            while (remainder--) { \
-                *((type *)p) = (type)color; \
-                p += (bpp); \
-            } \
-        } \
-        pixels += pitch; \
-    } \
- \
-    SSE_END; \
-}
-
-static void SDL_TARGETING("sse") SDL_FillSurfaceRect1SSE(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
-{
-    int i, n;
-
-    SSE_BEGIN;
-    while (h--) {
-        Uint8 *p = pixels;
-        n = w;
-
-        if (n > 63) {
-            int adjust = 16 - ((uintptr_t)p & 15);
-            if (adjust) {
-                n -= adjust;
-                SDL_memset(p, color, adjust);
-                p += adjust;
-            }
-            SSE_WORK;
-        }
-        if (n & 63) {
-            int remainder = (n & 63);
-            SDL_memset(p, color, remainder);
-        }
-        pixels += pitch;
-    }
-
-    SSE_END;
-}
-// DEFINE_SSE_FILLRECT(1, Uint8)
-DEFINE_SSE_FILLRECT(2, Uint16)
-DEFINE_SSE_FILLRECT(4, Uint32)
-
-/* *INDENT-ON* */ // clang-format on
-#endif            // __SSE__
+#include "../stdlib/SDL_sysstdlib.h"
 
 static void SDL_FillSurfaceRect1(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
+    // Filling a surface that doesn't fit in the cache through it would just evict everything else
+    const bool nontemporal = SDL_UseNonTemporalStores((size_t)w * h);
     int n;
     Uint8 *p = NULL;
 
@@ -156,7 +48,7 @@ static void SDL_FillSurfaceRect1(Uint8 *pixels, int pitch, Uint32 color, int w,
                 *p++ = (Uint8)color;
                 --n;
             }
-            SDL_memset4(p, color, (n >> 2));
+            SDL_memset4_vector(p, color, (n >> 2), nontemporal);
         }
         if (n & 3) {
             p += (n & ~3);
@@ -177,6 +69,7 @@ static void SDL_FillSurfaceRect1(Uint8 *pixels, int pitch, Uint32 color, int w,
 
 static void SDL_FillSurfaceRect2(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
+    const bool nontemporal = SDL_UseNonTemporalStores((size_t)w * h * 2);
     int n;
     Uint16 *p = NULL;
 
@@ -189,7 +82,7 @@ static void SDL_FillSurfaceRect2(Uint8 *pixels, int pitch, Uint32 color, int w,
                 *p++ = (Uint16)color;
                 --n;
             }
-            SDL_memset4(p, color, (n >> 1));
+            SDL_memset4_vector(p, color, (n >> 1), nontemporal);
         }
         if (n & 1) {
             p[n - 1] = (Uint16)color;
@@ -227,8 +120,16 @@ static void SDL_FillSurfaceRect3(Uint8 *pixels, int pitch, Uint32 color, int w,
 
 static void SDL_FillSurfaceRect4(Uint8 *pixels, int pitch, Uint32 color, int w, int h)
 {
+    const bool nontemporal = SDL_UseNonTemporalStores((size_t)w * h * 4);
+
+    // If the rows are contiguous, fill them all at once
+    if (w * 4 == pitch) {
+        SDL_memset4_vector(pixels, color, (size_t)w * h, nontemporal);
+        return;
+    }
+
     while (h--) {
-        SDL_memset4(pixels, color, w);
+        SDL_memset4_vector(pixels, color, w, nontemporal);
         pixels += pitch;
     }
 }
@@ -303,12 +204,6 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         {
             color |= (color << 8);
             color |= (color << 16);
-#ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect1SSE;
-                break;
-            }
-#endif
             fill_function = SDL_FillSurfaceRect1;
             break;
         }
@@ -316,12 +211,6 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
         case 2:
         {
             color |= (color << 16);
-#ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect2SSE;
-                break;
-            }
-#endif
             fill_function = SDL_FillSurfaceRect2;
             break;
         }
@@ -335,12 +224,6 @@ bool SDL_FillSurfaceRects(SDL_Surface *dst, const SDL_Rect *rects, int count, Ui
 
         case 4:
         {
-#ifdef SDL_SSE_INTRINSICS
-            if (SDL_HasSSE()) {
-                fill_function = SDL_FillSurfaceRect4SSE;
-                break;
-            }
-#endif
             fill_function = SDL_FillSurfaceRect4;
             break;
         }
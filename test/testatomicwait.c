@@ -0,0 +1,225 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Checks waiting on atomic variables and measures the wakeup latency.
+
+   Two threads take turns incrementing a counter, each one waiting for the
+   other's increment before making its own, and the round trip time is
+   compared with the same ping-pong done with a pair of semaphores and with
+   a mutex and condition variable. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    SDL_AtomicInt turn;
+    SDL_Semaphore *semaphores[2];
+    SDL_Mutex *lock;
+    SDL_Condition *condition;
+    int condition_turn;
+    int count;
+} PingPong;
+
+typedef struct
+{
+    PingPong *data;
+    int player;
+} Player;
+
+static int SDLCALL atomic_player(void *userdata)
+{
+    Player *player = (Player *)userdata;
+    PingPong *data = player->data;
+    int turn, current;
+
+    for (turn = player->player; turn < 2 * data->count; turn += 2) {
+        while ((current = SDL_GetAtomicInt(&data->turn)) != turn - 1) {
+            SDL_WaitAtomicInt(&data->turn, current);
+        }
+        SDL_SetAtomicInt(&data->turn, turn);
+        SDL_NotifyAtomicIntOne(&data->turn);
+    }
+    return 0;
+}
+
+static int SDLCALL semaphore_player(void *userdata)
+{
+    Player *player = (Player *)userdata;
+    PingPong *data = player->data;
+    int i;
+
+    for (i = 0; i < data->count; ++i) {
+        SDL_WaitSemaphore(data->semaphores[player->player]);
+        SDL_SignalSemaphore(data->semaphores[!player->player]);
+    }
+    return 0;
+}
+
+static int SDLCALL condition_player(void *userdata)
+{
+    Player *player = (Player *)userdata;
+    PingPong *data = player->data;
+    int turn;
+
+    for (turn = player->player; turn < 2 * data->count; turn += 2) {
+        SDL_LockMutex(data->lock);
+        while (data->condition_turn != turn) {
+            SDL_WaitCondition(data->condition, data->lock);
+        }
+        ++data->condition_turn;
+        SDL_SignalCondition(data->condition);
+        SDL_UnlockMutex(data->lock);
+    }
+    return 0;
+}
+
+static bool run_ping_pong(const char *name, SDL_ThreadFunction func, PingPong *data)
+{
+    Player players[2];
+    SDL_Thread *threads[2];
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_SetAtomicInt(&data->turn, -1);
+    data->condition_turn = 0;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < 2; ++i) {
+        players[i].data = data;
+        players[i].player = i;
+        threads[i] = SDL_CreateThread(func, name, &players[i]);
+        if (!threads[i]) {
+            SDL_Log("Couldn't create thread: %s", SDL_GetError());
+            if (i > 0) {
+                SDL_DetachThread(threads[0]);
+            }
+            return false;
+        }
+    }
+    if (func == semaphore_player) {
+        SDL_SignalSemaphore(data->semaphores[0]);
+    }
+    SDL_WaitThread(threads[0], NULL);
+    SDL_WaitThread(threads[1], NULL);
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%-10s %8.1f ns per round trip", name, (double)elapsed / data->count);
+    return true;
+}
+
+static bool test_timeout(void)
+{
+    SDL_AtomicInt value;
+    Uint64 start, elapsed;
+    bool ok = true;
+
+    SDL_SetAtomicInt(&value, 1);
+
+    if (!SDL_WaitAtomicIntTimeout(&value, 0, 1000)) {
+        SDL_Log("Waiting for a value the atomic doesn't have timed out");
+        ok = false;
+    }
+    if (SDL_WaitAtomicIntTimeout(&value, 1, 0)) {
+        SDL_Log("Waiting with a zero timeout didn't time out");
+        ok = false;
+    }
+
+    start = SDL_GetTicksNS();
+    if (SDL_WaitAtomicIntTimeout(&value, 1, 20)) {
+        SDL_Log("Waiting for a value that doesn't change didn't time out");
+        ok = false;
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    if (elapsed < SDL_MS_TO_NS(20)) {
+        SDL_Log("Waiting timed out after %" SDL_PRIu64 " ns, expected at least 20 ms", elapsed);
+        ok = false;
+    }
+
+    /* Nobody is waiting, so these shouldn't do anything */
+    SDL_NotifyAtomicIntOne(&value);
+    SDL_NotifyAtomicIntAll(&value);
+
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    PingPong data;
+    bool ok = true;
+    int i;
+
+    SDL_zero(data);
+    data.count = 100000;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                data.count = SDL_atoi(argv[i + 1]);
+                consumed = (data.count > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--count N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!test_timeout()) {
+        ok = false;
+    }
+
+    data.semaphores[0] = SDL_CreateSemaphore(0);
+    data.semaphores[1] = SDL_CreateSemaphore(0);
+    data.lock = SDL_CreateMutex();
+    data.condition = SDL_CreateCondition();
+    if (!data.semaphores[0] || !data.semaphores[1] || !data.lock || !data.condition) {
+        SDL_Log("Couldn't create synchronization objects: %s", SDL_GetError());
+        ok = false;
+    } else {
+        SDL_Log("%d round trips, %d CPU cores", data.count, SDL_GetNumLogicalCPUCores());
+        if (!run_ping_pong("atomic", atomic_player, &data)) {
+            ok = false;
+        } else if (SDL_GetAtomicInt(&data.turn) != 2 * data.count - 1) {
+            SDL_Log("The atomic ping-pong ended on turn %d, expected %d", SDL_GetAtomicInt(&data.turn), 2 * data.count - 1);
+            ok = false;
+        }
+        if (!run_ping_pong("semaphore", semaphore_player, &data) ||
+            !run_ping_pong("condition", condition_player, &data)) {
+            ok = false;
+        }
+    }
+
+    SDL_DestroyCondition(data.condition);
+    SDL_DestroyMutex(data.lock);
+    SDL_DestroySemaphore(data.semaphores[1]);
+    SDL_DestroySemaphore(data.semaphores[0]);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return ok ? 0 : 1;
+}
@@ -304,6 +304,161 @@ static int SDLCALL events_mainThreadCallbacks(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Adds events of different types and checks that range queries return them in order
+ *
+ * \sa SDL_PeepEvents
+ * \sa SDL_HasEvents
+ * \sa SDL_FlushEvents
+ */
+static int SDLCALL events_peepEventRanges(void *arg)
+{
+    static const Uint32 types[] = {
+        SDL_EVENT_USER, SDL_EVENT_KEY_DOWN, SDL_EVENT_USER + 1, SDL_EVENT_MOUSE_MOTION,
+        SDL_EVENT_KEY_UP, SDL_EVENT_USER, SDL_EVENT_MOUSE_BUTTON_DOWN, SDL_EVENT_USER + 1
+    };
+    SDL_Event events[SDL_arraysize(types)];
+    SDL_Event event;
+    int i, result;
+
+    /* Flush all events */
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < (int)SDL_arraysize(types); ++i) {
+        SDL_zero(event);
+        event.type = types[i];
+        event.user.code = i;
+        result = SDL_PeepEvents(&event, 1, SDL_ADDEVENT, 0, 0);
+        SDLTest_AssertCheck(result == 1, "Check result from SDL_PeepEvents(SDL_ADDEVENT), expected: 1, got: %d", result);
+    }
+
+    result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_KEY_DOWN, SDL_EVENT_MOUSE_BUTTON_DOWN);
+    SDLTest_AssertCheck(result == 4, "Check number of keyboard and mouse events, expected: 4, got: %d", result);
+    SDLTest_AssertCheck(SDL_HasEvents(SDL_EVENT_KEY_UP, SDL_EVENT_KEY_UP), "Check SDL_HasEvents returns true for SDL_EVENT_KEY_UP");
+    SDLTest_AssertCheck(!SDL_HasEvents(SDL_EVENT_MOUSE_BUTTON_UP, SDL_EVENT_MOUSE_WHEEL), "Check SDL_HasEvents returns false for SDL_EVENT_MOUSE_BUTTON_UP");
+
+    /* Events in a range spanning several event categories come back in the order they were added */
+    result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_KEY_DOWN, SDL_EVENT_USER);
+    SDLTest_AssertCheck(result == 6, "Check result from SDL_PeepEvents(SDL_GETEVENT), expected: 6, got: %d", result);
+    for (i = 1; i < result; ++i) {
+        SDLTest_AssertCheck(events[i - 1].user.code < events[i].user.code, "Check event %d was added before event %d", (int)events[i - 1].user.code, (int)events[i].user.code);
+    }
+
+    SDL_FlushEvent(SDL_EVENT_USER + 1);
+    result = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDLTest_AssertCheck(result == 0, "Check the queue is empty after flushing, got: %d events", result);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Pushes mouse motion with SDL_HINT_EVENT_COALESCE_MOTION and checks that it is merged
+ *
+ * \sa SDL_HINT_EVENT_COALESCE_MOTION
+ * \sa SDL_GetMotionHistory
+ */
+static int SDLCALL events_coalesceMotion(void *arg)
+{
+    const SDL_MouseID mouse = 0x1234;
+    SDL_Event events[16];
+    SDL_Event event;
+    int i, result;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, "1");
+
+    for (i = 0; i < 10; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.which = mouse;
+        /* The last two events are in another window */
+        event.motion.windowID = (i < 8) ? 1 : 2;
+        event.motion.x = (float)i;
+        event.motion.xrel = 1.0f;
+        event.motion.yrel = -1.0f;
+        SDL_PushEvent(&event);
+    }
+
+    result = SDL_PeepEvents(events, SDL_arraysize(events), SDL_GETEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+    SDLTest_AssertCheck(result == 2, "Check number of merged motion events, expected: 2, got: %d", result);
+    if (result == 2) {
+        SDLTest_AssertCheck(events[0].motion.x == 7.0f, "Check x of first event, expected: 7, got: %g", events[0].motion.x);
+        SDLTest_AssertCheck(events[0].motion.xrel == 8.0f, "Check xrel of first event, expected: 8, got: %g", events[0].motion.xrel);
+        SDLTest_AssertCheck(events[0].motion.yrel == -8.0f, "Check yrel of first event, expected: -8, got: %g", events[0].motion.yrel);
+        SDLTest_AssertCheck(events[1].motion.x == 9.0f, "Check x of second event, expected: 9, got: %g", events[1].motion.x);
+        SDLTest_AssertCheck(events[1].motion.xrel == 2.0f, "Check xrel of second event, expected: 2, got: %g", events[1].motion.xrel);
+    }
+
+    result = SDL_GetMotionHistory(SDL_EVENT_MOUSE_MOTION, mouse, events, -1);
+    SDLTest_AssertCheck(result == -1, "Check SDL_GetMotionHistory with a negative count, expected: -1, got: %d", result);
+    result = SDL_GetMotionHistory(SDL_EVENT_MOUSE_MOTION, mouse, events, 4);
+    SDLTest_AssertCheck(result == 4, "Check SDL_GetMotionHistory, expected: 4, got: %d", result);
+    SDLTest_AssertCheck(events[0].motion.x == 0.0f && events[3].motion.x == 3.0f, "Check the oldest events are returned first");
+    result = SDL_GetMotionHistory(SDL_EVENT_MOUSE_MOTION, mouse, events, SDL_arraysize(events));
+    SDLTest_AssertCheck(result == 6, "Check SDL_GetMotionHistory, expected: 6, got: %d", result);
+    result = SDL_GetMotionHistory(SDL_EVENT_MOUSE_MOTION, mouse, events, SDL_arraysize(events));
+    SDLTest_AssertCheck(result == 0, "Check SDL_GetMotionHistory is empty, got: %d", result);
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    return TEST_COMPLETED;
+}
+
+/**
+ * Pushes batches of events, with and without an event filter that drops some of them
+ *
+ * \sa SDL_PushEvents
+ */
+static bool SDLCALL events_dropOddEventFilter(void *userdata, SDL_Event *event)
+{
+    if (event->type == SDL_EVENT_USER && (event->user.code % 2) != 0) {
+        return false;
+    }
+    return true;
+}
+
+static int SDLCALL events_pushEvents(void *arg)
+{
+    SDL_Event events_in[10];
+    SDL_Event events_out[10];
+    int i, result;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+
+    for (i = 0; i < (int)SDL_arraysize(events_in); ++i) {
+        SDL_zero(events_in[i]);
+        events_in[i].type = SDL_EVENT_USER;
+        events_in[i].user.code = i;
+    }
+
+    SDL_SetEventFilter(events_dropOddEventFilter, NULL);
+    result = SDL_PushEvents(events_in, SDL_arraysize(events_in));
+    SDLTest_AssertCheck(result == 5, "Check result from SDL_PushEvents with an event filter, expected: 5, got: %d", result);
+    SDL_SetEventFilter(NULL, NULL);
+
+    result = SDL_PushEvents(events_in, SDL_arraysize(events_in));
+    SDLTest_AssertCheck(result == 10, "Check result from SDL_PushEvents, expected: 10, got: %d", result);
+    SDLTest_AssertCheck(events_in[0].common.timestamp == 0, "Check the events passed in are not modified");
+
+    result = SDL_PeepEvents(events_out, 5, SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDLTest_AssertCheck(result == 5, "Check events from the first batch, expected: 5, got: %d", result);
+    for (i = 0; i < result; ++i) {
+        SDLTest_AssertCheck(events_out[i].user.code == i * 2, "Check event %d, got code: %d", i, (int)events_out[i].user.code);
+    }
+    result = SDL_PeepEvents(events_out, SDL_arraysize(events_out), SDL_GETEVENT, SDL_EVENT_USER, SDL_EVENT_USER);
+    SDLTest_AssertCheck(result == 10, "Check events from the second batch, expected: 10, got: %d", result);
+    for (i = 0; i < result; ++i) {
+        SDLTest_AssertCheck(events_out[i].user.code == i, "Check event %d, got code: %d", i, (int)events_out[i].user.code);
+        SDLTest_AssertCheck(events_out[i].common.timestamp != 0, "Check event %d has a timestamp", i);
+    }
+
+    result = SDL_PushEvents(NULL, 1);
+    SDLTest_AssertCheck(result == -1, "Check SDL_PushEvents(NULL) fails, got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Events test cases */
@@ -323,12 +478,27 @@ static const SDLTest_TestCaseReference eventsTest_mainThreadCallbacks = {
     events_mainThreadCallbacks, "events_mainThreadCallbacks", "Run callbacks on the main thread", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference eventsTest_peepEventRanges = {
+    events_peepEventRanges, "events_peepEventRanges", "Gets events by type range in the order they were added", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_coalesceMotion = {
+    events_coalesceMotion, "events_coalesceMotion", "Merges consecutive motion events and keeps their history", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference eventsTest_pushEvents = {
+    events_pushEvents, "events_pushEvents", "Pushes a batch of events", TEST_ENABLED
+};
+
 /* Sequence of Events test cases */
 static const SDLTest_TestCaseReference *eventsTests[] = {
     &eventsTest_pushPumpAndPollUserevent,
     &eventsTest_addDelEventWatch,
     &eventsTest_addDelEventWatchWithUserdata,
     &eventsTest_mainThreadCallbacks,
+    &eventsTest_peepEventRanges,
+    &eventsTest_coalesceMotion,
+    &eventsTest_pushEvents,
     NULL
 };
 
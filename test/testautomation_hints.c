@@ -271,6 +271,52 @@ static int SDLCALL hints_setHint(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Verify that cached hint values follow changes to the hint and the environment
+ */
+static int SDLCALL hints_getHintAfterChanges(void *arg)
+{
+    const char *testHint = "SDL_AUTOMATED_TEST_HINT_CACHE";
+    const char *first;
+    const char *testValue;
+
+    SDL_SetHint(testHint, "first");
+    first = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(first && SDL_strcmp(first, "first") == 0, "testValue = %s, expected \"first\"", first);
+    testValue = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(testValue == first, "Repeated SDL_GetHint() should return the same string");
+
+    SDL_SetHint("SDL_AUTOMATED_TEST_HINT_OTHER", "other");
+    testValue = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(testValue == first, "Changing another hint should keep the same string");
+    SDL_ResetHint("SDL_AUTOMATED_TEST_HINT_OTHER");
+
+    SDL_SetHint(testHint, "second");
+    testValue = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(testValue && SDL_strcmp(testValue, "second") == 0, "testValue = %s, expected \"second\"", testValue);
+
+    SDLTest_AssertPass("Call to SDL_SetEnvironmentVariable()");
+    SDL_SetEnvironmentVariable(SDL_GetEnvironment(), testHint, "environment", true);
+    testValue = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(testValue && SDL_strcmp(testValue, "environment") == 0, "testValue = %s, expected \"environment\"", testValue);
+
+    SDL_SetHintWithPriority(testHint, "override", SDL_HINT_OVERRIDE);
+    testValue = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(testValue && SDL_strcmp(testValue, "override") == 0, "testValue = %s, expected \"override\"", testValue);
+
+    SDLTest_AssertPass("Call to SDL_ResetHint()");
+    SDL_ResetHint(testHint);
+    testValue = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(testValue && SDL_strcmp(testValue, "environment") == 0, "testValue = %s, expected \"environment\"", testValue);
+
+    SDLTest_AssertPass("Call to SDL_UnsetEnvironmentVariable()");
+    SDL_UnsetEnvironmentVariable(SDL_GetEnvironment(), testHint);
+    testValue = SDL_GetHint(testHint);
+    SDLTest_AssertCheck(testValue == NULL, "testValue = %s, expected NULL", testValue);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Hints test cases */
@@ -282,10 +328,15 @@ static const SDLTest_TestCaseReference hintsSetHint = {
     hints_setHint, "hints_setHint", "Call to SDL_SetHint", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference hintsGetHintAfterChanges = {
+    hints_getHintAfterChanges, "hints_getHintAfterChanges", "Call to SDL_GetHint after changing the hint and environment", TEST_ENABLED
+};
+
 /* Sequence of Hints test cases */
 static const SDLTest_TestCaseReference *hintsTests[] = {
     &hintsGetHint,
     &hintsSetHint,
+    &hintsGetHintAfterChanges,
     NULL
 };
 
@@ -361,6 +361,95 @@ static int SDLCALL iostrm_testDynamicMem(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests buffering another stream.
+ *
+ * \sa SDL_IOFromBufferedIO
+ * \sa SDL_CloseIO
+ */
+static int SDLCALL iostrm_testBuffered(void *arg)
+{
+    static const size_t bufferSizes[] = { 4, 64 };
+    SDL_IOStream *src, *rw;
+    Uint8 u8;
+    Uint32 u32;
+    Sint64 i;
+    size_t j;
+    int result;
+
+    /* Run the generic tests with buffers smaller and larger than the data */
+    for (j = 0; j < SDL_arraysize(bufferSizes); ++j) {
+        char *mem;
+
+        src = SDL_IOFromDynamicMem();
+        SDLTest_AssertCheck(src != NULL, "Verify opening memory with SDL_IOFromDynamicMem does not return NULL");
+        if (src == NULL) {
+            return TEST_ABORTED;
+        }
+        rw = SDL_IOFromBufferedIO(src, bufferSizes[j], false);
+        SDLTest_AssertPass("Call to SDL_IOFromBufferedIO(src, %d, false) succeeded", (int)bufferSizes[j]);
+        SDLTest_AssertCheck(rw != NULL, "Verify SDL_IOFromBufferedIO does not return NULL");
+        if (rw == NULL) {
+            SDL_CloseIO(src);
+            return TEST_ABORTED;
+        }
+
+        testGenericIOStreamValidations(rw, true);
+
+        result = SDL_CloseIO(rw);
+        SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
+        SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+        mem = (char *)SDL_GetPointerProperty(SDL_GetIOProperties(src), SDL_PROP_IOSTREAM_DYNAMIC_MEMORY_POINTER, NULL);
+        SDLTest_AssertCheck(mem != NULL && SDL_GetIOSize(src) == (Sint64)SDL_strlen(IOStreamHelloWorldTestString), "Verify all writes reached the buffered stream");
+        if (mem) {
+            mem[SDL_GetIOSize(src)] = '\0';
+            SDLTest_AssertCheck(SDL_strcmp(mem, IOStreamHelloWorldTestString) == 0, "Verify buffered stream contents, expected '%s', got '%s'", IOStreamHelloWorldTestString, mem);
+        }
+        SDL_CloseIO(src);
+    }
+
+    /* Read ahead from a file and make sure the file is left where the reads stopped */
+    src = SDL_IOFromFile(IOStreamAlphabetFilename, "r");
+    SDLTest_AssertCheck(src != NULL, "Verify opening file with SDL_IOFromFile in read mode does not return NULL");
+    if (src == NULL) {
+        return TEST_ABORTED;
+    }
+    rw = SDL_IOFromBufferedIO(src, 0, false);
+    SDLTest_AssertCheck(rw != NULL, "Verify SDL_IOFromBufferedIO does not return NULL");
+    if (rw == NULL) {
+        SDL_CloseIO(src);
+        return TEST_ABORTED;
+    }
+
+    result = SDL_ReadU8(rw, &u8);
+    SDLTest_AssertCheck(result == true && u8 == 'A', "Verify SDL_ReadU8, expected 'A', got '%c'", u8);
+    result = SDL_ReadU32BE(rw, &u32);
+    SDLTest_AssertCheck(result == true && u32 == 0x42434445, "Verify SDL_ReadU32BE, expected 0x42434445, got 0x%08" SDL_PRIx32, u32);
+    i = SDL_SeekIO(rw, -3, SDL_IO_SEEK_CUR);
+    SDLTest_AssertCheck(i == 2, "Verify seek back within the buffer, expected 2, got %" SDL_PRIs64, i);
+    result = SDL_ReadU8(rw, &u8);
+    SDLTest_AssertCheck(result == true && u8 == 'C', "Verify SDL_ReadU8 after seek, expected 'C', got '%c'", u8);
+    i = SDL_SeekIO(rw, -2, SDL_IO_SEEK_END);
+    SDLTest_AssertCheck(i == 24, "Verify seek from the end, expected 24, got %" SDL_PRIs64, i);
+    result = SDL_ReadU32LE(rw, &u32);
+    SDLTest_AssertCheck(result == false, "Verify SDL_ReadU32LE fails at the end of the stream");
+    i = SDL_SeekIO(rw, 10, SDL_IO_SEEK_SET);
+    SDLTest_AssertCheck(i == 10, "Verify seek to 10, expected 10, got %" SDL_PRIs64, i);
+    result = SDL_ReadU8(rw, &u8);
+    SDLTest_AssertCheck(result == true && u8 == 'K', "Verify SDL_ReadU8 after seek, expected 'K', got '%c'", u8);
+
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+    i = SDL_TellIO(src);
+    SDLTest_AssertCheck(i == 11, "Verify the file is left after the last read, expected 11, got %" SDL_PRIs64, i);
+    result = SDL_ReadU8(src, &u8);
+    SDLTest_AssertCheck(result == true && u8 == 'L', "Verify reading the file directly, expected 'L', got '%c'", u8);
+    SDL_CloseIO(src);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests reading from file.
  *
@@ -393,6 +482,58 @@ static int SDLCALL iostrm_testFileRead(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Tests mapping files into memory.
+ *
+ * \sa SDL_MapFile
+ * \sa SDL_UnmapFile
+ * \sa SDL_IOFromFile
+ */
+static int SDLCALL iostrm_testMapFile(void *arg)
+{
+    SDL_IOStream *rw;
+    SDL_PropertiesID props;
+    const void *mem;
+    size_t size;
+    int result;
+
+    /* Map a file directly */
+    mem = SDL_MapFile(IOStreamAlphabetFilename, SDL_MAPFILE_SEQUENTIAL, &size);
+    SDLTest_AssertPass("Call to SDL_MapFile(\"%s\", SDL_MAPFILE_SEQUENTIAL) succeeded", IOStreamAlphabetFilename);
+    SDLTest_AssertCheck(mem != NULL, "Verify SDL_MapFile does not return NULL");
+    if (mem == NULL) {
+        return TEST_ABORTED;
+    }
+    SDLTest_AssertCheck(size == SDL_strlen(IOStreamAlphabetString), "Verify mapped size, expected %d, got %d", (int)SDL_strlen(IOStreamAlphabetString), (int)size);
+    SDLTest_AssertCheck(SDL_memcmp(mem, IOStreamAlphabetString, SDL_min(size, SDL_strlen(IOStreamAlphabetString))) == 0, "Verify mapped data matches the file");
+    SDL_UnmapFile(mem, size);
+    SDLTest_AssertPass("Call to SDL_UnmapFile() succeeded");
+
+    mem = SDL_MapFile("nonexistent_file", 0, &size);
+    SDLTest_AssertCheck(mem == NULL && size == 0, "Verify SDL_MapFile on a missing file returns NULL");
+
+    /* Open a mapped stream and run the generic tests on it */
+    rw = SDL_IOFromFile(IOStreamReadTestFilename, "rbmR");
+    SDLTest_AssertPass("Call to SDL_IOFromFile(..,\"rbmR\") succeeded");
+    SDLTest_AssertCheck(rw != NULL, "Verify opening file with SDL_IOFromFile in mapped mode does not return NULL");
+    if (rw == NULL) {
+        return TEST_ABORTED;
+    }
+
+    props = SDL_GetIOProperties(rw);
+    mem = SDL_GetPointerProperty(props, SDL_PROP_IOSTREAM_MEMORY_POINTER, NULL);
+    size = (size_t)SDL_GetNumberProperty(props, SDL_PROP_IOSTREAM_MEMORY_SIZE_NUMBER, 0);
+    SDLTest_AssertCheck(mem != NULL && size == SDL_strlen(IOStreamHelloWorldTestString), "Verify the mapped data is available as a property");
+
+    testGenericIOStreamValidations(rw, false);
+
+    result = SDL_CloseIO(rw);
+    SDLTest_AssertPass("Call to SDL_CloseIO() succeeded");
+    SDLTest_AssertCheck(result == true, "Verify result value is true; got: %d", result);
+
+    return TEST_COMPLETED;
+}
+
 /**
  * Tests writing from file.
  *
@@ -686,10 +827,18 @@ static const SDLTest_TestCaseReference iostrmTest9 = {
     iostrm_testCompareRWFromMemWithRWFromFile, "iostrm_testCompareRWFromMemWithRWFromFile", "Compare RWFromMem and RWFromFile IOStream for read and seek", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference iostrmTest10 = {
+    iostrm_testBuffered, "iostrm_testBuffered", "Tests buffering another stream", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference iostrmTest11 = {
+    iostrm_testMapFile, "iostrm_testMapFile", "Tests mapping files into memory", TEST_ENABLED
+};
+
 /* Sequence of IOStream test cases */
 static const SDLTest_TestCaseReference *iostrmTests[] = {
     &iostrmTest1, &iostrmTest2, &iostrmTest3, &iostrmTest4, &iostrmTest5, &iostrmTest6,
-    &iostrmTest7, &iostrmTest8, &iostrmTest9, NULL
+    &iostrmTest7, &iostrmTest8, &iostrmTest9, &iostrmTest10, &iostrmTest11, NULL
 };
 
 /* IOStream test suite (global) */
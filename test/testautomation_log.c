@@ -188,6 +188,81 @@ static int SDLCALL log_testHint(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Check SDL_HINT_LOG_ASYNC functionality
+ */
+typedef struct
+{
+    int count;
+    int out_of_order;
+    int long_messages;
+    int other_thread;
+    SDL_ThreadID thread;
+} AsyncLogState;
+
+static void SDLCALL TestAsyncLogOutput(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    AsyncLogState *state = (AsyncLogState *)userdata;
+
+    if (SDL_strlen(message) > 1000) {
+        ++state->long_messages;
+    } else if (SDL_atoi(message) != state->count) {
+        ++state->out_of_order;
+    }
+    if (SDL_GetCurrentThreadID() != state->thread) {
+        ++state->other_thread;
+    }
+    ++state->count;
+}
+
+static int SDLCALL log_testAsync(void *arg)
+{
+    AsyncLogState state;
+    char long_message[1025];
+    int i;
+
+    SDL_SetHint(SDL_HINT_LOGGING, NULL);
+    SDL_memset(long_message, 'x', sizeof(long_message) - 1);
+    long_message[sizeof(long_message) - 1] = '\0';
+
+    SDL_SetHint(SDL_HINT_LOG_ASYNC, "block");
+    SDLTest_AssertPass("SDL_SetHint(SDL_HINT_LOG_ASYNC, \"block\")");
+    {
+        SDL_zero(state);
+        state.thread = SDL_GetCurrentThreadID();
+        SDL_GetLogOutputFunction(&original_function, &original_userdata);
+        SDL_SetLogOutputFunction(TestAsyncLogOutput, &state);
+        for (i = 0; i < 2000; ++i) {
+            SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%d", i);
+        }
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "%s", long_message);
+        SDL_FlushLogs();
+        DisableTestLog();
+        SDLTest_AssertPass("SDL_FlushLogs()");
+        SDLTest_AssertCheck(state.count == 2001, "Check message count, expected: 2001, got: %d", state.count);
+        SDLTest_AssertCheck(state.out_of_order == 0, "Check messages out of order, expected: 0, got: %d", state.out_of_order);
+        SDLTest_AssertCheck(state.long_messages == 1, "Check long messages, expected: 1, got: %d", state.long_messages);
+        SDLTest_AssertCheck(state.other_thread == state.count, "Check messages written on another thread, expected: %d, got: %d", state.count, state.other_thread);
+    }
+
+    SDL_SetHint(SDL_HINT_LOG_ASYNC, "0");
+    SDLTest_AssertPass("SDL_SetHint(SDL_HINT_LOG_ASYNC, \"0\")");
+    {
+        SDL_zero(state);
+        state.thread = SDL_GetCurrentThreadID();
+        SDL_GetLogOutputFunction(&original_function, &original_userdata);
+        SDL_SetLogOutputFunction(TestAsyncLogOutput, &state);
+        SDL_LogInfo(SDL_LOG_CATEGORY_APPLICATION, "0");
+        DisableTestLog();
+        SDLTest_AssertCheck(state.count == 1, "Check message count, expected: 1, got: %d", state.count);
+        SDLTest_AssertCheck(state.other_thread == 0, "Check messages written on another thread, expected: 0, got: %d", state.other_thread);
+    }
+
+    SDL_SetHint(SDL_HINT_LOG_ASYNC, NULL);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Log test cases */
@@ -195,9 +270,13 @@ static const SDLTest_TestCaseReference logTestHint = {
     log_testHint, "log_testHint", "Check SDL_HINT_LOGGING functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference logTestAsync = {
+    log_testAsync, "log_testAsync", "Check SDL_HINT_LOG_ASYNC functionality", TEST_ENABLED
+};
+
 /* Sequence of Log test cases */
 static const SDLTest_TestCaseReference *logTests[] = {
-    &logTestHint, NULL
+    &logTestHint, &logTestAsync, NULL
 };
 
 /* Timer test suite (global) */
@@ -382,6 +382,94 @@ static int SDLCALL properties_testLocking(void *arg)
     return TEST_COMPLETED;
 }
 
+/**
+ * Test property atoms
+ */
+static int SDLCALL properties_testAtoms(void *arg)
+{
+    SDL_PropertiesID props;
+    SDL_PropertyAtom atom, other;
+    char key[8];
+    int i, count;
+    const char *value_string;
+    Sint64 value_number;
+
+    SDLTest_AssertPass("Call to SDL_GetPropertyAtom()");
+    atom = SDL_GetPropertyAtom("atom.test");
+    SDLTest_AssertCheck(atom != 0,
+        "Verify atom is nonzero, got: %" SDL_PRIu32, atom);
+    other = SDL_GetPropertyAtom("atom.test");
+    SDLTest_AssertCheck(atom == other,
+        "Verify the same name gives the same atom, got: %" SDL_PRIu32 ", expected: %" SDL_PRIu32, other, atom);
+    other = SDL_GetPropertyAtom("atom.other");
+    SDLTest_AssertCheck(other != 0 && other != atom,
+        "Verify a different name gives a different atom, got: %" SDL_PRIu32, other);
+    SDLTest_AssertCheck(SDL_GetPropertyAtom(NULL) == 0,
+        "Verify NULL name gives atom 0");
+    SDLTest_AssertCheck(SDL_GetPropertyAtom("") == 0,
+        "Verify empty name gives atom 0");
+
+    props = SDL_CreateProperties();
+
+    SDLTest_AssertPass("Call to SDL_Get*PropertyByAtom()");
+    value_number = SDL_GetNumberPropertyByAtom(props, atom, 1234);
+    SDLTest_AssertCheck(value_number == 1234,
+        "Verify property default, got: %" SDL_PRIs64 ", expected: 1234", value_number);
+    SDL_SetNumberProperty(props, "atom.test", 1);
+    value_number = SDL_GetNumberPropertyByAtom(props, atom, 1234);
+    SDLTest_AssertCheck(value_number == 1,
+        "Verify property value, got: %" SDL_PRIs64 ", expected: 1", value_number);
+    value_string = SDL_GetStringPropertyByAtom(props, atom, NULL);
+    SDLTest_AssertCheck(value_string && SDL_strcmp(value_string, "1") == 0,
+        "Verify string conversion, got: %s, expected: 1", value_string ? value_string : "NULL");
+    SDLTest_AssertCheck(SDL_GetBooleanPropertyByAtom(props, atom, false) == true,
+        "Verify boolean conversion");
+    SDLTest_AssertCheck(SDL_GetFloatPropertyByAtom(props, atom, 0.0f) == 1.0f,
+        "Verify float conversion");
+    SDLTest_AssertCheck(SDL_GetPointerPropertyByAtom(props, atom, NULL) == NULL,
+        "Verify pointer conversion");
+    value_number = SDL_GetNumberPropertyByAtom(props, other, 1234);
+    SDLTest_AssertCheck(value_number == 1234,
+        "Verify unset property default, got: %" SDL_PRIs64 ", expected: 1234", value_number);
+    SDL_ClearProperty(props, "atom.test");
+    value_number = SDL_GetNumberPropertyByAtom(props, atom, 1234);
+    SDLTest_AssertCheck(value_number == 1234,
+        "Verify cleared property default, got: %" SDL_PRIs64 ", expected: 1234", value_number);
+
+    SDLTest_AssertPass("Call to SDL_SetNumberProperty() with many properties");
+    for (i = 0; i < 100; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "%d", 99 - i);
+        SDL_SetNumberProperty(props, key, 99 - i);
+    }
+    count = 0;
+    for (i = 0; i < 100; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "%d", i);
+        if (SDL_GetNumberProperty(props, key, -1) == i &&
+            SDL_GetNumberPropertyByAtom(props, SDL_GetPropertyAtom(key), -1) == i) {
+            ++count;
+        }
+    }
+    SDLTest_AssertCheck(count == 100,
+        "Verify all properties are found, got %d, expected 100", count);
+    for (i = 0; i < 100; i += 2) {
+        SDL_snprintf(key, SDL_arraysize(key), "%d", i);
+        SDL_ClearProperty(props, key);
+    }
+    count = 0;
+    for (i = 0; i < 100; ++i) {
+        SDL_snprintf(key, SDL_arraysize(key), "%d", i);
+        if (SDL_GetNumberProperty(props, key, -1) == ((i % 2) ? i : -1)) {
+            ++count;
+        }
+    }
+    SDLTest_AssertCheck(count == 100,
+        "Verify the remaining properties after clearing, got %d, expected 100", count);
+
+    SDL_DestroyProperties(props);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Properties test cases */
@@ -401,12 +489,17 @@ static const SDLTest_TestCaseReference propertiesTestLocking = {
     properties_testLocking, "properties_testLocking", "Test property locking functionality", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference propertiesTestAtoms = {
+    properties_testAtoms, "properties_testAtoms", "Test property atom functionality", TEST_ENABLED
+};
+
 /* Sequence of Properties test cases */
 static const SDLTest_TestCaseReference *propertiesTests[] = {
     &propertiesTestBasic,
     &propertiesTestCopy,
     &propertiesTestCleanup,
     &propertiesTestLocking,
+    &propertiesTestAtoms,
     NULL
 };
 
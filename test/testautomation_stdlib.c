@@ -1238,6 +1238,81 @@ stdlib_iconv(void *arg)
 }
 
 
+static int SDLCALL
+stdlib_iconvLong(void *arg)
+{
+    /* ASCII runs of different lengths around characters of every UTF-8 length, so the conversions see blocks that are all, partly and not ASCII */
+    static const char *pieces[] = {
+        "a", "hello world", "0123456789abcdefghijklmnopqrstuvwxyz", "\xc3\xa9", "\xe6\x97\xa5", "\xf0\x9f\x8e\xae"
+    };
+    static const char *encodings[] = { "UTF-16LE", "UCS-4LE", "UTF-8" };
+    static const size_t units[] = { 2, 4, 1 };
+    const size_t max_len = 4096;
+    char *text;
+    size_t i, j;
+
+    text = (char *)SDL_malloc(max_len + 1);
+    SDLTest_AssertCheck(text != NULL, "Check malloc");
+    if (!text) {
+        return TEST_ABORTED;
+    }
+
+    for (i = 0; i < 20; ++i) {
+        size_t len = 0, expected_count = 0, count;
+        const char *p;
+
+        while (len < max_len - 4) {
+            const char *piece = pieces[SDLTest_RandomIntegerInRange(0, SDL_arraysize(pieces) - 1)];
+            const size_t piece_len = SDL_strlen(piece);
+            if (len + piece_len > max_len - 4) {
+                break;
+            }
+            SDL_memcpy(text + len, piece, piece_len);
+            len += piece_len;
+        }
+        if (i >= 10) {
+            /* Make the text invalid, the conversions will not take the fast path */
+            text[SDLTest_RandomIntegerInRange(0, (Sint32)len - 1)] = (char)0xFF;
+        }
+        text[len] = '\0';
+
+        p = text;
+        while (*p) {
+            SDL_StepUTF8(&p, NULL);
+            ++expected_count;
+        }
+        count = SDL_utf8strlen(text);
+        SDLTest_AssertCheck(count == expected_count, "Check SDL_utf8strlen() of %d bytes, expected %d, got %d", (int)len, (int)expected_count, (int)count);
+
+        if (i >= 10) {
+            continue;
+        }
+        for (j = 0; j < SDL_arraysize(encodings); ++j) {
+            char *converted = SDL_iconv_string(encodings[j], "UTF-8", text, len);
+            char *result = NULL;
+            size_t converted_len = 0;
+
+            SDLTest_AssertCheck(converted != NULL, "Check SDL_iconv_string(%s, UTF-8) of %d bytes", encodings[j], (int)len);
+            if (!converted) {
+                continue;
+            }
+            /* The converted text is terminated by a zero code unit */
+            while (SDL_memcmp(converted + converted_len, "\0\0\0\0", units[j]) != 0) {
+                converted_len += units[j];
+            }
+            result = SDL_iconv_string("UTF-8", encodings[j], converted, converted_len);
+            SDLTest_AssertCheck(result && SDL_strcmp(result, text) == 0, "Check SDL_iconv_string(UTF-8, %s) gives back the original text", encodings[j]);
+            SDL_free(converted);
+            SDL_free(result);
+        }
+    }
+
+    SDL_free(text);
+
+    return TEST_COMPLETED;
+}
+
+
 static int SDLCALL
 stdlib_strpbrk(void *arg)
 {
@@ -1433,6 +1508,144 @@ static int SDLCALL stdlib_strtod(void *arg)
     return TEST_COMPLETED;
 }
 
+static Uint32 reference_crc32(Uint32 crc, const Uint8 *data, size_t len)
+{
+    /* Bitwise version of the original algorithm, which every fast path must match */
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; ++i) {
+        Uint32 r = (Uint8)crc ^ data[i];
+        for (bit = 0; bit < 8; ++bit) {
+            r = (r & 1 ? 0 : (Uint32)0xEDB88320L) ^ r >> 1;
+        }
+        crc = (r ^ (Uint32)0xFF000000L) ^ crc >> 8;
+    }
+    return crc;
+}
+
+static int SDLCALL stdlib_crc32(void *arg)
+{
+    static const size_t lengths[] = { 0, 1, 7, 8, 15, 16, 63, 64, 65, 255, 256, 257, 1000, 4096, 65536 + 13 };
+    const size_t max_len = 65536 + 13 + 16;
+    Uint8 *buffer;
+    Uint32 expected, actual;
+    size_t i, offset;
+
+    actual = SDL_crc32(0, "123456789", 9);
+    SDLTest_AssertCheck(actual == 0xCBF43926, "Check SDL_crc32(\"123456789\"), expected 0xCBF43926, got 0x%08" SDL_PRIx32, actual);
+
+    buffer = (Uint8 *)SDL_malloc(max_len);
+    SDLTest_AssertCheck(buffer != NULL, "Check malloc");
+    if (!buffer) {
+        return TEST_ABORTED;
+    }
+    for (i = 0; i < max_len; ++i) {
+        buffer[i] = (Uint8)SDLTest_RandomIntegerInRange(0, 255);
+    }
+
+    for (i = 0; i < SDL_arraysize(lengths); ++i) {
+        for (offset = 0; offset < 16; offset += 5) {
+            const Uint32 seed = (Uint32)(i * 0x01010101);
+            const size_t len = lengths[i];
+            const size_t split = len / 3;
+
+            expected = reference_crc32(seed, buffer + offset, len);
+            actual = SDL_crc32(seed, buffer + offset, len);
+            SDLTest_AssertCheck(actual == expected, "Check SDL_crc32() of %d bytes at offset %d, expected 0x%08" SDL_PRIx32 ", got 0x%08" SDL_PRIx32, (int)len, (int)offset, expected, actual);
+
+            /* Checksumming in pieces must give the same result */
+            actual = SDL_crc32(SDL_crc32(seed, buffer + offset, split), buffer + offset + split, len - split);
+            SDLTest_AssertCheck(actual == expected, "Check SDL_crc32() of %d bytes in two pieces, expected 0x%08" SDL_PRIx32 ", got 0x%08" SDL_PRIx32, (int)len, expected, actual);
+        }
+    }
+
+    SDL_free(buffer);
+
+    return TEST_COMPLETED;
+}
+
+static int SDLCALL stdlib_randomStream(void *arg)
+{
+    /* Philox4x32-10 known answer, from the Random123 test vectors */
+    static const Uint32 known[4] = { 0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8 };
+    static const int pieces[] = { 1, 3, 7, 2, 16, 33, 5, 64, 4, 300 };
+    const int count = 1000;
+    SDL_RandomStream stream;
+    Uint32 *expected, *actual;
+    float *floats;
+    Sint32 *ints;
+    int i, pos;
+    bool result;
+
+    stream.seed = 0;
+    stream.position = 0;
+    expected = (Uint32 *)SDL_malloc(count * sizeof(Uint32));
+    actual = (Uint32 *)SDL_malloc(count * sizeof(Uint32));
+    floats = (float *)SDL_malloc(count * sizeof(float));
+    ints = (Sint32 *)SDL_malloc(count * sizeof(Sint32));
+    SDLTest_AssertCheck(expected && actual && floats && ints, "Check malloc");
+    if (!expected || !actual || !floats || !ints) {
+        return TEST_ABORTED;
+    }
+
+    result = SDL_RandFillBits(&stream, actual, 4);
+    SDLTest_AssertCheck(result, "Check SDL_RandFillBits() succeeded");
+    SDLTest_AssertCheck(SDL_memcmp(actual, known, sizeof(known)) == 0,
+                        "Check first block, expected %08" SDL_PRIx32 " %08" SDL_PRIx32 " %08" SDL_PRIx32 " %08" SDL_PRIx32 ", got %08" SDL_PRIx32 " %08" SDL_PRIx32 " %08" SDL_PRIx32 " %08" SDL_PRIx32,
+                        known[0], known[1], known[2], known[3], actual[0], actual[1], actual[2], actual[3]);
+    SDLTest_AssertCheck(stream.position == 4, "Check position, expected 4, got %" SDL_PRIu64, stream.position);
+
+    /* The stream must be the same however it's split up */
+    SDL_InitRandomStream(&stream, 0x0123456789abcdefULL);
+    SDL_RandFillBits(&stream, expected, count);
+    SDL_InitRandomStream(&stream, 0x0123456789abcdefULL);
+    for (i = 0, pos = 0; pos < count; ++i) {
+        const int n = SDL_min(pieces[i % SDL_arraysize(pieces)], count - pos);
+        SDL_RandFillBits(&stream, actual + pos, n);
+        pos += n;
+    }
+    SDLTest_AssertCheck(SDL_memcmp(actual, expected, count * sizeof(Uint32)) == 0, "Check values generated in pieces match values generated at once");
+
+    /* Seeking is setting the position */
+    stream.position = 123;
+    SDL_RandFillBits(&stream, actual, 10);
+    SDLTest_AssertCheck(SDL_memcmp(actual, expected + 123, 10 * sizeof(Uint32)) == 0, "Check values after seeking to position 123");
+
+    /* Floats and ints come from the same values, converted like SDL_randf_r() and SDL_rand_r() */
+    stream.position = 1;
+    result = SDL_RandFillFloats(&stream, floats, count - 1);
+    SDLTest_AssertCheck(result, "Check SDL_RandFillFloats() succeeded");
+    stream.position = 1;
+    result = SDL_RandFillInts(&stream, ints, count - 1, 6);
+    SDLTest_AssertCheck(result, "Check SDL_RandFillInts() succeeded");
+    for (i = 0; i < count - 1; ++i) {
+        const float f = (expected[i + 1] >> 8) * 0x1p-24f;
+        const Sint32 v = (Sint32)(((Uint64)expected[i + 1] * 6) >> 32);
+        if (floats[i] != f || floats[i] < 0.0f || floats[i] >= 1.0f) {
+            SDLTest_AssertCheck(false, "Check float %d, expected %f, got %f", i, f, floats[i]);
+            break;
+        }
+        if (ints[i] != v || ints[i] < 0 || ints[i] >= 6) {
+            SDLTest_AssertCheck(false, "Check int %d, expected %d, got %d", i, (int)v, (int)ints[i]);
+            break;
+        }
+    }
+    SDLTest_AssertCheck(i == count - 1, "Check converted values");
+
+    result = SDL_RandFillInts(&stream, ints, 1, 0);
+    SDLTest_AssertCheck(!result, "Check SDL_RandFillInts() with n of 0 fails");
+    result = SDL_RandFillBits(NULL, actual, 1);
+    SDLTest_AssertCheck(!result, "Check SDL_RandFillBits() with NULL stream fails");
+
+    SDL_free(expected);
+    SDL_free(actual);
+    SDL_free(floats);
+    SDL_free(ints);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Standard C routine test cases */
@@ -1476,6 +1689,10 @@ static const SDLTest_TestCaseReference stdlibTest_iconv = {
     stdlib_iconv, "stdlib_iconv", "Calls to SDL_iconv", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference stdlibTest_iconvLong = {
+    stdlib_iconvLong, "stdlib_iconvLong", "Calls to SDL_iconv_string and SDL_utf8strlen with long mixed text", TEST_ENABLED
+};
+
 static const SDLTest_TestCaseReference stdlibTest_strpbrk = {
     stdlib_strpbrk, "stdlib_strpbrk", "Calls to SDL_strpbrk", TEST_ENABLED
 };
@@ -1492,6 +1709,14 @@ static const SDLTest_TestCaseReference stdlibTest_strtod = {
     stdlib_strtod, "stdlib_strtod", "Calls to SDL_strtod", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference stdlibTest_crc32 = {
+    stdlib_crc32, "stdlib_crc32", "Calls to SDL_crc32", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference stdlibTest_randomStream = {
+    stdlib_randomStream, "stdlib_randomStream", "Calls to SDL_RandFillBits, SDL_RandFillFloats and SDL_RandFillInts", TEST_ENABLED
+};
+
 /* Sequence of Standard C routine test cases */
 static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest_strnlen,
@@ -1504,10 +1729,13 @@ static const SDLTest_TestCaseReference *stdlibTests[] = {
     &stdlibTest_aligned_alloc,
     &stdlibTestOverflow,
     &stdlibTest_iconv,
+    &stdlibTest_iconvLong,
     &stdlibTest_strpbrk,
     &stdlibTest_wcstol,
     &stdlibTest_strtox,
     &stdlibTest_strtod,
+    &stdlibTest_crc32,
+    &stdlibTest_randomStream,
     NULL
 };
 
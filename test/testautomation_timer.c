@@ -174,6 +174,102 @@ static int SDLCALL timer_addRemoveTimer(void *arg)
 #endif
 }
 
+#ifndef SDL_PLATFORM_EMSCRIPTEN
+
+/* Periodic test callback */
+static Uint64 SDLCALL timerPeriodicCallback(void *param, SDL_TimerID timerID, Uint64 interval)
+{
+    SDL_AddAtomicInt((SDL_AtomicInt *)param, 1);
+    return interval;
+}
+
+#endif
+
+/**
+ * Call to SDL_GetTimerStats
+ */
+static int SDLCALL timer_getTimerStats(void *arg)
+{
+#ifdef SDL_PLATFORM_EMSCRIPTEN
+    SDLTest_Log("Timer callbacks on Emscripten require a main loop to handle events");
+    return TEST_SKIPPED;
+#else
+    SDL_AtomicInt calls;
+    SDL_TimerStats stats;
+    SDL_TimerID id;
+    bool result;
+
+    SDL_SetAtomicInt(&calls, 0);
+
+    id = SDL_AddTimerNS(SDL_MS_TO_NS(5), timerPeriodicCallback, &calls);
+    SDLTest_AssertPass("Call to SDL_AddTimerNS(5 ms, ...)");
+    SDLTest_AssertCheck(id > 0, "Check result value, expected: >0, got: %" SDL_PRIu32, id);
+
+    SDL_Delay(100);
+    SDLTest_AssertPass("Call to SDL_Delay(100)");
+
+    result = SDL_GetTimerStats(id, &stats);
+    SDLTest_AssertPass("Call to SDL_GetTimerStats()");
+    SDLTest_AssertCheck(result == true, "Check result value, expected: true, got: %i", result);
+    SDLTest_AssertCheck(stats.num_calls > 0, "Check num_calls, expected: >0, got: %" SDL_PRIu64, stats.num_calls);
+    SDLTest_AssertCheck(stats.num_calls <= (Uint64)SDL_GetAtomicInt(&calls), "Check num_calls, expected: <=%d, got: %" SDL_PRIu64, SDL_GetAtomicInt(&calls), stats.num_calls);
+    SDLTest_AssertCheck(stats.max_lateness >= stats.last_lateness, "Check max_lateness >= last_lateness, got: %" SDL_PRIu64 " and %" SDL_PRIu64, stats.max_lateness, stats.last_lateness);
+    SDLTest_AssertCheck(stats.total_lateness >= stats.max_lateness, "Check total_lateness >= max_lateness, got: %" SDL_PRIu64 " and %" SDL_PRIu64, stats.total_lateness, stats.max_lateness);
+
+    result = SDL_RemoveTimer(id);
+    SDLTest_AssertPass("Call to SDL_RemoveTimer()");
+    SDLTest_AssertCheck(result == true, "Check result value, expected: true, got: %i", result);
+
+    /* Statistics aren't available after the timer is removed */
+    result = SDL_GetTimerStats(id, &stats);
+    SDLTest_AssertPass("Call to SDL_GetTimerStats() after SDL_RemoveTimer()");
+    SDLTest_AssertCheck(result == false, "Check result value, expected: false, got: %i", result);
+
+    return TEST_COMPLETED;
+#endif
+}
+
+/**
+ * Call to SDL_DelayPrecise and SDL_GetDelayStats
+ */
+static int SDLCALL timer_delayPreciseStats(void *arg)
+{
+    const Uint64 testDelay = SDL_MS_TO_NS(5);
+    SDL_DelayStats stats;
+    Uint64 start, elapsed, count;
+    bool result;
+    int i;
+
+    SDL_ResetDelayStats();
+    SDLTest_AssertPass("Call to SDL_ResetDelayStats()");
+
+    for (i = 0; i < 10; ++i) {
+        start = SDL_GetTicksNS();
+        SDL_DelayPrecise(testDelay);
+        elapsed = SDL_GetTicksNS() - start;
+        SDLTest_AssertCheck(elapsed >= testDelay, "Check delay, expected: >=%" SDL_PRIu64 ", got: %" SDL_PRIu64, testDelay, elapsed);
+    }
+
+    result = SDL_GetDelayStats(&stats);
+    SDLTest_AssertPass("Call to SDL_GetDelayStats()");
+    SDLTest_AssertCheck(result == true, "Check result value, expected: true, got: %i", result);
+    SDLTest_AssertCheck(stats.num_delays == 10, "Check num_delays, expected: 10, got: %" SDL_PRIu64, stats.num_delays);
+    for (i = 0, count = 0; i < SDL_DELAY_STATS_BUCKETS; ++i) {
+        count += stats.histogram[i];
+    }
+    SDLTest_AssertCheck(count == stats.num_delays, "Check histogram total, expected: %" SDL_PRIu64 ", got: %" SDL_PRIu64, stats.num_delays, count);
+    SDLTest_AssertCheck(stats.total_error >= stats.max_error, "Check total_error >= max_error, got: %" SDL_PRIu64 " and %" SDL_PRIu64, stats.total_error, stats.max_error);
+
+    SDL_ResetDelayStats();
+    SDL_GetDelayStats(&stats);
+    SDLTest_AssertCheck(stats.num_delays == 0, "Check num_delays after reset, expected: 0, got: %" SDL_PRIu64, stats.num_delays);
+
+    result = SDL_GetDelayStats(NULL);
+    SDLTest_AssertCheck(result == false, "Check SDL_GetDelayStats(NULL), expected: false, got: %i", result);
+
+    return TEST_COMPLETED;
+}
+
 /* ================= Test References ================== */
 
 /* Timer test cases */
@@ -193,9 +289,17 @@ static const SDLTest_TestCaseReference timerTest4 = {
     timer_addRemoveTimer, "timer_addRemoveTimer", "Call to SDL_AddTimer and SDL_RemoveTimer", TEST_ENABLED
 };
 
+static const SDLTest_TestCaseReference timerTest5 = {
+    timer_getTimerStats, "timer_getTimerStats", "Call to SDL_GetTimerStats", TEST_ENABLED
+};
+
+static const SDLTest_TestCaseReference timerTest6 = {
+    timer_delayPreciseStats, "timer_delayPreciseStats", "Call to SDL_DelayPrecise and SDL_GetDelayStats", TEST_ENABLED
+};
+
 /* Sequence of Timer test cases */
 static const SDLTest_TestCaseReference *timerTests[] = {
-    &timerTest1, &timerTest2, &timerTest3, &timerTest4, NULL
+    &timerTest1, &timerTest2, &timerTest3, &timerTest4, &timerTest5, &timerTest6, NULL
 };
 
 /* Timer test suite (global) */
@@ -0,0 +1,309 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Counts how many reads reach a file when loading it with and without
+   SDL_IOFromBufferedIO(), and checks that both ways read the same data.
+
+   Each of these reads is a system call for streams that aren't buffered by
+   the C runtime, like the ones SDL creates from file descriptors. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static const char *bmp_filename = "testbufferedio.bmp";
+static const char *wav_filename = "testbufferedio.wav";
+
+typedef struct
+{
+    SDL_IOStream *src;
+    int reads;
+} CountingData;
+
+static Sint64 SDLCALL counting_size(void *userdata)
+{
+    CountingData *data = (CountingData *)userdata;
+    return SDL_GetIOSize(data->src);
+}
+
+static Sint64 SDLCALL counting_seek(void *userdata, Sint64 offset, SDL_IOWhence whence)
+{
+    CountingData *data = (CountingData *)userdata;
+    return SDL_SeekIO(data->src, offset, whence);
+}
+
+static size_t SDLCALL counting_read(void *userdata, void *ptr, size_t size, SDL_IOStatus *status)
+{
+    CountingData *data = (CountingData *)userdata;
+    size_t bytes;
+
+    ++data->reads;
+    bytes = SDL_ReadIO(data->src, ptr, size);
+    if (bytes == 0 && SDL_GetIOStatus(data->src) == SDL_IO_STATUS_NOT_READY) {
+        *status = SDL_IO_STATUS_NOT_READY;
+    }
+    return bytes;
+}
+
+static bool SDLCALL counting_close(void *userdata)
+{
+    CountingData *data = (CountingData *)userdata;
+    return SDL_CloseIO(data->src);
+}
+
+/* Opens a file and counts the reads made on it into data->reads */
+static SDL_IOStream *open_counting(const char *file, CountingData *data, bool buffered)
+{
+    SDL_IOStreamInterface iface;
+    SDL_IOStream *stream;
+
+    data->reads = 0;
+    data->src = SDL_IOFromFile(file, "rb");
+    if (!data->src) {
+        return NULL;
+    }
+
+    SDL_INIT_INTERFACE(&iface);
+    iface.size = counting_size;
+    iface.seek = counting_seek;
+    iface.read = counting_read;
+    iface.close = counting_close;
+    stream = SDL_OpenIO(&iface, data);
+    if (!stream) {
+        SDL_CloseIO(data->src);
+        return NULL;
+    }
+    if (buffered) {
+        stream = SDL_IOFromBufferedIO(stream, 0, true);
+    }
+    return stream;
+}
+
+static void report(const char *name, const CountingData *data, Uint64 elapsed)
+{
+    SDL_Log("%-28s %8d reads %10.3f ms", name, data->reads, (double)elapsed / SDL_NS_PER_MS);
+}
+
+static bool create_files(int width, int height)
+{
+    SDL_Surface *surface;
+    SDL_IOStream *wav;
+    Uint32 i, samples;
+    bool result;
+
+    /* A BMP file with random pixels */
+    surface = SDL_CreateSurface(width, height, SDL_PIXELFORMAT_RGB24);
+    if (!surface) {
+        return false;
+    }
+    for (i = 0; i < (Uint32)(surface->h * surface->pitch); ++i) {
+        ((Uint8 *)surface->pixels)[i] = (Uint8)SDL_rand(256);
+    }
+    result = SDL_SaveBMP(surface, bmp_filename);
+    SDL_DestroySurface(surface);
+    if (!result) {
+        return false;
+    }
+
+    /* A mono 16-bit WAV file with a second of audio */
+    samples = 44100;
+    wav = SDL_IOFromFile(wav_filename, "wb");
+    if (!wav) {
+        return false;
+    }
+    result = SDL_WriteU32BE(wav, 0x52494646) && /* RIFF */
+             SDL_WriteU32LE(wav, 36 + samples * 2) &&
+             SDL_WriteU32BE(wav, 0x57415645) && /* WAVE */
+             SDL_WriteU32BE(wav, 0x666d7420) && /* fmt  */
+             SDL_WriteU32LE(wav, 16) &&
+             SDL_WriteU16LE(wav, 1) &&
+             SDL_WriteU16LE(wav, 1) &&
+             SDL_WriteU32LE(wav, 44100) &&
+             SDL_WriteU32LE(wav, 44100 * 2) &&
+             SDL_WriteU16LE(wav, 2) &&
+             SDL_WriteU16LE(wav, 16) &&
+             SDL_WriteU32BE(wav, 0x64617461) && /* data */
+             SDL_WriteU32LE(wav, samples * 2);
+    for (i = 0; result && i < samples; ++i) {
+        result = SDL_WriteS16LE(wav, (Sint16)(i * 31));
+    }
+    if (!SDL_CloseIO(wav)) {
+        result = false;
+    }
+    return result;
+}
+
+/* Reads a file the way file format loaders read headers, one field at a time */
+static bool read_fields(bool buffered, Uint32 *checksum)
+{
+    CountingData data;
+    SDL_IOStream *stream;
+    Uint64 start;
+    Uint32 value;
+
+    stream = open_counting(bmp_filename, &data, buffered);
+    if (!stream) {
+        return false;
+    }
+
+    *checksum = 0;
+    start = SDL_GetTicksNS();
+    while (SDL_ReadU32LE(stream, &value)) {
+        *checksum = *checksum * 31 + value;
+    }
+    report(buffered ? "SDL_ReadU32LE, buffered" : "SDL_ReadU32LE", &data, SDL_GetTicksNS() - start);
+
+    SDL_CloseIO(stream);
+    return true;
+}
+
+static bool load_bmp(bool buffered, Uint32 *checksum)
+{
+    CountingData data;
+    SDL_IOStream *stream;
+    SDL_Surface *surface;
+    Uint64 start;
+    int y;
+
+    stream = open_counting(bmp_filename, &data, buffered);
+    if (!stream) {
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    surface = SDL_LoadBMP_IO(stream, true);
+    report(buffered ? "SDL_LoadBMP_IO, buffered" : "SDL_LoadBMP_IO", &data, SDL_GetTicksNS() - start);
+    if (!surface) {
+        return false;
+    }
+
+    *checksum = 0;
+    for (y = 0; y < surface->h; ++y) {
+        const Uint8 *row = (const Uint8 *)surface->pixels + y * surface->pitch;
+        int x;
+
+        for (x = 0; x < surface->w * 3; ++x) {
+            *checksum = *checksum * 31 + row[x];
+        }
+    }
+    SDL_DestroySurface(surface);
+    return true;
+}
+
+static bool load_wav(bool buffered, Uint32 *checksum)
+{
+    CountingData data;
+    SDL_IOStream *stream;
+    SDL_AudioSpec spec;
+    Uint8 *audio_buf;
+    Uint32 audio_len, i;
+    Uint64 start;
+    bool result;
+
+    stream = open_counting(wav_filename, &data, buffered);
+    if (!stream) {
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    result = SDL_LoadWAV_IO(stream, true, &spec, &audio_buf, &audio_len);
+    report(buffered ? "SDL_LoadWAV_IO, buffered" : "SDL_LoadWAV_IO", &data, SDL_GetTicksNS() - start);
+    if (!result) {
+        return false;
+    }
+
+    *checksum = audio_len;
+    for (i = 0; i < audio_len; ++i) {
+        *checksum = *checksum * 31 + audio_buf[i];
+    }
+    SDL_free(audio_buf);
+    return true;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int width = 1001;
+    int height = 1000;
+    Uint32 checksums[2];
+    bool ok = true;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--width") == 0 && argv[i + 1]) {
+                width = SDL_atoi(argv[i + 1]);
+                consumed = (width > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--height") == 0 && argv[i + 1]) {
+                height = SDL_atoi(argv[i + 1]);
+                consumed = (height > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--width N]", "[--height N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!create_files(width, height)) {
+        SDL_Log("Couldn't create test files: %s", SDL_GetError());
+        ok = false;
+        goto done;
+    }
+
+    SDL_Log("%dx%d 24-bit BMP file", width, height);
+    if (!read_fields(false, &checksums[0]) || !read_fields(true, &checksums[1])) {
+        SDL_Log("Couldn't read %s: %s", bmp_filename, SDL_GetError());
+        ok = false;
+    } else if (checksums[0] != checksums[1]) {
+        SDL_Log("Buffered reads returned different data");
+        ok = false;
+    }
+
+    /* SDL_LoadBMP_IO() buffers its input itself, so buffering again shouldn't change much */
+    if (!load_bmp(false, &checksums[0]) || !load_bmp(true, &checksums[1])) {
+        SDL_Log("Couldn't load %s: %s", bmp_filename, SDL_GetError());
+        ok = false;
+    } else if (checksums[0] != checksums[1]) {
+        SDL_Log("Buffered BMP load returned different pixels");
+        ok = false;
+    }
+
+    if (!load_wav(false, &checksums[0]) || !load_wav(true, &checksums[1])) {
+        SDL_Log("Couldn't load %s: %s", wav_filename, SDL_GetError());
+        ok = false;
+    } else if (checksums[0] != checksums[1]) {
+        SDL_Log("Buffered WAV load returned different audio");
+        ok = false;
+    }
+
+done:
+    SDL_RemovePath(bmp_filename);
+    SDL_RemovePath(wav_filename);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,134 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Throughput benchmark for SDL_crc32, from 64 bytes up to 64 megabytes.
+
+   Each size is also checked against the original byte-at-a-time algorithm,
+   and timed against it. Run with SDL_CPU_FEATURE_MASK=-pclmul,-pmull to
+   time the table-driven fallback instead of the carry-less multiply path. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static Uint32 bytewise_crc32(Uint32 crc, const void *data, size_t len)
+{
+    const Uint8 *bytes = (const Uint8 *)data;
+    size_t i;
+    int bit;
+
+    for (i = 0; i < len; ++i) {
+        Uint32 r = (Uint8)crc ^ bytes[i];
+        for (bit = 0; bit < 8; ++bit) {
+            r = (r & 1 ? 0 : (Uint32)0xEDB88320L) ^ r >> 1;
+        }
+        crc = (r ^ (Uint32)0xFF000000L) ^ crc >> 8;
+    }
+    return crc;
+}
+
+/* Returns megabytes per second */
+static double time_crc32(Uint32 (*crc32)(Uint32, const void *, size_t), const Uint8 *data, size_t len, Uint64 total, Uint32 *result)
+{
+    const Uint64 iterations = SDL_max(total / len, 1);
+    Uint64 start, elapsed, i;
+    Uint32 crc = 0;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < iterations; ++i) {
+        crc = crc32(0, data, len);
+    }
+    elapsed = SDL_GetPerformanceCounter() - start;
+    *result = crc;
+
+    if (elapsed == 0) {
+        elapsed = 1;
+    }
+    return ((double)(iterations * len) / (1024.0 * 1024.0)) / ((double)elapsed / (double)SDL_GetPerformanceFrequency());
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    size_t max_size = 64 * 1024 * 1024;
+    Uint64 total = 256 * 1024 * 1024;
+    bool reference = true;
+    bool result = true;
+    Uint8 *data;
+    size_t size;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--max") == 0 && argv[i + 1]) {
+                max_size = (size_t)SDL_strtoull(argv[i + 1], NULL, 0);
+                consumed = (max_size >= 64) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--total") == 0 && argv[i + 1]) {
+                total = SDL_strtoull(argv[i + 1], NULL, 0);
+                consumed = (total > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--no-reference") == 0) {
+                reference = false;
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--max BYTES]", "[--total BYTES]", "[--no-reference]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    data = (Uint8 *)SDL_malloc(max_size);
+    if (!data) {
+        SDL_Log("Couldn't allocate %u bytes", (unsigned int)max_size);
+        return 1;
+    }
+    for (size = 0; size < max_size; ++size) {
+        data[size] = (Uint8)(size * 2654435761u >> 13);
+    }
+
+    SDL_Log("%10s %12s %12s", "size", "SDL_crc32", "bytewise");
+    for (size = 64; size <= max_size; size *= 4) {
+        Uint32 crc = 0, expected = 0;
+        const double fast = time_crc32(SDL_crc32, data, size, total, &crc);
+
+        if (reference) {
+            /* the reference is slow, so don't spend as long on it */
+            const double slow = time_crc32(bytewise_crc32, data, size, total / 16, &expected);
+            SDL_Log("%10u %9.1f MB/s %9.1f MB/s%s", (unsigned int)size, fast, slow, (crc == expected) ? "" : "  (WRONG RESULT)");
+            if (crc != expected) {
+                result = false;
+            }
+        } else {
+            SDL_Log("%10u %9.1f MB/s", (unsigned int)size, fast);
+        }
+    }
+
+    SDL_free(data);
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return result ? 0 : 1;
+}
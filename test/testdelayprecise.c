@@ -0,0 +1,123 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how precise SDL_DelayPrecise() is when pacing frames.
+
+   For each frame rate, this waits for the next frame with SDL_DelayPrecise()
+   after a random amount of simulated work, and reports the wake error
+   histogram from SDL_GetDelayStats() along with the fraction of the time
+   that was spent busy waiting rather than sleeping. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static void run_frames(int fps, int frames, Uint64 *seed)
+{
+    const Uint64 frame_ns = SDL_NS_PER_SECOND / fps;
+    SDL_DelayStats stats;
+    Uint64 next = SDL_GetTicksNS() + frame_ns;
+    Uint64 limit;
+    int i;
+
+    SDL_ResetDelayStats();
+
+    for (i = 0; i < frames; ++i) {
+        /* Simulate up to half a frame of work */
+        const Uint64 work = SDL_GetTicksNS() + (Uint64)SDL_rand_r(seed, (Sint32)(frame_ns / 2));
+        Uint64 now;
+        while ((now = SDL_GetTicksNS()) < work) {
+            SDL_CPUPauseInstruction();
+        }
+
+        if (now < next) {
+            SDL_DelayPrecise(next - now);
+        }
+        next += frame_ns;
+    }
+
+    SDL_GetDelayStats(&stats);
+    if (stats.num_delays == 0) {
+        return;
+    }
+
+    SDL_Log("%d FPS: %" SDL_PRIu64 " delays, wake error average %.2f us, maximum %.2f us",
+            fps, stats.num_delays, (double)stats.total_error / stats.num_delays / 1000.0, (double)stats.max_error / 1000.0);
+    SDL_Log("  %.1f%% of the waiting time was spent busy waiting",
+            100.0 * (double)stats.total_spin / (double)(stats.total_sleep + stats.total_spin));
+    for (i = 0, limit = 1; i < SDL_DELAY_STATS_BUCKETS; ++i, limit *= 2) {
+        if (stats.histogram[i]) {
+            if (i < SDL_DELAY_STATS_BUCKETS - 1) {
+                SDL_Log("  < %6" SDL_PRIu64 " us: %" SDL_PRIu64, limit, stats.histogram[i]);
+            } else {
+                SDL_Log("  >=%6" SDL_PRIu64 " us: %" SDL_PRIu64, limit / 2, stats.histogram[i]);
+            }
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static const int rates[] = { 60, 144, 240 };
+    SDLTest_CommonState *state;
+    Uint64 seed = 0xde1a7;
+    int seconds = 2;
+    int fps = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--seconds") == 0 && argv[i + 1]) {
+                seconds = SDL_atoi(argv[i + 1]);
+                consumed = (seconds > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--fps") == 0 && argv[i + 1]) {
+                fps = SDL_atoi(argv[i + 1]);
+                consumed = (fps > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--seconds N]", "[--fps N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    if (fps > 0) {
+        run_frames(fps, fps * seconds, &seed);
+    } else {
+        for (i = 0; i < (int)SDL_arraysize(rates); ++i) {
+            run_frames(rates[i], rates[i] * seconds, &seed);
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return 0;
+}
@@ -0,0 +1,171 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Counts the allocations made for events that carry temporary memory.
+
+   Text input, drop and clipboard events point to strings that SDL keeps
+   alive until the next time events are pumped. Each frame, this pushes a
+   number of clipboard updates, which is the way to generate such events
+   through the public API, then polls the queue empty. The number of calls
+   to the memory functions per frame and per event is reported, for a
+   frame spent pushing the same number of user events as a baseline. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static SDL_malloc_func real_malloc;
+static SDL_calloc_func real_calloc;
+static SDL_realloc_func real_realloc;
+static SDL_free_func real_free;
+static SDL_AtomicInt num_allocations;
+
+static void * SDLCALL counting_malloc(size_t size)
+{
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return real_malloc(size);
+}
+
+static void * SDLCALL counting_calloc(size_t nmemb, size_t size)
+{
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return real_calloc(nmemb, size);
+}
+
+static void * SDLCALL counting_realloc(void *mem, size_t size)
+{
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return real_realloc(mem, size);
+}
+
+static void SDLCALL counting_free(void *mem)
+{
+    real_free(mem);
+}
+
+static const void * SDLCALL clipboard_callback(void *userdata, const char *mime_type, size_t *size)
+{
+    static const char text[] = "\xe3\x81\x93\xe3\x82\x93\xe3\x81\xab\xe3\x81\xa1\xe3\x81\xaf";
+
+    *size = sizeof(text) - 1;
+    return text;
+}
+
+/* Returns the number of allocations made in one frame */
+static int run_frame(int count, bool clipboard, Uint32 user_event)
+{
+    static const char *mime_types[] = { "text/plain;charset=utf-8", "application/x-ime-composition" };
+    const int start = SDL_GetAtomicInt(&num_allocations);
+    SDL_Event event;
+    int i, received = 0;
+
+    for (i = 0; i < count; ++i) {
+        if (clipboard) {
+            SDL_SetClipboardData(clipboard_callback, NULL, NULL, mime_types, SDL_arraysize(mime_types));
+        } else {
+            SDL_zero(event);
+            event.type = user_event;
+            SDL_PushEvent(&event);
+        }
+    }
+    while (SDL_PollEvent(&event)) {
+        if (event.type == (clipboard ? (Uint32)SDL_EVENT_CLIPBOARD_UPDATE : user_event)) {
+            ++received;
+        }
+    }
+    if (received != count) {
+        SDL_Log("Received %d events, expected %d", received, count);
+    }
+    return SDL_GetAtomicInt(&num_allocations) - start;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_Window *window;
+    int frames = 100;
+    int count = 50;
+    Uint32 user_event;
+    int baseline = 0, total = 0;
+    Uint64 start, elapsed;
+    int i;
+
+    SDL_GetOriginalMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    SDL_SetMemoryFunctions(counting_malloc, counting_calloc, counting_realloc, counting_free);
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--frames") == 0 && argv[i + 1]) {
+                frames = SDL_atoi(argv[i + 1]);
+                consumed = (frames > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = (count > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--frames N]", "[--count N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(SDL_INIT_VIDEO)) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+    window = SDL_CreateWindow("testeventmemory", 320, 200, 0);
+    if (!window) {
+        SDL_Log("Couldn't create window: %s", SDL_GetError());
+        SDL_Quit();
+        return 1;
+    }
+    user_event = SDL_RegisterEvents(1);
+
+    /* Warm up, so the queue has all the entries it needs */
+    run_frame(count, false, user_event);
+    run_frame(count, true, user_event);
+
+    for (i = 0; i < frames; ++i) {
+        baseline += run_frame(count, false, user_event);
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < frames; ++i) {
+        total += run_frame(count, true, user_event);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_Log("%d frames of %d events", frames, count);
+    SDL_Log("user events:      %8.2f allocations per frame", (double)baseline / frames);
+    SDL_Log("clipboard events: %8.2f allocations per frame, %.2f per event, %.2f us per event",
+            (double)total / frames, (double)total / frames / count, (double)elapsed / 1000.0 / frames / count);
+
+    SDL_ClearClipboardData();
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return 0;
+}
@@ -0,0 +1,390 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Event queue throughput with 1 to N producer threads.
+
+   Producers push user events with SDL_PushEvent() while the main thread
+   drains the queue with SDL_PollEvent(). For comparison, the same run is
+   repeated adding events with SDL_PeepEvents(SDL_ADDEVENT), which always
+   takes the queue lock, and pushing batches of events with SDL_PushEvents().
+   The consumer also checks that every producer's events arrive complete
+   and in order.
+
+   Then the queue is filled with a mix of event types, and range queries
+   and flushes for a few of those types are timed.
+
+   Finally, a burst of mouse motion from an 8 kHz mouse is pushed with and
+   without SDL_HINT_EVENT_COALESCE_MOTION, to compare the queue length. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define BATCH_SIZE 128
+
+typedef enum
+{
+    PUSH_EVENT,
+    PEEP_EVENTS,
+    PUSH_EVENTS
+} PushMode;
+
+typedef struct
+{
+    int index;
+    int count;
+    PushMode mode;
+    Uint32 event_type;
+} Producer;
+
+static void push_batches(Producer *producer)
+{
+    SDL_Event batch[BATCH_SIZE];
+    int i, n, pushed;
+
+    for (i = 0; i < producer->count; i += n) {
+        n = SDL_min(BATCH_SIZE, producer->count - i);
+        for (pushed = 0; pushed < n; ++pushed) {
+            SDL_zero(batch[pushed]);
+            batch[pushed].type = producer->event_type;
+            batch[pushed].user.code = producer->index;
+            batch[pushed].user.data1 = (void *)(uintptr_t)(i + pushed);
+        }
+
+        pushed = 0;
+        while (pushed < n) {
+            const int result = SDL_PushEvents(&batch[pushed], n - pushed);
+            if (result > 0) {
+                pushed += result;
+            } else {
+                /* The queue is full, give the consumer a chance to catch up */
+                SDL_Delay(0);
+            }
+        }
+    }
+}
+
+static int SDLCALL producer_thread(void *data)
+{
+    Producer *producer = (Producer *)data;
+    SDL_Event event;
+    int i;
+
+    if (producer->mode == PUSH_EVENTS) {
+        push_batches(producer);
+        return 0;
+    }
+
+    SDL_zero(event);
+    event.type = producer->event_type;
+    event.user.code = producer->index;
+
+    for (i = 0; i < producer->count; ++i) {
+        event.user.data1 = (void *)(uintptr_t)i;
+        event.user.timestamp = 0;
+
+        for (;;) {
+            bool pushed;
+
+            if (producer->mode == PEEP_EVENTS) {
+                /* Do the same work SDL_PushEvent() would */
+                event.user.timestamp = SDL_GetTicksNS();
+                pushed = (SDL_PeepEvents(&event, 1, SDL_ADDEVENT, 0, 0) == 1);
+            } else {
+                pushed = SDL_PushEvent(&event);
+            }
+            if (pushed) {
+                break;
+            }
+            /* The queue is full, give the consumer a chance to catch up */
+            SDL_Delay(0);
+        }
+    }
+    return 0;
+}
+
+/* Returns millions of events per second, or a negative value on failure */
+static double run(int num_producers, int count, PushMode mode, Uint32 event_type)
+{
+    SDL_Thread **threads = (SDL_Thread **)SDL_calloc(num_producers, sizeof(*threads));
+    Producer *producers = (Producer *)SDL_calloc(num_producers, sizeof(*producers));
+    int *expected = (int *)SDL_calloc(num_producers, sizeof(*expected));
+    const Sint64 total = (Sint64)num_producers * count;
+    Sint64 received = 0;
+    Uint64 start, elapsed;
+    bool failed = false;
+    int i;
+
+    if (!threads || !producers || !expected) {
+        SDL_free(threads);
+        SDL_free(producers);
+        SDL_free(expected);
+        return -1.0;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_producers; ++i) {
+        producers[i].index = i;
+        producers[i].count = count;
+        producers[i].mode = mode;
+        producers[i].event_type = event_type;
+        threads[i] = SDL_CreateThread(producer_thread, "producer", &producers[i]);
+        if (!threads[i]) {
+            SDL_Log("Couldn't create thread: %s", SDL_GetError());
+            failed = true;
+            received += count;
+        }
+    }
+
+    while (received < total) {
+        SDL_Event event;
+
+        if (!SDL_PollEvent(&event)) {
+            continue;
+        }
+        if (event.type != event_type) {
+            continue;
+        }
+        if (event.user.code < 0 || event.user.code >= num_producers ||
+            (int)(uintptr_t)event.user.data1 != expected[event.user.code]) {
+            SDL_Log("Producer %d: got event %d, expected %d", (int)event.user.code,
+                    (int)(uintptr_t)event.user.data1, expected[event.user.code]);
+            failed = true;
+            break;
+        }
+        ++expected[event.user.code];
+        ++received;
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    for (i = 0; i < num_producers; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_FlushEvent(event_type);
+
+    SDL_free(threads);
+    SDL_free(producers);
+    SDL_free(expected);
+
+    if (failed) {
+        return -1.0;
+    }
+    return ((double)total / 1000000.0) / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND);
+}
+
+static const Uint32 mixed_types[] = {
+    SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION,
+    SDL_EVENT_KEY_DOWN, SDL_EVENT_KEY_UP, SDL_EVENT_GAMEPAD_AXIS_MOTION, SDL_EVENT_FINGER_MOTION
+};
+
+static bool fill_mixed(int count, Uint32 event_type)
+{
+    SDL_Event event;
+    int i;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    for (i = 0; i < count; ++i) {
+        SDL_zero(event);
+        /* One user event every 1000 events */
+        event.type = (i % 1000) ? mixed_types[i % SDL_arraysize(mixed_types)] : event_type;
+        if (SDL_PeepEvents(&event, 1, SDL_ADDEVENT, 0, 0) != 1) {
+            SDL_Log("Couldn't add event %d: %s", i, SDL_GetError());
+            return false;
+        }
+    }
+    return true;
+}
+
+/* Returns false if a query gave the wrong answer */
+static bool run_mixed(int count, Uint32 event_type)
+{
+    const int iterations = 1000;
+    const int expected = (count + 999) / 1000;
+    SDL_Event event;
+    Uint64 start;
+    int i, found = 0, remaining;
+
+    if (!fill_mixed(count, event_type)) {
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; ++i) {
+        found += SDL_HasEvent(event_type);
+    }
+    SDL_Log("%-40s %10.2f us", "SDL_HasEvent(user event)", (double)(SDL_GetTicksNS() - start) / iterations / 1000.0);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; ++i) {
+        found += !SDL_HasEvent(SDL_EVENT_DROP_FILE);
+    }
+    SDL_Log("%-40s %10.2f us", "SDL_HasEvent(not queued)", (double)(SDL_GetTicksNS() - start) / iterations / 1000.0);
+    if (found != 2 * iterations) {
+        SDL_Log("SDL_HasEvent() returned the wrong result");
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < iterations; ++i) {
+        found = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, event_type, event_type);
+    }
+    SDL_Log("%-40s %10.2f us", "SDL_PeepEvents(SDL_PEEKEVENT, user)", (double)(SDL_GetTicksNS() - start) / iterations / 1000.0);
+    if (found != expected) {
+        SDL_Log("Found %d user events, expected %d", found, expected);
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    found = 0;
+    while (SDL_PeepEvents(&event, 1, SDL_GETEVENT, event_type, event_type) == 1) {
+        ++found;
+    }
+    SDL_Log("%-40s %10.2f us", "SDL_PeepEvents(SDL_GETEVENT, user)", (double)(SDL_GetTicksNS() - start) / SDL_max(found, 1) / 1000.0);
+    if (found != expected) {
+        SDL_Log("Got %d user events, expected %d", found, expected);
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    SDL_FlushEvent(SDL_EVENT_GAMEPAD_AXIS_MOTION);
+    SDL_FlushEvents(SDL_EVENT_KEY_DOWN, SDL_EVENT_KEY_UP);
+    SDL_Log("%-40s %10.2f us", "SDL_FlushEvents(gamepad, keyboard)", (double)(SDL_GetTicksNS() - start) / 1000.0);
+
+    remaining = 0;
+    for (i = 0; i < count; ++i) {
+        const Uint32 type = mixed_types[i % SDL_arraysize(mixed_types)];
+        if ((i % 1000) && type != SDL_EVENT_GAMEPAD_AXIS_MOTION && type != SDL_EVENT_KEY_DOWN && type != SDL_EVENT_KEY_UP) {
+            ++remaining;
+        }
+    }
+    found = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    if (found != remaining) {
+        SDL_Log("%d events left after flushing, expected %d", found, remaining);
+        return false;
+    }
+    return true;
+}
+
+/* Returns the number of events queued after one frame of motion */
+static int run_motion(int count, bool coalesce)
+{
+    SDL_Event event;
+    Uint64 start;
+    int i, queued;
+
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    SDL_SetHint(SDL_HINT_EVENT_COALESCE_MOTION, coalesce ? "1" : "0");
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        SDL_zero(event);
+        event.type = SDL_EVENT_MOUSE_MOTION;
+        event.motion.which = 1;
+        event.motion.windowID = 1;
+        event.motion.x = (float)(i % 100);
+        event.motion.xrel = 1.0f;
+        SDL_PushEvent(&event);
+    }
+    queued = SDL_PeepEvents(NULL, 0, SDL_PEEKEVENT, SDL_EVENT_MOUSE_MOTION, SDL_EVENT_MOUSE_MOTION);
+    SDL_Log("%-40s %10.2f us, %d queued", coalesce ? "motion, coalesced" : "motion", (double)(SDL_GetTicksNS() - start) / 1000.0, queued);
+
+    SDL_ResetHint(SDL_HINT_EVENT_COALESCE_MOTION);
+    SDL_FlushEvents(SDL_EVENT_FIRST, SDL_EVENT_LAST);
+    return queued;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int max_producers = 8;
+    int count = 200000;
+    int mixed = 50000;
+    Uint32 event_type;
+    int result = 0;
+    int num_producers;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--producers") == 0 && argv[i + 1]) {
+                max_producers = SDL_atoi(argv[i + 1]);
+                consumed = (max_producers > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = (count > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--mixed") == 0 && argv[i + 1]) {
+                mixed = SDL_atoi(argv[i + 1]);
+                consumed = (mixed > 0 && mixed < 65535) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--producers N]", "[--count N]", "[--mixed N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (!SDL_Init(SDL_INIT_EVENTS)) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    event_type = SDL_RegisterEvents(1);
+
+    SDL_Log("%d events per producer", count);
+    SDL_Log("%10s %16s %16s %16s", "producers", "SDL_PushEvent", "SDL_PeepEvents", "SDL_PushEvents");
+    for (num_producers = 1; num_producers <= max_producers; num_producers *= 2) {
+        const double push = run(num_producers, count, PUSH_EVENT, event_type);
+        const double peep = run(num_producers, count, PEEP_EVENTS, event_type);
+        const double batch = run(num_producers, count, PUSH_EVENTS, event_type);
+
+        if (push < 0.0 || peep < 0.0 || batch < 0.0) {
+            result = 1;
+            break;
+        }
+        SDL_Log("%10d %10.2f M/s %12.2f M/s %12.2f M/s", num_producers, push, peep, batch);
+    }
+
+    if (result == 0) {
+        SDL_Log("%d mixed events", mixed);
+        if (!run_mixed(mixed, event_type)) {
+            result = 1;
+        }
+    }
+
+    if (result == 0) {
+        /* 8000 events is one second at 8 kHz */
+        run_motion(8000, false);
+        if (run_motion(8000, true) != 1) {
+            SDL_Log("Motion events weren't coalesced");
+            result = 1;
+        }
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}
@@ -0,0 +1,641 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Microbenchmark for SDL's internal hash table.
+
+   This compiles SDL's hash table directly into the test, and compares it
+   against a copy of the previous layout (a single array of 32-byte items
+   using Robin Hood hashing), so both can be timed on the same machine. It
+   also measures how lookup throughput scales with reader threads, for both
+   rwlock-protected and concurrent tables. */
+
+/* Hack #1: avoid inclusion of SDL_main.h by SDL_internal.h */
+#define SDL_main_h_
+
+/* Hack #2: avoid dynapi renaming (must be done before #include <SDL3/SDL.h>) */
+#include "../src/dynapi/SDL_dynapi.h"
+#ifdef SDL_DYNAMIC_API
+#undef SDL_DYNAMIC_API
+#endif
+#define SDL_DYNAMIC_API 0
+
+#include "../src/SDL_hashtable.c"
+
+/* Hack #3: undo Hack #1 */
+#ifdef SDL_main_h_
+#undef SDL_main_h_
+#endif
+#ifdef SDL_MAIN_NOIMPL
+#undef SDL_MAIN_NOIMPL
+#endif
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+/* Hack #4: SDL doesn't export the functions it names its own locks with */
+SDL_Mutex *SDL_CreateNamedMutex(const char *name)
+{
+    (void)name;
+    return SDL_CreateMutex();
+}
+
+SDL_RWLock *SDL_CreateNamedRWLock(const char *name)
+{
+    (void)name;
+    return SDL_CreateRWLock();
+}
+
+/* The previous hash table layout, trimmed down to what the benchmark needs. */
+
+typedef struct LegacyHashItem
+{
+    const void *key;
+    const void *value;
+    Uint32 hash;
+    Uint32 probe_len : 31;
+    Uint32 live : 1;
+} LegacyHashItem;
+
+typedef struct LegacyHashTable
+{
+    LegacyHashItem *table;
+    SDL_HashCallback hash;
+    SDL_HashKeyMatchCallback keymatch;
+    Uint32 hash_mask;
+    Uint32 max_probe_len;
+    Uint32 num_occupied_slots;
+} LegacyHashTable;
+
+static Uint32 legacy_probe_length(Uint32 zero_idx, Uint32 actual_idx, Uint32 num_buckets)
+{
+    return (actual_idx < zero_idx) ? (num_buckets - zero_idx + actual_idx) : (actual_idx - zero_idx);
+}
+
+static LegacyHashItem *legacy_find(const LegacyHashTable *ht, const void *key, Uint32 hash)
+{
+    Uint32 i = hash & ht->hash_mask;
+    Uint32 probe_len = 0;
+
+    while (true) {
+        LegacyHashItem *item = ht->table + i;
+        if (!item->live) {
+            return NULL;
+        }
+        if (item->hash == hash && ht->keymatch(NULL, item->key, key)) {
+            return item;
+        }
+        if (probe_len > item->probe_len) {
+            return NULL;
+        }
+        if (++probe_len > ht->max_probe_len) {
+            return NULL;
+        }
+        i = (i + 1) & ht->hash_mask;
+    }
+}
+
+static void legacy_insert_item(LegacyHashItem *item_to_insert, LegacyHashItem *table, Uint32 hash_mask, Uint32 *max_probe_len)
+{
+    const Uint32 num_buckets = hash_mask + 1;
+    Uint32 idx = item_to_insert->hash & hash_mask;
+
+    while (true) {
+        LegacyHashItem *candidate = table + idx;
+
+        if (!candidate->live) {
+            *candidate = *item_to_insert;
+            candidate->probe_len = legacy_probe_length(candidate->hash & hash_mask, idx, num_buckets);
+            *max_probe_len = SDL_max(*max_probe_len, candidate->probe_len);
+            return;
+        }
+
+        const Uint32 new_probe_len = legacy_probe_length(item_to_insert->hash & hash_mask, idx, num_buckets);
+        if (candidate->probe_len < new_probe_len) {
+            LegacyHashItem temp_item = *candidate;
+            *candidate = *item_to_insert;
+            *item_to_insert = temp_item;
+            candidate->probe_len = new_probe_len;
+            *max_probe_len = SDL_max(*max_probe_len, new_probe_len);
+        }
+
+        idx = (idx + 1) & hash_mask;
+    }
+}
+
+static void *legacy_create(SDL_HashCallback hash, SDL_HashKeyMatchCallback keymatch)
+{
+    LegacyHashTable *ht = (LegacyHashTable *)SDL_calloc(1, sizeof(*ht));
+    ht->table = (LegacyHashItem *)SDL_calloc(4, sizeof(LegacyHashItem));
+    ht->hash_mask = 3;
+    ht->hash = hash;
+    ht->keymatch = keymatch;
+    return ht;
+}
+
+static bool legacy_insert(void *table, const void *key, const void *value)
+{
+    LegacyHashTable *ht = (LegacyHashTable *)table;
+    const Uint32 hash = ht->hash(NULL, key) * 0x9E3779B1u;
+    LegacyHashItem new_item;
+
+    if (legacy_find(ht, key, hash)) {
+        return false;
+    }
+
+    ht->num_occupied_slots++;
+    if (ht->num_occupied_slots > (Uint32)((217 * (Uint64)(ht->hash_mask + 1)) >> 8)) {
+        const Uint32 old_size = ht->hash_mask + 1;
+        LegacyHashItem *old_table = ht->table;
+        ht->table = (LegacyHashItem *)SDL_calloc(old_size * 2, sizeof(LegacyHashItem));
+        ht->hash_mask = (old_size * 2) - 1;
+        ht->max_probe_len = 0;
+        for (Uint32 i = 0; i < old_size; ++i) {
+            if (old_table[i].live) {
+                legacy_insert_item(&old_table[i], ht->table, ht->hash_mask, &ht->max_probe_len);
+            }
+        }
+        SDL_free(old_table);
+    }
+
+    new_item.key = key;
+    new_item.value = value;
+    new_item.hash = hash;
+    new_item.live = true;
+    new_item.probe_len = 0;
+    legacy_insert_item(&new_item, ht->table, ht->hash_mask, &ht->max_probe_len);
+    return true;
+}
+
+static bool legacy_lookup(void *table, const void *key, const void **value)
+{
+    LegacyHashTable *ht = (LegacyHashTable *)table;
+    const LegacyHashItem *item = legacy_find(ht, key, ht->hash(NULL, key) * 0x9E3779B1u);
+    if (item) {
+        *value = item->value;
+        return true;
+    }
+    return false;
+}
+
+static bool legacy_remove(void *table, const void *key)
+{
+    LegacyHashTable *ht = (LegacyHashTable *)table;
+    LegacyHashItem *item = legacy_find(ht, key, ht->hash(NULL, key) * 0x9E3779B1u);
+    if (!item) {
+        return false;
+    }
+
+    ht->num_occupied_slots--;
+    Uint32 idx = (Uint32)(item - ht->table);
+    while (true) {
+        idx = (idx + 1) & ht->hash_mask;
+        LegacyHashItem *next_item = ht->table + idx;
+        if (next_item->probe_len < 1) {
+            SDL_zerop(item);
+            return true;
+        }
+        *item = *next_item;
+        item->probe_len -= 1;
+        item = next_item;
+    }
+}
+
+static void legacy_destroy(void *table)
+{
+    LegacyHashTable *ht = (LegacyHashTable *)table;
+    SDL_free(ht->table);
+    SDL_free(ht);
+}
+
+/* The current layout, through the regular internal API. */
+
+static void *current_create(SDL_HashCallback hash, SDL_HashKeyMatchCallback keymatch)
+{
+    return SDL_CreateHashTable(0, false, hash, keymatch, NULL, NULL);
+}
+
+static bool current_insert(void *table, const void *key, const void *value)
+{
+    return SDL_InsertIntoHashTable((SDL_HashTable *)table, key, value, false);
+}
+
+static bool current_lookup(void *table, const void *key, const void **value)
+{
+    return SDL_FindInHashTable((const SDL_HashTable *)table, key, value);
+}
+
+static bool current_remove(void *table, const void *key)
+{
+    return SDL_RemoveFromHashTable((SDL_HashTable *)table, key);
+}
+
+static void current_destroy(void *table)
+{
+    SDL_DestroyHashTable((SDL_HashTable *)table);
+}
+
+typedef struct HashTableImpl
+{
+    const char *name;
+    void *(*create)(SDL_HashCallback hash, SDL_HashKeyMatchCallback keymatch);
+    bool (*insert)(void *table, const void *key, const void *value);
+    bool (*lookup)(void *table, const void *key, const void **value);
+    bool (*remove)(void *table, const void *key);
+    void (*destroy)(void *table);
+} HashTableImpl;
+
+static const HashTableImpl impls[] = {
+    { "legacy", legacy_create, legacy_insert, legacy_lookup, legacy_remove, legacy_destroy },
+    { "current", current_create, current_insert, current_lookup, current_remove, current_destroy }
+};
+
+static double elapsed_ns_per_op(Uint64 start, int count)
+{
+    const Uint64 elapsed = SDL_GetPerformanceCounter() - start;
+    return ((double)elapsed * 1e9) / ((double)SDL_GetPerformanceFrequency() * (double)count);
+}
+
+/* Insert every key, look them all up, look up keys that aren't there, then remove them all.
+   Returns false if the table gave a wrong answer at any point. */
+static bool run_benchmark(const HashTableImpl *impl, const char *keytype, SDL_HashCallback hash, SDL_HashKeyMatchCallback keymatch,
+                          const void **keys, const void **missing, int count)
+{
+    void *table = impl->create(hash, keymatch);
+    const void *value = NULL;
+    double insert_ns, hit_ns, miss_ns, remove_ns;
+    bool result = true;
+    Uint64 start;
+    int i;
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; i++) {
+        if (!impl->insert(table, keys[i], (const void *)(uintptr_t)(i + 1))) {
+            result = false;
+        }
+    }
+    insert_ns = elapsed_ns_per_op(start, count);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; i++) {
+        if (!impl->lookup(table, keys[i], &value) || value != (const void *)(uintptr_t)(i + 1)) {
+            result = false;
+        }
+    }
+    hit_ns = elapsed_ns_per_op(start, count);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; i++) {
+        if (impl->lookup(table, missing[i], &value)) {
+            result = false;
+        }
+    }
+    miss_ns = elapsed_ns_per_op(start, count);
+
+    start = SDL_GetPerformanceCounter();
+    for (i = 0; i < count; i++) {
+        if (!impl->remove(table, keys[i])) {
+            result = false;
+        }
+    }
+    remove_ns = elapsed_ns_per_op(start, count);
+
+    /* everything is gone, so nothing should be found anymore. */
+    for (i = 0; i < count; i += 97) {
+        if (impl->lookup(table, keys[i], &value)) {
+            result = false;
+        }
+    }
+
+    impl->destroy(table);
+
+    SDL_Log("%-8s %-7s n=%-8d insert %7.2f ns  hit %7.2f ns  miss %7.2f ns  remove %7.2f ns%s",
+            impl->name, keytype, count, insert_ns, hit_ns, miss_ns, remove_ns, result ? "" : "  (WRONG RESULTS)");
+    return result;
+}
+
+/* Interleave inserts and removes so the current layout has to deal with tombstones. */
+static bool run_churn_test(bool concurrent, const void **keys, int count)
+{
+    SDL_HashTable *table;
+    const void *value = NULL;
+    bool result = true;
+    int round, i;
+
+    if (concurrent) {
+        table = SDL_CreateConcurrentHashTable(0, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    } else {
+        table = SDL_CreateHashTable(0, false, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    }
+
+    for (round = 0; round < 8; round++) {
+        for (i = 0; i < count; i++) {
+            if ((i % 8) != round && !SDL_InsertIntoHashTable(table, keys[i], keys[i], true)) {
+                result = false;
+            }
+        }
+        for (i = 0; i < count; i += 2) {
+            SDL_RemoveFromHashTable(table, keys[i]);
+        }
+        for (i = 0; i < count; i++) {
+            const bool expected = ((i % 2) != 0) && (((i % 8) != round) || (round > 0));
+            const bool found = SDL_FindInHashTable(table, keys[i], &value);
+            if ((found != expected) || (found && value != keys[i])) {
+                result = false;
+            }
+        }
+    }
+
+    for (i = 0; i < count; i++) {
+        SDL_RemoveFromHashTable(table, keys[i]);
+    }
+    if (!SDL_HashTableEmpty(table)) {
+        result = false;
+    }
+
+    SDL_DestroyHashTable(table);
+    if (!result) {
+        SDL_Log("%s churn test gave wrong results!", concurrent ? "concurrent" : "single-threaded");
+    }
+    return result;
+}
+
+/* Rebuilds a concurrent table while removed items are still waiting for readers to leave, and
+   makes retiring the old arrays run out of memory. The arrays are then freed right away, so no
+   waiting item may still point at them: a later rebuild could get the same address back, and
+   the item would mark a slot in the live arrays as deleted. */
+static SDL_malloc_func real_malloc;
+static bool fail_retired_allocations;
+
+static void * SDLCALL failing_retired_malloc(size_t size)
+{
+    if (fail_retired_allocations && size == sizeof(SDL_HashRetired)) {
+        return NULL;
+    }
+    return real_malloc(size);
+}
+
+static bool run_retire_out_of_memory_test(const void **keys, int count)
+{
+    SDL_calloc_func real_calloc;
+    SDL_realloc_func real_realloc;
+    SDL_free_func real_free;
+    SDL_HashTable *table;
+    const void *value = NULL;
+    bool result = true;
+    SDL_HashSlots *old_slots;
+    SDL_HashRetired *retired;
+    Uint32 capacity;
+    int i, token;
+
+    count = SDL_min(count, 1000);
+    table = SDL_CreateConcurrentHashTable(0, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    for (i = 0; i < count; i++) {
+        SDL_InsertIntoHashTable(table, keys[i], keys[i], true);
+    }
+
+    /* A reader keeps the removed items from being freed */
+    lock_for_reading(table, &token);
+    for (i = 0; i < count; i += 4) {
+        SDL_RemoveFromHashTable(table, keys[i]);
+    }
+    unlock_for_reading(table, token);
+
+    SDL_GetMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    SDL_SetMemoryFunctions(failing_retired_malloc, real_calloc, real_realloc, real_free);
+    old_slots = table->slots;
+    capacity = old_slots->hash_mask + 1;
+    lock_for_writing(table);
+    fail_retired_allocations = true;
+    resize(table, capacity);
+    fail_retired_allocations = false;
+    SDL_SetMemoryFunctions(real_malloc, real_calloc, real_realloc, real_free);
+
+    /* The old arrays are gone, so nothing may still refer to them */
+    for (i = 0; i < 2; i++) {
+        for (retired = table->retired[i]; retired; retired = retired->next) {
+            if (retired->owner == old_slots) {
+                result = false;
+            }
+        }
+    }
+    unlock_for_writing(table);
+
+    /* Let the table free everything that was retired */
+    for (i = 0; i < 4; i++) {
+        SDL_RemoveFromHashTable(table, keys[0]);
+    }
+
+    for (i = 0; i < count; i++) {
+        const bool expected = (i % 4) != 0;
+        const bool found = SDL_FindInHashTable(table, keys[i], &value);
+        if ((found != expected) || (found && value != keys[i])) {
+            result = false;
+        }
+    }
+
+    SDL_DestroyHashTable(table);
+    if (!result) {
+        SDL_Log("concurrent table gave wrong results after running out of memory for retired nodes!");
+    }
+    return result;
+}
+
+/* Contention benchmark: several threads looking things up while one thread keeps changing the table. */
+
+/* The contention benchmark runs up to this many readers, plus a writer */
+#define MAX_READERS 63
+
+typedef struct ContentionData
+{
+    SDL_HashTable *table;
+    const void **keys;
+    int count;
+    SDL_AtomicInt done;
+    SDL_AtomicInt lookups;
+    SDL_AtomicInt failures;
+} ContentionData;
+
+static int SDLCALL contention_reader(void *arg)
+{
+    ContentionData *data = (ContentionData *)arg;
+    const void *value = NULL;
+    int lookups = 0;
+    int i = 0;
+
+    while (!SDL_GetAtomicInt(&data->done)) {
+        /* the first half of the keys is never removed, so these must always be found. */
+        if (!SDL_FindInHashTable(data->table, data->keys[i], &value) || value != data->keys[i]) {
+            SDL_AddAtomicInt(&data->failures, 1);
+        }
+        if (++i == data->count / 2) {
+            i = 0;
+        }
+        lookups++;
+    }
+
+    SDL_AddAtomicInt(&data->lookups, lookups);
+    return 0;
+}
+
+static int SDLCALL contention_writer(void *arg)
+{
+    ContentionData *data = (ContentionData *)arg;
+    int i = data->count / 2;
+
+    while (!SDL_GetAtomicInt(&data->done)) {
+        SDL_InsertIntoHashTable(data->table, data->keys[i], data->keys[i], true);
+        SDL_RemoveFromHashTable(data->table, data->keys[i]);
+        if (++i == data->count) {
+            i = data->count / 2;
+        }
+    }
+    return 0;
+}
+
+static bool run_contention_benchmark(bool concurrent, int num_readers, const void **keys, int count, Uint32 duration_ms)
+{
+    SDL_Thread *threads[MAX_READERS + 1];
+    ContentionData data;
+    int i;
+
+    SDL_zero(data);
+    data.keys = keys;
+    data.count = count;
+    if (concurrent) {
+        data.table = SDL_CreateConcurrentHashTable(0, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    } else {
+        data.table = SDL_CreateHashTable(0, true, SDL_HashID, SDL_KeyMatchID, NULL, NULL);
+    }
+    for (i = 0; i < count / 2; i++) {
+        SDL_InsertIntoHashTable(data.table, keys[i], keys[i], false);
+    }
+
+    for (i = 0; i < num_readers; i++) {
+        threads[i] = SDL_CreateThread(contention_reader, "reader", &data);
+    }
+    threads[num_readers] = SDL_CreateThread(contention_writer, "writer", &data);
+
+    SDL_Delay(duration_ms);
+    SDL_SetAtomicInt(&data.done, 1);
+    for (i = 0; i <= num_readers; i++) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_DestroyHashTable(data.table);
+
+    SDL_Log("%-10s readers=%-2d %10.0f lookups/sec%s", concurrent ? "concurrent" : "rwlock", num_readers,
+            (double)SDL_GetAtomicInt(&data.lookups) * 1000.0 / (double)duration_ms,
+            SDL_GetAtomicInt(&data.failures) ? "  (WRONG RESULTS)" : "");
+    return SDL_GetAtomicInt(&data.failures) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    const void **id_keys, **id_missing, **string_keys, **string_missing;
+    char *string_storage;
+    int count = 100000;
+    int max_threads = SDL_clamp(SDL_GetNumLogicalCPUCores(), 4, MAX_READERS);
+    Uint32 duration_ms = 100;
+    bool result = true;
+    size_t impl;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = (count > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                max_threads = SDL_atoi(argv[i + 1]);
+                consumed = (max_threads > 0 && max_threads <= MAX_READERS) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--duration") == 0 && argv[i + 1]) {
+                duration_ms = (Uint32)SDL_atoi(argv[i + 1]);
+                consumed = (duration_ms > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--count N]", "[--threads N]", "[--duration MS]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    id_keys = (const void **)SDL_malloc(count * sizeof(void *));
+    id_missing = (const void **)SDL_malloc(count * sizeof(void *));
+    string_keys = (const void **)SDL_malloc(count * sizeof(void *));
+    string_missing = (const void **)SDL_malloc(count * sizeof(void *));
+    string_storage = (char *)SDL_malloc(count * 2 * 16);
+    if (!id_keys || !id_missing || !string_keys || !string_missing || !string_storage) {
+        SDL_Log("Out of memory!");
+        return 1;
+    }
+
+    for (i = 0; i < count; i++) {
+        char *key = string_storage + (i * 2 * 16);
+        char *miss = key + 16;
+        id_keys[i] = (const void *)(uintptr_t)(i + 1);
+        id_missing[i] = (const void *)(uintptr_t)(count + i + 1);
+        SDL_snprintf(key, 16, "prop.%d", i);
+        SDL_snprintf(miss, 16, "none.%d", i);
+        string_keys[i] = key;
+        string_missing[i] = miss;
+    }
+
+    for (impl = 0; impl < SDL_arraysize(impls); impl++) {
+        if (!run_benchmark(&impls[impl], "ids", SDL_HashID, SDL_KeyMatchID, id_keys, id_missing, count)) {
+            result = false;
+        }
+        if (!run_benchmark(&impls[impl], "strings", SDL_HashString, SDL_KeyMatchString, string_keys, string_missing, count)) {
+            result = false;
+        }
+    }
+
+    if (!run_churn_test(false, id_keys, count) || !run_churn_test(true, id_keys, count)) {
+        result = false;
+    }
+    if (!run_retire_out_of_memory_test(id_keys, count)) {
+        result = false;
+    }
+
+    for (i = 1; i <= max_threads; i *= 2) {
+        if (!run_contention_benchmark(false, i, id_keys, count, duration_ms)) {
+            result = false;
+        }
+        if (!run_contention_benchmark(true, i, id_keys, count, duration_ms)) {
+            result = false;
+        }
+    }
+
+    SDL_free(id_keys);
+    SDL_free(id_missing);
+    SDL_free(string_keys);
+    SDL_free(string_missing);
+    SDL_free(string_storage);
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return result ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Times hint lookups, the way SDL subsystems check hints on hot paths.
+
+   A number of threads each call SDL_GetHintBoolean() in a loop, on a hint
+   that is set, one that comes from the environment and one that doesn't
+   exist. Optionally, another thread keeps changing an unrelated hint, so
+   lookups have to notice that values may have changed. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static const char *hints[] = {
+    "SDL_TEST_HINT_LOOKUP_SET",
+    "SDL_TEST_HINT_LOOKUP_ENVIRONMENT",
+    "SDL_TEST_HINT_LOOKUP_MISSING"
+};
+
+static int count = 1000000;
+static SDL_AtomicInt done;
+
+static int SDLCALL lookup_thread(void *data)
+{
+    Uint64 *elapsed = (Uint64 *)data;
+    Uint64 start = SDL_GetTicksNS();
+    int i, enabled = 0;
+
+    for (i = 0; i < count; ++i) {
+        if (SDL_GetHintBoolean(hints[i % SDL_arraysize(hints)], false)) {
+            ++enabled;
+        }
+    }
+    *elapsed = SDL_GetTicksNS() - start;
+
+    /* Two of every three hints are true */
+    if (enabled < (count / 3) * 2) {
+        SDL_Log("Only %d of %d lookups returned true", enabled, count);
+    }
+    return 0;
+}
+
+static int SDLCALL writer_thread(void *data)
+{
+    int *changes = (int *)data;
+
+    while (!SDL_GetAtomicInt(&done)) {
+        SDL_SetHint("SDL_TEST_HINT_LOOKUP_CHANGING", (*changes & 1) ? "1" : "0");
+        ++*changes;
+        SDL_Delay(1);
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_Thread *threads[64];
+    Uint64 elapsed[64];
+    SDL_Thread *writer = NULL;
+    int num_threads = 1;
+    bool changing = false;
+    int changes = 0;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = (count > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                num_threads = SDL_atoi(argv[i + 1]);
+                consumed = (num_threads > 0 && num_threads <= (int)SDL_arraysize(threads)) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--changing") == 0) {
+                changing = true;
+                consumed = 1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--count N]", "[--threads N]", "[--changing]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    SDL_SetEnvironmentVariable(SDL_GetEnvironment(), hints[1], "1", true);
+    SDL_SetHint(hints[0], "1");
+
+    if (changing) {
+        writer = SDL_CreateThread(writer_thread, "writer", &changes);
+    }
+    for (i = 0; i < num_threads; ++i) {
+        threads[i] = SDL_CreateThread(lookup_thread, "lookup", &elapsed[i]);
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    SDL_SetAtomicInt(&done, 1);
+    SDL_WaitThread(writer, NULL);
+
+    for (i = 0; i < num_threads; ++i) {
+        SDL_Log("Thread %d: %d lookups in %.2f ms, %.1f ns per lookup",
+                i, count, (double)elapsed[i] / 1000000.0, (double)elapsed[i] / count);
+    }
+    if (changing) {
+        SDL_Log("%d hint changes during the test", changes);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return 0;
+}
@@ -0,0 +1,175 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures text conversion throughput on large inputs.
+
+   This builds multi-megabyte UTF-8 texts with different mixes of scripts,
+   like clipboard contents or localization files, and reports how fast
+   SDL_iconv_string() converts them to and from UTF-16 and UCS-4, and how
+   fast SDL_utf8strlen() counts them. Every conversion is checked by
+   converting the result back. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static const struct
+{
+    const char *name;
+    const char *text;
+} samples[] = {
+    { "ascii", "The quick brown fox jumps over the lazy dog, again and again. " },
+    { "latin", "Voix ambigu\xc3\xab d'un c\xc5\x93ur qui, au z\xc3\xa9phyr, pr\xc3\xa9" "f\xc3\xa8re les jattes de kiwis. " },
+    { "cjk", "\xe6\x97\xa5\xe6\x9c\xac\xe8\xaa\x9e\xe3\x81\xae\xe3\x83\x86\xe3\x82\xad\xe3\x82\xb9\xe3\x83\x88\xe3\x81\xa7\xe3\x81\x99\xe3\x80\x82" },
+    { "emoji", "Game over \xf0\x9f\x8e\xae\xf0\x9f\x91\xbe score: 100 \xf0\x9f\x8f\x86 " },
+};
+
+static char *make_text(const char *sample, size_t size)
+{
+    const size_t len = SDL_strlen(sample);
+    char *text = (char *)SDL_malloc(size + 1);
+    size_t pos = 0;
+
+    if (!text) {
+        return NULL;
+    }
+    while (pos + len <= size) {
+        SDL_memcpy(text + pos, sample, len);
+        pos += len;
+    }
+    text[pos] = '\0';
+    return text;
+}
+
+static double throughput(size_t bytes, Uint64 ns)
+{
+    return ((double)bytes / (1024.0 * 1024.0)) / ((double)ns / 1000000000.0);
+}
+
+/* Converts the text to `encoding` and back, returns the time for each direction */
+static bool round_trip(const char *text, size_t len, const char *encoding, size_t unit, Uint64 *to_ns, Uint64 *from_ns)
+{
+    Uint64 start;
+    char *converted, *result;
+    size_t converted_len = 0;
+    bool ok;
+
+    start = SDL_GetTicksNS();
+    converted = SDL_iconv_string(encoding, "UTF-8", text, len);
+    *to_ns = SDL_GetTicksNS() - start;
+    if (!converted) {
+        return false;
+    }
+
+    /* Find the length of the converted text, which is terminated by a zero code unit */
+    if (unit == 2) {
+        while (((const Uint16 *)converted)[converted_len]) {
+            ++converted_len;
+        }
+    } else if (unit == 4) {
+        while (((const Uint32 *)converted)[converted_len]) {
+            ++converted_len;
+        }
+    } else {
+        converted_len = SDL_strlen(converted);
+    }
+
+    start = SDL_GetTicksNS();
+    result = SDL_iconv_string("UTF-8", encoding, converted, converted_len * unit);
+    *from_ns = SDL_GetTicksNS() - start;
+
+    ok = (result && SDL_strlen(result) == len && SDL_memcmp(result, text, len) == 0);
+    SDL_free(converted);
+    SDL_free(result);
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    size_t size = 8;
+    bool ok = true;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--size") == 0 && argv[i + 1]) {
+                size = (size_t)SDL_atoi(argv[i + 1]);
+                consumed = (size > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--size MB]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    SDL_Log("%d MB of UTF-8 text, throughput in MB of UTF-8 per second", (int)size);
+    SDL_Log("%-6s %10s %10s %10s %10s %10s %10s", "text", "->UTF16", "UTF16->", "->UCS4", "UCS4->", "->UTF8", "strlen");
+
+    for (i = 0; i < (int)SDL_arraysize(samples); ++i) {
+        char *text = make_text(samples[i].text, size * 1024 * 1024);
+        Uint64 to_utf16, from_utf16, to_ucs4, from_ucs4, utf8_ns, strlen_ns, start;
+        size_t len, count;
+        char *copy;
+
+        if (!text) {
+            SDL_Log("Out of memory");
+            return 1;
+        }
+        len = SDL_strlen(text);
+
+        if (!round_trip(text, len, "UTF-16LE", 2, &to_utf16, &from_utf16) ||
+            !round_trip(text, len, "UCS-4LE", 4, &to_ucs4, &from_ucs4)) {
+            SDL_Log("%s: conversion round trip failed", samples[i].name);
+            ok = false;
+        }
+
+        start = SDL_GetTicksNS();
+        copy = SDL_iconv_string("UTF-8", "UTF-8", text, len);
+        utf8_ns = SDL_GetTicksNS() - start;
+        if (!copy || SDL_strcmp(copy, text) != 0) {
+            SDL_Log("%s: UTF-8 copy failed", samples[i].name);
+            ok = false;
+        }
+        SDL_free(copy);
+
+        start = SDL_GetTicksNS();
+        count = SDL_utf8strlen(text);
+        strlen_ns = SDL_GetTicksNS() - start;
+
+        SDL_Log("%-6s %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f  (%d codepoints)", samples[i].name,
+                throughput(len, to_utf16), throughput(len, from_utf16),
+                throughput(len, to_ucs4), throughput(len, from_ucs4),
+                throughput(len, utf8_ns), throughput(len, strlen_ns), (int)count);
+
+        SDL_free(text);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return ok ? 0 : 1;
+}
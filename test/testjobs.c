@@ -0,0 +1,303 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Checks the job system and measures how it scales.
+
+   First this runs chains and groups of jobs with dependencies, and checks
+   that every job ran after the ones it depends on. Then it splits a
+   computation over an array with recursive fork/join, where every job
+   submits half of its range as a new job, works on the other half and
+   waits for the first, and reports the speedup over a single thread for
+   each number of worker threads. The overhead per job is measured
+   separately, with the same recursion over jobs that do no work. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+typedef struct
+{
+    SDL_AtomicInt *clock;
+    int index;
+    int ran_at;
+} OrderTask;
+
+typedef struct
+{
+    SDL_JobSystem *system;
+    const Uint32 *values;
+    int count;
+    Uint64 result;
+} ForkJoinTask;
+
+static int grain = 1024;
+
+static void SDLCALL order_job(void *userdata)
+{
+    OrderTask *task = (OrderTask *)userdata;
+    task->ran_at = SDL_AddAtomicInt(task->clock, 1);
+}
+
+static Uint64 work(const Uint32 *values, int count)
+{
+    Uint64 result = 0;
+    int i, j;
+
+    /* Enough arithmetic per element that memory bandwidth isn't the limit */
+    for (i = 0; i < count; ++i) {
+        Uint32 x = values[i];
+        for (j = 0; j < 32; ++j) {
+            x ^= x << 13;
+            x ^= x >> 17;
+            x ^= x << 5;
+        }
+        result += x;
+    }
+    return result;
+}
+
+static void SDLCALL fork_join_job(void *userdata)
+{
+    ForkJoinTask *task = (ForkJoinTask *)userdata;
+    ForkJoinTask left, right;
+    SDL_Job *job;
+
+    if (task->count <= grain) {
+        task->result = work(task->values, task->count);
+        return;
+    }
+
+    left.system = task->system;
+    left.values = task->values;
+    left.count = task->count / 2;
+    right.system = task->system;
+    right.values = task->values + left.count;
+    right.count = task->count - left.count;
+
+    job = SDL_SubmitJob(task->system, fork_join_job, &left, NULL, 0);
+    fork_join_job(&right);
+    if (job) {
+        SDL_WaitJob(job);
+        SDL_ReleaseJob(job);
+    } else {
+        fork_join_job(&left);
+    }
+    task->result = left.result + right.result;
+}
+
+/* The same recursion with jobs that do no work, so the time is all job system overhead */
+static void SDLCALL empty_fork_join_job(void *userdata)
+{
+    ForkJoinTask *task = (ForkJoinTask *)userdata;
+    ForkJoinTask left, right;
+    SDL_Job *job;
+
+    if (task->count <= 1) {
+        return;
+    }
+
+    left.system = task->system;
+    left.count = task->count / 2;
+    right.system = task->system;
+    right.count = task->count - left.count;
+
+    job = SDL_SubmitJob(task->system, empty_fork_join_job, &left, NULL, 0);
+    empty_fork_join_job(&right);
+    if (job) {
+        SDL_WaitJob(job);
+        SDL_ReleaseJob(job);
+    }
+}
+
+static bool test_dependencies(SDL_JobSystem *system)
+{
+    enum { CHAIN_LENGTH = 100, GROUP_SIZE = 100 };
+    OrderTask chain[CHAIN_LENGTH], group[GROUP_SIZE], last;
+    SDL_Job *jobs[GROUP_SIZE];
+    SDL_Job *job, *previous = NULL, *all;
+    SDL_AtomicInt clock;
+    bool ok = true;
+    int i;
+
+    SDL_SetAtomicInt(&clock, 0);
+
+    /* Each job in the chain depends on the one before it */
+    for (i = 0; i < CHAIN_LENGTH; ++i) {
+        chain[i].clock = &clock;
+        chain[i].index = i;
+        chain[i].ran_at = -1;
+        job = SDL_SubmitJob(system, order_job, &chain[i], &previous, previous ? 1 : 0);
+        SDL_ReleaseJob(previous);
+        previous = job;
+    }
+    SDL_WaitJob(previous);
+    SDL_ReleaseJob(previous);
+    for (i = 1; i < CHAIN_LENGTH; ++i) {
+        if (chain[i].ran_at <= chain[i - 1].ran_at) {
+            SDL_Log("Chain job %d ran before job %d", i, i - 1);
+            ok = false;
+        }
+    }
+
+    /* A job without a function waits for the whole group, and one more job depends on that */
+    for (i = 0; i < GROUP_SIZE; ++i) {
+        group[i].clock = &clock;
+        group[i].index = i;
+        group[i].ran_at = -1;
+        jobs[i] = SDL_SubmitJob(system, order_job, &group[i], NULL, 0);
+    }
+    all = SDL_SubmitJob(system, NULL, NULL, jobs, GROUP_SIZE);
+    last.clock = &clock;
+    last.ran_at = -1;
+    job = SDL_SubmitJob(system, order_job, &last, &all, 1);
+    SDL_WaitJob(job);
+    for (i = 0; i < GROUP_SIZE; ++i) {
+        if (group[i].ran_at < 0 || group[i].ran_at >= last.ran_at) {
+            SDL_Log("Group job %d ran after the job that depends on the group", i);
+            ok = false;
+        }
+        SDL_ReleaseJob(jobs[i]);
+    }
+    SDL_ReleaseJob(all);
+    SDL_ReleaseJob(job);
+
+    /* The whole group depends on one job, which grows its list of dependents while it might be running */
+    last.ran_at = -1;
+    job = SDL_SubmitJob(system, order_job, &last, NULL, 0);
+    for (i = 0; i < GROUP_SIZE; ++i) {
+        group[i].ran_at = -1;
+        jobs[i] = SDL_SubmitJob(system, order_job, &group[i], &job, 1);
+    }
+    for (i = 0; i < GROUP_SIZE; ++i) {
+        SDL_WaitJob(jobs[i]);
+        if (group[i].ran_at <= last.ran_at) {
+            SDL_Log("Group job %d ran before the job it depends on", i);
+            ok = false;
+        }
+        SDL_ReleaseJob(jobs[i]);
+    }
+    SDL_ReleaseJob(job);
+
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int count = 4 * 1024 * 1024;
+    int max_threads = SDL_GetNumLogicalCPUCores();
+    Uint32 *values;
+    Uint64 expected, start, serial_ns, overhead_ns;
+    bool ok = true;
+    int i, num_threads;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = (count > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--grain") == 0 && argv[i + 1]) {
+                grain = SDL_atoi(argv[i + 1]);
+                consumed = (grain > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                max_threads = SDL_atoi(argv[i + 1]);
+                consumed = (max_threads > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--count N]", "[--grain N]", "[--threads N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    values = (Uint32 *)SDL_malloc(count * sizeof(*values));
+    if (!values) {
+        SDL_Log("Out of memory");
+        return 1;
+    }
+    for (i = 0; i < count; ++i) {
+        values[i] = (Uint32)i * 2654435761u + 1;
+    }
+
+    start = SDL_GetTicksNS();
+    expected = work(values, count);
+    serial_ns = SDL_GetTicksNS() - start;
+
+    SDL_Log("%d elements in jobs of %d, %d CPU cores", count, grain, SDL_GetNumLogicalCPUCores());
+    SDL_Log("serial:     %8.2f ms", (double)serial_ns / 1000000.0);
+
+    /* Double the threads each time, and make sure the last pass uses all of them */
+    for (num_threads = 1; num_threads <= max_threads;
+         num_threads = (num_threads < max_threads && num_threads * 2 > max_threads) ? max_threads : num_threads * 2) {
+        SDL_PropertiesID props = SDL_CreateProperties();
+        SDL_JobSystem *system;
+        ForkJoinTask task;
+        Uint64 elapsed;
+
+        SDL_SetNumberProperty(props, SDL_PROP_JOBSYSTEM_CREATE_THREADS_NUMBER, num_threads);
+        system = SDL_CreateJobSystem(props);
+        SDL_DestroyProperties(props);
+        if (!system) {
+            SDL_Log("Couldn't create job system: %s", SDL_GetError());
+            ok = false;
+            break;
+        }
+
+        if (!test_dependencies(system)) {
+            ok = false;
+        }
+
+        /* The main thread starts the work and helps while it waits */
+        task.system = system;
+        task.values = values;
+        task.count = count;
+        task.result = 0;
+        start = SDL_GetTicksNS();
+        fork_join_job(&task);
+        elapsed = SDL_GetTicksNS() - start;
+
+        if (task.result != expected) {
+            SDL_Log("%d threads: wrong result", num_threads);
+            ok = false;
+        }
+
+        task.count = count / grain;
+        start = SDL_GetTicksNS();
+        empty_fork_join_job(&task);
+        overhead_ns = SDL_GetTicksNS() - start;
+
+        SDL_Log("%2d threads: %8.2f ms, %5.2fx, %6.1f ns overhead per job", num_threads,
+                (double)elapsed / 1000000.0, (double)serial_ns / elapsed,
+                (double)overhead_ns / SDL_max(task.count - 1, 1));
+
+        SDL_DestroyJobSystem(system);
+    }
+
+    SDL_free(values);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return ok ? 0 : 1;
+}
@@ -12,6 +12,12 @@
 
 /* Test the thread and mutex locking functions
    Also exercises the system's signal/thread interaction
+
+   With --benchmark, measures how many contended lock/unlock pairs and
+   condition variable handoffs per second the mutex implementation manages.
+   On Linux, run it again with SDL_LINUX_FORCE_PTHREAD_SYNC=1 to compare the
+   futex and pthread implementations. With SDL_LOCK_PROFILING=1, the lock
+   profile of the benchmark is logged at the end.
 */
 
 #include <signal.h>
@@ -29,6 +35,21 @@ static SDL_Thread **threads;
 static int worktime = 1000;
 static SDLTest_CommonState *state;
 
+typedef struct
+{
+    SDL_Condition *cond;
+    int iterations;
+    int counter;
+    int turn;
+} BenchmarkState;
+
+typedef struct
+{
+    SDL_LogOutputFunction output;
+    void *userdata;
+    Sint64 acquired;
+} ProfileCapture;
+
 /**
  * SDL_Quit() shouldn't be used with atexit() directly because
  * calling conventions may differ...
@@ -99,6 +120,140 @@ Run(void *data)
     return 0;
 }
 
+static int SDLCALL
+LockBenchmark(void *data)
+{
+    BenchmarkState *benchmark = (BenchmarkState *)data;
+    int i;
+
+    for (i = 0; i < benchmark->iterations; ++i) {
+        SDL_LockMutex(mutex);
+        ++benchmark->counter;
+        SDL_UnlockMutex(mutex);
+    }
+    return 0;
+}
+
+static int SDLCALL
+HandoffBenchmark(void *data)
+{
+    BenchmarkState *benchmark = (BenchmarkState *)data;
+    const int player = (SDL_GetCurrentThreadID() == mainthread) ? 0 : 1;
+    int i;
+
+    /* Two threads take turns, so every handoff wakes up the other one */
+    SDL_LockMutex(mutex);
+    for (i = 0; i < benchmark->iterations; ++i) {
+        while (benchmark->turn != player) {
+            SDL_WaitCondition(benchmark->cond, mutex);
+        }
+        ++benchmark->counter;
+        benchmark->turn = !player;
+        SDL_SignalCondition(benchmark->cond);
+    }
+    SDL_UnlockMutex(mutex);
+    return 0;
+}
+
+/* Picks the row for our mutex out of the lock profile, and passes everything on */
+static void SDLCALL
+CaptureLockProfile(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    ProfileCapture *capture = (ProfileCapture *)userdata;
+    const size_t len = SDL_strlen("testlock");
+
+    if (SDL_strncmp(message, "testlock", len) == 0 && message[len] == ' ') {
+        char *endptr;
+        const Uint64 acquired = SDL_strtoull(message + len, &endptr, 10);
+        if (endptr != message + len) {
+            capture->acquired = (Sint64)acquired;
+        }
+    }
+    capture->output(capture->userdata, category, priority, message);
+}
+
+static bool
+DumpLockProfile(int expected)
+{
+    ProfileCapture capture;
+    bool ok = true;
+
+    capture.acquired = -1;
+    SDL_GetLogOutputFunction(&capture.output, &capture.userdata);
+    SDL_SetLogOutputFunction(CaptureLockProfile, &capture);
+    if (!SDL_DumpLockProfile()) {
+        ok = false;
+    }
+    SDL_SetLogOutputFunction(capture.output, capture.userdata);
+
+    if (!ok) {
+        SDL_Log("Couldn't dump the lock profile: %s", SDL_GetError());
+    } else if (capture.acquired < 0) {
+        SDL_Log("The lock profile has no row for the testlock mutex");
+        ok = false;
+    } else if (capture.acquired < expected) {
+        SDL_Log("The lock profile counted %" SDL_PRIs64 " acquisitions, expected at least %d", capture.acquired, expected);
+        ok = false;
+    }
+    return ok;
+}
+
+static bool
+RunBenchmark(int iterations)
+{
+    const char *implementation = SDL_GetHintBoolean(SDL_HINT_LINUX_FORCE_PTHREAD_SYNC, false) ? "pthread" : "default";
+    BenchmarkState benchmark;
+    SDL_Thread *handoff_thread;
+    Uint64 start, elapsed;
+    bool ok = true;
+    int i;
+
+    benchmark.cond = SDL_CreateCondition();
+    benchmark.iterations = iterations;
+    benchmark.counter = 0;
+    benchmark.turn = 0;
+    if (!benchmark.cond) {
+        SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create condition: %s", SDL_GetError());
+        return false;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < nb_threads; ++i) {
+        threads[i] = SDL_CreateThread(LockBenchmark, "Locker", &benchmark);
+    }
+    for (i = 0; i < nb_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    if (benchmark.counter != nb_threads * iterations) {
+        SDL_Log("Lost updates: counted %d of %d", benchmark.counter, nb_threads * iterations);
+        ok = false;
+    }
+    SDL_Log("%s mutex, %d threads: %.2f million lock/unlock pairs per second", implementation,
+            nb_threads, ((double)nb_threads * iterations) / ((double)elapsed / 1000.0));
+
+    benchmark.counter = 0;
+    start = SDL_GetTicksNS();
+    handoff_thread = SDL_CreateThread(HandoffBenchmark, "Handoff", &benchmark);
+    HandoffBenchmark(&benchmark);
+    SDL_WaitThread(handoff_thread, NULL);
+    elapsed = SDL_GetTicksNS() - start;
+    if (benchmark.counter != 2 * iterations) {
+        SDL_Log("Lost handoffs: counted %d of %d", benchmark.counter, 2 * iterations);
+        ok = false;
+    }
+    SDL_Log("%s condition: %.2f thousand handoffs per second", implementation,
+            (2.0 * iterations) / ((double)elapsed / 1000000.0));
+
+    /* Every lock/unlock pair above went through the profiled mutex */
+    if (SDL_GetHintBoolean(SDL_HINT_LOCK_PROFILING, false) && !DumpLockProfile(nb_threads * iterations)) {
+        ok = false;
+    }
+
+    SDL_DestroyCondition(benchmark.cond);
+    return ok;
+}
+
 #ifndef _WIN32
 static Uint32 hit_timeout(void *param, SDL_TimerID timerID, Uint32 interval) {
     SDL_Log("Hit timeout! Sending SIGINT!");
@@ -110,6 +265,8 @@ static Uint32 hit_timeout(void *param, SDL_TimerID timerID, Uint32 interval) {
 int main(int argc, char *argv[])
 {
     int i;
+    int benchmark = 0;
+    SDL_PropertiesID props;
 #ifndef _WIN32
     int timeout = 0;
 #endif
@@ -142,6 +299,14 @@ int main(int argc, char *argv[])
                         consumed = 2;
                     }
                 }
+            } else if (SDL_strcmp(argv[i], "--benchmark") == 0) {
+                if (argv[i + 1]) {
+                    char *endptr;
+                    benchmark = SDL_strtol(argv[i + 1], &endptr, 0);
+                    if (endptr != argv[i + 1] && *endptr == '\0' && benchmark > 0) {
+                        consumed = 2;
+                    }
+                }
 #ifndef _WIN32
             } else if (SDL_strcmp(argv[i], "--timeout") == 0) {
                 if (argv[i + 1]) {
@@ -158,6 +323,7 @@ int main(int argc, char *argv[])
             static const char *options[] = {
                 "[--nbthreads NB]",
                 "[--worktime ms]",
+                "[--benchmark iterations]",
 #ifndef _WIN32
                 "[--timeout ms]",
 #endif
@@ -181,13 +347,22 @@ int main(int argc, char *argv[])
 
     SDL_SetAtomicInt(&doterminate, 0);
 
-    mutex = SDL_CreateMutex();
+    props = SDL_CreateProperties();
+    SDL_SetStringProperty(props, SDL_PROP_MUTEX_CREATE_NAME_STRING, "testlock");
+    mutex = SDL_CreateMutexWithProperties(props);
+    SDL_DestroyProperties(props);
     if (!mutex) {
         SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Couldn't create mutex: %s", SDL_GetError());
         exit(1);
     }
 
     mainthread = SDL_GetCurrentThreadID();
+    if (benchmark) {
+        const bool ok = RunBenchmark(benchmark);
+        SDL_DestroyMutex(mutex);
+        SDL_free(threads);
+        return ok ? 0 : 1;
+    }
     SDL_Log("Main thread: %" SDL_PRIu64, mainthread);
     (void)atexit(printid);
     for (i = 0; i < nb_threads; ++i) {
@@ -0,0 +1,169 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures how long SDL_Log() blocks the calling thread.
+
+   A number of threads log formatted messages as fast as they can, while
+   the log output function simulates a slow sink, like a console or a file
+   on a busy disk. The latency of each logging call is reported for
+   synchronous logging and for each SDL_HINT_LOG_ASYNC mode, along with the
+   number of messages that made it to the output function. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static SDL_LogOutputFunction original_function;
+static void *original_userdata;
+static int count = 20000;
+static int sink_us = 5;
+static SDL_AtomicInt delivered;
+
+typedef struct
+{
+    int index;
+    Uint64 *latencies;
+} ThreadData;
+
+static void SDLCALL slow_output(void *userdata, int category, SDL_LogPriority priority, const char *message)
+{
+    Uint64 end;
+
+    if (category != SDL_LOG_CATEGORY_CUSTOM) {
+        /* Results and dropped message reports */
+        original_function(original_userdata, category, priority, message);
+        return;
+    }
+
+    end = SDL_GetTicksNS() + SDL_US_TO_NS(sink_us);
+    while (SDL_GetTicksNS() < end) {
+        /* Busy wait, this is a sink that takes a while to write a line */
+    }
+    SDL_AddAtomicInt(&delivered, 1);
+}
+
+static int SDLCALL log_thread(void *arg)
+{
+    ThreadData *data = (ThreadData *)arg;
+    int i;
+
+    for (i = 0; i < count; ++i) {
+        const Uint64 start = SDL_GetTicksNS();
+        SDL_LogInfo(SDL_LOG_CATEGORY_CUSTOM, "thread %d: message %d of %d, position %.3f", data->index, i, count, i * 0.5);
+        data->latencies[i] = SDL_GetTicksNS() - start;
+    }
+    return 0;
+}
+
+static int SDLCALL compare_latency(const void *a, const void *b)
+{
+    const Uint64 x = *(const Uint64 *)a;
+    const Uint64 y = *(const Uint64 *)b;
+    return (x < y) ? -1 : (x > y);
+}
+
+static void run_test(const char *mode, int num_threads)
+{
+    SDL_Thread *threads[64];
+    ThreadData data[64];
+    Uint64 *latencies;
+    Uint64 start, elapsed, flushed;
+    const int total = count * num_threads;
+    int i;
+
+    latencies = (Uint64 *)SDL_calloc(total, sizeof(*latencies));
+    if (!latencies) {
+        return;
+    }
+
+    SDL_SetHint(SDL_HINT_LOG_ASYNC, mode);
+    SDL_SetAtomicInt(&delivered, 0);
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_threads; ++i) {
+        data[i].index = i;
+        data[i].latencies = &latencies[i * count];
+        threads[i] = SDL_CreateThread(log_thread, "log", &data[i]);
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+    }
+    elapsed = SDL_GetTicksNS() - start;
+    SDL_FlushLogs();
+    flushed = SDL_GetTicksNS() - start;
+
+    SDL_qsort(latencies, total, sizeof(*latencies), compare_latency);
+    SDL_Log("%-5s: p50 %7.2f us, p99 %8.2f us, max %9.2f us, %6.1f ms logging, %6.1f ms until written, %d of %d messages written",
+            mode,
+            (double)latencies[total / 2] / 1000.0,
+            (double)latencies[(total * 99) / 100] / 1000.0,
+            (double)latencies[total - 1] / 1000.0,
+            (double)elapsed / 1000000.0, (double)flushed / 1000000.0,
+            SDL_GetAtomicInt(&delivered), total);
+
+    SDL_free(latencies);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    int num_threads = 2;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = (count > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                num_threads = SDL_atoi(argv[i + 1]);
+                consumed = (num_threads > 0 && num_threads <= 64) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--sink-us") == 0 && argv[i + 1]) {
+                sink_us = SDL_atoi(argv[i + 1]);
+                consumed = (sink_us >= 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--count N]", "[--threads N]", "[--sink-us N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    SDL_Log("%d threads logging %d messages each, %d us per message written", num_threads, count, sink_us);
+
+    SDL_SetLogPriority(SDL_LOG_CATEGORY_CUSTOM, SDL_LOG_PRIORITY_INFO);
+    SDL_GetLogOutputFunction(&original_function, &original_userdata);
+    SDL_SetLogOutputFunction(slow_output, NULL);
+    run_test("0", num_threads);
+    run_test("drop", num_threads);
+    run_test("block", num_threads);
+    SDL_SetHint(SDL_HINT_LOG_ASYNC, "0");
+    SDL_SetLogOutputFunction(original_function, original_userdata);
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return 0;
+}
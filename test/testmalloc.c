@@ -0,0 +1,324 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Multi-threaded allocation benchmark for SDL_malloc.
+
+   Two workloads are timed with 1 to N threads:
+   - churn: each thread keeps a working set of small blocks, and randomly
+     frees and replaces them.
+   - handoff: threads are paired up, one allocating blocks and passing them
+     through a ring buffer to the other, which frees them. This is what
+     happens to event memory and audio buffers.
+
+   Run it once plainly and once with --thread-cache to compare. The C runtime
+   allocator may already cache per thread, --locked-allocator puts a single
+   lock around it, the way SDL's built-in allocator works. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define WORKING_SET 256
+#define RING_SIZE   1024
+
+typedef struct
+{
+    SDL_AtomicInt head;
+    SDL_AtomicInt tail;
+    void *blocks[RING_SIZE];
+} Ring;
+
+typedef struct
+{
+    int iterations;
+    Uint64 seed;
+    Ring *ring;
+    bool failed;
+} Worker;
+
+static SDL_SpinLock allocator_lock;
+static SDL_malloc_func original_malloc;
+static SDL_calloc_func original_calloc;
+static SDL_realloc_func original_realloc;
+static SDL_free_func original_free;
+
+static void * SDLCALL locked_malloc(size_t size)
+{
+    void *mem;
+    SDL_LockSpinlock(&allocator_lock);
+    mem = original_malloc(size);
+    SDL_UnlockSpinlock(&allocator_lock);
+    return mem;
+}
+
+static void * SDLCALL locked_calloc(size_t nmemb, size_t size)
+{
+    void *mem;
+    SDL_LockSpinlock(&allocator_lock);
+    mem = original_calloc(nmemb, size);
+    SDL_UnlockSpinlock(&allocator_lock);
+    return mem;
+}
+
+static void * SDLCALL locked_realloc(void *ptr, size_t size)
+{
+    void *mem;
+    SDL_LockSpinlock(&allocator_lock);
+    mem = original_realloc(ptr, size);
+    SDL_UnlockSpinlock(&allocator_lock);
+    return mem;
+}
+
+static void SDLCALL locked_free(void *ptr)
+{
+    SDL_LockSpinlock(&allocator_lock);
+    original_free(ptr);
+    SDL_UnlockSpinlock(&allocator_lock);
+}
+
+static void wait_a_little(int *spins)
+{
+    /* Don't starve the other thread if there aren't enough cores to go around */
+    if (++*spins < 100) {
+        SDL_CPUPauseInstruction();
+    } else {
+        SDL_Delay(0);
+    }
+}
+
+static size_t random_size(Uint64 *state)
+{
+    /* Mostly tiny, with a tail up to 512 bytes */
+    const Sint32 r = SDL_rand_r(state, 1024);
+    if (r < 768) {
+        return 16 + (size_t)(r % 112);
+    }
+    return 128 + (size_t)(r % 385);
+}
+
+static int SDLCALL churn_thread(void *data)
+{
+    Worker *worker = (Worker *)data;
+    void *blocks[WORKING_SET];
+    int i;
+
+    SDL_zeroa(blocks);
+    for (i = 0; i < worker->iterations; ++i) {
+        const int slot = SDL_rand_r(&worker->seed, WORKING_SET);
+        const size_t size = random_size(&worker->seed);
+
+        SDL_free(blocks[slot]);
+        blocks[slot] = SDL_malloc(size);
+        if (!blocks[slot]) {
+            worker->failed = true;
+            break;
+        }
+        /* Touch both ends, so a bad block size shows up under memory checkers */
+        ((Uint8 *)blocks[slot])[0] = (Uint8)i;
+        ((Uint8 *)blocks[slot])[size - 1] = (Uint8)i;
+    }
+    for (i = 0; i < WORKING_SET; ++i) {
+        SDL_free(blocks[i]);
+    }
+    return 0;
+}
+
+static int SDLCALL producer_thread(void *data)
+{
+    Worker *worker = (Worker *)data;
+    Ring *ring = worker->ring;
+    int i;
+
+    for (i = 0; i < worker->iterations; ++i) {
+        const int head = SDL_GetAtomicInt(&ring->head);
+        void *block;
+        int spins = 0;
+
+        while (head - SDL_GetAtomicInt(&ring->tail) >= RING_SIZE) {
+            wait_a_little(&spins);
+        }
+
+        block = SDL_malloc(random_size(&worker->seed));
+        if (!block) {
+            worker->failed = true;
+        }
+        ring->blocks[head % RING_SIZE] = block;
+        SDL_SetAtomicInt(&ring->head, head + 1);
+    }
+    return 0;
+}
+
+static int SDLCALL consumer_thread(void *data)
+{
+    Worker *worker = (Worker *)data;
+    Ring *ring = worker->ring;
+    int i;
+
+    for (i = 0; i < worker->iterations; ++i) {
+        const int tail = SDL_GetAtomicInt(&ring->tail);
+        int spins = 0;
+
+        while (SDL_GetAtomicInt(&ring->head) == tail) {
+            wait_a_little(&spins);
+        }
+
+        SDL_free(ring->blocks[tail % RING_SIZE]);
+        SDL_SetAtomicInt(&ring->tail, tail + 1);
+    }
+    return 0;
+}
+
+/* Returns millions of allocations per second, or a negative value on failure */
+static double run(bool handoff, int num_threads, int iterations)
+{
+    SDL_Thread **threads = (SDL_Thread **)SDL_calloc(num_threads, sizeof(*threads));
+    Worker *workers = (Worker *)SDL_calloc(num_threads, sizeof(*workers));
+    Ring *rings = (Ring *)SDL_calloc(num_threads, sizeof(*rings));
+    Uint64 start, elapsed;
+    bool failed = false;
+    int i;
+
+    if (!threads || !workers || !rings) {
+        SDL_free(threads);
+        SDL_free(workers);
+        SDL_free(rings);
+        return -1.0;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_threads; ++i) {
+        SDL_ThreadFunction func;
+
+        workers[i].iterations = iterations;
+        workers[i].seed = 0x5D1 + i;
+        workers[i].ring = &rings[i / 2];
+        if (handoff) {
+            func = (i % 2) ? consumer_thread : producer_thread;
+        } else {
+            func = churn_thread;
+        }
+        threads[i] = SDL_CreateThread(func, "worker", &workers[i]);
+        if (!threads[i]) {
+            SDL_Log("Couldn't create thread: %s", SDL_GetError());
+            failed = true;
+            if (handoff) {
+                /* Make sure the other half of the pair doesn't wait forever */
+                if (i % 2) {
+                    SDL_SetAtomicInt(&rings[i / 2].tail, iterations);
+                } else {
+                    SDL_SetAtomicInt(&rings[i / 2].head, iterations);
+                }
+            }
+        }
+    }
+    for (i = 0; i < num_threads; ++i) {
+        SDL_WaitThread(threads[i], NULL);
+        if (workers[i].failed) {
+            failed = true;
+        }
+    }
+    elapsed = SDL_GetTicksNS() - start;
+
+    SDL_free(threads);
+    SDL_free(workers);
+    SDL_free(rings);
+
+    if (failed) {
+        return -1.0;
+    }
+    if (handoff) {
+        /* Only the producers allocate */
+        num_threads /= 2;
+    }
+    return ((double)num_threads * iterations / 1000000.0) / ((double)SDL_max(elapsed, 1) / SDL_NS_PER_SECOND);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    bool thread_cache = false;
+    bool locked_allocator = false;
+    int max_threads = 8;
+    int iterations = 1000000;
+    int result = 0;
+    int num_threads;
+    int i;
+
+    /* This has to happen before anything is allocated */
+    for (i = 1; i < argc; ++i) {
+        if (SDL_strcmp(argv[i], "--locked-allocator") == 0) {
+            locked_allocator = true;
+            SDL_GetMemoryFunctions(&original_malloc, &original_calloc, &original_realloc, &original_free);
+            SDL_SetMemoryFunctions(locked_malloc, locked_calloc, locked_realloc, locked_free);
+        } else if (SDL_strcmp(argv[i], "--thread-cache") == 0) {
+            thread_cache = true;
+            if (!SDL_SetMemoryThreadCache(true)) {
+                /* SDL_Log() allocates, so this is only safe to do afterwards */
+                SDL_Log("Couldn't enable thread cache: %s", SDL_GetError());
+                return 1;
+            }
+        }
+    }
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--thread-cache") == 0 ||
+                SDL_strcmp(argv[i], "--locked-allocator") == 0) {
+                consumed = 1;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                max_threads = SDL_atoi(argv[i + 1]);
+                consumed = (max_threads > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--iterations") == 0 && argv[i + 1]) {
+                iterations = SDL_atoi(argv[i + 1]);
+                consumed = (iterations > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--thread-cache]", "[--locked-allocator]", "[--threads N]", "[--iterations N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    SDL_Log("Thread cache %s, %s allocator, %d allocations per thread",
+            thread_cache ? "enabled" : "disabled", locked_allocator ? "locked" : "default", iterations);
+    SDL_Log("%8s %14s %14s", "threads", "churn", "handoff");
+    for (num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+        const double churn = run(false, num_threads, iterations);
+        /* The handoff test needs a pair of threads */
+        const double handoff = run(true, SDL_max(num_threads, 2), iterations);
+
+        if (churn < 0.0 || handoff < 0.0) {
+            SDL_Log("Allocation failed with %d threads", num_threads);
+            result = 1;
+            break;
+        }
+        SDL_Log("%8d %9.2f M/s %9.2f M/s", num_threads, churn, handoff);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return result;
+}
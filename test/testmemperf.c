@@ -0,0 +1,188 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures memory bandwidth of SDL's copies and fills against the C runtime.
+
+   For buffer sizes from 1 KB up to well past the size of the CPU caches,
+   this copies with memcpy() and by blitting between surfaces, and fills with
+   memset(), SDL_memset4() and SDL_FillSurfaceRect(). The bandwidth of each
+   is reported in GB/s, so the sizes where SDL's vector code and its
+   non-temporal stores start to pay off can be compared with the C runtime. */
+
+#include <string.h>
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+/* Surfaces are made of rows of this many bytes, or a single row if smaller */
+#define ROW_BYTES 4096
+
+typedef enum
+{
+    TEST_MEMCPY,
+    TEST_BLIT,
+    TEST_MEMSET,
+    TEST_MEMSET4,
+    TEST_FILLRECT
+} TestType;
+
+static SDL_Surface *create_surface(void *pixels, size_t size)
+{
+    const int pitch = (int)SDL_min(size, ROW_BYTES);
+    SDL_Surface *surface = SDL_CreateSurfaceFrom(pitch / 4, (int)(size / pitch), SDL_PIXELFORMAT_ARGB8888, pixels, pitch);
+
+    /* Blits are straight copies */
+    if (surface) {
+        SDL_SetSurfaceBlendMode(surface, SDL_BLENDMODE_NONE);
+    }
+    return surface;
+}
+
+static double measure(TestType type, Uint8 *dst, Uint8 *src, size_t size, SDL_Surface *dst_surface, SDL_Surface *src_surface)
+{
+    /* Move at least 64 MB per trial, so small sizes get enough repeats to time */
+    const int repeats = (int)SDL_max(2, (64 * 1024 * 1024) / size);
+    Uint64 start, elapsed, best = 0;
+    int trial, i;
+
+    /* The best of a few trials, to filter out noise from other processes */
+    for (trial = 0; trial < 3; ++trial) {
+        start = SDL_GetTicksNS();
+        for (i = 0; i < repeats; ++i) {
+            switch (type) {
+            case TEST_MEMCPY:
+                memcpy(dst, src, size);
+                break;
+            case TEST_BLIT:
+                SDL_BlitSurface(src_surface, NULL, dst_surface, NULL);
+                break;
+            case TEST_MEMSET:
+                memset(dst, i & 0xFF, size);
+                break;
+            case TEST_MEMSET4:
+                SDL_memset4(dst, (Uint32)i * 0x01010101, size / 4);
+                break;
+            case TEST_FILLRECT:
+                SDL_FillSurfaceRect(dst_surface, NULL, (Uint32)i * 0x01010101);
+                break;
+            }
+        }
+        elapsed = SDL_GetTicksNS() - start;
+        if (!best || elapsed < best) {
+            best = elapsed;
+        }
+    }
+
+    return ((double)size * repeats / (1024.0 * 1024.0 * 1024.0)) / ((double)best / 1000000000.0);
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    size_t max_size = 64;
+    size_t size;
+    bool ok = true;
+    int i;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--max-size") == 0 && argv[i + 1]) {
+                max_size = (size_t)SDL_atoi(argv[i + 1]);
+                consumed = (max_size > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--max-size MB]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+    max_size *= 1024 * 1024;
+
+    SDL_Log("Bandwidth in GB/s, %d CPU cores, %d byte cache lines", SDL_GetNumLogicalCPUCores(), SDL_GetCPUCacheLineSize());
+    SDL_Log("%10s %10s %10s %10s %10s %10s", "size", "memcpy", "blit", "memset", "memset4", "fillrect");
+
+    for (size = 1024; size <= max_size; size *= 4) {
+        Uint8 *src = (Uint8 *)SDL_malloc(size);
+        Uint8 *dst = (Uint8 *)SDL_malloc(size);
+        SDL_Surface *src_surface = NULL, *dst_surface = NULL;
+        double results[TEST_FILLRECT + 1];
+        const Uint32 pattern = 0x12345678;
+        size_t j;
+
+        if (src && dst) {
+            src_surface = create_surface(src, size);
+            dst_surface = create_surface(dst, size);
+        }
+        if (!src_surface || !dst_surface) {
+            SDL_Log("Couldn't create %d KB buffers: %s", (int)(size / 1024), SDL_GetError());
+            ok = false;
+            SDL_free(src);
+            SDL_free(dst);
+            break;
+        }
+        for (j = 0; j < size; ++j) {
+            src[j] = (Uint8)j;
+        }
+
+        for (i = 0; i <= TEST_FILLRECT; ++i) {
+            results[i] = measure((TestType)i, dst, src, size, dst_surface, src_surface);
+        }
+
+        /* Check that the last copy and fill did the right thing */
+        SDL_BlitSurface(src_surface, NULL, dst_surface, NULL);
+        if (SDL_memcmp(dst, src, size) != 0) {
+            SDL_Log("%d KB blit is wrong", (int)(size / 1024));
+            ok = false;
+        }
+        /* An unaligned start rotates the pattern for the aligned stores */
+        SDL_memset4(dst + 5, pattern, (size - 8) / 4);
+        for (j = 5; j + 4 <= size - 3; j += 4) {
+            if (SDL_memcmp(dst + j, &pattern, sizeof(pattern)) != 0) {
+                SDL_Log("%d KB SDL_memset4() is wrong", (int)(size / 1024));
+                ok = false;
+                break;
+            }
+        }
+
+        if (size >= 1024 * 1024) {
+            SDL_Log("%7d MB %10.2f %10.2f %10.2f %10.2f %10.2f", (int)(size / (1024 * 1024)),
+                    results[TEST_MEMCPY], results[TEST_BLIT], results[TEST_MEMSET], results[TEST_MEMSET4], results[TEST_FILLRECT]);
+        } else {
+            SDL_Log("%7d KB %10.2f %10.2f %10.2f %10.2f %10.2f", (int)(size / 1024),
+                    results[TEST_MEMCPY], results[TEST_BLIT], results[TEST_MEMSET], results[TEST_MEMSET4], results[TEST_FILLRECT]);
+        }
+
+        SDL_DestroySurface(src_surface);
+        SDL_DestroySurface(dst_surface);
+        SDL_free(src);
+        SDL_free(dst);
+    }
+
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Measures the cost of object properties at scale.
+
+   This creates a large number of small textures on a software renderer,
+   since every texture carries its own group of properties, and reports the
+   allocations, memory and time it takes. Then it reads a few properties
+   back from every texture, by name and by atom, and destroys them all. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+static SDL_malloc_func real_malloc;
+static SDL_calloc_func real_calloc;
+static SDL_realloc_func real_realloc;
+static SDL_free_func real_free;
+static SDL_AtomicInt num_allocations;
+static SDL_AtomicInt num_bytes;
+
+/* Every block starts with its size, so the bytes in use can be counted when it's freed */
+typedef union
+{
+    size_t size;
+    Sint64 align_int;
+    double align_double;
+    void *align_pointer;
+} BlockHeader;
+
+static void *track_block(BlockHeader *header, size_t size)
+{
+    if (!header) {
+        return NULL;
+    }
+    header->size = size;
+    SDL_AddAtomicInt(&num_bytes, (int)size);
+    return header + 1;
+}
+
+static void * SDLCALL counting_malloc(size_t size)
+{
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return track_block((BlockHeader *)real_malloc(sizeof(BlockHeader) + size), size);
+}
+
+static void * SDLCALL counting_calloc(size_t nmemb, size_t size)
+{
+    size_t total;
+
+    if (!SDL_size_mul_check_overflow(nmemb, size, &total)) {
+        return NULL;
+    }
+    SDL_AddAtomicInt(&num_allocations, 1);
+    return track_block((BlockHeader *)real_calloc(1, sizeof(BlockHeader) + total), total);
+}
+
+static void * SDLCALL counting_realloc(void *mem, size_t size)
+{
+    BlockHeader *header = NULL;
+    size_t old_size = 0;
+
+    SDL_AddAtomicInt(&num_allocations, 1);
+    if (mem) {
+        header = (BlockHeader *)mem - 1;
+        old_size = header->size;
+    }
+    header = (BlockHeader *)real_realloc(header, sizeof(BlockHeader) + size);
+    if (!header) {
+        return NULL;
+    }
+    SDL_AddAtomicInt(&num_bytes, -(int)old_size);
+    return track_block(header, size);
+}
+
+static void SDLCALL counting_free(void *mem)
+{
+    if (mem) {
+        BlockHeader *header = (BlockHeader *)mem - 1;
+        SDL_AddAtomicInt(&num_bytes, -(int)header->size);
+        real_free(header);
+    }
+}
+
+static const char *names[] = {
+    SDL_PROP_TEXTURE_FORMAT_NUMBER,
+    SDL_PROP_TEXTURE_ACCESS_NUMBER,
+    SDL_PROP_TEXTURE_WIDTH_NUMBER,
+    SDL_PROP_TEXTURE_HEIGHT_NUMBER
+};
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    SDL_Surface *surface;
+    SDL_Renderer *renderer;
+    SDL_Texture **textures;
+    SDL_PropertyAtom atoms[SDL_arraysize(names)];
+    int count = 100000;
+    int allocations, bytes;
+    Sint64 sum = 0, expected;
+    Uint64 start, create_time, name_time, atom_time, destroy_time;
+    int i, j;
+
+    SDL_GetOriginalMemoryFunctions(&real_malloc, &real_calloc, &real_realloc, &real_free);
+    SDL_SetMemoryFunctions(counting_malloc, counting_calloc, counting_realloc, counting_free);
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--count") == 0 && argv[i + 1]) {
+                count = SDL_atoi(argv[i + 1]);
+                consumed = (count > 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--count N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    surface = SDL_CreateSurface(64, 64, SDL_PIXELFORMAT_RGBA32);
+    renderer = surface ? SDL_CreateSoftwareRenderer(surface) : NULL;
+    textures = (SDL_Texture **)SDL_calloc(count, sizeof(*textures));
+    if (!renderer || !textures) {
+        SDL_Log("Couldn't create renderer: %s", SDL_GetError());
+        return 1;
+    }
+    for (i = 0; i < (int)SDL_arraysize(names); ++i) {
+        atoms[i] = SDL_GetPropertyAtom(names[i]);
+    }
+
+    allocations = SDL_GetAtomicInt(&num_allocations);
+    bytes = SDL_GetAtomicInt(&num_bytes);
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        textures[i] = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA32, SDL_TEXTUREACCESS_STATIC, 1 + (i % 4), 1);
+        if (!textures[i]) {
+            SDL_Log("Couldn't create texture %d: %s", i, SDL_GetError());
+            return 1;
+        }
+    }
+    create_time = SDL_GetTicksNS() - start;
+    allocations = SDL_GetAtomicInt(&num_allocations) - allocations;
+    bytes = SDL_GetAtomicInt(&num_bytes) - bytes;
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        SDL_PropertiesID props = SDL_GetTextureProperties(textures[i]);
+        for (j = 0; j < (int)SDL_arraysize(names); ++j) {
+            sum += SDL_GetNumberProperty(props, names[j], 0);
+        }
+    }
+    name_time = SDL_GetTicksNS() - start;
+    expected = sum;
+
+    sum = 0;
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        SDL_PropertiesID props = SDL_GetTextureProperties(textures[i]);
+        for (j = 0; j < (int)SDL_arraysize(names); ++j) {
+            sum += SDL_GetNumberPropertyByAtom(props, atoms[j], 0);
+        }
+    }
+    atom_time = SDL_GetTicksNS() - start;
+    if (sum != expected) {
+        SDL_Log("Lookups by atom returned %" SDL_PRIs64 ", expected %" SDL_PRIs64, sum, expected);
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < count; ++i) {
+        SDL_DestroyTexture(textures[i]);
+    }
+    destroy_time = SDL_GetTicksNS() - start;
+
+    SDL_Log("%d textures", count);
+    SDL_Log("create:  %8.2f ms, %6.2f allocations and %6.0f bytes per texture",
+            (double)create_time / 1000000.0, (double)allocations / count, (double)bytes / count);
+    SDL_Log("by name: %8.2f ms, %6.1f ns per lookup",
+            (double)name_time / 1000000.0, (double)name_time / count / SDL_arraysize(names));
+    SDL_Log("by atom: %8.2f ms, %6.1f ns per lookup",
+            (double)atom_time / 1000000.0, (double)atom_time / count / SDL_arraysize(names));
+    SDL_Log("destroy: %8.2f ms", (double)destroy_time / 1000000.0);
+
+    SDL_free(textures);
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroySurface(surface);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return 0;
+}
@@ -10,6 +10,8 @@
   freely.
 */
 
+#include <stddef.h>
+
 #include <SDL3/SDL.h>
 #include <SDL3/SDL_main.h>
 #include <SDL3/SDL_test.h>
@@ -61,6 +63,301 @@ test_sort(const char *desc, int *nums, const int arraylen)
     }
 }
 
+typedef struct
+{
+    Uint32 key;
+    Uint32 index;
+} Record32;
+
+typedef struct
+{
+    Sint64 key;
+    Uint64 index;
+} Record64;
+
+static int SDLCALL
+record_compare_r(void *userdata, const void *_a, const void *_b)
+{
+    const Record32 *a = (const Record32 *)_a;
+    const Record32 *b = (const Record32 *)_b;
+    return (a->key < b->key) ? -1 : ((a->key > b->key) ? 1 : 0);
+}
+
+static void
+test_sort_keys(Uint64 *seed)
+{
+    static const int lengths[] = { 0, 1, 12, 31, 32, 1000, 100000 };
+    int i, n;
+
+    for (n = 0; n < SDL_arraysize(lengths); n++) {
+        const int arraylen = lengths[n];
+        Record32 *records32 = (Record32 *)SDL_malloc(sizeof(*records32) * (arraylen + 1));
+        Record64 *records64 = (Record64 *)SDL_malloc(sizeof(*records64) * (arraylen + 1));
+        Uint8 *packed = (Uint8 *)SDL_malloc(13 * (arraylen + 1));
+        bool ok = true;
+
+        if (!records32 || !records64 || !packed) {
+            SDL_Log("out of memory");
+            return;
+        }
+
+        SDL_Log("test: SDL_SortKeys arraylen=%d", arraylen);
+
+        /* Unsigned keys with lots of duplicates, to check that the sort is stable */
+        for (i = 0; i < arraylen; i++) {
+            records32[i].key = (Uint32)SDL_rand_r(seed, 100) << (i % 3 * 12);
+            records32[i].index = i;
+        }
+        SDL_SortKeys32(records32, arraylen, sizeof(*records32), offsetof(Record32, key), SDL_SORTKEY_UNSIGNED);
+        for (i = 1; i < arraylen; i++) {
+            if (records32[i - 1].key > records32[i].key ||
+                (records32[i - 1].key == records32[i].key && records32[i - 1].index > records32[i].index)) {
+                ok = false;
+            }
+        }
+
+        /* Signed keys */
+        for (i = 0; i < arraylen; i++) {
+            records32[i].key = (Uint32)(SDL_rand_r(seed, 2000000) - 1000000);
+        }
+        SDL_SortKeys32(records32, arraylen, sizeof(*records32), offsetof(Record32, key), SDL_SORTKEY_SIGNED);
+        for (i = 1; i < arraylen; i++) {
+            if ((Sint32)records32[i - 1].key > (Sint32)records32[i].key) {
+                ok = false;
+            }
+        }
+
+        /* Float keys, including zeroes of both signs */
+        for (i = 0; i < arraylen; i++) {
+            const float value = (i % 10 == 0) ? ((i % 20 == 0) ? -0.0f : 0.0f) : (SDL_randf_r(seed) - 0.5f) * 1000.0f;
+            SDL_memcpy(&records32[i].key, &value, sizeof(value));
+        }
+        SDL_SortKeys32(records32, arraylen, sizeof(*records32), offsetof(Record32, key), SDL_SORTKEY_FLOAT);
+        for (i = 1; i < arraylen; i++) {
+            float a, b;
+            SDL_memcpy(&a, &records32[i - 1].key, sizeof(a));
+            SDL_memcpy(&b, &records32[i].key, sizeof(b));
+            /* -0.0 sorts before 0.0 */
+            if (a > b || (a == 0.0f && b == 0.0f && records32[i - 1].key == 0 && records32[i].key != 0)) {
+                ok = false;
+            }
+        }
+
+        /* 64-bit signed keys that only differ in the upper bits */
+        for (i = 0; i < arraylen; i++) {
+            records64[i].key = (Sint64)(SDL_rand_r(seed, 2000) - 1000) << 40;
+            records64[i].index = i;
+        }
+        SDL_SortKeys64(records64, arraylen, sizeof(*records64), offsetof(Record64, key), SDL_SORTKEY_SIGNED);
+        for (i = 1; i < arraylen; i++) {
+            if (records64[i - 1].key > records64[i].key ||
+                (records64[i - 1].key == records64[i].key && records64[i - 1].index > records64[i].index)) {
+                ok = false;
+            }
+        }
+
+        /* Doubles at an unaligned offset in odd sized elements */
+        for (i = 0; i < arraylen; i++) {
+            const double value = ((double)SDL_randf_r(seed) - 0.5) * 1e300;
+            SDL_memset(&packed[i * 13], i & 0xFF, 13);
+            SDL_memcpy(&packed[i * 13 + 3], &value, sizeof(value));
+        }
+        SDL_SortKeys64(packed, arraylen, 13, 3, SDL_SORTKEY_FLOAT);
+        for (i = 1; i < arraylen; i++) {
+            double a, b;
+            SDL_memcpy(&a, &packed[(i - 1) * 13 + 3], sizeof(a));
+            SDL_memcpy(&b, &packed[i * 13 + 3], sizeof(b));
+            if (a > b || packed[i * 13] != packed[i * 13 + 12]) {
+                ok = false;
+            }
+        }
+
+        if (SDL_SortKeys32(records32, arraylen, sizeof(*records32), sizeof(*records32) - 3, SDL_SORTKEY_UNSIGNED)) {
+            SDL_Log("SDL_SortKeys32 accepted a key past the end of the element!");
+        }
+
+        if (!ok) {
+            SDL_Log("SDL_SortKeys is broken!");
+        }
+
+        SDL_free(records32);
+        SDL_free(records64);
+        SDL_free(packed);
+    }
+}
+
+static void
+test_parallel_sort(Uint64 *seed)
+{
+    const int arraylen = 300000;
+    int *nums = (int *)SDL_malloc(sizeof(*nums) * arraylen);
+    int *nums_copy = (int *)SDL_malloc(sizeof(*nums) * arraylen);
+    int i;
+
+    if (!nums || !nums_copy) {
+        SDL_Log("out of memory");
+        return;
+    }
+
+    SDL_Log("test: SDL_ParallelSort arraylen=%d", arraylen);
+
+    for (i = 0; i < arraylen; i++) {
+        nums[i] = SDL_rand_r(seed, 1000000);
+    }
+    SDL_memcpy(nums_copy, nums, sizeof(*nums) * arraylen);
+
+    SDL_ParallelSort(nums, arraylen, sizeof(nums[0]), num_compare_r, &a_global_var);
+    SDL_qsort(nums_copy, arraylen, sizeof(nums[0]), num_compare);
+    if (SDL_memcmp(nums, nums_copy, sizeof(*nums) * arraylen) != 0) {
+        SDL_Log("parallel sort is broken!");
+    }
+
+    SDL_free(nums);
+    SDL_free(nums_copy);
+}
+
+/* M. D. McIlroy, "A Killer Adversary for Quicksort".
+   The compare function decides the values of the elements as the sort looks
+   at them, in the way that makes the most trouble for any quicksort. */
+static int *adversary_values;
+static int adversary_gas;
+static int adversary_solid;
+static int adversary_candidate;
+static Uint64 adversary_compares;
+
+static int SDLCALL
+adversary_compare(const void *_a, const void *_b)
+{
+    const int a = *((const int *)_a);
+    const int b = *((const int *)_b);
+
+    ++adversary_compares;
+    if (adversary_values[a] == adversary_gas && adversary_values[b] == adversary_gas) {
+        adversary_values[(a == adversary_candidate) ? a : b] = adversary_solid++;
+    }
+    if (adversary_values[a] == adversary_gas) {
+        adversary_candidate = a;
+    } else if (adversary_values[b] == adversary_gas) {
+        adversary_candidate = b;
+    }
+    return adversary_values[a] - adversary_values[b];
+}
+
+static void
+test_adversary(void)
+{
+    const int arraylen = 50000;
+    int *nums = (int *)SDL_malloc(sizeof(*nums) * arraylen);
+    Uint64 limit = 0;
+    int i;
+
+    adversary_values = (int *)SDL_malloc(sizeof(*adversary_values) * arraylen);
+    if (!nums || !adversary_values) {
+        SDL_Log("out of memory");
+        return;
+    }
+
+    SDL_Log("test: quicksort adversary arraylen=%d", arraylen);
+
+    adversary_gas = arraylen;
+    adversary_solid = 0;
+    adversary_candidate = 0;
+    adversary_compares = 0;
+    for (i = 0; i < arraylen; i++) {
+        nums[i] = i;
+        adversary_values[i] = adversary_gas;
+    }
+    SDL_qsort(nums, arraylen, sizeof(nums[0]), adversary_compare);
+
+    /* Quadratic behavior would be hundreds of millions of comparisons */
+    for (i = arraylen; i > 1; i >>= 1) {
+        limit += 8 * arraylen;
+    }
+    SDL_Log("%" SDL_PRIu64 " comparisons", adversary_compares);
+    if (adversary_compares > limit) {
+        SDL_Log("sort went quadratic!");
+    }
+    for (i = 1; i < arraylen; i++) {
+        if (adversary_values[nums[i - 1]] > adversary_values[nums[i]]) {
+            SDL_Log("sort is broken!");
+            break;
+        }
+    }
+
+    SDL_free(nums);
+    SDL_free(adversary_values);
+}
+
+static double
+benchmark_ns_per_element(Record32 *records, const Record32 *input, int arraylen, int method)
+{
+    const int repeats = SDL_max(1, 1000000 / arraylen);
+    Uint64 elapsed = 0;
+    int i;
+
+    for (i = 0; i < repeats; i++) {
+        Uint64 start;
+
+        SDL_memcpy(records, input, sizeof(*records) * arraylen);
+        start = SDL_GetTicksNS();
+        switch (method) {
+        case 0:
+            SDL_qsort_r(records, arraylen, sizeof(*records), record_compare_r, NULL);
+            break;
+        case 1:
+            SDL_SortKeys32(records, arraylen, sizeof(*records), offsetof(Record32, key), SDL_SORTKEY_UNSIGNED);
+            break;
+        default:
+            SDL_ParallelSort(records, arraylen, sizeof(*records), record_compare_r, NULL);
+            break;
+        }
+        elapsed += SDL_GetTicksNS() - start;
+    }
+    for (i = 1; i < arraylen; i++) {
+        if (records[i - 1].key > records[i].key) {
+            SDL_Log("sort is broken!");
+            break;
+        }
+    }
+    return (double)elapsed / repeats / arraylen;
+}
+
+static void
+run_benchmark(Uint64 *seed)
+{
+    static const int lengths[] = { 1000, 10000, 100000, 1000000, 10000000 };
+    int i, n;
+
+    SDL_Log("Sorting 8 byte records by a random 32-bit key, %d CPU cores", SDL_GetNumLogicalCPUCores());
+    SDL_Log("%10s %18s %18s %18s", "elements", "SDL_qsort_r", "SDL_SortKeys32", "SDL_ParallelSort");
+
+    for (n = 0; n < SDL_arraysize(lengths); n++) {
+        const int arraylen = lengths[n];
+        Record32 *input = (Record32 *)SDL_malloc(sizeof(*input) * arraylen);
+        Record32 *records = (Record32 *)SDL_malloc(sizeof(*records) * arraylen);
+        double qsort_ns, keys_ns, parallel_ns;
+
+        if (!input || !records) {
+            SDL_Log("out of memory");
+            SDL_free(input);
+            SDL_free(records);
+            return;
+        }
+        for (i = 0; i < arraylen; i++) {
+            input[i].key = (Uint32)SDL_rand_bits_r(seed);
+            input[i].index = i;
+        }
+
+        qsort_ns = benchmark_ns_per_element(records, input, arraylen, 0);
+        keys_ns = benchmark_ns_per_element(records, input, arraylen, 1);
+        parallel_ns = benchmark_ns_per_element(records, input, arraylen, 2);
+        SDL_Log("%10d %12.2f ns/el %12.2f ns/el %12.2f ns/el", arraylen, qsort_ns, keys_ns, parallel_ns);
+
+        SDL_free(input);
+        SDL_free(records);
+    }
+}
+
 int main(int argc, char *argv[])
 {
     static int nums[1024 * 100];
@@ -70,6 +367,7 @@ int main(int argc, char *argv[])
     SDLTest_CommonState *state;
     Uint64 seed = 0;
     int seed_seen = 0;
+    bool benchmark = false;
 
     /* Initialize test framework */
     state = SDLTest_CommonCreateState(argv, 0);
@@ -83,7 +381,10 @@ int main(int argc, char *argv[])
 
         consumed = SDLTest_CommonArg(state, i);
         if (!consumed) {
-            if (!seed_seen) {
+            if (SDL_strcmp(argv[i], "--benchmark") == 0) {
+                benchmark = true;
+                consumed = 1;
+            } else if (!seed_seen) {
                 char *endptr = NULL;
 
                 seed = (Uint64)SDL_strtoull(argv[i], &endptr, 0);
@@ -97,7 +398,7 @@ int main(int argc, char *argv[])
             }
         }
         if (consumed <= 0) {
-            static const char *options[] = { "[seed]", NULL };
+            static const char *options[] = { "[--benchmark]", "[seed]", NULL };
             SDLTest_CommonLogUsage(state, argv[0], options);
             return 1;
         }
@@ -135,6 +436,14 @@ int main(int argc, char *argv[])
         test_sort("random sorted", nums, arraylen);
     }
 
+    test_sort_keys(&seed);
+    test_parallel_sort(&seed);
+    test_adversary();
+
+    if (benchmark) {
+        run_benchmark(&seed);
+    }
+
     SDL_Quit();
     SDLTest_CommonDestroyState(state);
 
@@ -26,6 +26,7 @@
 
 static SDL_Semaphore *sem;
 static int alive;
+static SDL_AtomicInt tokens_taken;
 
 typedef struct Thread_State
 {
@@ -256,6 +257,65 @@ TestOverheadContended(bool try_wait)
     SDL_DestroySemaphore(sem);
 }
 
+static int SDLCALL
+ThreadFuncThroughputContended(void *data)
+{
+    Thread_State *state = (Thread_State *)data;
+    const int total = NUM_OVERHEAD_OPS * NUM_OVERHEAD_OPS_MULT;
+
+    /* Every thread gets one token past the total, which tells it to stop */
+    for (;;) {
+        SDL_WaitSemaphore(sem);
+        if (SDL_AddAtomicInt(&tokens_taken, 1) >= total) {
+            break;
+        }
+        ++state->loop_count;
+    }
+    return 0;
+}
+
+static void
+TestThroughputContended(void)
+{
+    Uint64 start_ticks;
+    Uint64 end_ticks;
+    Uint64 duration;
+    Thread_State thread_states[NUM_THREADS] = { { 0 } };
+    const int total = NUM_OVERHEAD_OPS * NUM_OVERHEAD_OPS_MULT;
+    int loop_count;
+    int i;
+
+    sem = SDL_CreateSemaphore(0);
+    SDL_SetAtomicInt(&tokens_taken, 0);
+    SDL_Log("Doing %d contended Post/Wait operations on semaphore using %d threads (%s)",
+            total, NUM_THREADS, SDL_GetHintBoolean(SDL_HINT_LINUX_FORCE_PTHREAD_SYNC, false) ? "pthread" : "default");
+
+    start_ticks = SDL_GetTicksNS();
+    for (i = 0; i < NUM_THREADS; ++i) {
+        char name[64];
+        (void)SDL_snprintf(name, sizeof(name), "Thread%u", (unsigned int)i);
+        thread_states[i].thread = SDL_CreateThread(ThreadFuncThroughputContended, name, (void *)&thread_states[i]);
+    }
+    for (i = 0; i < total + NUM_THREADS; ++i) {
+        SDL_SignalSemaphore(sem);
+    }
+
+    loop_count = 0;
+    for (i = 0; i < NUM_THREADS; ++i) {
+        SDL_WaitThread(thread_states[i].thread, NULL);
+        loop_count += thread_states[i].loop_count;
+    }
+    end_ticks = SDL_GetTicksNS();
+    SDL_assert_release(loop_count == total);
+
+    duration = end_ticks - start_ticks;
+    SDL_Log("Took %" SDL_PRIu64 " milliseconds, %.2f million operations per second",
+            SDL_NS_TO_MS(duration), (double)total / ((double)duration / 1000.0));
+    SDL_Log("%s", "");
+
+    SDL_DestroySemaphore(sem);
+}
+
 int main(int argc, char **argv)
 {
     int arg_count = 0;
@@ -324,6 +384,8 @@ int main(int argc, char **argv)
         TestOverheadContended(false);
 
         TestOverheadContended(true);
+
+        TestThroughputContended();
     }
 
     SDL_Quit();
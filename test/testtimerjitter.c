@@ -0,0 +1,223 @@
+/*
+  Copyright (C) 1997-2025 Sam Lantinga <slouken@libsdl.org>
+
+  This software is provided 'as-is', without any express or implied
+  warranty.  In no event will the authors be held liable for any damages
+  arising from the use of this software.
+
+  Permission is granted to anyone to use this software for any purpose,
+  including commercial applications, and to alter it and redistribute it
+  freely.
+*/
+
+/* Stress test for the timer thread.
+
+   This creates a large number of periodic timers with intervals between
+   10 and 100 ms and lets them run for a while. Each callback measures how
+   late it was called compared to when it should have been, which grows
+   with the amount of work the timer thread does to keep its queue sorted.
+   A fraction of the timers are removed and replaced while the test runs.
+
+   With --threads N, the callbacks run on a pool of N worker threads (see
+   SDL_HINT_TIMER_THREADS), and the time spent in callbacks is reported as a
+   number of cores kept busy. With --slow N, one more timer blocks for N ms
+   each time it runs, which delays every other timer unless there are worker
+   threads. */
+
+#include <SDL3/SDL.h>
+#include <SDL3/SDL_main.h>
+#include <SDL3/SDL_test.h>
+
+#define NUM_BUCKETS 12 /* lateness histogram, by powers of 4 starting at 1 us */
+
+typedef struct
+{
+    SDL_TimerID id;
+    Uint64 due;
+} TimerState;
+
+static SDL_AtomicInt num_calls;
+static SDL_SpinLock stats_lock;
+static Uint64 total_lateness;
+static Uint64 max_lateness;
+static int histogram[NUM_BUCKETS];
+
+static Uint64 SDLCALL timer_callback(void *userdata, SDL_TimerID timerID, Uint64 interval)
+{
+    TimerState *state = (TimerState *)userdata;
+    const Uint64 now = SDL_GetTicksNS();
+
+    /* Callbacks may run on several threads with SDL_HINT_TIMER_THREADS */
+    SDL_LockSpinlock(&stats_lock);
+    if (now > state->due) {
+        const Uint64 lateness = now - state->due;
+        Uint64 limit = 1000;
+        int bucket = 0;
+
+        while (bucket < NUM_BUCKETS - 1 && lateness >= limit) {
+            limit *= 4;
+            ++bucket;
+        }
+        ++histogram[bucket];
+        total_lateness += lateness;
+        max_lateness = SDL_max(max_lateness, lateness);
+    } else {
+        ++histogram[0];
+    }
+    SDL_UnlockSpinlock(&stats_lock);
+    SDL_AddAtomicInt(&num_calls, 1);
+
+    state->due = now + interval;
+    return interval;
+}
+
+static Uint32 SDLCALL slow_callback(void *userdata, SDL_TimerID timerID, Uint32 interval)
+{
+    SDL_Delay(*(int *)userdata);
+    return interval;
+}
+
+static void add_timer(TimerState *state, Uint64 interval)
+{
+    state->due = SDL_GetTicksNS() + interval;
+    state->id = SDL_AddTimerNS(interval, timer_callback, state);
+    if (!state->id) {
+        SDL_Log("Couldn't add timer: %s", SDL_GetError());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    SDLTest_CommonState *state;
+    Uint64 seed = 0x5d171e;
+    TimerState *timers;
+    int num_timers = 100000;
+    int seconds = 5;
+    int threads = 0;
+    int slow = 0;
+    SDL_TimerID slow_timer = 0;
+    Uint64 runtime = 0;
+    int replaced = 0;
+    Uint64 start, elapsed;
+    int i, calls;
+
+    /* Initialize test framework */
+    state = SDLTest_CommonCreateState(argv, 0);
+    if (!state) {
+        return 1;
+    }
+
+    /* Parse commandline */
+    for (i = 1; i < argc;) {
+        int consumed;
+
+        consumed = SDLTest_CommonArg(state, i);
+        if (!consumed) {
+            if (SDL_strcmp(argv[i], "--timers") == 0 && argv[i + 1]) {
+                num_timers = SDL_atoi(argv[i + 1]);
+                consumed = (num_timers > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--seconds") == 0 && argv[i + 1]) {
+                seconds = SDL_atoi(argv[i + 1]);
+                consumed = (seconds > 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--threads") == 0 && argv[i + 1]) {
+                threads = SDL_atoi(argv[i + 1]);
+                consumed = (threads >= 0) ? 2 : -1;
+            } else if (SDL_strcmp(argv[i], "--slow") == 0 && argv[i + 1]) {
+                slow = SDL_atoi(argv[i + 1]);
+                consumed = (slow >= 0) ? 2 : -1;
+            }
+        }
+        if (consumed <= 0) {
+            static const char *options[] = { "[--timers N]", "[--seconds N]", "[--threads N]", "[--slow N]", NULL };
+            SDLTest_CommonLogUsage(state, argv[0], options);
+            return 1;
+        }
+
+        i += consumed;
+    }
+
+    if (threads > 0) {
+        char value[16];
+        SDL_snprintf(value, sizeof(value), "%d", threads);
+        SDL_SetHint(SDL_HINT_TIMER_THREADS, value);
+    }
+
+    if (!SDL_Init(0)) {
+        SDL_Log("Couldn't initialize SDL: %s", SDL_GetError());
+        return 1;
+    }
+
+    timers = (TimerState *)SDL_calloc(num_timers, sizeof(*timers));
+    if (!timers) {
+        SDL_Quit();
+        return 1;
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_timers; ++i) {
+        add_timer(&timers[i], SDL_MS_TO_NS(10 + SDL_rand_r(&seed, 91)));
+    }
+    SDL_Log("Added %d timers in %.2f ms", num_timers, (double)(SDL_GetTicksNS() - start) / 1000000.0);
+
+    if (slow > 0) {
+        slow_timer = SDL_AddTimer(10, slow_callback, &slow);
+    }
+
+    start = SDL_GetTicksNS();
+    while ((elapsed = SDL_GetTicksNS() - start) < SDL_SECONDS_TO_NS(seconds)) {
+        /* Replace one in a hundred timers every 100 ms */
+        for (i = 0; i < num_timers / 100; ++i) {
+            TimerState *timer = &timers[SDL_rand_r(&seed, num_timers)];
+            if (SDL_RemoveTimer(timer->id)) {
+                add_timer(timer, SDL_MS_TO_NS(10 + SDL_rand_r(&seed, 91)));
+                ++replaced;
+            }
+        }
+        SDL_Delay(100);
+    }
+
+    for (i = 0; i < num_timers; ++i) {
+        SDL_TimerStats stats;
+        if (SDL_GetTimerStats(timers[i].id, &stats)) {
+            runtime += stats.total_runtime;
+        }
+    }
+
+    if (slow_timer) {
+        SDL_RemoveTimer(slow_timer);
+    }
+
+    start = SDL_GetTicksNS();
+    for (i = 0; i < num_timers; ++i) {
+        SDL_RemoveTimer(timers[i].id);
+    }
+    SDL_Log("Removed %d timers in %.2f ms", num_timers, (double)(SDL_GetTicksNS() - start) / 1000000.0);
+
+    /* Let the timer thread notice the timers are gone before reading the results */
+    SDL_Delay(200);
+
+    calls = SDL_GetAtomicInt(&num_calls);
+    SDL_Log("%d callbacks in %.2f seconds (%d timers replaced) on %d threads", calls, (double)elapsed / 1000000000.0, replaced, SDL_max(threads, 1));
+    SDL_Log("Callbacks kept %.2f cores busy (not counting replaced timers)", (double)runtime / elapsed);
+    if (calls > 0) {
+        Uint64 limit = 1000;
+
+        SDL_Log("Lateness: average %.3f ms, maximum %.3f ms",
+                (double)total_lateness / calls / 1000000.0, (double)max_lateness / 1000000.0);
+        for (i = 0; i < NUM_BUCKETS; ++i, limit *= 4) {
+            if (histogram[i]) {
+                if (i < NUM_BUCKETS - 1) {
+                    SDL_Log("  < %9.3f ms: %d", (double)limit / 1000000.0, histogram[i]);
+                } else {
+                    SDL_Log("  >=%9.3f ms: %d", (double)(limit / 4) / 1000000.0, histogram[i]);
+                }
+            }
+        }
+    }
+
+    SDL_free(timers);
+    SDL_Quit();
+    SDLTest_CommonDestroyState(state);
+
+    return 0;
+}